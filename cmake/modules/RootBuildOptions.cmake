@@ -168,6 +168,7 @@ ROOT_BUILD_OPTION(x11 ON "Enable support for X11")
 ROOT_BUILD_OPTION(xft ON "Enable anti-alias support with Xft")
 ROOT_BUILD_OPTION(xml ON "Enable support for XML (requires libxml2)")
 ROOT_BUILD_OPTION(xrootd ON "Enable support for XRootD file server and client")
+ROOT_BUILD_OPTION(zstd ON "Enable support for ZSTD compression (requires libzstd >= 1.4.0)")
 
 option(all "Enable all optional components by default" OFF)
 option(clingtest "Enable cling tests (Note: that this makes llvm/clang symbols visible in libCling)" OFF)
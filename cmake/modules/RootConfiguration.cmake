@@ -398,6 +398,11 @@ if(lz4)
 else()
   set(haslz4compression undef)
 endif()
+if(zstd)
+  set(haszstd define)
+else()
+  set(haszstd undef)
+endif()
 if(cocoa)
   set(hascocoa define)
 else()
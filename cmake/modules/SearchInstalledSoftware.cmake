@@ -234,6 +234,23 @@ if(builtin_lz4)
   add_subdirectory(builtins/lz4)
 endif()
 
+#---Check for ZSTD-------------------------------------------------------------------
+if(zstd)
+  message(STATUS "Looking for ZSTD")
+  foreach(suffix FOUND INCLUDE_DIR LIBRARY LIBRARIES)
+    unset(ZSTD_${suffix} CACHE)
+  endforeach()
+  find_package(ZSTD 1.4.0)
+  if(NOT ZSTD_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "ZSTD library not found and it is required (zstd option enabled)")
+    else()
+      message(STATUS "ZSTD not found. Switching off zstd option")
+      set(zstd OFF CACHE BOOL "Disabled because ZSTD not found (${zstd_description})" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for X11 which is mandatory lib on Unix--------------------------------------
 if(x11)
   message(STATUS "Looking for X11")
@@ -878,6 +895,18 @@ if(arrow)
     endif()
   endif()
 
+  #---Parquet is built as part of the Arrow C++ libraries, optionally
+  if(ARROW_FOUND)
+    find_path(PARQUET_INCLUDE_DIR parquet/arrow/reader.h HINTS ${ARROW_INCLUDE_DIR})
+    find_library(PARQUET_SHARED_LIB NAMES parquet HINTS ${ARROW_LIBS})
+    if(PARQUET_INCLUDE_DIR AND PARQUET_SHARED_LIB)
+      set(PARQUET_FOUND TRUE)
+      message(STATUS "Found the Parquet library: ${PARQUET_SHARED_LIB}")
+    else()
+      message(STATUS "Parquet library not found, RDataFrame will not read Parquet files.")
+    endif()
+  endif()
+
 endif()
 
 #---Check for cling and llvm --------------------------------------------------------
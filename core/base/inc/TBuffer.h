@@ -23,6 +23,7 @@
 
 #include "TObject.h"
 #include "TClass.h"
+#include "TDataType.h"
 
 #include <vector>
 
@@ -91,6 +92,7 @@ public:
    void     SetParent(TObject *parent);
    TObject *GetParent()  const;
    char    *Buffer()     const { return fBuffer; }
+   char    *GetCurrent() const { return fBufCur; }
    Int_t    BufferSize() const { return fBufSize; }
    void     DetachBuffer() { fBuffer = 0; }
    Int_t    Length()     const { return (Int_t)(fBufCur - fBuffer); }
@@ -102,6 +104,7 @@ public:
 
    virtual Int_t      ReadBuf(void *buf, Int_t max) = 0;
    virtual void       WriteBuf(const void *buf, Int_t max) = 0;
+   virtual Bool_t     ByteSwapBuffer(Long64_t n, EDataType type);
 
    virtual char      *ReadString(char *s, Int_t max) = 0;
    virtual void       WriteString(const char *s) = 0;
@@ -275,6 +275,18 @@ void  TBuffer::SetReAllocFunc(ReAllocCharFun_t reallocfunc )
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Byte-swap in place the n values of basic type `type` starting at the current
+/// position, from the representation used on file to the host one.
+///
+/// The default implementation does not support any conversion and returns
+/// kFALSE, so that callers fall back to reading the values one by one.
+
+Bool_t TBuffer::ByteSwapBuffer(Long64_t /*n*/, EDataType /*type*/)
+{
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set buffer in read mode.
 
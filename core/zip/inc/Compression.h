@@ -25,11 +25,15 @@ namespace ROOT {
 ///    compression usually results in greater compression factors, but takes
 ///    more CPU time and memory when compressing. LZMA memory usage is particularly
 ///    high for compression levels 8 and 9.
-///  - Finally, the LZ4 package results in worse compression ratios
+///  - The LZ4 package results in worse compression ratios
 ///    than ZLIB but achieves much faster decompression rates.
+///  - Finally, the ZSTD package (Zstandard) offers decompression rates close to LZ4
+///    with compression ratios close to LZMA. It is only available if ROOT was built
+///    with ZSTD support (R__HAS_ZSTD); its baskets can additionally be compressed
+///    with a trained per-branch dictionary (see TBranch::TrainCompressionDictionary).
 ///
-/// The current algorithms support level 1 to 9. The higher the level the greater
-/// the compression and more CPU time and memory resources used during compression.
+/// The current algorithms support level 1 to 9 (ZSTD supports level 1 to 22). The higher
+/// the level the greater the compression and more CPU time and memory resources used during compression.
 /// Level 0 means no compression.
 ///
 /// Recommendation for the compression algorithm's levels:
@@ -38,6 +42,7 @@ namespace ROOT {
 ///   since in the case of LZMA we don't care about compression/decompression speed)
 ///   [207 - 208]
 ///  - LZ4 is recommended to be used with compression level 4 [404]
+///  - ZSTD is recommended to be used with compression level 5 [505]
 
 struct RCompressionSetting {
    struct EDefaults { /// Note: this is only temporarily a struct and will become a enum class hence the name convention
@@ -67,6 +72,7 @@ struct RCompressionSetting {
          kUseMin = 1,
          kDefaultZLIB = 1,
          kDefaultLZ4 = 4,
+         kDefaultZSTD = 5,
          kDefaultOld = 6,
          kDefaultLZMA = 7
       };
@@ -87,6 +93,8 @@ struct RCompressionSetting {
          kOldCompressionAlgo,
          /// Use LZ4 compression
          kLZ4,
+         /// Use ZSTD compression
+         kZSTD,
          /// Undefined compression algorithm (must be kept the last of the list in case a new algorithm is added).
          kUndefined
       };
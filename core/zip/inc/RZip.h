@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <stddef.h>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -23,6 +25,12 @@ extern "C" unsigned long R__memcompress(char *tgt, unsigned long tgtsize, char *
 
 extern "C" void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues);
 
+/**
+ * Same as R__zipMultipleAlgorithm, additionally compressing with the dictionary registered under dictid
+ * (see R__zipRegisterDictionary) if the algorithm supports dictionaries.  A dictid of 0 means no dictionary.
+ */
+extern "C" void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues, unsigned dictid);
+
 /**
  * This is a historical definition, prior to ROOT supporting multiple algorithms in a single file.  Use
  * R__zipMultipleAlgorithm instead.
@@ -33,6 +41,22 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * Make a compression dictionary known to the compression routines; R__unzip looks it up by the ID
+ * recorded in the compressed buffers.  Registrations are reference counted.  Returns the dictionary ID,
+ * or 0 if the dictionary is invalid, if a different dictionary with the same ID is already registered
+ * or if ROOT was built without an algorithm supporting dictionaries.
+ */
+extern "C" unsigned R__zipRegisterDictionary(const char *dict, int dictsize);
+
+extern "C" void R__zipUnregisterDictionary(unsigned dictid);
+
+/**
+ * Train a dictionary of at most dictcapacity bytes from nsamples samples stored contiguously in samples.
+ * Returns the size of the dictionary, or 0 on failure.
+ */
+extern "C" int R__zipTrainDictionary(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
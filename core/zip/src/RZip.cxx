@@ -12,6 +12,9 @@
 #include "Bits.h"
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
+#ifdef R__HAS_ZSTD
+#include "ZipZSTD.h"
+#endif
 
 #include "zlib.h"
 
@@ -37,6 +40,7 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
    R__ZipMode = 1 : ZLIB compression algorithm is used (default)
    R__ZipMode = 2 : LZMA compression algorithm is used
    R__ZipMode = 4 : LZ4  compression algorithm is used
+   R__ZipMode = 5 : ZSTD compression algorithm is used
    R__ZipMode = 0 or 3 : a very old compression algorithm is used
    (the very old algorithm is supported for backward compatibility)
    The LZMA algorithm requires the external XZ package be installed when linking
@@ -46,6 +50,11 @@ static void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigne
   The LZ4 algorithm requires the external LZ4 package to be installed when linking
   is done.  LZ4 typically has the worst compression ratios, but much faster decompression
   speeds - sometimes by an order of magnitude.
+
+  The ZSTD algorithm requires the external ZSTD package to be installed when linking
+  is done; if ROOT was built without it, ZLIB is used instead.  ZSTD decompresses
+  almost as fast as LZ4 with compression factors close to LZMA, and can use a
+  dictionary trained on typical data to compress small buffers much better.
 */
 #ifdef R__HAS_DEFAULT_LZ4
 ROOT::RCompressionSetting::EAlgorithm::EValues R__ZipMode = ROOT::RCompressionSetting::EAlgorithm::EValues::kLZ4;
@@ -72,9 +81,19 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      1 = zlib */
 /*                      2 = lzma */
 /*                      3 = old */
+/*                      4 = lz4 */
+/*                      5 = zstd */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
      /* int cxlevel;                      compression level */
 {
+   R__zipMultipleAlgorithmDict(cxlevel, srcsize, src, tgtsize, tgt, irep, compressionAlgorithm, 0);
+}
+
+/* dictid is the ID of a dictionary registered with R__zipRegisterDictionary, or 0 for none. */
+/* The dictionary is only used by the algorithms supporting it (zstd) and ignored otherwise. */
+void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm, unsigned dictid)
+     /* int cxlevel;                      compression level */
+{
 
   if (*srcsize < 1 + HDRSIZE + 1) {
      *irep = 0;
@@ -97,6 +116,11 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
+#ifdef R__HAS_ZSTD
+  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+     R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep, dictid);
+     return;
+#endif
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
      return;
@@ -266,10 +290,15 @@ static int is_valid_header_lz4(unsigned char *src)
    return src[0] == 'L' && src[1] == '4';
 }
 
+static int is_valid_header_zstd(unsigned char *src)
+{
+   return src[0] == 'Z' && src[1] == 'S' && src[2] == 1;
+}
+
 static int is_valid_header(unsigned char *src)
 {
    return is_valid_header_zlib(src) || is_valid_header_old(src) || is_valid_header_lzma(src) ||
-          is_valid_header_lz4(src);
+          is_valid_header_lz4(src) || is_valid_header_zstd(src);
 }
 
 int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
@@ -361,6 +390,13 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
   } else if (is_valid_header_lz4(src)) {
      R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
      return;
+  } else if (is_valid_header_zstd(src)) {
+#ifdef R__HAS_ZSTD
+     R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+#else
+     fprintf(stderr, "R__unzip: buffer is compressed with ZSTD but ROOT was built without ZSTD support\n");
+#endif
+     return;
   }
 
   /* Old zlib format */
@@ -413,3 +449,42 @@ void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
      *irep = stream.total_out;
      return;
 }
+
+/**
+ * Below are the routines handling compression dictionaries.
+ */
+
+unsigned R__zipRegisterDictionary(const char *dict, int dictsize)
+{
+#ifdef R__HAS_ZSTD
+   return R__registerDictZSTD(dict, dictsize);
+#else
+   (void)dict;
+   (void)dictsize;
+   return 0;
+#endif
+}
+
+void R__zipUnregisterDictionary(unsigned dictid)
+{
+#ifdef R__HAS_ZSTD
+   if (dictid)
+      R__unregisterDictZSTD(dictid);
+#else
+   (void)dictid;
+#endif
+}
+
+int R__zipTrainDictionary(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples)
+{
+#ifdef R__HAS_ZSTD
+   return R__trainDictZSTD(dict, dictcapacity, samples, samplesizes, nsamples);
+#else
+   (void)dict;
+   (void)dictcapacity;
+   (void)samples;
+   (void)samplesizes;
+   (void)nsamples;
+   return 0;
+#endif
+}
@@ -0,0 +1,25 @@
+// @(#)root/zstd:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <stddef.h>
+
+// NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
+// #ifdef's to avoid problems with C code.
+#ifdef __cplusplus
+extern "C" {
+#endif
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid);
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+unsigned R__registerDictZSTD(const char *dict, int dictsize);
+void R__unregisterDictZSTD(unsigned dictid);
+int R__trainDictZSTD(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples);
+#ifdef __cplusplus
+}
+#endif
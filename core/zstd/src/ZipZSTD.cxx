@@ -0,0 +1,270 @@
+// @(#)root/zstd:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ZipZSTD.h"
+
+#include "ROOT/RConfig.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <zdict.h>
+#include <zstd.h>
+
+// Header consists of:
+// - 2 byte identifier "ZS"
+// - 1 byte ZSTD frame format version (currently always 1).
+// - 3 bytes of compressed size
+// - 3 bytes of uncompressed size
+// The ZSTD frame that follows carries its own content checksum and, if a dictionary
+// was used, the ID of that dictionary.
+static const int kHeaderSize = 2 + 1 + 3 + 3;
+static const char kFormatVersion = 1;
+
+namespace {
+
+struct RZstdCCtxDeleter {
+   void operator()(ZSTD_CCtx *ctx) const { ZSTD_freeCCtx(ctx); }
+};
+struct RZstdDCtxDeleter {
+   void operator()(ZSTD_DCtx *ctx) const { ZSTD_freeDCtx(ctx); }
+};
+struct RZstdCDictDeleter {
+   void operator()(ZSTD_CDict *dict) const { ZSTD_freeCDict(dict); }
+};
+struct RZstdDDictDeleter {
+   void operator()(ZSTD_DDict *dict) const { ZSTD_freeDDict(dict); }
+};
+
+/// A registered dictionary: the raw content, its digested form for decompression and
+/// the digested forms for compression, one per compression level used so far.
+/// Digested dictionaries are read-only and can be shared amongst threads.
+struct RZstdDict {
+   std::vector<char> fContent;
+   std::unique_ptr<ZSTD_DDict, RZstdDDictDeleter> fDDict;
+   std::map<int, std::unique_ptr<ZSTD_CDict, RZstdCDictDeleter>> fCDicts;
+   int fRefCount = 0;
+};
+
+std::mutex &GetDictMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+std::map<unsigned, std::shared_ptr<RZstdDict>> &GetDictRegistry()
+{
+   static std::map<unsigned, std::shared_ptr<RZstdDict>> registry;
+   return registry;
+}
+
+std::shared_ptr<RZstdDict> FindDict(unsigned dictid)
+{
+   std::lock_guard<std::mutex> lock(GetDictMutex());
+   auto &registry = GetDictRegistry();
+   auto it = registry.find(dictid);
+   return it == registry.end() ? nullptr : it->second;
+}
+
+const ZSTD_CDict *GetCDict(unsigned dictid, int cxlevel)
+{
+   // The registry keeps the dictionary alive as long as the caller holds a
+   // registration, which it must do while compressing with it.
+   std::lock_guard<std::mutex> lock(GetDictMutex());
+   auto &registry = GetDictRegistry();
+   auto it = registry.find(dictid);
+   if (it == registry.end())
+      return nullptr;
+   auto &cdict = it->second->fCDicts[cxlevel];
+   if (!cdict) {
+      const auto &content = it->second->fContent;
+      cdict.reset(ZSTD_createCDict(content.data(), content.size(), cxlevel));
+   }
+   return cdict.get();
+}
+
+// Compression and decompression contexts are expensive to create; keep one per thread.
+ZSTD_CCtx *GetCCtx()
+{
+   thread_local std::unique_ptr<ZSTD_CCtx, RZstdCCtxDeleter> ctx(ZSTD_createCCtx());
+   return ctx.get();
+}
+
+ZSTD_DCtx *GetDCtx()
+{
+   thread_local std::unique_ptr<ZSTD_DCtx, RZstdDCtxDeleter> ctx(ZSTD_createDCtx());
+   return ctx.get();
+}
+
+} // anonymous namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictid)
+{
+   *irep = 0;
+
+   if (R__unlikely(*tgtsize <= kHeaderSize)) {
+      return;
+   }
+
+   // Refuse to compress more than 16MB at a time -- we are only allowed 3 bytes for size info.
+   if (R__unlikely(*srcsize > 0xffffff || *srcsize < 0)) {
+      return;
+   }
+
+   if (cxlevel > ZSTD_maxCLevel()) {
+      cxlevel = ZSTD_maxCLevel();
+   }
+
+   ZSTD_CCtx *ctx = GetCCtx();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+   ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
+   ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, cxlevel);
+   ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, 1);
+   if (dictid) {
+      const ZSTD_CDict *cdict = GetCDict(dictid, cxlevel);
+      if (R__unlikely(!cdict)) {
+         fprintf(stderr, "R__zipZSTD: dictionary %u is not registered.\n", dictid);
+         return;
+      }
+      ZSTD_CCtx_refCDict(ctx, cdict);
+   }
+
+   size_t returnStatus =
+      ZSTD_compress2(ctx, &tgt[kHeaderSize], *tgtsize - kHeaderSize, src, static_cast<size_t>(*srcsize));
+   // Not enough room in the target buffer is not an error: the caller will store the data uncompressed.
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      return;
+   }
+   if (R__unlikely(returnStatus > 0xffffff)) {
+      return;
+   }
+
+   tgt[0] = 'Z';
+   tgt[1] = 'S';
+   tgt[2] = kFormatVersion;
+
+   // NOTE: these next 6 bytes are required from the ROOT compressed buffer format;
+   // upper layers will assume they are laid out in a specific manner.
+   tgt[3] = (char)(returnStatus & 0xff);
+   tgt[4] = (char)((returnStatus >> 8) & 0xff);
+   tgt[5] = (char)((returnStatus >> 16) & 0xff);
+
+   tgt[6] = (char)(*srcsize & 0xff); /* decompressed size */
+   tgt[7] = (char)((*srcsize >> 8) & 0xff);
+   tgt[8] = (char)((*srcsize >> 16) & 0xff);
+
+   *irep = (int)returnStatus + kHeaderSize;
+}
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+   // NOTE: We don't check that srcsize / tgtsize is reasonable or within the ROOT-imposed limits.
+   // This is assumed to be handled by the upper layers.
+
+   *irep = 0;
+   if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
+      fprintf(stderr, "R__unzipZSTD: algorithm run against buffer with incorrect header (got %d%d; expected %d%d).\n",
+              src[0], src[1], 'Z', 'S');
+      return;
+   }
+   if (R__unlikely(src[2] != kFormatVersion)) {
+      fprintf(stderr, "R__unzipZSTD: unknown on-disk format version (got %d; expected %d).\n", src[2],
+              kFormatVersion);
+      return;
+   }
+
+   ZSTD_DCtx *ctx = GetDCtx();
+   if (R__unlikely(!ctx)) {
+      return;
+   }
+
+   const void *frame = &src[kHeaderSize];
+   size_t frameSize = *srcsize - kHeaderSize;
+   size_t returnStatus;
+   unsigned dictid = ZSTD_getDictID_fromFrame(frame, frameSize);
+   if (dictid) {
+      auto dict = FindDict(dictid);
+      if (R__unlikely(!dict)) {
+         fprintf(stderr, "R__unzipZSTD: buffer was compressed with dictionary %u which is not registered.\n", dictid);
+         return;
+      }
+      returnStatus = ZSTD_decompress_usingDDict(ctx, tgt, *tgtsize, frame, frameSize, dict->fDDict.get());
+   } else {
+      returnStatus = ZSTD_decompressDCtx(ctx, tgt, *tgtsize, frame, frameSize);
+   }
+   if (R__unlikely(ZSTD_isError(returnStatus))) {
+      fprintf(stderr, "R__unzipZSTD: error in decompression: %s\n", ZSTD_getErrorName(returnStatus));
+      return;
+   }
+
+   *irep = (int)returnStatus;
+}
+
+unsigned R__registerDictZSTD(const char *dict, int dictsize)
+{
+   if (!dict || dictsize <= 0) {
+      return 0;
+   }
+   // Only dictionaries in the ZSTD format carry an ID that is recorded in the frames, which is
+   // how the decompression finds them again; raw content dictionaries cannot be registered.
+   unsigned dictid = ZDICT_getDictID(dict, dictsize);
+   if (!dictid) {
+      fprintf(stderr, "R__registerDictZSTD: not a ZSTD dictionary.\n");
+      return 0;
+   }
+
+   std::lock_guard<std::mutex> lock(GetDictMutex());
+   auto &entry = GetDictRegistry()[dictid];
+   if (entry) {
+      // The frames only record the ID: a different dictionary with the same ID would be used in place of
+      // the registered one, and the data compressed with either could not be decompressed correctly.
+      const auto &content = entry->fContent;
+      if (content.size() != static_cast<size_t>(dictsize) || !std::equal(content.begin(), content.end(), dict)) {
+         fprintf(stderr, "R__registerDictZSTD: a different dictionary with ID %u is already registered.\n", dictid);
+         return 0;
+      }
+   } else {
+      entry = std::make_shared<RZstdDict>();
+      entry->fContent.assign(dict, dict + dictsize);
+      entry->fDDict.reset(ZSTD_createDDict(entry->fContent.data(), entry->fContent.size()));
+      if (!entry->fDDict) {
+         GetDictRegistry().erase(dictid);
+         return 0;
+      }
+   }
+   ++entry->fRefCount;
+   return dictid;
+}
+
+void R__unregisterDictZSTD(unsigned dictid)
+{
+   std::lock_guard<std::mutex> lock(GetDictMutex());
+   auto &registry = GetDictRegistry();
+   auto it = registry.find(dictid);
+   if (it != registry.end() && --it->second->fRefCount <= 0) {
+      registry.erase(it);
+   }
+}
+
+int R__trainDictZSTD(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes, unsigned nsamples)
+{
+   size_t returnStatus = ZDICT_trainFromBuffer(dict, dictcapacity, samples, samplesizes, nsamples);
+   if (ZDICT_isError(returnStatus)) {
+      fprintf(stderr, "R__trainDictZSTD: %s\n", ZDICT_getErrorName(returnStatus));
+      return 0;
+   }
+   return (int)returnStatus;
+}
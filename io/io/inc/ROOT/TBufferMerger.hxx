@@ -83,6 +83,21 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** Returns whether the trees are merged by moving their baskets (default = false). */
+   bool GetBasketMerge() const;
+
+   /** By default, each TBufferMergerFile written is serialized into a buffer,
+    *  which is read back and merged into the output file by TFileMerger.
+    *  With @param enable set, the trees of a TBufferMergerFile are instead merged
+    *  by the thread writing it, directly from the trees in memory: their already
+    *  compressed baskets are copied to the output file, rewriting only the keys
+    *  and the basket offsets (see TTree::Merge and the "LiveSources" option),
+    *  while other objects go through the merge queue as usual. The output trees
+    *  are kept in memory and written when other objects are merged and at the end.
+    *  This must be set before any TBufferMergerFile is written.
+    */
+   void SetBasketMerge(bool enable = true);
+
    friend class TBufferMergerFile;
 
 private:
@@ -99,9 +114,13 @@ private:
 
    void Merge();
    void Push(TBufferFile *buffer);
+   bool MergeTrees(TDirectory *source);
+   bool MergeTrees(TDirectory *source, TDirectory *target);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
    size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   bool fBasketMerge{false};                                     //< Merge the trees by moving their baskets
+   bool fTreesMerged{false};                                     //< True if trees were merged by moving their baskets
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
    std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
@@ -96,6 +96,7 @@ public:
 
    virtual Int_t      ReadBuf(void *buf, Int_t max);
    virtual void       WriteBuf(const void *buf, Int_t max);
+   virtual Bool_t     ByteSwapBuffer(Long64_t n, EDataType type);
 
    virtual char      *ReadString(char *s, Int_t max);
    virtual void       WriteString(const char *s);
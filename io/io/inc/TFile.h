@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <memory>
 
 #include "Compression.h"
 #include "TDirectoryFile.h"
@@ -45,9 +46,16 @@ class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
 
+namespace ROOT {
+namespace Internal {
+class TAsyncReadBatch;
+}
+}
+
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileCacheRead;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
@@ -94,6 +102,8 @@ protected:
    TMap            *fCacheReadMap;   ///<!Pointer to the read cache (if any)
    TFileCacheWrite *fCacheWrite;     ///<!Pointer to the write cache (if any)
    Long64_t         fArchiveOffset;  ///<!Offset at which file starts in archive
+   char            *fMMapBuffer{nullptr}; ///<!Read-only memory mapping of the whole file (option MMAP)
+   Long64_t         fMMapSize{0};    ///<!Size of the memory mapping
    Bool_t           fIsArchive : 1;  ///<!True if this is a pure archive file
    Bool_t           fNoAnchorInName : 1; ///<!True if we don't want to force the anchor to be appended to the file name
    Bool_t           fIsRootFile : 1; ///<!True is this is a ROOT file, raw file otherwise
@@ -126,11 +136,16 @@ protected:
    static std::atomic<Long64_t>  fgFileCounter;           ///<Counter for all opened files
    static std::atomic<Int_t>     fgReadCalls;             ///<Number of bytes read from all TFile objects
    static Int_t     fgReadaheadSize;         ///<Readahead buffer size
+   static Int_t     fgAsyncReadThreads;      ///<Number of threads reading local files asynchronously (-1: from TFile.AsyncReadThreads)
    static Bool_t    fgReadInfo;              ///<if true (default) ReadStreamerInfo is called when opening a file
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void  Init(Bool_t create);
    Bool_t                    FlushWriteCache();
    Int_t                     ReadBufferViaCache(char *buf, Int_t len);
+   Bool_t                    ReadMappedBuffer(char *buf, Int_t len, Double_t start);
+   std::shared_ptr<ROOT::Internal::TAsyncReadBatch> ReadBuffersAsync(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+   Bool_t                    MapFile();
+   void                      UnmapFile();
    Int_t                     WriteBufferViaCache(const char *buf, Int_t len);
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -233,6 +248,7 @@ public:
    virtual Int_t       GetNbytesFree() const {return fNbytesFree;}
    virtual TString     GetNewUrl() { return ""; }
    Long64_t            GetRelOffset() const { return fOffset - fArchiveOffset; }
+   const   char       *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual Long64_t    GetSeekFree() const {return fSeekFree;}
    virtual Long64_t    GetSeekInfo() const {return fSeekInfo;}
    virtual Long64_t    GetSize() const;
@@ -241,6 +257,7 @@ public:
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
+           Bool_t      IsMapped() const { return fMMapBuffer != nullptr; }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
    virtual void        ls(Option_t *option="") const;
@@ -302,11 +319,13 @@ public:
    static Long64_t     GetFileBytesWritten();
    static Int_t        GetFileReadCalls();
    static Int_t        GetReadaheadSize();
+   static Int_t        GetAsyncReadThreads();
 
    static void         SetFileBytesRead(Long64_t bytes = 0);
    static void         SetFileBytesWritten(Long64_t bytes = 0);
    static void         SetFileReadCalls(Int_t readcalls = 0);
    static void         SetReadaheadSize(Int_t bufsize = 256000);
+   static void         SetAsyncReadThreads(Int_t nthreads = 8);
    static void         SetReadStreamerInfo(Bool_t readinfo=kTRUE);
    static Bool_t       GetReadStreamerInfo();
 
@@ -16,6 +16,8 @@
 
 #include "TFile.h"
 
+#include <memory>
+
 class TBranch;
 class TFilePrefetch;
 
@@ -53,6 +55,7 @@ protected:
    Bool_t         fIsSorted;         ///< True if fSeek array is sorted
    Bool_t         fIsTransferred;    ///< True when fBuffer contains something valid
    Long64_t       fPrefetchedBlocks; ///< Number of blocks prefetched.
+   std::shared_ptr<ROOT::Internal::TAsyncReadBatch> fAsyncBatch; ///<! Blocks of fBuffer still being read by TFile::ReadBuffersAsync
 
    //variables for the second block prefetched with the same semantics as for the first one
    Int_t          fBNseek;
@@ -71,6 +74,7 @@ protected:
    Bool_t         fBIsTransferred;
 
    void SetEnablePrefetchingImpl(Bool_t setPrefetching = kFALSE); // Can not be virtual as it is called from the constructor.
+   void WaitAsyncReads();
 
 private:
    TFileCacheRead(const TFileCacheRead &);            //cannot be copied
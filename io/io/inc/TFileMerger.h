@@ -17,11 +17,13 @@
 #include "TString.h"
 #include "TStopwatch.h"
 
+#include <functional>
 #include <memory>
 
 class TList;
 class TFile;
 class TDirectory;
+class TKey;
 
 namespace ROOT {
 class TIOFeatures;
@@ -54,10 +56,13 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitiation on the max number of files opened.
+   Bool_t         fIMTEnabled{kFALSE};        ///<! True if the objects to merge are read concurrently with implicit multi-threading (default kFALSE)
 
    Bool_t         OpenExcessFiles();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
+   void           ForEachSourceObject(TList *sourcelist, TFile *first, const char *path, TKey *key,
+                                      const std::function<void(TFile *, TObject *)> &merge);
 
 public:
    /// Type of the partial merge
@@ -115,6 +120,8 @@ public:
    virtual Bool_t PartialMerge(Int_t type = kAll | kIncremental);
    virtual void   SetFastMethod(Bool_t fast=kTRUE)  {fFastMethod = fast;}
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
+   Bool_t         GetImplicitMT() const { return fIMTEnabled; }
+   void           SetImplicitMT(Bool_t enabled = kTRUE) { fIMTEnabled = enabled; }
    virtual void        RecursiveRemove(TObject *obj);
 
    ClassDef(TFileMerger, 6)  // File copying and merging services
@@ -0,0 +1,187 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TAsyncReadEngine.h"
+
+#include "TError.h"
+
+#include <algorithm>
+#include <cerrno>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+constexpr Int_t TAsyncReadEngine::kMaxRequestSize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark the read index as done and wake up the threads waiting for it.
+
+void TAsyncReadBatch::Complete(size_t index, Bool_t ok)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fRequests[index].fDone = kTRUE;
+   if (!ok)
+      fFailed = kTRUE;
+   --fNPending;
+   fCompleted.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until the bytes [offset, offset+len) of the buffer are read.
+/// Returns kFALSE if any read of the batch failed.
+
+Bool_t TAsyncReadBatch::Wait(Long64_t offset, Int_t len)
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   // First read ending after offset.
+   auto first = std::upper_bound(fRequests.begin(), fRequests.end(), offset,
+                                 [](Long64_t o, const TRequest &r) { return o < r.fBufOffset + r.fLen; });
+   for (auto req = first; req != fRequests.end() && req->fBufOffset < offset + len; ++req) {
+      fCompleted.wait(lock, [&req] { return req->fDone; });
+   }
+   return !fFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until all the reads are done. Returns kFALSE if any of them failed.
+
+Bool_t TAsyncReadBatch::WaitAll()
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   fCompleted.wait(lock, [this] { return fNPending == 0; });
+   return !fFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Let the threads issue the reads still queued, then join them.
+
+TAsyncReadEngine::~TAsyncReadEngine()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStopped = kTRUE;
+   }
+   fPending.notify_all();
+   for (auto &thread : fThreads)
+      thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the engine, with at least nthreads threads, or nullptr if nthreads is not
+/// positive or positional reads are not supported on this platform.
+///
+/// The engine is destroyed at the end of the process, once the reads already
+/// queued are done; reads submitted after that are refused.
+
+TAsyncReadEngine *TAsyncReadEngine::GetInstance(Int_t nthreads)
+{
+#ifndef WIN32
+   if (nthreads <= 0)
+      return nullptr;
+   static TAsyncReadEngine engine;
+   engine.AddThreads(nthreads);
+   return &engine;
+#else
+   (void)nthreads;
+   return nullptr;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Grow the pool up to nthreads threads.
+
+void TAsyncReadEngine::AddThreads(Int_t nthreads)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   while (!fStopped && (Int_t)fThreads.size() < nthreads)
+      fThreads.emplace_back(&TAsyncReadEngine::Run, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Body of the threads of the pool: issue the queued reads, in order, until
+/// the engine is destroyed.
+
+void TAsyncReadEngine::Run()
+{
+   while (true) {
+      std::shared_ptr<TAsyncReadBatch> batch;
+      size_t index;
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fPending.wait(lock, [this] { return fStopped || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         batch = std::move(fQueue.front().first);
+         index = fQueue.front().second;
+         fQueue.pop_front();
+      }
+
+      const auto &req = batch->fRequests[index];
+      Bool_t ok = kTRUE;
+#ifndef WIN32
+      char *dest = batch->fBuffer + req.fBufOffset;
+      Long64_t pos = req.fPos;
+      Int_t left = req.fLen;
+      while (left > 0) {
+         ssize_t siz = pread(batch->fFd, dest, left, pos);
+         if (siz < 0 && errno == EINTR)
+            continue;
+         if (siz <= 0) {
+            ::SysError("TAsyncReadEngine::Run", "error reading %d bytes at position %lld, got %ld", req.fLen,
+                       req.fPos, (Long_t)(req.fLen - left));
+            ok = kFALSE;
+            break;
+         }
+         dest += siz;
+         pos += siz;
+         left -= siz;
+      }
+#endif
+      batch->Complete(index, ok);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Queue the reads of the nbuf blocks described in arrays pos and len, at
+/// offset in the file, storing them contiguously in buffer.
+///
+/// Blocks larger than kMaxRequestSize are split, so that they are read by
+/// several threads. Returns nullptr if the engine is being destroyed.
+
+std::shared_ptr<TAsyncReadBatch>
+TAsyncReadEngine::Submit(Int_t fd, char *buffer, const Long64_t *pos, const Int_t *len, Int_t nbuf, Long64_t offset)
+{
+   auto batch = std::make_shared<TAsyncReadBatch>(fd, buffer);
+   Long64_t bufOffset = 0;
+   for (Int_t i = 0; i < nbuf; ++i) {
+      for (Int_t done = 0; done < len[i]; done += kMaxRequestSize) {
+         const Int_t size = std::min(kMaxRequestSize, len[i] - done);
+         batch->fRequests.push_back({offset + pos[i] + done, bufOffset + done, size, kFALSE});
+      }
+      bufOffset += len[i];
+   }
+   batch->fNPending = batch->fRequests.size();
+
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fStopped)
+         return nullptr;
+      for (size_t i = 0; i < batch->fRequests.size(); ++i)
+         fQueue.emplace_back(batch, i);
+   }
+   fPending.notify_all();
+   return batch;
+}
+
+} // Internal
+} // ROOT
@@ -0,0 +1,86 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TAsyncReadEngine
+#define ROOT_TAsyncReadEngine
+
+#include "Rtypes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// A set of positional reads from a local file into a contiguous buffer, submitted together
+/// to the TAsyncReadEngine. The reads complete in any order; Wait() blocks until the bytes
+/// of interest are in the buffer, so that they can be used while the other reads go on.
+class TAsyncReadBatch {
+   friend class TAsyncReadEngine;
+
+   struct TRequest {
+      Long64_t fPos;       // Position in the file.
+      Long64_t fBufOffset; // Position in the buffer.
+      Int_t fLen;          // Number of bytes to read.
+      Bool_t fDone;        // Whether the bytes are in the buffer.
+   };
+
+   Int_t fFd;                       // File descriptor to read from.
+   char *fBuffer;                   // Destination of the reads; must stay valid until WaitAll() returned.
+   std::vector<TRequest> fRequests; // Reads, in increasing order of fBufOffset.
+   size_t fNPending{0};             // Number of reads not completed yet.
+   Bool_t fFailed{kFALSE};          // Whether any of the reads failed.
+   std::mutex fMutex;
+   std::condition_variable fCompleted;
+
+   void Complete(size_t index, Bool_t ok);
+
+public:
+   TAsyncReadBatch(Int_t fd, char *buffer) : fFd(fd), fBuffer(buffer) {}
+
+   Bool_t Wait(Long64_t offset, Int_t len);
+   Bool_t WaitAll();
+};
+
+/// A pool of threads issuing positional reads (pread) on local files, so that all the blocks
+/// of a cluster are requested at once and the device queue is kept full, instead of reading
+/// the blocks one after the other on the thread that needs them.
+class TAsyncReadEngine {
+   std::mutex fMutex;
+   std::condition_variable fPending;
+   std::deque<std::pair<std::shared_ptr<TAsyncReadBatch>, size_t>> fQueue; // Reads not started yet.
+   std::vector<std::thread> fThreads;
+   Bool_t fStopped{kFALSE}; // Set by the destructor: the threads exit once the queue is empty.
+
+   TAsyncReadEngine() = default;
+   void AddThreads(Int_t nthreads);
+   void Run();
+
+public:
+   /// Size of the individual reads a large block is split into, so that it is read in parallel.
+   static constexpr Int_t kMaxRequestSize = 1024 * 1024;
+
+   ~TAsyncReadEngine();
+
+   static TAsyncReadEngine *GetInstance(Int_t nthreads);
+
+   std::shared_ptr<TAsyncReadBatch>
+   Submit(Int_t fd, char *buffer, const Long64_t *pos, const Int_t *len, Int_t nbuf, Long64_t offset = 0);
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -3193,6 +3193,74 @@ void TBufferFile::WriteBuf(const void *buf, Int_t max)
    fBufCur += max;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert n values of width sizeof(T) starting at buf from the on-file
+/// (big endian) representation to the host one. The loop has no aliasing
+/// between iterations, which lets the compiler vectorize it.
+
+template <typename T>
+void ByteSwapInPlace(char *buf, Long64_t n)
+{
+#ifdef R__BYTESWAP
+   for (Long64_t i = 0; i < n; ++i) {
+      T value;
+      memcpy(&value, buf + i * sizeof(T), sizeof(T));
+      if (sizeof(T) == 2)
+         value = Rbswap_16(value);
+      else if (sizeof(T) == 4)
+         value = Rbswap_32(value);
+      else
+         value = Rbswap_64(value);
+      memcpy(buf + i * sizeof(T), &value, sizeof(T));
+   }
+#else
+   (void)buf;
+   (void)n;
+#endif
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Byte-swap in place, in a single pass, the n values of basic type `type`
+/// starting at the current position of the I/O buffer. Values are converted
+/// from the big endian representation used on file to the host one; the
+/// current position is left unchanged.
+///
+/// Returns kFALSE if the type is not supported or if the buffer does not hold
+/// n such values past the current position.
+
+Bool_t TBufferFile::ByteSwapBuffer(Long64_t n, EDataType type)
+{
+   Int_t size = 0;
+   switch (type) {
+      case kBool_t:
+      case kChar_t:
+      case kUChar_t: size = 1; break;
+      case kShort_t:
+      case kUShort_t: size = 2; break;
+      case kInt_t:
+      case kUInt_t:
+      case kFloat_t: size = 4; break;
+      case kLong64_t:
+      case kULong64_t:
+      case kDouble_t: size = 8; break;
+      default: return kFALSE;
+   }
+   if (n < 0 || n * size > (Long64_t)(fBufMax - fBufCur))
+      return kFALSE;
+
+   switch (size) {
+      case 2: ByteSwapInPlace<UShort_t>(fBufCur, n); break;
+      case 4: ByteSwapInPlace<UInt_t>(fBufCur, n); break;
+      case 8: ByteSwapInPlace<ULong64_t>(fBufCur, n); break;
+      default: break; // single bytes need no swapping
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read string from I/O buffer. String is read till 0 character is
 /// found or till max-1 characters are read (i.e. string s has max
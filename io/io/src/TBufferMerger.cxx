@@ -12,7 +12,12 @@
 #include "ROOT/TBufferMerger.hxx"
 
 #include "TBufferFile.h"
+#include "TClass.h"
+#include "TClassRef.h"
 #include "TError.h"
+#include "TFileMergeInfo.h"
+#include "TKey.h"
+#include "TList.h"
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
@@ -21,6 +26,8 @@
 namespace ROOT {
 namespace Experimental {
 
+static TClassRef R__TTree_Class("TTree");
+
 TBufferMerger::TBufferMerger(const char *name, Option_t *option, Int_t compress)
 {
    // We cannot chain constructors or use in-place initialization here because
@@ -49,6 +56,13 @@ TBufferMerger::~TBufferMerger()
 
    if (!fQueue.empty())
       Merge();
+
+   // The trees merged by moving their baskets are only written along with the merges
+   // of the queue, make sure their last state ends up in the output file.
+   if (fTreesMerged && fMerger.GetOutputFile()) {
+      std::lock_guard<std::mutex> lock(fMergeMutex);
+      fMerger.GetOutputFile()->Write("", TObject::kOverwrite);
+   }
 }
 
 std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
@@ -87,6 +101,73 @@ void TBufferMerger::SetAutoSave(size_t size)
    fAutoSave = size;
 }
 
+bool TBufferMerger::GetBasketMerge() const
+{
+   return fBasketMerge;
+}
+
+void TBufferMerger::SetBasketMerge(bool enable)
+{
+   fBasketMerge = enable;
+   // The trees are handled by MergeTrees, the merge of the queue must leave them alone.
+   fMerger.SetNotrees(enable);
+}
+
+/// Merge the trees of the source directory (and of its subdirectories) into the output
+/// file, moving their baskets, and return whether the source holds other objects to merge.
+bool TBufferMerger::MergeTrees(TDirectory *source)
+{
+   std::lock_guard<std::mutex> lock(fMergeMutex);
+   if (!fMerger.GetOutputFile())
+      return true;
+   TDirectory::TContext ctxt;
+   fTreesMerged = true;
+   return MergeTrees(source, fMerger.GetOutputFile());
+}
+
+bool TBufferMerger::MergeTrees(TDirectory *source, TDirectory *target)
+{
+   bool others = false;
+   TIter nextkey(source->GetListOfKeys());
+   while (auto key = static_cast<TKey *>(nextkey())) {
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl || !(cl->InheritsFrom(R__TTree_Class) || cl->InheritsFrom(TDirectory::Class())))
+         others = true;
+   }
+
+   TIter next(source->GetList());
+   while (TObject *obj = next()) {
+      if (auto dir = dynamic_cast<TDirectory *>(obj)) {
+         TDirectory *subdir = target->GetDirectory(dir->GetName());
+         if (!subdir)
+            subdir = target->mkdir(dir->GetName(), dir->GetTitle());
+         others |= MergeTrees(dir, subdir);
+         continue;
+      }
+      if (!obj->InheritsFrom(R__TTree_Class))
+         continue;
+
+      // The baskets of the tree were flushed when writing the file: they are copied as they
+      // are into the output tree, which is created by cloning the first tree merged.
+      ROOT::MergeFunc_t merge = obj->IsA()->GetMerge();
+      if (!merge) {
+         Error("TBufferMerger", "cannot merge the baskets of %s", obj->GetName());
+         continue;
+      }
+      TFileMergeInfo info(target);
+      info.fOptions = "fast LiveSources";
+      if (TObject *output = target->GetList()->FindObject(obj->GetName())) {
+         TList inputs;
+         inputs.Add(obj);
+         info.fIsFirst = kFALSE;
+         merge(output, &inputs, &info);
+      } else {
+         merge(obj, nullptr, &info);
+      }
+   }
+   return others;
+}
+
 void TBufferMerger::Merge()
 {
    if (fMergeMutex.try_lock()) {
@@ -32,10 +32,13 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
    Int_t nbytes = TMemFile::Write(name, opt, bufsize);
 
    if (nbytes) {
-      TBufferFile *buffer = new TBufferFile(TBuffer::kWrite);
-      CopyTo(*buffer);
-      buffer->SetReadMode();
-      fMerger.Push(buffer);
+      // Move the baskets of the trees right away, only the other objects need to be serialized.
+      if (!fMerger.fBasketMerge || fMerger.MergeTrees(this)) {
+         TBufferFile *buffer = new TBufferFile(TBuffer::kWrite);
+         CopyTo(*buffer);
+         buffer->SetReadMode();
+         fMerger.Push(buffer);
+      }
       ResetAfterMerge(0);
    }
    return nbytes;
@@ -84,6 +84,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -134,6 +135,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TGlobal.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "TAsyncReadEngine.h"
 
 using std::sqrt;
 
@@ -142,6 +144,7 @@ std::atomic<Long64_t> TFile::fgBytesWrite{0};
 std::atomic<Long64_t> TFile::fgFileCounter{0};
 std::atomic<Int_t>    TFile::fgReadCalls{0};
 Int_t    TFile::fgReadaheadSize = 256000;
+Int_t    TFile::fgAsyncReadThreads = -1;
 Bool_t   TFile::fgReadInfo = kTRUE;
 TList   *TFile::fgAsyncOpenRequests = 0;
 TString  TFile::fgCacheFileDir;
@@ -240,10 +243,16 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// RECREATE      | Create a new file, if the file already exists it will be overwritten.
 /// UPDATE        | Open an existing file for writing. If no file exists, it is created.
 /// READ          | Open an existing file for reading (default).
+/// MMAP          | Open an existing local file for reading through a read-only memory mapping.
 /// NET           | Used by derived remote file access classes, not a user callable option.
 /// WEB           | Used by derived remote http access class, not a user callable option.
 ///
 /// If option = "" (default), READ is assumed.
+/// With MMAP the baskets are uncompressed straight from the mapped file,
+/// without being copied first, and the blocks prefetched by the TTreeCache
+/// are advised to the kernel (madvise) instead of being read in the cache
+/// buffer. If the file cannot be mapped, it is read as with READ. Setting
+/// TFile.MMap to yes in the .rootrc maps all the files opened with READ.
 /// The file can be specified as a URL of the form:
 ///
 ///     file:///user/rdm/bla.root or file:/user/rdm/bla.root
@@ -289,7 +298,7 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// 1   | minimal compression level but fast.
 /// ... | ....
 /// 9   | maximal compression level but slower and might use more memory.
-/// (For the currently supported algorithms, the maximum level is 9)
+/// (For the currently supported algorithms, the maximum level is 9, except for ZSTD which goes up to 22)
 /// If compress is negative it indicates the compression level is not set yet.
 /// The enumeration ROOT::RCompressionSetting::EAlgorithm associates each
 /// algorithm with a number. There is a utility function to help
@@ -415,6 +424,12 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    if (fOption == "NEW")
       fOption = "CREATE";
 
+   Bool_t mmap = kFALSE;
+   if (fOption == "MMAP") {
+      mmap    = kTRUE;
+      fOption = "READ";
+   }
+
    Bool_t create   = (fOption == "CREATE") ? kTRUE : kFALSE;
    Bool_t recreate = (fOption == "RECREATE") ? kTRUE : kFALSE;
    Bool_t update   = (fOption == "UPDATE") ? kTRUE : kFALSE;
@@ -423,6 +438,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
       read    = kTRUE;
       fOption = "READ";
    }
+   if (read && !mmap && gEnv->GetValue("TFile.MMap", 0))
+      mmap = kTRUE;
 
    Bool_t devnull = kFALSE;
 
@@ -514,6 +531,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      if (mmap)
+         MapFile();
    }
 
    Init(create);
@@ -921,6 +940,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -976,6 +996,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      UnmapFile();
       SysClose(fD);
       fD = -1;
    }
@@ -1630,6 +1651,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMMapBuffer)
+         return ReadMappedBuffer(buf, len, start);
+
       Seek(pos);
       ssize_t siz;
 
@@ -1680,6 +1704,9 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 
       if (gPerfStats != 0) start = TTimeStamp();
 
+      if (fMMapBuffer)
+         return ReadMappedBuffer(buf, len, start);
+
       while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
          ResetErrno();
 
@@ -1727,6 +1754,25 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   // Local files can be read by the asynchronous read engine, all the blocks in parallel.
+   if (auto batch = ReadBuffersAsync(buf, pos, len, nbuf))
+      return !batch->WaitAll();
+
+   // A memory mapped file needs no read-ahead buffer, the blocks are copied
+   // straight from the mapping.
+   if (fMMapBuffer) {
+      Double_t start = 0;
+      if (gPerfStats != 0) start = TTimeStamp();
+      Int_t k = 0;
+      for (Int_t i = 0; i < nbuf; i++) {
+         SetOffset(pos[i]);
+         if (ReadMappedBuffer(&buf[k], len[i], start))
+            return kTRUE;
+         k += len[i];
+      }
+      return kFALSE;
+   }
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1777,6 +1823,46 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Start reading the nbuf blocks described in arrays pos and len, stored
+/// contiguously in buf as by ReadBuffers(), with the asynchronous read engine.
+///
+/// buf must not be used nor released before the returned batch is waited for
+/// (TAsyncReadBatch::Wait() for some of the bytes, WaitAll()). Returns nullptr
+/// if the engine is not used for this file: it only reads local files opened
+/// for reading (not memory mapped), when enabled with SetAsyncReadThreads().
+
+std::shared_ptr<ROOT::Internal::TAsyncReadBatch> TFile::ReadBuffersAsync(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   if (!buf || nbuf <= 0 || IsA() != TFile::Class() || !IsOpen() || fWritable || fMMapBuffer)
+      return nullptr;
+   auto engine = ROOT::Internal::TAsyncReadEngine::GetInstance(GetAsyncReadThreads());
+   if (!engine)
+      return nullptr;
+
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+
+   auto batch = engine->Submit(fD, buf, pos, len, nbuf, fArchiveOffset);
+   if (!batch)
+      return nullptr;
+
+   Long64_t total = 0;
+   for (Int_t i = 0; i < nbuf; i++)
+      total += len[i];
+   fBytesRead  += total;
+   fgBytesRead += total;
+   fReadCalls  += nbuf;
+   fgReadCalls += nbuf;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, (Int_t)total, start);
+   }
+   return batch;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -1812,6 +1898,100 @@ Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read len bytes at the current offset of a memory mapped file.
+///
+/// Returns kTRUE in case of failure, i.e. if the bytes are beyond the end of
+/// the mapping.
+
+Bool_t TFile::ReadMappedBuffer(char *buf, Int_t len, Double_t start)
+{
+   if (fOffset < 0 || len < 0 || fOffset + len > fMMapSize) {
+      Error("ReadBuffer", "error reading all requested bytes from file %s, got %lld of %d",
+            GetName(), fOffset < 0 ? 0 : TMath::Max(fMMapSize - fOffset, (Long64_t)0), len);
+      return kTRUE;
+   }
+   memcpy(buf, fMMapBuffer + fOffset, len);
+   fOffset     += len;
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the len bytes at offset pos of a file opened with
+/// option MMAP, or nullptr if the file is not mapped or the bytes are outside
+/// of the mapping.
+///
+/// This allows to use the content of the file in place, without copying it.
+/// The bytes are accounted as read from the file; they must not be modified
+/// and are only valid until the file is closed.
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   Long64_t offset = pos + fArchiveOffset;
+   if (!fMMapBuffer || offset < 0 || len < 0 || offset + len > fMMapSize)
+      return nullptr;
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+   return fMMapBuffer + offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the whole file read-only in memory, see option MMAP of the constructor.
+///
+/// Returns kTRUE in case of success. Otherwise a warning is printed and the
+/// file is read with the regular system calls.
+
+Bool_t TFile::MapFile()
+{
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size = 0;
+   if (SysStat(fD, &id, &size, &flags, &modtime) || size <= 0) {
+      Warning("MapFile", "cannot determine the size of file %s, reading it without memory mapping", GetName());
+      return kFALSE;
+   }
+   void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fD, 0);
+   if (addr == MAP_FAILED) {
+      Warning("MapFile", "cannot map file %s in memory (%s), reading it without memory mapping", GetName(),
+              gSystem->GetError());
+      return kFALSE;
+   }
+   fMMapBuffer = static_cast<char *>(addr);
+   fMMapSize   = size;
+   return kTRUE;
+#else
+   Warning("MapFile", "memory mapped files are not supported on this platform, reading %s without memory mapping",
+           GetName());
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file, if any.
+
+void TFile::UnmapFile()
+{
+   if (!fMMapBuffer)
+      return;
+#ifndef WIN32
+   munmap(fMMapBuffer, fMMapSize);
+#endif
+   fMMapBuffer = nullptr;
+   fMMapSize   = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read the FREE linked list.
 ///
@@ -2116,6 +2296,7 @@ Int_t TFile::ReOpen(Option_t *mode)
 
       // close readonly file
       if (IsOpen()) {
+         UnmapFile();
          SysClose(fD);
          fD = -1;
       }
@@ -2169,6 +2350,17 @@ void TFile::SetOffset(Long64_t offset, ERelativeTo pos)
 
 void TFile::Seek(Long64_t offset, ERelativeTo pos)
 {
+   // The file descriptor is not used to read a memory mapped file.
+   if (fMMapBuffer) {
+      // The mapping covers the whole file: an archive member ends fEND bytes after its
+      // fArchiveOffset, as kBeg positions are counted from fArchiveOffset.
+      if (pos == kEnd)
+         fOffset = (fArchiveOffset ? fArchiveOffset + fEND : fMMapSize) + offset;
+      else
+         SetOffset(offset, pos);
+      return;
+   }
+
    int whence = 0;
    switch (pos) {
       case kBeg:
@@ -4468,6 +4660,30 @@ Int_t TFile::GetReadaheadSize()
 //______________________________________________________________________________
 void TFile::SetReadaheadSize(Int_t bytes) { fgReadaheadSize = bytes; }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the number of threads of the asynchronous read
+/// engine used for local files, see SetAsyncReadThreads().
+
+Int_t TFile::GetAsyncReadThreads()
+{
+   if (fgAsyncReadThreads < 0)
+      fgAsyncReadThreads = gEnv->GetValue("TFile.AsyncReadThreads", 0);
+   return fgAsyncReadThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function setting the number of threads reading local files
+/// asynchronously, 0 disabling the asynchronous reads.
+///
+/// With nthreads > 0, ReadBuffers() and the read caches (TFileCacheRead,
+/// TTreeCache) submit all the blocks at once to a pool of nthreads threads
+/// doing positional reads, instead of reading them one after the other. The
+/// read caches use the blocks as soon as they are in memory, while the next
+/// ones are still being read. The default is taken from TFile.AsyncReadThreads
+/// in .rootrc. The pool never shrinks.
+
+void TFile::SetAsyncReadThreads(Int_t nthreads) { fgAsyncReadThreads = nthreads < 0 ? 0 : nthreads; }
+
 //______________________________________________________________________________
 void TFile::SetFileBytesRead(Long64_t bytes) { fgBytesRead = bytes; }
 
@@ -4725,10 +4941,11 @@ TFile::EFileType TFile::GetType(const char *name, Option_t *option, TString *pre
             } else {
                lfname.Form("%s/%s", gSystem->HomeDirectory(), fname);
             }
-            // If option "READ" test existence and access
+            // If option "READ" (or "MMAP") test existence and access
             TString opt = option;
             Bool_t read = (opt.IsNull() ||
-                          !opt.CompareTo("READ", TString::kIgnoreCase)) ? kTRUE : kFALSE;
+                          !opt.CompareTo("READ", TString::kIgnoreCase) ||
+                          !opt.CompareTo("MMAP", TString::kIgnoreCase)) ? kTRUE : kFALSE;
             if (read) {
                char *fn;
                if ((fn = gSystem->ExpandPathName(TUrl(lfname).GetFile()))) {
@@ -5035,6 +5252,28 @@ Bool_t TFile::Cp(const char *src, const char *dst, Bool_t progressbar,
    return success;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Advise the kernel that the bytes [begin, begin+len) of a memory mapped file
+/// will be needed soon, so that it can start loading them in the page cache.
+/// A null len only probes the support. Returns kTRUE in case of failure.
+
+static Bool_t R__AdviseMappedBuffer(char *map, Long64_t mapSize, Long64_t begin, Int_t len)
+{
+   if (len == 0)
+      return kFALSE;
+   if (begin < 0 || len < 0 || begin + len > mapSize)
+      return kTRUE;
+#ifndef WIN32
+   static const Long64_t pageSize = sysconf(_SC_PAGESIZE);
+   // madvise wants a page aligned address.
+   const Long64_t aligned = begin - begin % pageSize;
+   return madvise(map + aligned, begin + len - aligned, MADV_WILLNEED) != 0;
+#else
+   (void)map;
+   return kTRUE;
+#endif
+}
+
 //______________________________________________________________________________
 //The next statement is not active anymore on Linux.
 //Using posix_fadvise introduces a performance penalty (10 %) on optimized files
@@ -5046,6 +5285,10 @@ Bool_t TFile::ReadBufferAsync(Long64_t offset, Int_t len)
    // which blocks we are going to read so it can start loading these blocks
    // in the buffer cache.
 
+   // Memory mapped files are only advised, see R__AdviseMappedBuffer().
+   if (fMMapBuffer)
+      return R__AdviseMappedBuffer(fMMapBuffer, fMMapSize, offset + fArchiveOffset, len);
+
    // Shortcut to avoid having to implement dummy ReadBufferAsync() in all
    // I/O plugins. Override ReadBufferAsync() in plugins if async is supported.
    if (IsA() != TFile::Class())
@@ -5071,8 +5314,13 @@ Bool_t TFile::ReadBufferAsync(Long64_t offset, Int_t len)
    return (result != 0);
 }
 #else
-Bool_t TFile::ReadBufferAsync(Long64_t, Int_t)
+Bool_t TFile::ReadBufferAsync(Long64_t offset, Int_t len)
 {
+   // Memory mapped files are supported: the pages are advised to the kernel,
+   // the reads themselves are served from the mapping.
+   if (fMMapBuffer)
+      return R__AdviseMappedBuffer(fMMapBuffer, fMMapSize, offset + fArchiveOffset, len);
+
    // Not supported yet on non Linux systems.
 
    return kTRUE;
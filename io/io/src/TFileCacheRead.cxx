@@ -31,6 +31,7 @@
 #include "TFileCacheWrite.h"
 #include "TFilePrefetch.h"
 #include "TMathBase.h"
+#include "TAsyncReadEngine.h"
 
 ClassImp(TFileCacheRead);
 
@@ -158,6 +159,7 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
 
 TFileCacheRead::~TFileCacheRead()
 {
+   WaitAsyncReads();
    SafeDelete(fPrefetch);
    delete [] fSeek;
    delete [] fSeekIndex;
@@ -187,6 +189,7 @@ TFileCacheRead::~TFileCacheRead()
 
 void TFileCacheRead::Close(Option_t * /* opt = "" */)
 {
+   WaitAsyncReads();
    if (fPrefetch) {
       delete fPrefetch;
       fPrefetch = 0;
@@ -458,8 +461,11 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
       // If ReadBufferAsync is not supported by this implementation...
       if (!fAsyncReading) {
-         // Then we use the vectored read to read everything now
-         if (fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
+         // Then we use the vectored read to read everything now, or start
+         // reading everything in the background if the file supports it;
+         // the blocks are then waited for one by one, when requested.
+         fAsyncBatch = fFile->ReadBuffersAsync(fBuffer,fPos,fLen,fNb);
+         if (!fAsyncBatch && fFile->ReadBuffers(fBuffer,fPos,fLen,fNb)) {
             return -1;
          }
          fIsTransferred = kTRUE;
@@ -528,6 +534,9 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
       if (loc >= 0 && loc <fNseek && pos == fSeekSort[loc]) {
          if (buf) {
+            if (fAsyncBatch && !fAsyncBatch->Wait(fSeekPos[loc], len)) {
+               return -1;
+            }
             memcpy(buf,&fBuffer[fSeekPos[loc]],len);
             fFile->SetOffset(pos+len);
          }
@@ -543,6 +552,7 @@ Int_t TFileCacheRead::ReadBufferExtNormal(char *buf, Long64_t pos, Int_t len, In
 
 void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
 {
+   WaitAsyncReads();
    fFile = file;
 
    if (fAsyncReading) {
@@ -571,6 +581,7 @@ void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
 void TFileCacheRead::Sort()
 {
    if (!fNseek) return;
+   WaitAsyncReads();
    TMath::Sort(fNseek,fSeek,fSeekIndex,kFALSE);
    Int_t i;
    Int_t nb = 0;
@@ -629,6 +640,7 @@ void TFileCacheRead::Sort()
 void TFileCacheRead::SecondSort()
 {
    if (!fBNseek) return;
+   WaitAsyncReads();
    TMath::Sort(fBNseek,fBSeek,fBSeekIndex,kFALSE);
    Int_t i;
    Int_t nb = 0;
@@ -678,6 +690,18 @@ void TFileCacheRead::SecondSort()
    fBIsSorted = kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the blocks of fBuffer still being read in the background, see
+/// TFile::ReadBuffersAsync(), before fBuffer is reused or released.
+
+void TFileCacheRead::WaitAsyncReads()
+{
+   if (fAsyncBatch) {
+      fAsyncBatch->WaitAll();
+      fAsyncBatch.reset();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TFilePrefetch* TFileCacheRead::GetPrefetchObj(){
@@ -716,6 +740,8 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
       return 0;
    }
 
+   WaitAsyncReads();
+
    Bool_t inval = kFALSE;
 
    // the cached data is too large to fit in the new buffer size mark data unavailable
@@ -802,7 +828,9 @@ void TFileCacheRead::SetEnablePrefetchingImpl(Bool_t setPrefetching)
       fAsyncReading = kFALSE;
    }
    else {
-      fAsyncReading = gEnv->GetValue("TFile.AsyncReading", 0);
+      // The blocks of memory mapped files are only advised to the kernel and
+      // read in place, they do not need the local buffer either.
+      fAsyncReading = gEnv->GetValue("TFile.AsyncReading", 0) || (fFile && fFile->IsMapped());
       if (fAsyncReading) {
          // Check if asynchronous reading is supported by this TFile specialization
          fAsyncReading = kFALSE;
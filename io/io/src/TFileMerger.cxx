@@ -40,6 +40,13 @@ to be merged, like the standalone hadd program.
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 #ifdef WIN32
 // For _getmaxstdio
 #include <stdio.h>
@@ -370,6 +377,75 @@ Bool_t TFileMerger::Merge(Bool_t)
    return PartialMerge(kAll | kRegular);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the object of the given key in the directory path of the source files,
+/// from first until the end of sourcelist, and pass each of them, in the order
+/// of sourcelist, to merge (together with its file). The current directory is
+/// the one of the object when merge is called. The sources without the object
+/// are skipped, as are those where it cannot be read (with a message).
+///
+/// If implicit multi-threading is enabled for this merger (see SetImplicitMT),
+/// the objects are read concurrently by batches, the next batch being read while
+/// the objects of the current one are merged. Only the reading is concurrent,
+/// the objects are merged one at a time on the calling thread.
+
+void TFileMerger::ForEachSourceObject(TList *sourcelist, TFile *first, const char *path, TKey *key,
+                                      const std::function<void(TFile *, TObject *)> &merge)
+{
+   auto readObject = [path, key](TFile *source) -> TObject * {
+      TDirectory *ndir = source->GetDirectory(path);
+      if (!ndir)
+         return nullptr;
+      TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
+      if (!key2)
+         return nullptr;
+      TDirectory::TContext ctxt(ndir);
+      TObject *hobj = key2->ReadObj();
+      if (!hobj) {
+         ::Info("TFileMerger::MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
+                key->GetName(), key->GetTitle(), source->GetName());
+      }
+      return hobj;
+   };
+   auto mergeObject = [path, &merge](TFile *source, TObject *hobj) {
+      // make sure we are at the correct directory level by cd'ing to path
+      source->GetDirectory(path)->cd();
+      merge(source, hobj);
+   };
+
+#ifdef R__USE_IMT
+   if (fIMTEnabled && ROOT::IsImplicitMTEnabled()) {
+      std::vector<TFile *> sources;
+      for (TFile *source = first; source; source = (TFile*)sourcelist->After(source))
+         sources.push_back(source);
+      std::vector<TObject *> objects(sources.size(), nullptr);
+      // Two batches in flight at most: the one being merged and the one being read.
+      const size_t batchSize = 2 * std::max(ROOT::GetImplicitMTPoolSize(), 1u);
+      ROOT::Experimental::TTaskGroup readers[2];
+      auto readBatch = [&](size_t begin) {
+         for (size_t i = begin; i < std::min(begin + batchSize, sources.size()); ++i)
+            readers[(begin / batchSize) % 2].Run([&, i]() { objects[i] = readObject(sources[i]); });
+      };
+      readBatch(0);
+      for (size_t begin = 0; begin < sources.size(); begin += batchSize) {
+         if (begin + batchSize < sources.size())
+            readBatch(begin + batchSize);
+         readers[(begin / batchSize) % 2].Wait();
+         for (size_t i = begin; i < std::min(begin + batchSize, sources.size()); ++i) {
+            if (objects[i])
+               mergeObject(sources[i], objects[i]);
+         }
+      }
+      return;
+   }
+#endif
+
+   for (TFile *source = first; source; source = (TFile*)sourcelist->After(source)) {
+      if (TObject *hobj = readObject(source))
+         mergeObject(source, hobj);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Merge all objects in a directory
 ///
@@ -555,40 +631,24 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                   func(obj, &inputs, &info);
                   info.fIsFirst = kFALSE;
                } else {
-                  do {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
-                     if (ndir) {
-                        ndir->cd();
-                        TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
-                        if (key2) {
-                           TObject *hobj = key2->ReadObj();
-                           if (!hobj) {
-                              Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
-                                   key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
-                              continue;
-                           }
-                           // Set ownership for collections
-                           if (hobj->InheritsFrom(TCollection::Class())) {
-                              ((TCollection*)hobj)->SetOwner();
-                           }
-                           hobj->ResetBit(kMustCleanup);
-                           inputs.Add(hobj);
-                           if (!oneGo) {
-                              ROOT::MergeFunc_t func = cl->GetMerge();
-                              Long64_t result = func(obj, &inputs, &info);
-                              info.fIsFirst = kFALSE;
-                              if (result < 0) {
-                                 Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
-                                       obj->GetName(), nextsource->GetName());
-                              }
-                              inputs.Delete();
-                           }
+                  ForEachSourceObject(sourcelist, nextsource, path, key, [&](TFile *source, TObject *hobj) {
+                     // Set ownership for collections
+                     if (hobj->InheritsFrom(TCollection::Class())) {
+                        ((TCollection*)hobj)->SetOwner();
+                     }
+                     hobj->ResetBit(kMustCleanup);
+                     inputs.Add(hobj);
+                     if (!oneGo) {
+                        ROOT::MergeFunc_t func = cl->GetMerge();
+                        Long64_t result = func(obj, &inputs, &info);
+                        info.fIsFirst = kFALSE;
+                        if (result < 0) {
+                           Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                                 obj->GetName(), source->GetName());
                         }
+                        inputs.Delete();
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
-                  } while (nextsource);
+                  });
                   // Merge the list, if still to be done
                   if (oneGo || info.fIsFirst) {
                      ROOT::MergeFunc_t func = cl->GetMerge();
@@ -620,38 +680,22 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            obj->GetName(), key->GetName());
                   }
                } else {
-                  while (nextsource) {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
-                     if (ndir) {
-                        ndir->cd();
-                        TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
-                        if (key2) {
-                           TObject *hobj = key2->ReadObj();
-                           if (!hobj) {
-                              Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
-                                   key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
-                              continue;
-                           }
-                           // Set ownership for collections
-                           if (hobj->InheritsFrom(TCollection::Class())) {
-                              ((TCollection*)hobj)->SetOwner();
-                           }
-                           hobj->ResetBit(kMustCleanup);
-                           listH.Add(hobj);
-                           Int_t error = 0;
-                           obj->Execute("Merge", listHargs.Data(), &error);
-                           info.fIsFirst = kFALSE;
-                           if (error) {
-                              Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
-                                    obj->GetName(), nextsource->GetName());
-                           }
-                           listH.Delete();
-                        }
+                  ForEachSourceObject(sourcelist, nextsource, path, key, [&](TFile *source, TObject *hobj) {
+                     // Set ownership for collections
+                     if (hobj->InheritsFrom(TCollection::Class())) {
+                        ((TCollection*)hobj)->SetOwner();
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
-                  }
+                     hobj->ResetBit(kMustCleanup);
+                     listH.Add(hobj);
+                     Int_t error = 0;
+                     obj->Execute("Merge", listHargs.Data(), &error);
+                     info.fIsFirst = kFALSE;
+                     if (error) {
+                        Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                              obj->GetName(), source->GetName());
+                     }
+                     listH.Delete();
+                  });
                   // Merge the list, if still to be done
                   if (info.fIsFirst) {
                      Int_t error = 0;
@@ -682,38 +726,22 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            obj->GetName(), key->GetName());
                   }
                } else {
-                  while (nextsource) {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
-                     if (ndir) {
-                        ndir->cd();
-                        TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
-                        if (key2) {
-                           TObject *hobj = key2->ReadObj();
-                           if (!hobj) {
-                              Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
-                                   key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
-                              continue;
-                           }
-                           // Set ownership for collections
-                           if (hobj->InheritsFrom(TCollection::Class())) {
-                              ((TCollection*)hobj)->SetOwner();
-                           }
-                           hobj->ResetBit(kMustCleanup);
-                           listH.Add(hobj);
-                           Int_t error = 0;
-                           obj->Execute("Merge", listHargs.Data(), &error);
-                           info.fIsFirst = kFALSE;
-                           if (error) {
-                              Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
-                                    obj->GetName(), nextsource->GetName());
-                           }
-                           listH.Delete();
-                        }
+                  ForEachSourceObject(sourcelist, nextsource, path, key, [&](TFile *source, TObject *hobj) {
+                     // Set ownership for collections
+                     if (hobj->InheritsFrom(TCollection::Class())) {
+                        ((TCollection*)hobj)->SetOwner();
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
-                  }
+                     hobj->ResetBit(kMustCleanup);
+                     listH.Add(hobj);
+                     Int_t error = 0;
+                     obj->Execute("Merge", listHargs.Data(), &error);
+                     info.fIsFirst = kFALSE;
+                     if (error) {
+                        Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                              obj->GetName(), source->GetName());
+                     }
+                     listH.Delete();
+                  });
                   // Merge the list, if still to be done
                   if (info.fIsFirst) {
                      Int_t error = 0;
@@ -4,6 +4,7 @@
 #include "ROOT/TTaskGroup.hxx"
 
 #include "TFile.h"
+#include "TNamed.h"
 #include "TROOT.h"
 #include "TTree.h"
 
@@ -11,6 +12,7 @@
 #include <cstdio>
 #include <future>
 #include <memory>
+#include <string>
 #include <thread>
 #include <sys/stat.h>
 
@@ -176,6 +178,132 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, BasketMerge)
+{
+   int nevents = 16384;
+   int nthreads = 8;
+   int events_per_thread = nevents / nthreads;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_basketmerge.root");
+      merger.SetBasketMerge();
+      EXPECT_TRUE(merger.GetBasketMerge());
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+
+            // Write twice, such that each worker merges into an existing output tree
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int j = 0; j < events_per_thread; ++j) {
+               n = i * events_per_thread + j;
+               mytree->Fill();
+               if (j == events_per_thread / 2)
+                  myfile->Write();
+            }
+            myfile->Write();
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+
+      // Only the trees were written, nothing went through the queue
+      EXPECT_EQ(0u, merger.GetQueueSize());
+   }
+
+   ASSERT_TRUE(FileExists("tbuffermerger_basketmerge.root"));
+
+   {
+      TFile f("tbuffermerger_basketmerge.root");
+      TTree *t = nullptr;
+      f.GetObject("mytree", t);
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(nevents, t->GetEntries());
+
+      int n;
+      long long sum = 0;
+      t->SetBranchAddress("n", &n);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         sum += n;
+      }
+      EXPECT_EQ((long long)nevents * (nevents - 1) / 2, sum);
+   }
+
+   RemoveFile("tbuffermerger_basketmerge.root");
+}
+
+TEST(TBufferMerger, BasketMergeSplitBranch)
+{
+   int nevents = 4096;
+   int nthreads = 4;
+   int events_per_thread = nevents / nthreads;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_basketmergesplit.root");
+      merger.SetBasketMerge();
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+
+            // The sub-branches of the split branch keep their addresses across the merges
+            TNamed named;
+            TNamed *pnamed = &named;
+            mytree->Branch("named", &pnamed, 32000, 99);
+            EXPECT_LT(0, mytree->GetBranch("named")->GetListOfBranches()->GetEntries());
+            for (int j = 0; j < events_per_thread; ++j) {
+               named.SetName(std::to_string(i * events_per_thread + j).c_str());
+               mytree->Fill();
+               if (j == events_per_thread / 2)
+                  myfile->Write();
+            }
+            myfile->Write();
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+   }
+
+   ASSERT_TRUE(FileExists("tbuffermerger_basketmergesplit.root"));
+
+   {
+      TFile f("tbuffermerger_basketmergesplit.root");
+      TTree *t = nullptr;
+      f.GetObject("mytree", t);
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(nevents, t->GetEntries());
+
+      TNamed *named = nullptr;
+      long long sum = 0;
+      t->SetBranchAddress("named", &named);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         sum += std::stoll(named->GetName());
+      }
+      EXPECT_EQ((long long)nevents * (nevents - 1) / 2, sum);
+      t->ResetBranchAddresses();
+      delete named;
+   }
+
+   RemoveFile("tbuffermerger_basketmergesplit.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
@@ -1,8 +1,13 @@
+#include "RConfigure.h"
 #include "TFileMerger.h"
 
 #include "TMemFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <memory>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace {
@@ -96,3 +101,40 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+#ifdef R__USE_IMT
+TEST(TFileMerger, ImplicitMT)
+{
+   ROOT::EnableImplicitMT(2);
+
+   const int nfiles = 11; // More than one batch of files read concurrently.
+   std::vector<std::unique_ptr<TMemFile>> inputs;
+   for (int i = 0; i < nfiles; ++i) {
+      inputs.emplace_back(new TMemFile(TString::Format("input%d.root", i), "RECREATE"));
+      CreateATuple(*inputs.back(), "a_tree", i);
+   }
+
+   TFileMerger merger;
+   merger.SetImplicitMT();
+   EXPECT_TRUE(merger.GetImplicitMT());
+   auto output = std::unique_ptr<TMemFile>(new TMemFile("output.root", "CREATE"));
+   ASSERT_TRUE(merger.OutputFile(std::move(output)));
+   for (auto &input : inputs)
+      merger.AddFile(input.get(), false);
+   ASSERT_TRUE(merger.PartialMerge());
+
+   // The entries are merged in the order of the input files.
+   auto t = static_cast<TTree *>(merger.GetOutputFile()->Get("a_tree"));
+   ASSERT_TRUE(t != nullptr);
+   ASSERT_EQ(nfiles, t->GetEntries());
+   double d;
+   t->SetBranchAddress("a_tree", &d);
+   for (int i = 0; i < nfiles; ++i) {
+      t->GetEntry(i);
+      EXPECT_EQ(i, d);
+   }
+   t->ResetBranchAddresses();
+
+   ROOT::DisableImplicitMT();
+}
+#endif
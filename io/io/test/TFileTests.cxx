@@ -1,6 +1,11 @@
 #include "TFile.h"
+#include "TFileCacheRead.h"
+#include "TNamed.h"
 #include "TSystem.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 // Tests ROOT-9857
@@ -22,4 +27,54 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+TEST(TFile, AsyncReadThreads)
+{
+   const auto filename = "AsyncReadThreads.root";
+   {
+      TFile f(filename, "RECREATE", "", 0);
+      for (int i = 0; i < 200; ++i) {
+         TNamed obj(TString::Format("obj%d", i), TString('x', 10000 + i));
+         obj.Write();
+      }
+   }
+
+   // Scattered blocks, one of them larger than the size of the individual asynchronous reads.
+   Long64_t pos[] = {0, 200, 5000, 20000};
+   Int_t len[] = {100, 1000, 10000, 1500000};
+   const Int_t nbuf = 4;
+   const Int_t total = 100 + 1000 + 10000 + 1500000;
+
+   TFile f(filename);
+   ASSERT_FALSE(f.IsZombie());
+   ASSERT_GT(f.GetSize(), pos[3] + len[3]);
+   std::vector<char> expected(total), actual(total);
+
+   const auto nthreads = TFile::GetAsyncReadThreads();
+   TFile::SetAsyncReadThreads(0);
+   ASSERT_FALSE(f.ReadBuffers(expected.data(), pos, len, nbuf));
+
+   TFile::SetAsyncReadThreads(4);
+   EXPECT_FALSE(f.ReadBuffers(actual.data(), pos, len, nbuf));
+   EXPECT_EQ(expected, actual);
+
+   // The blocks prefetched by a TFileCacheRead are read in the background, and each one is used as soon as it is in.
+   {
+      TFileCacheRead cache(&f, total + 1000);
+      f.SetCacheRead(&cache);
+      for (Int_t i = 0; i < nbuf; ++i)
+         cache.Prefetch(pos[i], len[i]);
+      std::fill(actual.begin(), actual.end(), 0);
+      Long64_t offset = 0;
+      for (Int_t i = 0; i < nbuf; ++i) {
+         EXPECT_FALSE(f.ReadBuffer(actual.data() + offset, pos[i], len[i])) << "block " << i;
+         offset += len[i];
+      }
+      EXPECT_EQ(expected, actual);
+      f.SetCacheRead(nullptr);
+   }
+   TFile::SetAsyncReadThreads(nthreads);
+
+   gSystem->Unlink(filename);
+}
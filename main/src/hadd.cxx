@@ -51,6 +51,10 @@
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
+  With the option -mt [nthreads], the objects to merge are read from the input
+  files by several threads (by default as many as there are cores) while the
+  previously read ones are merged, within the hadd process.
+
   For options that takes a size as argument, a decimal number of bytes is expected.
   If the number ends with a ``k'', ``m'', ``g'', etc., the number is multiplied
   by 1000 (1K), 1000000 (1MB), 1000000000 (1G), etc.
@@ -79,6 +83,7 @@
 #include "TObjString.h"
 #include "Riostream.h"
 #include "TClass.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TUUID.h"
 #include "ROOT/StringConv.hxx"
@@ -110,6 +115,8 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
+   UInt_t nThreads = 0;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -184,6 +191,31 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-mt") == 0) {
+         // If the number of threads is not specified, use the default.
+         // Only an argument made of digits is a number of threads: e.g. 2018.root is the output file.
+         Bool_t isNumber = a + 1 != argc && argv[a + 1][0] != '\0';
+         if (isNumber) {
+            for (char *c = argv[a + 1]; *c != '\0'; ++c) {
+               if (!isdigit(*c)) {
+                  isNumber = kFALSE;
+                  break;
+               }
+            }
+         }
+         if (isNumber) {
+            Long_t request = strtol(argv[a + 1], 0, 10);
+            if (request < kMaxUInt && request >= 0) {
+               nThreads = (UInt_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -mt: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+         multithread = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -334,6 +366,20 @@ int main( int argc, char **argv )
 
    gSystem->Load("libTreePlayer");
 
+   if (multithread) {
+      if (multiproc) {
+         std::cerr << "Warning: -mt cannot be combined with -j; the input files will be read by a single thread.\n";
+         multithread = kFALSE;
+      } else {
+#ifdef R__USE_IMT
+         ROOT::EnableImplicitMT(nThreads);
+#else
+         std::cerr << "Warning: ROOT was built without implicit multi-threading; ignoring -mt.\n";
+         multithread = kFALSE;
+#endif
+      }
+   }
+
    const char *targetname = 0;
    if (outputPlace) {
       targetname = argv[outputPlace];
@@ -427,6 +473,7 @@ int main( int argc, char **argv )
          }
       }
       merger.SetNotrees(noTrees);
+      merger.SetImplicitMT(multithread);
       merger.SetMergeOptions(cacheSize);
       merger.SetIOFeatures(features);
       Bool_t status;
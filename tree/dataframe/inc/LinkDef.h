@@ -34,6 +34,7 @@
 #pragma link C++ class ROOT::RDF::TProfile2DModel-;
 #pragma link C++ class ROOT::Internal::RDF::RIgnoreErrorLevelRAII-;
 #pragma link C++ class ROOT::Internal::RDF::FillHelper-;
+#pragma link C++ class ROOT::RDF::RResultHandle-;
 #pragma link C++ class ROOT::RDF::RTrivialDS-;
 #pragma link C++ class ROOT::RDF::RRootDS-;
 #pragma link C++ class ROOT::RDF::RCsvDS-;
@@ -7,7 +7,11 @@
 #include <memory>
 
 namespace arrow {
+class Schema;
 class Table;
+namespace ipc {
+class RecordBatchFileReader;
+}
 }
 
 namespace ROOT {
@@ -21,17 +25,23 @@ namespace RDF {
 
 class RArrowDS final : public RDataSource {
 private:
-   std::shared_ptr<arrow::Table> fTable;
+   std::shared_ptr<arrow::Table> fTable; ///< The table read, null if the record batches are read from a file
+   std::shared_ptr<arrow::ipc::RecordBatchFileReader> fFileReader; ///< The reader of the file, if any
+   std::shared_ptr<arrow::Schema> fSchema;
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   int fNextBatch = 0;          ///< The next record batch to read from the file
+   ULong64_t fNextEntry = 0ULL; ///< The first entry of the next record batch read from the file
    std::vector<std::string> fColumnNames;
    size_t fNSlots = 0U;
 
    std::vector<std::pair<size_t, size_t>> fGetterIndex; // (columnId, visitorId)
    std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters; // Visitors to be used to track and get entries. One per column.
    std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+   std::vector<std::pair<ULong64_t, ULong64_t>> ReadNextBatches();
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::string_view fileName, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const override;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
@@ -49,6 +59,11 @@ public:
 /// \param[in] table an apache::arrow table to use as a source.
 RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a Apache Arrow RDataFrame reading an Arrow IPC file.
+/// \param[in] fileName the path of a file in the Arrow IPC file format (Feather V2).
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columns);
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -0,0 +1,42 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <Compression.h>
+#include <ROOT/RStringView.hxx>
+#include <RtypesCore.h>
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer the storage in memory of the dataset cached by RInterface::Cache
+struct RCacheOptions {
+   using ECAlgo = ROOT::ECompressionAlgorithm;
+   RCacheOptions() = default;
+   RCacheOptions(const RCacheOptions &) = default;
+   RCacheOptions(RCacheOptions &&) = default;
+   RCacheOptions(ECAlgo comprAlgo, int comprLevel, unsigned int chunkSize, ULong64_t maxMemory,
+                 std::string_view spillDir = "")
+      : fCompressionAlgorithm(comprAlgo), fCompressionLevel(comprLevel), fChunkSize(chunkSize),
+        fMaxMemory(maxMemory), fSpillDir(spillDir)
+   {
+   }
+   ECAlgo fCompressionAlgorithm = ROOT::kLZ4; ///< Compression algorithm of the chunks
+   int fCompressionLevel = 1;                 ///< Compression level of the chunks, 0 to store them uncompressed
+   unsigned int fChunkSize = 100000;          ///< Maximum number of entries of a chunk
+   /// Number of bytes of chunks kept in memory, chunks beyond it are moved to a scratch file; 0 for no limit
+   ULong64_t fMaxMemory = 0;
+   std::string fSpillDir; ///< Directory of the scratch file, the temporary directory if empty
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
@@ -14,8 +14,8 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDataSource.hxx"
 
+#include <cstddef>
 #include <deque>
-#include <list>
 #include <map>
 #include <vector>
 
@@ -32,36 +32,42 @@ private:
    using ColType_t = char;
    static const std::map<ColType_t, std::string> fgColTypeMap;
 
-   std::streampos fDataPos = 0;
+   const char *fData = nullptr;      ///< The content of the file, mapped in memory or read in fBuffer
+   std::size_t fDataSize = 0;        ///< Size of the content of the file
+   bool fIsMapped = false;           ///< Whether fData is a memory mapping of the file
+   std::vector<char> fBuffer;        ///< The content of the file, if it cannot be mapped in memory
+   std::size_t fDataPos = 0;         ///< Position of the first record in the file
+   std::size_t fCursor = 0;          ///< Position of the first record not read yet
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
-   std::ifstream fStream;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
    ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
+   ULong64_t fFirstRecordEntry = 0ULL; // the entry number of the first record of the current chunk
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
-   std::list<ColType_t> fColTypesList;
-   std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
-   std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
-   std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
-   std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
+   std::vector<ColType_t> fColTypesList;
+   std::vector<std::vector<void *>> fColAddresses;    // fColAddresses[column][slot]
+   // The values of the records of the current chunk, fXColumns[column][record]. Only the vector matching the type of
+   // the column is filled.
+   std::vector<std::vector<double>> fDoubleColumns;
+   std::vector<std::vector<Long64_t>> fLong64Columns;
+   std::vector<std::vector<std::string>> fStringColumns;
    // This must be a deque to avoid the specialisation vector<bool>. This would not
    // work given that the pointer to the boolean in that case cannot be taken
-   std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
+   std::vector<std::deque<bool>> fBoolColumns;
 
    static TRegexp intRegex, doubleRegex1, doubleRegex2, trueRegex, falseRegex;
 
-   void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecords(const char *begin, const char *end, ULong64_t firstRecord);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
-   void InferColTypes(std::vector<std::string> &);
-   void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   void InferColTypes(const char *begin, const char *end);
+   ColType_t InferType(const std::string &);
+   void MapFile(const std::string &fileName);
+   std::vector<std::string> ParseColumns(const char *begin, const char *end);
+   const char *ParseValue(const char *begin, const char *end, std::string &value);
    ColType_t GetType(std::string_view colName) const;
 
 protected:
@@ -69,6 +75,8 @@ protected:
 
 public:
    RCsvDS(std::string_view fileName, bool readHeaders = true, char delimiter = ',', Long64_t linesChunkSize = -1LL);
+   RCsvDS(const RCsvDS &) = delete;
+   RCsvDS &operator=(const RCsvDS &) = delete;
    void Finalise();
    void FreeRecords();
    ~RCsvDS();
@@ -16,6 +16,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 #include <iomanip>
@@ -25,7 +26,9 @@
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/RDF/RCacheStore.hxx"
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
@@ -64,6 +67,8 @@ public:
 
 };
 
+class RLoopManager;
+
 } // namespace RDF
 } // namespace Detail
 
@@ -121,6 +126,14 @@ public:
    CountHelper(const CountHelper &) = delete;
    void InitTask(TTreeReader *, unsigned int) {}
    void Exec(unsigned int slot);
+   /// Count the entries of a block selected by `mask`, see RLoopManager::SetBulkSize.
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n)
+   {
+      ULong64_t count = 0;
+      for (auto i = 0u; i < n; ++i)
+         count += mask[i] != 0;
+      fCounts[slot] += count;
+   }
    void Initialize() { /* noop */}
    void Finalize();
    ULong64_t &PartialUpdate(unsigned int slot);
@@ -157,6 +170,25 @@ public:
    std::string GetActionName() { return "Report"; }
 };
 
+/// Fills a RProfileReport with the measurements of the profiler of the event loop, see RInterface::Profile.
+class ProfileHelper : public RActionImpl<ProfileHelper> {
+   const std::shared_ptr<ROOT::RDF::RProfileReport> fReport;
+   RLoopManager *fLoopManager;
+
+public:
+   using ColumnTypes_t = TypeList<>;
+   ProfileHelper(const std::shared_ptr<ROOT::RDF::RProfileReport> &report, RLoopManager *lm)
+      : fReport(report), fLoopManager(lm){};
+   ProfileHelper(ProfileHelper &&) = default;
+   ProfileHelper(const ProfileHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int /* slot */) {}
+   void Initialize() { /* noop */}
+   void Finalize();
+
+   std::string GetActionName() { return "Profile"; }
+};
+
 class FillHelper : public RActionImpl<FillHelper> {
    // this sets a total initial size of 16 MB for the buffers (can increase)
    static constexpr unsigned int fgTotalBufSize = 2097152;
@@ -653,6 +685,16 @@ public:
          fMins[slot] = std::min(v, fMins[slot]);
    }
 
+   /// Process the values of the entries of a block selected by `mask`, see RLoopManager::SetBulkSize.
+   template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const T *vs)
+   {
+      ResultType min = fMins[slot];
+      for (auto i = 0u; i < n; ++i)
+         min = mask[i] ? std::min(static_cast<ResultType>(vs[i]), min) : min;
+      fMins[slot] = min;
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -697,6 +739,16 @@ public:
          fMaxs[slot] = std::max((ResultType)v, fMaxs[slot]);
    }
 
+   /// Process the values of the entries of a block selected by `mask`, see RLoopManager::SetBulkSize.
+   template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const T *vs)
+   {
+      ResultType max = fMaxs[slot];
+      for (auto i = 0u; i < n; ++i)
+         max = mask[i] ? std::max(static_cast<ResultType>(vs[i]), max) : max;
+      fMaxs[slot] = max;
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -757,6 +809,19 @@ public:
          fSums[slot] += static_cast<ResultType>(v);
    }
 
+   /// Process the values of the entries of a block selected by `mask`, see RLoopManager::SetBulkSize.
+   template <typename T, typename R = ResultType,
+             typename std::enable_if<std::is_arithmetic<T>::value && std::is_arithmetic<R>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const T *vs)
+   {
+      ResultType sum = fSums[slot];
+      for (auto i = 0u; i < n; ++i) {
+         if (mask[i])
+            sum += static_cast<ResultType>(vs[i]);
+      }
+      fSums[slot] = sum;
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize()
@@ -792,6 +857,22 @@ public:
       }
    }
 
+   /// Process the values of the entries of a block selected by `mask`, see RLoopManager::SetBulkSize.
+   template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const T *vs)
+   {
+      double sum = fSums[slot];
+      ULong64_t count = 0;
+      for (auto i = 0u; i < n; ++i) {
+         if (mask[i]) {
+            sum += static_cast<double>(vs[i]);
+            ++count;
+         }
+      }
+      fSums[slot] = sum;
+      fCounts[slot] += count;
+   }
+
    void Initialize() { /* noop */}
 
    void Finalize();
@@ -1045,6 +1126,67 @@ inline void UpdateBoolArray(BoolArrayMap &boolArrays, RVec<bool> &v, const std::
    }
 }
 
+template <bool...>
+struct TBoolPack;
+
+/// Whether the columns of a Snapshot can be written with TTree::FillBulk: they must all be of arithmetic types, which
+/// are written in branches made of a single leaf of basic type. bool is excluded as std::vector<bool> has no data().
+template <typename... BranchTypes>
+using IsSnapshotBulkFillable_t =
+   std::is_same<TBoolPack<(std::is_arithmetic<BranchTypes>::value && !std::is_same<BranchTypes, bool>::value)...,
+                          true>,
+                TBoolPack<true, (std::is_arithmetic<BranchTypes>::value && !std::is_same<BranchTypes, bool>::value)...>>;
+
+/// Buffers of the values of the columns of a Snapshot, written a block of entries at a time with TTree::FillBulk.
+/// This is the no-op version for the columns that cannot be written in bulk, see IsSnapshotBulkFillable_t.
+template <bool IsBulkFillable, typename... BranchTypes>
+class SnapshotBulkBuffers {
+public:
+   void Push(const BranchTypes &...) {}
+   std::size_t GetSize() const { return 0; }
+   void Flush(TTree &, const ColumnNames_t &) {}
+};
+
+template <typename... BranchTypes>
+class SnapshotBulkBuffers<true, BranchTypes...> {
+   std::tuple<std::vector<BranchTypes>...> fValues;
+   std::size_t fSize = 0;
+
+   template <std::size_t... S>
+   void PushImpl(const BranchTypes &... values, std::index_sequence<S...>)
+   {
+      int expander[] = {(std::get<S>(fValues).push_back(values), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+   }
+
+   template <std::size_t... S>
+   void FlushImpl(TTree &tree, const ColumnNames_t &branchNames, std::index_sequence<S...>)
+   {
+      // the branches were created with the addresses of the column values: point them to the buffers instead
+      int expander[] = {(tree.GetBranch(branchNames[S].c_str())->SetAddress(std::get<S>(fValues).data()), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      if (tree.FillBulk(fSize) < 0)
+         throw std::runtime_error("Snapshot: could not write the entries of tree " + std::string(tree.GetName()));
+      int clearer[] = {(std::get<S>(fValues).clear(), 0)..., 0};
+      (void)clearer;
+      fSize = 0;
+   }
+
+public:
+   void Push(const BranchTypes &... values)
+   {
+      PushImpl(values..., std::index_sequence_for<BranchTypes...>());
+      ++fSize;
+   }
+   std::size_t GetSize() const { return fSize; }
+   /// Fill the tree with the buffered entries, and empty the buffers.
+   void Flush(TTree &tree, const ColumnNames_t &branchNames)
+   {
+      if (fSize > 0)
+         FlushImpl(tree, branchNames, std::index_sequence_for<BranchTypes...>());
+   }
+};
+
 /// Helper object for a single-thread Snapshot action
 template <typename... BranchTypes>
 class SnapshotHelper : public RActionImpl<SnapshotHelper<BranchTypes...>> {
@@ -1061,6 +1203,8 @@ class SnapshotHelper : public RActionImpl<SnapshotHelper<BranchTypes...>> {
    BoolArrayMap fBoolArrays; // Storage for C arrays of bools to be written out
    std::vector<TBranch *> fBranches;     // Addresses of branches in output, non-null only for the ones holding C arrays
    std::vector<void *> fBranchAddresses; // Addresses associated to output branches, non-null only for the ones holding C arrays
+   const std::size_t fBulkFillSize; // Number of entries written at once with TTree::FillBulk, 0 to fill one at a time
+   SnapshotBulkBuffers<IsSnapshotBulkFillable_t<BranchTypes...>::value, BranchTypes...> fBulkBuffers;
 
 public:
    using ColumnTypes_t = TypeList<BranchTypes...>;
@@ -1068,7 +1212,10 @@ public:
                   const ColumnNames_t &vbnames, const ColumnNames_t &bnames, const RSnapshotOptions &options)
       : fFileName(filename), fDirName(dirname), fTreeName(treename), fOptions(options), fInputBranchNames(vbnames),
         fOutputBranchNames(ReplaceDotWithUnderscore(bnames)), fBranches(vbnames.size(), nullptr),
-        fBranchAddresses(vbnames.size(), nullptr)
+        fBranchAddresses(vbnames.size(), nullptr),
+        fBulkFillSize(IsSnapshotBulkFillable_t<BranchTypes...>::value && options.fBulkFillSize > 0
+                         ? options.fBulkFillSize
+                         : 0)
    {
    }
 
@@ -1094,6 +1241,12 @@ public:
          SetBranches(values..., ind_t{});
          fIsFirstEvent = false;
       }
+      if (fBulkFillSize > 0) {
+         fBulkBuffers.Push(values...);
+         if (fBulkBuffers.GetSize() == fBulkFillSize)
+            fBulkBuffers.Flush(*fOutputTree, fOutputBranchNames);
+         return;
+      }
       UpdateBoolArrays(values..., ind_t{});
       fOutputTree->Fill();
    }
@@ -1154,6 +1307,7 @@ public:
    {
       if (fOutputFile && fOutputTree) {
          ::TDirectory::TContext ctxt(fOutputFile->GetDirectory(fDirName.c_str()));
+         fBulkBuffers.Flush(*fOutputTree, fOutputBranchNames);
          fOutputTree->Write();
          // must destroy the TTree first, otherwise TFile will delete it too leading to a double delete
          fOutputTree.reset();
@@ -1186,6 +1340,9 @@ class SnapshotHelperMT : public RActionImpl<SnapshotHelperMT<BranchTypes...>> {
    std::vector<std::vector<TBranch *>> fBranches;
    // Addresses associated to output branches per slot, non-null only for the ones holding C arrays
    std::vector<std::vector<void *>> fBranchAddresses; 
+   const std::size_t fBulkFillSize; // Number of entries written at once with TTree::FillBulk, 0 to fill one at a time
+   // Per-slot buffers of the entries to be written with TTree::FillBulk
+   std::vector<SnapshotBulkBuffers<IsSnapshotBulkFillable_t<BranchTypes...>::value, BranchTypes...>> fBulkBuffers;
 
 public:
    using ColumnTypes_t = TypeList<BranchTypes...>;
@@ -1196,7 +1353,11 @@ public:
         fDirName(dirname), fTreeName(treename), fOptions(options), fInputBranchNames(vbnames),
         fOutputBranchNames(ReplaceDotWithUnderscore(bnames)), fInputTrees(fNSlots), fBoolArrays(fNSlots),
         fBranches(fNSlots, std::vector<TBranch *>(vbnames.size(), nullptr)), 
-        fBranchAddresses(fNSlots, std::vector<void *>(vbnames.size(), nullptr))
+        fBranchAddresses(fNSlots, std::vector<void *>(vbnames.size(), nullptr)),
+        fBulkFillSize(IsSnapshotBulkFillable_t<BranchTypes...>::value && options.fBulkFillSize > 0
+                         ? options.fBulkFillSize
+                         : 0),
+        fBulkBuffers(fNSlots)
    {
    }
    SnapshotHelperMT(const SnapshotHelperMT &) = delete;
@@ -1235,6 +1396,7 @@ public:
 
    void FinalizeTask(unsigned int slot)
    {
+      fBulkBuffers[slot].Flush(*fOutputTrees[slot], fOutputBranchNames);
       if (fOutputTrees[slot]->GetEntries() > 0)
          fOutputFiles[slot]->Write();
       // clear now to avoid concurrent destruction of output trees and input tree (which has them listed as fClones)
@@ -1250,8 +1412,20 @@ public:
          SetBranches(slot, values..., ind_t{});
          fIsFirstEvent[slot] = 0;
       }
-      UpdateBoolArrays(slot, values..., ind_t{});
-      fOutputTrees[slot]->Fill();
+      if (fBulkFillSize > 0) {
+         // the buffered entries are written when the buffer is full, and at each cluster boundary so that the
+         // baskets are handed over to the TBufferMerger at the same entries as when filling one entry at a time
+         auto &buffers = fBulkBuffers[slot];
+         buffers.Push(values...);
+         const auto autoFlush = fOutputTrees[slot]->GetAutoFlush();
+         const auto entries = fOutputTrees[slot]->GetEntries() + buffers.GetSize();
+         if (buffers.GetSize() < fBulkFillSize && !(autoFlush > 0 && entries % autoFlush == 0))
+            return;
+         buffers.Flush(*fOutputTrees[slot], fOutputBranchNames);
+      } else {
+         UpdateBoolArrays(slot, values..., ind_t{});
+         fOutputTrees[slot]->Fill();
+      }
       auto entries = fOutputTrees[slot]->GetEntries();
       auto autoFlush = fOutputTrees[slot]->GetAutoFlush();
       if ((autoFlush > 0) && (entries % autoFlush == 0))
@@ -1324,6 +1498,63 @@ public:
    std::string GetActionName() { return "Snapshot"; }
 };
 
+/// Helper object for a Cache action with RCacheOptions: each slot fills the chunks of a RCacheStore, sealed when full
+/// and at the end of each task.
+template <typename... BranchTypes>
+class CacheHelper : public RActionImpl<CacheHelper<BranchTypes...>> {
+   using Columns_t = std::tuple<RCacheColumn<BranchTypes>...>;
+
+   std::shared_ptr<RCacheStore> fStore;
+   std::vector<Columns_t> fColumns;  // the columns of the chunk being filled by each slot
+   std::vector<ULong64_t> fNEntries; // the number of entries of the chunk being filled by each slot
+
+   template <std::size_t... S>
+   void SealChunk(unsigned int slot, std::index_sequence<S...>)
+   {
+      if (fNEntries[slot] == 0)
+         return;
+      fStore->AddChunk(fNEntries[slot], {std::get<S>(fColumns[slot]).Seal()...});
+      fNEntries[slot] = 0;
+   }
+
+   template <std::size_t... S>
+   static void PushValues(Columns_t &columns, std::index_sequence<S...>, BranchTypes &... values)
+   {
+      std::initializer_list<int> expander{(std::get<S>(columns).Push(values), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+public:
+   using ColumnTypes_t = TypeList<BranchTypes...>;
+   CacheHelper(const std::shared_ptr<RCacheStore> &store, const unsigned int nSlots)
+      : fStore(store), fColumns(nSlots), fNEntries(nSlots, 0)
+   {
+   }
+   CacheHelper(CacheHelper &&) = default;
+   CacheHelper(const CacheHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, BranchTypes &... values)
+   {
+      PushValues(fColumns[slot], std::index_sequence_for<BranchTypes...>(), values...);
+      if (++fNEntries[slot] == fStore->GetChunkSize())
+         SealChunk(slot, std::index_sequence_for<BranchTypes...>());
+   }
+
+   void Initialize() { /* noop */}
+
+   void FinalizeTask(unsigned int slot) { SealChunk(slot, std::index_sequence_for<BranchTypes...>()); }
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fColumns.size(); ++slot)
+         SealChunk(slot, std::index_sequence_for<BranchTypes...>());
+   }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
@@ -32,6 +32,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -67,15 +68,25 @@ namespace TTraits = ROOT::TypeTraits;
 namespace RDFInternal = ROOT::Internal::RDF;
 
 // Declare code in the interpreter via the TInterpreter::Declare method
-// and return the return code.
+// and return the return code
 bool InterpreterDeclare(const std::string &code);
 
+// Defer the declaration of code needed by the computation graph of lm to its next batch: the deferred declarations
+// of a graph are declared with a single TInterpreter::Declare call before its jitted code is compiled or called, see
+// InterpreterDeclareDeferredCode. Code that is not needed right away should be declared this way.
+void InterpreterDeclareDeferred(const std::string &code, RLoopManager &lm);
+
+// Declare the deferred declarations of the computation graphs in a single batch. Throws if some of them do not
+// compile; the declarations of other graphs are not affected.
+void InterpreterDeclareDeferredCode(const std::vector<RLoopManager *> &loopManagers);
+
 // Jit code in the interpreter with TInterpreter::Calc and return
-// a pair containing the return value of Calc and the error code.
+// a pair containing the return value of Calc and the error code. The deferred declarations of the computation graph
+// of lm are declared first.
 // The error code is:
 //   - 0 if Calc resulted in TInterpreter::kNoError
 //   - 1 otherwise
-std::pair<Long64_t, int> InterpreterCalc(const std::string &code);
+std::pair<Long64_t, int> InterpreterCalc(const std::string &code, RLoopManager &lm);
 
 using HeadNode_t = ::ROOT::RDF::RResultPtr<RInterface<RLoopManager, void>>;
 HeadNode_t CreateSnaphotRDF(const ColumnNames_t &validCols,
@@ -517,6 +528,15 @@ ColumnNames_t FindUnknownColumns(const ColumnNames_t &requiredCols, const Column
 
 bool IsInternalColumn(std::string_view colName);
 
+bool IsValidCppVarName(const std::string &var);
+
+/// Return the names of the branches, custom columns, data-source columns and aliases used by a jitted expression
+std::vector<std::string> FindUsedColumnNames(std::string_view expression, const ColumnNames_t &branches,
+                                             const ColumnNames_t &customColumns, const ColumnNames_t &dsColumns,
+                                             const std::map<std::string, std::string> &aliasMap);
+
+bool ParseRangeCut(std::string_view expression, const std::string &column, RDataSource::RRangeCut &cut);
+
 /// Returns the list of Filters defined in the whole graph
 std::vector<std::string> GetFilterNames(const std::shared_ptr<RLoopManager> &loopManager);
 
@@ -557,6 +577,45 @@ template <typename T>
 struct IsDeque_t<std::deque<T>> : std::true_type {};
 // clang-format on
 
+/// A systematic variation of the dataset, see RInterface::Vary, as seen from a node of the computation graph: the
+/// node and the custom columns that take its place in the branch of the graph processing the varied values.
+/// Nodes and columns that do not depend on the varied columns are shared with the nominal graph.
+template <typename Proxied>
+struct RVariation {
+   std::string fTag;
+   std::shared_ptr<Proxied> fNode;
+   RBookedCustomColumns fCustomColumns;
+};
+
+/// Copy a callable, or the initial value of the result of an action, for a systematic variation.
+/// Throw if it cannot be copied.
+template <typename T, typename std::enable_if<std::is_copy_constructible<T>::value, int>::type = 0>
+T CopyForVariation(const T &t)
+{
+   return t;
+}
+
+template <typename T, typename std::enable_if<!std::is_copy_constructible<T>::value, int>::type = 0>
+T CopyForVariation(const T &)
+{
+   throw std::runtime_error("This callable or action result cannot be copied for each systematic variation.");
+}
+
+template <typename T, typename std::enable_if<!std::is_base_of<TH1, T>::value, int>::type = 0>
+std::shared_ptr<T> MakeVariedResult(const std::shared_ptr<T> &r)
+{
+   return std::make_shared<T>(CopyForVariation(*r));
+}
+
+/// Histograms are detached from ROOT's memory management, like the nominal ones.
+template <typename T, typename std::enable_if<std::is_base_of<TH1, T>::value, int>::type = 0>
+std::shared_ptr<T> MakeVariedResult(const std::shared_ptr<T> &r)
+{
+   auto h = std::make_shared<T>(*r);
+   h->SetDirectory(nullptr);
+   return h;
+}
+
 } // namespace RDF
 } // namespace Internal
 
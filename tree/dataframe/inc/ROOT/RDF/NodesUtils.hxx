@@ -13,6 +13,7 @@
 
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 
@@ -52,7 +53,7 @@ using ReaderValueOrArray_t = typename TReaderValueOrArray<T>::Proxy_t;
 /// is passed instead.
 template <typename RDFValueTuple, std::size_t... S>
 void InitRDFValues(unsigned int slot, RDFValueTuple &valueTuple, TTreeReader *r, const ColumnNames_t &bn,
-                   const RBookedCustomColumns &customCols, std::index_sequence<S...>)
+                   const RBookedCustomColumns &customCols, std::index_sequence<S...>, RProfiler *profiler = nullptr)
 {
    // isTmpBranch has length bn.size(). Elements are true if the corresponding
    // branch is a temporary branch created with Define, false if they are
@@ -68,12 +69,13 @@ void InitRDFValues(unsigned int slot, RDFValueTuple &valueTuple, TTreeReader *r,
    //- TODO
    int expander[] = {(isTmpColumn[S]
                          ? std::get<S>(valueTuple).SetTmpColumn(slot, customCols.GetColumns().at(bn[S]).get())
-                         : std::get<S>(valueTuple).MakeProxy(r, bn[S]),
+                         : std::get<S>(valueTuple).MakeProxy(r, bn[S], slot, profiler),
                       0)...,
                      0};
    (void)expander; // avoid "unused variable" warnings for expander on gcc4.9
    (void)slot;     // avoid _bogus_ "unused variable" warnings for slot on gcc 4.9
    (void)r;        // avoid "unused variable" warnings for r on gcc5.2
+   (void)profiler; // avoid "unused variable" warnings for profiler when there are no columns
 }
 
 } // namespace RDF
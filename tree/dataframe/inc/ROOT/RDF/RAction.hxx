@@ -21,6 +21,7 @@
 #include <cstddef> // std::size_t
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -59,6 +60,12 @@ public:
       return std::static_pointer_cast<RColumnValue<T>>(fPtr)->Get(e);
    }
 
+   template <typename T>
+   T *GetBulk(const RDFDetail::RBulkBlock &block, const std::vector<char> &mask)
+   {
+      return std::static_pointer_cast<RColumnValue<T>>(fPtr)->GetBulk(block, mask);
+   }
+
    template <typename T>
    RColumnValue<T> *Cast()
    {
@@ -70,7 +77,7 @@ public:
 template <std::size_t... S, typename... ColTypes>
 void InitRDFValues(unsigned int slot, std::vector<RTypeErasedColumnValue> &values, TTreeReader *r,
                    const ColumnNames_t &bn, const RBookedCustomColumns &customCols, std::index_sequence<S...>,
-                   ROOT::TypeTraits::TypeList<ColTypes...>)
+                   ROOT::TypeTraits::TypeList<ColTypes...>, RProfiler *profiler = nullptr)
 {
    std::array<bool, sizeof...(S)> isTmpColumn;
    for (auto i = 0u; i < isTmpColumn.size(); ++i)
@@ -80,7 +87,7 @@ void InitRDFValues(unsigned int slot, std::vector<RTypeErasedColumnValue> &value
    (void)expander{(values.emplace_back(std::make_unique<RColumnValue<ColTypes>>()), 0)..., 0};
    (void)expander{(isTmpColumn[S]
                       ? values[S].Cast<ColTypes>()->SetTmpColumn(slot, customCols.GetColumns().at(bn.at(S)).get())
-                      : values[S].Cast<ColTypes>()->MakeProxy(r, bn.at(S)),
+                      : values[S].Cast<ColTypes>()->MakeProxy(r, bn.at(S), slot, profiler),
                    0)...,
                   0};
 }
@@ -94,6 +101,28 @@ void ResetRDFValueTuple(std::vector<RTypeErasedColumnValue> &values, std::index_
    (void)expander{(values[S].Cast<ColTypes>()->Reset(), 0)...};
 }
 
+/// Pass the values of the columns for a whole block to a helper that implements
+/// `ExecBulk(unsigned int slot, const char *mask, unsigned int n, const ColTypes *... values)`: the values of entry `i`
+/// of the block are `values[i]...`, and the entry must be processed only if `mask[i]` is not 0.
+// this overload is SFINAE'd out if Helper does not implement `ExecBulk` for these column types
+template <typename Helper, typename... ColTypes>
+auto ExecBulkHelper(Helper &helper, unsigned int slot, const char *mask, unsigned int n, int /*overloadresolver*/,
+                    ColTypes *... values) -> decltype(helper.ExecBulk(slot, mask, n, values...), void())
+{
+   helper.ExecBulk(slot, mask, n, values...);
+}
+
+/// Other helpers are called once per selected entry of the block.
+template <typename Helper, typename... ColTypes>
+void ExecBulkHelper(Helper &helper, unsigned int slot, const char *mask, unsigned int n, long /*overloadresolver*/,
+                    ColTypes *... values)
+{
+   for (auto i = 0u; i < n; ++i) {
+      if (mask[i])
+         helper.Exec(slot, values[i]...);
+   }
+}
+
 // fwd decl for RActionCRTP
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t>
 class RAction;
@@ -124,21 +153,40 @@ public:
 
    Helper &GetHelper() { return fHelper; }
 
-   void Initialize() final { fHelper.Initialize(); }
+   void Initialize() final
+   {
+      fProfiler = fLoopManager->GetProfiler();
+      if (fProfiler) {
+         std::string name = fHelper.GetActionName() + "(";
+         for (const auto &column : GetColumnNames())
+            name += (name.back() == '(' ? "" : ", ") + column;
+         fProfileId = fProfiler->AddNode(this, RProfiler::ENodeKind::kAction, name + ")");
+      }
+      fHelper.Initialize();
+   }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : GetCustomColumns().GetColumns())
          bookedBranch.second->InitSlot(r, slot);
       static_cast<Action_t *>(this)->InitColumnValues(r, slot);
+      static_cast<Action_t *>(this)->EnableBulkColumnValues(slot);
       fHelper.InitTask(r, slot);
    }
 
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RProfileScope scope(fProfiler, slot, fProfileId);
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
+      }
+   }
+
+   void RunBulk(unsigned int slot, const RBulkBlock &block) final
+   {
+      const auto &mask = fPrevData.CheckFiltersBulk(slot, block);
+      static_cast<Action_t *>(this)->ExecBulk(slot, block, mask, TypeInd_t());
    }
 
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
@@ -219,7 +267,12 @@ public:
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{});
+                    typename ActionCRTP_t::TypeInd_t{}, RActionBase::fProfiler);
+   }
+
+   void EnableBulkColumnValues(unsigned int slot)
+   {
+      RActionBase::GetLoopManager()->EnableBulkValues(slot, fValues[slot], typename ActionCRTP_t::TypeInd_t{});
    }
 
    template <std::size_t... S>
@@ -229,6 +282,16 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   template <std::size_t... S>
+   void ExecBulk(unsigned int slot, const RDFDetail::RBulkBlock &block, const std::vector<char> &mask,
+                 std::index_sequence<S...>)
+   {
+      const auto values = std::make_tuple(std::get<S>(fValues[slot]).GetBulk(block, mask)...);
+      (void)values; // avoid bogus 'unused variable' warning in gcc4.9
+      RProfileScope scope(RActionBase::fProfiler, slot, RActionBase::fProfileId);
+      ExecBulkHelper(ActionCRTP_t::GetHelper(), slot, mask.data(), block.fSize, 0, std::get<S>(values)...);
+   }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -270,9 +333,13 @@ public:
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{});
+                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, RActionBase::fProfiler);
    }
 
+   /// The output branches point to the column values passed to the first Exec call: entries must be processed one at
+   /// a time, so that these addresses hold the values of the current entry.
+   void EnableBulkColumnValues(unsigned int slot) { RActionBase::GetLoopManager()->DisableBulk(slot); }
+
    template <std::size_t... S>
    void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
@@ -280,6 +347,15 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
    }
 
+   /// Never called, as bulk processing is disabled for this action.
+   template <std::size_t... S>
+   void ExecBulk(unsigned int slot, const RDFDetail::RBulkBlock &block, const std::vector<char> &mask,
+                 std::index_sequence<S...>)
+   {
+      ExecBulkHelper(ActionCRTP_t::GetHelper(), slot, mask.data(), block.fSize, 0,
+                     fValues[slot][S].template GetBulk<ColTypes>(block, mask)...);
+   }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -310,9 +386,13 @@ public:
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{});
+                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, RActionBase::fProfiler);
    }
 
+   /// The output branches point to the column values passed to the first Exec call: entries must be processed one at
+   /// a time, so that these addresses hold the values of the current entry.
+   void EnableBulkColumnValues(unsigned int slot) { RActionBase::GetLoopManager()->DisableBulk(slot); }
+
    template <std::size_t... S>
    void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
@@ -320,6 +400,15 @@ public:
       ActionCRTP_t::GetHelper().Exec(slot, fValues[slot][S].template Get<ColTypes>(entry)...);
    }
 
+   /// Never called, as bulk processing is disabled for this action.
+   template <std::size_t... S>
+   void ExecBulk(unsigned int slot, const RDFDetail::RBulkBlock &block, const std::vector<char> &mask,
+                 std::index_sequence<S...>)
+   {
+      ExecBulkHelper(ActionCRTP_t::GetHelper(), slot, mask.data(), block.fSize, 0,
+                     fValues[slot][S].template GetBulk<ColTypes>(block, mask)...);
+   }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
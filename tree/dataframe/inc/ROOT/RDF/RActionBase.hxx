@@ -12,10 +12,13 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RBulkBlock.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
 #include <memory>
+#include <set>
 #include <string>
 
 namespace ROOT {
@@ -46,6 +49,8 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   RProfiler *fProfiler = nullptr; ///< Non-null during the event loops that are profiled
+   unsigned int fProfileId = 0;    ///< The id of this action in fProfiler
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -65,6 +70,8 @@ public:
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Bulk version of Run: execute the action on the entries of the block that pass all filters.
+   virtual void RunBulk(unsigned int slot, const RBulkBlock &block) = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -78,6 +85,9 @@ public:
    // overridden by RJittedAction
    virtual bool HasRun() const { return fHasRun; }
    virtual void SetHasRun() { fHasRun = true; }
+   // overridden by RJittedAction
+   virtual void
+   AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const;
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
 };
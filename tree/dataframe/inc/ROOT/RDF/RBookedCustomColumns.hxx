@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -95,6 +96,11 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Internally it recreates the map with the new column name, and swaps with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Add to datasetColumns the columns of the dataset which the columns in names are computed from.
+   void AddDatasetColumns(const ColumnNames_t &names, std::set<std::string> &datasetColumns,
+                          std::set<const RDFDetail::RCustomColumnBase *> &visited) const;
 };
 
 } // Namespace RDF
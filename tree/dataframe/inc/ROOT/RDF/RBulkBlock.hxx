@@ -0,0 +1,43 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDFBULKBLOCK
+#define ROOT_RDFBULKBLOCK
+
+#include "RtypesCore.h"
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+
+/// A block of entries processed at once by the nodes of the computation graph, see RLoopManager::SetBulkSize.
+/// The values of a column for all entries of the block are obtained at once via RColumnValue::GetBulk, as a contiguous
+/// array indexed like fEntries.
+struct RBulkBlock {
+   ULong64_t fId;            ///< Identifies the block among the ones processed by a slot, used by nodes to cache results
+   const Long64_t *fEntries; ///< The entry numbers of the block
+   unsigned int fSize;       ///< The number of entries in the block
+};
+
+} // ns RDF
+} // ns Detail
+
+namespace Internal {
+namespace RDF {
+
+/// Copies the current value of a column read from a TTree or a data source in the array of values of a block.
+struct RBulkLoader {
+   void *fColumn;                                 ///< The RColumnValue to load
+   void (*fLoad)(void *, unsigned int, Long64_t); ///< Load the value of the given entry at the given index
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif // ROOT_RDFBULKBLOCK
@@ -0,0 +1,163 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEDS
+#define ROOT_RCACHEDS
+
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RDF/RCacheStore.hxx"
+#include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RResultPtr.hxx"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A RDataSource reading the chunks of a RCacheStore filled by RInterface::Cache
+///
+/// The processing of the dataframe filling the store starts only when the event loop of
+/// the dataframe reading it is triggered. Each chunk of the store is an entry range of the
+/// data source, processed by one task. A slot reading an entry loads the chunk holding it,
+/// uncompressing its columns in buffers of the slot which the column values point to.
+template <typename... ColumnTypes>
+class RCacheDS final : public ROOT::RDF::RDataSource {
+   using Columns_t = std::tuple<RCacheColumn<ColumnTypes>...>;
+
+   ROOT::RDF::RResultPtr<RCacheStore> fStore;
+   const std::vector<std::string> fColNames;
+   const std::map<std::string, std::string> fColTypesMap;
+   unsigned int fNSlots{0};
+   /// The columns of the chunk loaded by each slot, and the entries of the chunk
+   std::vector<Columns_t> fColumns;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fLoaded;
+   std::vector<std::vector<void *>> fAddresses; ///< The address of the current value of each column, per slot
+   std::vector<std::pair<ULong64_t, ULong64_t>> fChunkRanges;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges{};
+
+   Record_t GetColumnReadersImpl(std::string_view colName, const std::type_info &id)
+   {
+      auto colNameStr = std::string(colName);
+      const auto idName = ROOT::Internal::RDF::TypeID2TypeName(id);
+      auto it = fColTypesMap.find(colNameStr);
+      if (fColTypesMap.end() == it) {
+         std::string err = "The specified column name, \"" + colNameStr + "\" is not known to the data source.";
+         throw std::runtime_error(err);
+      }
+
+      const auto colIdName = it->second;
+      if (colIdName != idName) {
+         std::string err = "Column " + colNameStr + " has type " + colIdName +
+                           " while the id specified is associated to type " + idName;
+         throw std::runtime_error(err);
+      }
+
+      const auto index = std::distance(fColNames.begin(), std::find(fColNames.begin(), fColNames.end(), colName));
+      Record_t ret(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         ret[slot] = &fAddresses[index][slot];
+      return ret;
+   }
+
+   template <std::size_t... S>
+   void LoadChunk(unsigned int slot, ULong64_t entry, std::index_sequence<S...>)
+   {
+      const auto chunk = fStore->FindChunk(entry);
+      const auto &range = fChunkRanges[chunk];
+      const auto nEntries = range.second - range.first;
+      std::initializer_list<int> expander{
+         (std::get<S>(fColumns[slot]).Load(*fStore, chunk, S, nEntries), 0)...};
+      (void)expander; // avoid unused variable warnings
+      fLoaded[slot] = range;
+   }
+
+   template <std::size_t... S>
+   void SetEntryHelper(unsigned int slot, ULong64_t index, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{(fAddresses[S][slot] = std::get<S>(fColumns[slot]).Get(index), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+protected:
+   std::string AsString() { return "cache data source"; };
+
+public:
+   RCacheDS(const ROOT::RDF::RResultPtr<RCacheStore> &store, const std::vector<std::string> &colNames)
+      : fStore(store), fColNames(colNames),
+        fColTypesMap(
+           [&colNames]() {
+              const std::vector<std::string> types{TypeID2TypeName(typeid(ColumnTypes))...};
+              std::map<std::string, std::string> m;
+              for (std::size_t i = 0; i < colNames.size(); ++i)
+                 m[colNames[i]] = types[i];
+              return m;
+           }())
+   {
+   }
+
+   const std::vector<std::string> &GetColumnNames() const { return fColNames; }
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges()
+   {
+      auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
+      return entryRanges;
+   }
+
+   std::string GetTypeName(std::string_view colName) const { return fColTypesMap.at(std::string(colName)); }
+
+   bool HasColumn(std::string_view colName) const { return fColTypesMap.count(std::string(colName)) > 0; }
+
+   bool SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      const auto &loaded = fLoaded[slot];
+      if (entry < loaded.first || entry >= loaded.second)
+         LoadChunk(slot, entry, std::index_sequence_for<ColumnTypes...>());
+      SetEntryHelper(slot, entry - fLoaded[slot].first, std::index_sequence_for<ColumnTypes...>());
+      return true;
+   }
+
+   void SetNSlots(unsigned int nSlots)
+   {
+      fNSlots = nSlots;
+      fColumns.resize(fNSlots);
+      fLoaded.resize(fNSlots);
+      fAddresses.assign(fColNames.size(), std::vector<void *>(fNSlots, nullptr));
+   }
+
+   void Initialise()
+   {
+      // this runs the event loop filling the store, if it did not run yet
+      fChunkRanges = fStore->GetChunkRanges();
+      fEntryRanges = fChunkRanges;
+   }
+
+   void Finalise()
+   {
+      // release the chunks loaded by the slots
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         fColumns[slot] = Columns_t();
+         fLoaded[slot] = {0ull, 0ull};
+      }
+   }
+
+   std::string GetLabel() { return "CacheDS"; }
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif
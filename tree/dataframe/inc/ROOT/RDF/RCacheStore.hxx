@@ -0,0 +1,198 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDFCACHESTORE
+#define ROOT_RDFCACHESTORE
+
+#include "ROOT/RCacheOptions.hxx"
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// The values of a column for the entries of a chunk, as handed to RCacheStore::AddChunk.
+struct RCacheColumnData {
+   std::vector<char> fBytes;       ///< The serialized values
+   std::shared_ptr<void> fObjects; ///< The values of the columns which are not serialized, null otherwise
+};
+
+/// The storage of a dataset cached in memory by RInterface::Cache with RCacheOptions.
+///
+/// Entries are stored in chunks, each filled by a slot during one task of the event loop and holding at most
+/// RCacheOptions::fChunkSize entries. The serialized values of each column of a chunk are compressed with the
+/// algorithm and level of the options. Chunks which would bring the bytes held in memory beyond
+/// RCacheOptions::fMaxMemory are moved to a scratch file, deleted with the store. Chunks are numbered in the order
+/// they are added and hold consecutive entries.
+///
+/// AddChunk() is thread-safe; the other methods must only be called once all chunks are added and are then
+/// thread-safe too.
+class RCacheStore {
+   /// The values of a column of a chunk, as stored
+   struct RColumn {
+      std::vector<char> fBytes;       ///< The stored bytes, empty if spilled
+      std::size_t fSize = 0;          ///< The number of bytes of the serialized values
+      std::size_t fStoredSize = 0;    ///< The number of bytes stored
+      bool fCompressed = false;       ///< Whether the stored bytes are compressed
+      Long64_t fSpillOffset = -1;     ///< The position of the stored bytes in the scratch file, -1 if in memory
+      std::shared_ptr<void> fObjects; ///< The values of the columns which are not serialized
+   };
+   struct RChunk {
+      ULong64_t fFirstEntry;
+      ULong64_t fNEntries;
+      std::vector<RColumn> fColumns;
+   };
+
+   const ROOT::RDF::RCacheOptions fOptions;
+   mutable std::mutex fMutex;          ///< Protects the chunks and the scratch file
+   std::vector<RChunk> fChunks;        ///< Ordered by first entry
+   ULong64_t fNEntries = 0;            ///< Total number of entries of the chunks
+   ULong64_t fMemoryBytes = 0;         ///< Number of bytes of the columns stored in memory
+   ULong64_t fSpilledBytes = 0;        ///< Number of bytes of the columns stored in the scratch file
+   std::string fSpillFileName;         ///< Name of the scratch file, empty until a chunk is spilled
+   std::FILE *fSpillFile = nullptr;    ///< The scratch file
+
+   void Spill(RChunk &chunk);
+
+public:
+   RCacheStore(const ROOT::RDF::RCacheOptions &options);
+   ~RCacheStore();
+   RCacheStore(const RCacheStore &) = delete;
+   RCacheStore &operator=(const RCacheStore &) = delete;
+
+   void AddChunk(ULong64_t nEntries, std::vector<RCacheColumnData> &&columns);
+   std::shared_ptr<void> ReadColumn(std::size_t chunk, std::size_t column, std::vector<char> &bytes) const;
+   std::size_t FindChunk(ULong64_t entry) const;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetChunkRanges() const;
+   ULong64_t GetNEntries() const { return fNEntries; }
+   ULong64_t GetMemoryBytes() const { return fMemoryBytes; }
+   ULong64_t GetSpilledBytes() const { return fSpilledBytes; }
+   unsigned int GetChunkSize() const { return fOptions.fChunkSize; }
+};
+
+/// Accumulates the values of a column of type T for a chunk of a RCacheStore (Push(), Seal()) and gives access to
+/// the values of a chunk read back from the store (Load(), Get()).
+///
+/// The primary template keeps the values in memory as objects; values of arithmetic types and RVecs of arithmetic
+/// types other than bool are serialized, and can therefore be compressed and spilled, see the specializations.
+template <typename T, typename Enable = void>
+class RCacheColumn {
+   std::shared_ptr<std::vector<T>> fValues = std::make_shared<std::vector<T>>();
+   std::vector<char> fBytes; ///< Stays empty, the values are not serialized
+
+public:
+   void Push(const T &v) { fValues->emplace_back(v); }
+
+   RCacheColumnData Seal()
+   {
+      RCacheColumnData data;
+      data.fObjects = std::move(fValues);
+      fValues = std::make_shared<std::vector<T>>();
+      return data;
+   }
+
+   void Load(const RCacheStore &store, std::size_t chunk, std::size_t column, ULong64_t /*nEntries*/)
+   {
+      fValues = std::static_pointer_cast<std::vector<T>>(store.ReadColumn(chunk, column, fBytes));
+   }
+
+   T *Get(ULong64_t i) { return &(*fValues)[i]; }
+};
+
+template <typename T>
+class RCacheColumn<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+   std::vector<char> fBytes;
+
+public:
+   void Push(const T &v)
+   {
+      const auto pos = fBytes.size();
+      fBytes.resize(pos + sizeof(T));
+      std::memcpy(&fBytes[pos], &v, sizeof(T));
+   }
+
+   RCacheColumnData Seal()
+   {
+      RCacheColumnData data;
+      data.fBytes.swap(fBytes);
+      return data;
+   }
+
+   void Load(const RCacheStore &store, std::size_t chunk, std::size_t column, ULong64_t /*nEntries*/)
+   {
+      store.ReadColumn(chunk, column, fBytes);
+   }
+
+   T *Get(ULong64_t i) { return reinterpret_cast<T *>(fBytes.data()) + i; }
+};
+
+/// RVecs are serialized as their flattened values followed by their sizes. Once loaded, the RVecs adopt the
+/// memory of the values.
+template <typename T>
+class RCacheColumn<ROOT::VecOps::RVec<T>,
+                   typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type> {
+   std::vector<T> fValues;
+   std::vector<UInt_t> fSizes;
+   std::vector<char> fBytes;
+   std::vector<ROOT::VecOps::RVec<T>> fVecs;
+
+public:
+   void Push(const ROOT::VecOps::RVec<T> &v)
+   {
+      fValues.insert(fValues.end(), v.begin(), v.end());
+      fSizes.emplace_back(v.size());
+   }
+
+   RCacheColumnData Seal()
+   {
+      RCacheColumnData data;
+      const auto valuesSize = fValues.size() * sizeof(T);
+      data.fBytes.resize(valuesSize + fSizes.size() * sizeof(UInt_t));
+      if (valuesSize)
+         std::memcpy(data.fBytes.data(), fValues.data(), valuesSize);
+      if (!fSizes.empty())
+         std::memcpy(data.fBytes.data() + valuesSize, fSizes.data(), fSizes.size() * sizeof(UInt_t));
+      fValues.clear();
+      fSizes.clear();
+      return data;
+   }
+
+   void Load(const RCacheStore &store, std::size_t chunk, std::size_t column, ULong64_t nEntries)
+   {
+      store.ReadColumn(chunk, column, fBytes);
+      std::vector<UInt_t> sizes(nEntries);
+      if (nEntries)
+         std::memcpy(sizes.data(), fBytes.data() + fBytes.size() - nEntries * sizeof(UInt_t),
+                     nEntries * sizeof(UInt_t));
+      fVecs.clear();
+      fVecs.reserve(nEntries);
+      auto values = reinterpret_cast<T *>(fBytes.data());
+      for (auto size : sizes) {
+         fVecs.emplace_back(values, size);
+         values += size;
+      }
+   }
+
+   ROOT::VecOps::RVec<T> *Get(ULong64_t i) { return &fVecs[i]; }
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif
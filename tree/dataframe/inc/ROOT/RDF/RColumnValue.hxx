@@ -11,7 +11,9 @@
 #ifndef ROOT_RCOLUMNVALUE
 #define ROOT_RCOLUMNVALUE
 
+#include <ROOT/RDF/RBulkBlock.hxx>
 #include <ROOT/RDF/RCustomColumnBase.hxx>
+#include <ROOT/RDF/RProfiler.hxx>
 #include <ROOT/RDF/Utils.hxx> // IsRVec_t, TypeID2TypeName
 #include <ROOT/RIntegerSequence.hxx>
 #include <ROOT/RMakeUnique.hxx>
@@ -22,7 +24,8 @@
 #include <TTreeReaderValue.h>
 #include <TTreeReaderArray.h>
 
-#include <cstring> // strcmp
+#include <algorithm> // std::none_of
+#include <cstring>   // strcmp
 #include <initializer_list>
 #include <limits>
 #include <memory>
@@ -32,11 +35,46 @@
 #include <type_traits>
 #include <vector>
 
+class TBranch;
+class TBufferFile;
+class TTree;
+
 namespace ROOT {
 namespace Internal {
 namespace RDF {
 using namespace ROOT::VecOps;
 
+/**
+\class ROOT::Internal::RDF::RBulkArrayReader
+\ingroup dataframe
+\brief Reads the values of an array branch a whole basket at a time.
+
+Branches holding a single leaf of basic type, e.g. `px[n]/F` or `v[3]/D`, are read via
+TBranch::GetBulkEntries: the content of a basket is deserialized (byte-swapped) in one pass
+and RColumnValue hands out, for each entry, RVecs that are views over this memory. No copy
+and no allocation takes place per entry.
+**/
+class RBulkArrayReader {
+   TTreeReader *fTreeReader = nullptr;   ///< The reader whose current entry we follow
+   std::string fBranchName;
+   const std::type_info &fValueType;     ///< Type of the array elements requested by the user
+   TTree *fTree = nullptr;               ///< The tree fBranch hangs from, to detect tree switches in TChains
+   Int_t fTreeNumber = -1;
+   TBranch *fBranch = nullptr;
+   std::unique_ptr<TBufferFile> fBuffer; ///< Values of the entries [fFirstEntry, fFirstEntry + fNEntries)
+   std::vector<Int_t> fOffsets;          ///< Byte offset in fBuffer of the values of each entry
+   Long64_t fFirstEntry = -1;
+   Long64_t fNEntries = 0;
+
+   bool SetupBranch();
+
+public:
+   RBulkArrayReader(TTreeReader &r, const std::string &branchName, const std::type_info &valueType);
+   ~RBulkArrayReader();
+   /// Set `values` and `size` to the array of the current entry. Return false if the branch cannot be read in bulk.
+   bool Get(void *&values, std::size_t &size);
+};
+
 /**
 \class ROOT::Internal::RDF::RColumnValue
 \ingroup dataframe
@@ -74,8 +112,12 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    enum class EColumnKind { kTree, kCustomColumn, kDataSource, kInvalid };
    // Set to the correct value by MakeProxy or SetTmpColumn
    EColumnKind fColumnKind = EColumnKind::kInvalid;
-   /// The slot this value belongs to. Only needed when querying custom column values, it is set in `SetTmpColumn`.
+   /// The slot this value belongs to. Only needed when querying custom column values or profiling the reads of Tree
+   /// columns, it is set in `SetTmpColumn` and `MakeProxy`.
    unsigned int fSlot = std::numeric_limits<unsigned int>::max();
+   /// Non-null if the reads of this Tree column are profiled, see RInterface::Profile.
+   RProfiler *fProfiler = nullptr;
+   unsigned int fProfileId = 0;
 
    // Each element of the following stacks will be in use by a _single task_.
    // Each task will push one element when it starts and pop it when it ends.
@@ -98,6 +140,34 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    /// If MustUseRVec, i.e. we are reading an array, we return a reference to this RVec to clients
    RVec<ColumnValue_t> fRVec;
    bool fCopyWarningPrinted = false;
+   /// If not null, array values are read a basket at a time and fRVec is a view over the basket content.
+   std::unique_ptr<RBulkArrayReader> fBulkReader;
+   /// Values of the entries of the current block, copied from the TTree or data source. Only used in bulk mode.
+   std::unique_ptr<T[]> fBulkValues;
+   unsigned int fBulkSize = 0;
+   /// Non-owning ptr to the values of a custom column for the entries of the current block. Only used in bulk mode.
+   T *fCustomBulkValues = nullptr;
+
+   static void LoadBulkValue(void *self, unsigned int idx, Long64_t entry)
+   {
+      auto &value = *static_cast<RColumnValue *>(self);
+      value.fBulkValues[idx] = value.Get(entry);
+   }
+
+   /// Values of fundamental types are copied in fBulkValues by a loader called right after each entry is read.
+   bool EnableBulkImpl(unsigned int bulkSize, std::vector<RBulkLoader> &loaders, std::true_type)
+   {
+      if (fBulkSize != bulkSize) {
+         fBulkValues.reset(new T[bulkSize]);
+         fBulkSize = bulkSize;
+      }
+      if (std::none_of(loaders.begin(), loaders.end(), [this](const RBulkLoader &l) { return l.fColumn == this; }))
+         loaders.push_back({this, &LoadBulkValue});
+      return true;
+   }
+
+   /// Other values, e.g. arrays or objects, are only valid while their entry is the current one: no bulk processing.
+   bool EnableBulkImpl(unsigned int, std::vector<RBulkLoader> &, std::false_type) { return false; }
 
 public:
    RColumnValue(){};
@@ -123,10 +193,16 @@ public:
       fSlot = slot;
    }
 
-   void MakeProxy(TTreeReader *r, const std::string &bn)
+   void MakeProxy(TTreeReader *r, const std::string &bn, unsigned int slot = 0, RProfiler *profiler = nullptr)
    {
       fColumnKind = EColumnKind::kTree;
+      fSlot = slot;
+      const auto profileId = profiler ? profiler->GetColumnId(bn) : -1;
+      fProfiler = profileId < 0 ? nullptr : profiler;
+      fProfileId = profileId < 0 ? 0u : static_cast<unsigned int>(profileId);
       fTreeReader = std::make_unique<TreeReader_t>(*r, bn.c_str());
+      if (MustUseRVec_t::value && !std::is_same<ColumnValue_t, bool>::value)
+         fBulkReader = std::make_unique<RBulkArrayReader>(*r, bn, typeid(ColumnValue_t));
    }
 
    /// This overload is used to return scalar quantities (i.e. types that are not read into a RVec)
@@ -137,6 +213,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope scope(fProfiler, fSlot, fProfileId, fTreeReader.get());
          return *(fTreeReader->Get());
       } else {
          fCustomColumn->Update(fSlot, entry);
@@ -153,6 +230,24 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope scope(fProfiler, fSlot, fProfileId, fTreeReader.get());
+         if (fBulkReader) {
+            void *values = nullptr;
+            std::size_t size = 0;
+            if (fBulkReader->Get(values, size)) {
+               if (size > 0) {
+                  T rvec(static_cast<ColumnValue_t *>(values), size);
+                  swap(fRVec, rvec);
+               } else {
+                  T emptyVec{};
+                  swap(fRVec, emptyVec);
+               }
+               return fRVec;
+            }
+            // the branch cannot be read in bulk: from now on go through the TTreeReaderArray
+            fBulkReader.reset();
+         }
+
          auto &readerArray = *fTreeReader;
          // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
          // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
@@ -220,6 +315,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope scope(fProfiler, fSlot, fProfileId, fTreeReader.get());
          auto &readerArray = *fTreeReader;
          const auto readerArraySize = readerArray.GetSize();
          if (readerArraySize > 0) {
@@ -238,6 +334,29 @@ public:
       }
    }
 
+   /// Prepare this value for bulk processing, in blocks of bulkSize entries, see RLoopManager::SetBulkSize.
+   /// Values read from a TTree or a data source add to `loaders` the function that copies them in the block.
+   /// Return false if the column cannot be read in bulk.
+   bool EnableBulk(unsigned int bulkSize, std::vector<RBulkLoader> &loaders)
+   {
+      if (fColumnKind == EColumnKind::kCustomColumn) {
+         fCustomBulkValues = static_cast<T *>(fCustomColumn->GetBulkValuePtr(fSlot));
+         return true;
+      }
+      return EnableBulkImpl(bulkSize, loaders, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+   }
+
+   /// Return the values of the entries of the block, stored contiguously: the value of the entry at index `i` of the
+   /// block is at index `i` of the array. Only the values of the entries selected by `mask` are guaranteed to be set.
+   /// Only valid in bulk mode, see EnableBulk.
+   T *GetBulk(const RBulkBlock &block, const std::vector<char> &mask)
+   {
+      if (fBulkValues)
+         return fBulkValues.get();
+      fCustomColumn->UpdateBulk(fSlot, block, mask);
+      return fCustomBulkValues;
+   }
+
    void Reset()
    {
       // This method should by all means not be removed, together with all
@@ -249,8 +368,11 @@ public:
       // - Thread #1) first task deletes TTreeReader
       // See https://github.com/root-project/root/commit/26e8ace6e47de6794ac9ec770c3bbff9b7f2e945
       if (EColumnKind::kTree == fColumnKind) {
+         fBulkReader.reset();
          fTreeReader.reset();
       }
+      fBulkValues.reset();
+      fBulkSize = 0;
    }
 };
 
@@ -14,13 +14,18 @@
 #include "ROOT/RDF/NodesUtils.hxx"
 #include "ROOT/RDF/RColumnValue.hxx"
 #include "ROOT/RDF/RCustomColumnBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
 
+#include <algorithm> // std::fill
 #include <deque>
+#include <memory>
+#include <set>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -61,6 +66,10 @@ class RCustomColumn final : public RCustomColumnBase {
    F fExpression;
    const ColumnNames_t fBranches;
    ValuesPerSlot_t fLastResults;
+   /// Per slot, values of the entries of the current block. Only used in bulk mode.
+   std::vector<std::unique_ptr<ret_type[]>> fBulkResults;
+   /// Per slot, the entry each element of fBulkResults was computed for, -1 if none.
+   std::vector<std::vector<Long64_t>> fBulkEntries;
 
    std::vector<RDFInternal::RDFValueTuple_t<ColumnTypes_t>> fValues;
 
@@ -92,11 +101,48 @@ class RCustomColumn final : public RCustomColumnBase {
       (void)entry;
    }
 
+   template <typename... Values>
+   ret_type Eval(unsigned int, Long64_t, NoneTag, Values &... values)
+   {
+      return fExpression(values...);
+   }
+
+   template <typename... Values>
+   ret_type Eval(unsigned int slot, Long64_t, SlotTag, Values &... values)
+   {
+      return fExpression(slot, values...);
+   }
+
+   template <typename... Values>
+   ret_type Eval(unsigned int slot, Long64_t entry, SlotAndEntryTag, Values &... values)
+   {
+      return fExpression(slot, entry, values...);
+   }
+
+   /// Evaluate the expression on the entries of the block selected by `mask` that were not evaluated yet, reading
+   /// the input columns as contiguous arrays.
+   template <std::size_t... S, typename... BranchTypes>
+   void UpdateBulkHelper(unsigned int slot, const RBulkBlock &block, const std::vector<char> &mask,
+                         std::index_sequence<S...>, TypeList<BranchTypes...>)
+   {
+      const auto values = std::make_tuple(std::get<S>(fValues[slot]).GetBulk(block, mask)...);
+      (void)values; // silence "unused variable" warnings in gcc
+      RDFInternal::RProfileScope scope(fProfiler, slot, fProfileId);
+      auto results = fBulkResults[slot].get();
+      auto lastEntries = fBulkEntries[slot].data();
+      for (auto i = 0u; i < block.fSize; ++i) {
+         if (mask[i] && lastEntries[i] != block.fEntries[i]) {
+            results[i] = Eval(slot, block.fEntries[i], ExtraArgsTag{}, std::get<S>(values)[i]...);
+            lastEntries[i] = block.fEntries[i];
+         }
+      }
+   }
+
 public:
    RCustomColumn(RLoopManager *lm, std::string_view name, F &&expression, const ColumnNames_t &bl, unsigned int nSlots,
                  const RDFInternal::RBookedCustomColumns &customColumns, bool isDSColumn = false)
       : RCustomColumnBase(lm, name, nSlots, isDSColumn, customColumns), fExpression(std::forward<F>(expression)),
-        fBranches(bl), fLastResults(fNSlots), fValues(fNSlots)
+        fBranches(bl), fLastResults(fNSlots), fBulkResults(fNSlots), fBulkEntries(fNSlots), fValues(fNSlots)
    {
    }
 
@@ -107,20 +153,39 @@ public:
    {
       // TODO: Each node calls this method for each column it uses. Multiple nodes may share the same columns, and this
       // would lead to this method being called multiple times.
-      RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fCustomColumns, TypeInd_t());
+      RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fCustomColumns, TypeInd_t(), fProfiler);
+      fLoopManager->EnableBulkValues(slot, fValues[slot], TypeInd_t());
+      // values computed in a previous task or event loop are stale
+      std::fill(fBulkEntries[slot].begin(), fBulkEntries[slot].end(), -1);
    }
 
    void *GetValuePtr(unsigned int slot) final { return static_cast<void *>(&fLastResults[slot]); }
 
+   void *GetBulkValuePtr(unsigned int slot) final
+   {
+      const auto bulkSize = fLoopManager->GetBulkSize();
+      if (fBulkEntries[slot].size() != bulkSize) {
+         fBulkResults[slot].reset(new ret_type[bulkSize]);
+         fBulkEntries[slot].assign(bulkSize, -1);
+      }
+      return static_cast<void *>(fBulkResults[slot].get());
+   }
+
    void Update(unsigned int slot, Long64_t entry) final
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         RDFInternal::RProfileScope scope(fProfiler, slot, fProfileId);
          UpdateHelper(slot, entry, TypeInd_t(), ColumnTypes_t(), ExtraArgsTag{});
          fLastCheckedEntry[slot] = entry;
       }
    }
 
+   void UpdateBulk(unsigned int slot, const RBulkBlock &block, const std::vector<char> &mask) final
+   {
+      UpdateBulkHelper(slot, block, mask, TypeInd_t(), ColumnTypes_t());
+   }
+
    const std::type_info &GetTypeId() const
    {
       return fIsDataSourceColumn ? typeid(typename std::remove_pointer<ret_type>::type) : typeid(ret_type);
@@ -132,6 +197,11 @@ public:
       // would lead to this method being called multiple times.
       RDFInternal::ResetRDFValueTuple(fValues[slot], TypeInd_t());
    }
+
+   void AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const final
+   {
+      fCustomColumns.AddDatasetColumns(fBranches, columns, visited);
+   }
 };
 
 } // ns RDF
@@ -13,8 +13,11 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RBulkBlock.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -41,6 +44,8 @@ protected:
    /// Used e.g. to distinguish custom columns with the same name in different branches of the computation graph.
    const unsigned int fID = GetNextID();
    RDFInternal::RBookedCustomColumns fCustomColumns;
+   RDFInternal::RProfiler *fProfiler = nullptr; ///< Non-null during the event loops that are profiled
+   unsigned int fProfileId = 0;                 ///< The id of this custom column in fProfiler
 
    static unsigned int GetNextID();
 
@@ -56,9 +61,16 @@ public:
    RLoopManager *GetLoopManagerUnchecked() const;
    std::string GetName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Compute the values of the entries of the block selected by `mask`, if not done yet. Only used in bulk mode.
+   virtual void UpdateBulk(unsigned int slot, const RBulkBlock &block, const std::vector<char> &mask) = 0;
+   /// Return the array of the values of the entries of the current block. Only used in bulk mode.
+   virtual void *GetBulkValuePtr(unsigned int slot) = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    virtual void InitNode();
+   /// Add to columns the columns of the dataset which this custom column is computed from.
+   virtual void AddDatasetColumns(std::set<std::string> &columns,
+                                  std::set<const RCustomColumnBase *> &visited) const = 0;
    /// Return the unique identifier of this RCustomColumnBase.
    unsigned int GetID() const { return fID; }
 };
@@ -23,7 +23,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -91,20 +93,58 @@ public:
       return fLastResult[slot];
    }
 
+   const std::vector<char> &CheckFiltersBulk(unsigned int slot, const RBulkBlock &block) final
+   {
+      auto &mask = fLastBulkMask[slot];
+      if (block.fId != fLastCheckedBlock[slot]) {
+         const auto &prevMask = fPrevData.CheckFiltersBulk(slot, block);
+         mask.resize(block.fSize);
+         CheckFilterBulkHelper(slot, block, prevMask, mask, TypeInd_t());
+         fLastCheckedBlock[slot] = block.fId;
+      }
+      return mask;
+   }
+
    template <std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
       // silence "unused parameter" warnings in gcc
       (void)slot;
       (void)entry;
+      RDFInternal::RProfileScope scope(fProfiler, slot, fProfileId);
       return fFilter(std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   /// Evaluate the filter on the entries of the block selected by `prevMask`, reading the columns as contiguous arrays.
+   template <std::size_t... S>
+   void CheckFilterBulkHelper(unsigned int slot, const RBulkBlock &block, const std::vector<char> &prevMask,
+                              std::vector<char> &mask, std::index_sequence<S...>)
+   {
+      const auto values = std::make_tuple(std::get<S>(fValues[slot]).GetBulk(block, prevMask)...);
+      (void)values; // silence "unused variable" warnings in gcc
+      RDFInternal::RProfileScope scope(fProfiler, slot, fProfileId);
+      ULong64_t nAccepted = 0;
+      ULong64_t nChecked = 0;
+      for (auto i = 0u; i < block.fSize; ++i) {
+         if (prevMask[i]) {
+            const bool passed = fFilter(std::get<S>(values)[i]...);
+            nAccepted += passed;
+            ++nChecked;
+            mask[i] = passed;
+         } else {
+            mask[i] = 0;
+         }
+      }
+      fAccepted[slot] += nAccepted;
+      fRejected[slot] += nChecked - nAccepted;
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fCustomColumns.GetColumns())
          bookedBranch.second->InitSlot(r, slot);
-      RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fCustomColumns, TypeInd_t());
+      RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fCustomColumns, TypeInd_t(), fProfiler);
+      fLoopManager->EnableBulkValues(slot, fValues[slot], TypeInd_t());
    }
 
    // recursive chain of `Report`s
@@ -149,6 +189,11 @@ public:
       filters.push_back(name);
    }
 
+   void AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const final
+   {
+      fCustomColumns.AddDatasetColumns(fBranches, columns, visited);
+   }
+
    virtual void ClearTask(unsigned int slot) final
    {
       for (auto &column : fCustomColumns.GetColumns()) {
@@ -13,9 +13,12 @@
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDataSource.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -32,6 +35,7 @@ namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
 
 class RLoopManager;
+class RCustomColumnBase;
 
 class RFilterBase : public RNodeBase {
 protected:
@@ -39,10 +43,14 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   std::vector<ULong64_t> fLastCheckedBlock;     ///< Per slot, id of the last block checked in bulk mode
+   std::vector<std::vector<char>> fLastBulkMask; ///< Per slot, result of the filter for the entries of that block
    const std::string fName;
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    RDFInternal::RBookedCustomColumns fCustomColumns;
+   RDFInternal::RProfiler *fProfiler = nullptr; ///< Non-null during the event loops that are profiled
+   unsigned int fProfileId = 0;                 ///< The id of this filter in fProfiler
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -54,6 +62,10 @@ public:
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    bool HasName() const;
    std::string GetName() const;
+   virtual bool HasChildren() const { return fNChildren > 0; }
+   /// Return the cut on a column of the data source which this filter is equivalent to, if it hangs directly from the
+   /// loop manager, null otherwise.
+   virtual const ROOT::RDF::RDataSource::RRangeCut *GetRangeCut() const { return nullptr; }
    virtual void FillReport(ROOT::RDF::RCutFlowReport &) const;
    virtual void TriggerChildrenCount() = 0;
    virtual void ResetReportCount()
@@ -67,6 +79,9 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Add to columns the columns of the dataset which this filter reads, directly or through custom columns.
+   virtual void AddDatasetColumns(std::set<std::string> &columns,
+                                  std::set<const RCustomColumnBase *> &visited) const = 0;
 };
 
 } // ns RDF
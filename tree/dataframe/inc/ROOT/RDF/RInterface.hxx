@@ -19,7 +19,9 @@
 #include "ROOT/RDF/RRange.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RDF/RCacheDS.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
@@ -106,6 +108,9 @@ class RInterface {
    /// Contains the custom columns defined up to this node.
    RDFInternal::RBookedCustomColumns fCustomColumns;
 
+   /// The systematic variations of the dataset at this node, see Vary.
+   std::vector<RDFInternal::RVariation<Proxied>> fVariations;
+
 public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Copy-assignment operator for RInterface.
@@ -148,8 +153,13 @@ public:
    /// Note that it is not a problem to pass RNode's by value.
    operator RNode() const
    {
-      return RNode(std::static_pointer_cast<::ROOT::Detail::RDF::RNodeBase>(fProxiedPtr), *fLoopManager, fCustomColumns,
-                   fDataSource);
+      RNode node(std::static_pointer_cast<::ROOT::Detail::RDF::RNodeBase>(fProxiedPtr), *fLoopManager, fCustomColumns,
+                 fDataSource);
+      for (const auto &variation : fVariations)
+         node.fVariations.push_back({variation.fTag,
+                                     std::static_pointer_cast<::ROOT::Detail::RDF::RNodeBase>(variation.fNode),
+                                     variation.fCustomColumns});
+      return node;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -194,9 +204,16 @@ public:
 
       using F_t = RDFDetail::RFilter<F, Proxied>;
 
+      auto variations =
+         BookVaried<F_t>(validColumnNames, /*dependsOnNode=*/true, [&f, &validColumnNames](RInterface &varied) {
+            return varied.Filter(RDFInternal::CopyForVariation(f), validColumnNames);
+         });
+
       auto filterPtr = std::make_shared<F_t>(std::move(f), validColumnNames, fProxiedPtr, newColumns, name);
       fLoopManager->Book(filterPtr.get());
-      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, newColumns, fDataSource);
+      RInterface<F_t, DS_t> newInterface(std::move(filterPtr), *fLoopManager, newColumns, fDataSource);
+      SetVariedNodes(newInterface, std::move(variations));
+      return newInterface;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -242,6 +259,10 @@ public:
    /// Refer to the first overload of this method for the full documentation.
    RInterface<RDFDetail::RJittedFilter, DS_t> Filter(std::string_view expression, std::string_view name = "")
    {
+      auto variations = BookVaried<RDFDetail::RJittedFilter>(
+         GetColumnsUsedBy(expression), /*dependsOnNode=*/true,
+         [expression](RInterface &varied) { return varied.Filter(expression); });
+
       // deleted by the jitted call to JitFilterHelper
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer<decltype(upcastNodeOnHeap)>::type::element_type;
@@ -253,8 +274,10 @@ public:
                                  fLoopManager->GetID());
 
       fLoopManager->Book(jittedFilter.get());
-      return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fCustomColumns,
-                                                        fDataSource);
+      RInterface<RDFDetail::RJittedFilter, DS_t> newInterface(std::move(jittedFilter), *fLoopManager, fCustomColumns,
+                                                              fDataSource);
+      SetVariedNodes(newInterface, std::move(variations));
+      return newInterface;
    }
 
    // clang-format off
@@ -369,6 +392,10 @@ public:
       RDFInternal::CheckCustomColumn(name, fLoopManager->GetTree(), fCustomColumns.GetNames(),
                                      fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
 
+      auto variations =
+         BookVaried<Proxied>(GetColumnsUsedBy(expression), /*dependsOnNode=*/false,
+                             [name, expression](RInterface &varied) { return varied.Define(name, expression); });
+
       auto jittedCustomColumn =
          std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots());
 
@@ -382,6 +409,7 @@ public:
       fLoopManager->RegisterCustomColumn(jittedCustomColumn.get());
 
       RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      SetVariedColumns(newInterface, std::move(variations), name);
 
       return newInterface;
    }
@@ -418,10 +446,134 @@ public:
 
       newCols.AddName(alias);
       RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      for (const auto &variation : fVariations) {
+         auto variedCols = variation.fCustomColumns;
+         variedCols.AddName(alias);
+         newInterface.fVariations.push_back({variation.fTag, variation.fNode, std::move(variedCols)});
+      }
 
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Declare systematic variations of a column, computed in the same event loop as the nominal results
+   /// \param[in] colName The name of the column to vary: a branch, a data-source column or a custom column.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object returning the
+   /// varied values of the column as a `RVec` (or any container with `size()` and `operator[]`), one per variation.
+   /// \param[in] columns Names of the columns/branches in input to the callable.
+   /// \param[in] variationTags The names of the variations, e.g. `{"down", "up"}`, in the order of the varied values.
+   /// \param[in] variationName The name of this group of variations, the name of the column by default.
+   /// \return the same node of the computation graph, with the variations attached.
+   ///
+   /// Each variation is identified by the tag `variationName:variationTag`. Downstream of this node, every Filter,
+   /// Define, Range and action is also booked for each variation that changes its inputs, directly or through the
+   /// custom columns it reads, on a branch of the computation graph where the varied column takes the varied value:
+   /// nodes and custom columns that do not depend on the varied column are shared with the nominal graph and are
+   /// evaluated once per entry. The results of an action for all the variations are retrieved with
+   /// ROOT::RDF::VariationsFor. The varied values must have the same type as the nominal column. Variations declared by
+   /// different calls to Vary are independent: each varies one column, the others taking their nominal value.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto scaled = df.Vary("pt", [](float pt) { return ROOT::RVec<float>{pt * 0.98f, pt * 1.02f}; }, {"pt"},
+   ///                       {"down", "up"}, "ptScale");
+   /// auto h = scaled.Filter([](float pt) { return pt > 20; }, {"pt"}).Histo1D<float>("pt");
+   /// auto hs = ROOT::RDF::VariationsFor(h); // "nominal", "ptScale:down" and "ptScale:up", filled in one event loop
+   /// ~~~
+   // clang-format on
+   template <typename F, typename std::enable_if<!std::is_convertible<F, std::string>::value, int>::type = 0>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &columns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using Values_t = typename TTraits::CallableTraits<F>::ret_type;
+      using Value_t = typename std::decay<decltype(std::declval<Values_t>()[0])>::type;
+
+      const auto validColName = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const auto tags = MakeVariationTags(variationName.empty() ? validColName : std::string(variationName),
+                                          variationTags);
+
+      // the varied values of each entry are computed once by a hidden custom column, each variation reads its own
+      const auto valuesName = MakeVariationsColumnName();
+      auto withValues = DefineImpl<F, RDFDetail::CustomColExtraArgs::None>(valuesName, std::move(expression), columns);
+
+      const auto nVariations = tags.size();
+      for (auto i = 0u; i < nVariations; ++i) {
+         auto getValue = [i, nVariations](const Values_t &values) -> Value_t {
+            if (values.size() != nVariations)
+               throw std::runtime_error("Vary: the expression returned " + std::to_string(values.size()) +
+                                        " values, but " + std::to_string(nVariations) + " variations were declared.");
+            return values[i];
+         };
+         using VariedCol_t = RDFDetail::RCustomColumn<decltype(getValue), RDFDetail::CustomColExtraArgs::None>;
+         auto variedCols = withValues.fCustomColumns;
+         auto variedColumn = std::make_shared<VariedCol_t>(fLoopManager, validColName, std::move(getValue),
+                                                           ColumnNames_t{valuesName}, fLoopManager->GetNSlots(),
+                                                           withValues.fCustomColumns);
+         fLoopManager->RegisterCustomColumn(variedColumn.get());
+         if (variedCols.HasName(validColName)) {
+            // a custom column: declare the type of its varied version, for future use by jitted nodes
+            RDFInternal::InterpreterDeclareDeferred("namespace __tdf" + std::to_string(fLoopManager->GetID()) +
+                                                    " { using " + validColName +
+                                                    std::to_string(variedColumn->GetID()) + "_type = " +
+                                                    RDFInternal::TypeID2TypeName(typeid(Value_t)) + "; }",
+                                                    *fLoopManager);
+         } else {
+            variedCols.AddName(validColName);
+         }
+         variedCols.AddColumn(variedColumn, validColName);
+         withValues.fVariations.push_back({tags[i], withValues.fProxiedPtr, std::move(variedCols)});
+      }
+
+      return withValues;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Declare systematic variations of a column, computed in the same event loop as the nominal results
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression A C++ expression returning the varied values of the column as a `RVec`, one per variation.
+   /// \param[in] variationTags The names of the variations, in the order of the varied values.
+   /// \param[in] variationName The name of this group of variations, the name of the column by default.
+   /// \return the same node of the computation graph, with the variations attached.
+   ///
+   /// The expression is just-in-time compiled. The name of the column must be a valid C++ variable name.
+   /// Refer to the first overload of this method for the full documentation.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto scaled = df.Vary("pt", "ROOT::RVec<float>{pt * 0.98f, pt * 1.02f}", {"down", "up"}, "ptScale");
+   /// ~~~
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, std::string_view expression,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      const auto validColName = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      if (!RDFInternal::IsValidCppVarName(validColName))
+         throw std::runtime_error("Vary: cannot vary column \"" + validColName +
+                                  "\" with a jitted expression: its name is not a valid C++ variable name.");
+      const auto tags = MakeVariationTags(variationName.empty() ? validColName : std::string(variationName),
+                                          variationTags);
+
+      // the varied values of each entry are computed once by a hidden custom column, each variation reads its own
+      const auto valuesName = MakeVariationsColumnName();
+      auto withValues = Define(valuesName, expression);
+
+      for (auto i = 0u; i < tags.size(); ++i) {
+         auto variedCols = withValues.fCustomColumns;
+         auto variedColumn =
+            std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, validColName, fLoopManager->GetNSlots());
+         RDFInternal::BookDefineJit(validColName, valuesName + ".at(" + std::to_string(i) + ")", *fLoopManager,
+                                    fDataSource, variedColumn, withValues.fCustomColumns,
+                                    fLoopManager->GetBranchNames());
+         fLoopManager->RegisterCustomColumn(variedColumn.get());
+         if (!variedCols.HasName(validColName))
+            variedCols.AddName(validColName);
+         variedCols.AddColumn(variedColumn, validColName);
+         withValues.fVariations.push_back({tags[i], withValues.fProxiedPtr, std::move(variedCols)});
+      }
+
+      return withValues;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -454,6 +606,12 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// #### Writing entries in bulk
+   /// When all the columns written are of arithmetic types other than `bool`, their values are buffered and written
+   /// `RSnapshotOptions::fBulkFillSize` entries at a time (1000 by default) with TTree::FillBulk, which serializes
+   /// whole baskets at once rather than going through TTree::Fill for each entry. The output is the same, baskets
+   /// and clusters included. Setting `fBulkFillSize` to 0 fills the entries one at a time.
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -519,7 +677,7 @@ public:
                << RDFInternal::PrettyPrintAddr(&columnList) << "),"
                << "*reinterpret_cast<ROOT::RDF::RSnapshotOptions*>(" << RDFInternal::PrettyPrintAddr(&options) << "));";
       // jit snapCall, return result
-      auto calcRes = RDFInternal::InterpreterCalc(snapCall.str());
+      auto calcRes = RDFInternal::InterpreterCalc(snapCall.str(), *fLoopManager);
       if (0 != calcRes.second) {
          std::string msg = "Cannot jit Snapshot call. Interpreter error code is " + std::to_string(calcRes.second) + ".";
          throw std::runtime_error(msg);
@@ -594,55 +752,48 @@ public:
       return CacheImpl<ColumnTypes...>(columnList, staticSeq);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, in compressed chunks
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columnList columns to be cached in memory.
+   /// \param[in] options RCacheOptions steering the storage of the cached dataset.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The entries are stored in chunks of at most RCacheOptions::fChunkSize entries. Each chunk is filled by a task
+   /// of the event loop filling the cache and is processed by a task of the event loops of the returned dataframe,
+   /// which therefore run in parallel when implicit multi-threading is enabled.
+   /// The values of columns of arithmetic types and of RVecs of arithmetic types are compressed chunk by chunk, by
+   /// default with LZ4. The chunks which would bring the memory they use beyond RCacheOptions::fMaxMemory bytes are
+   /// moved to a scratch file in RCacheOptions::fSpillDir, deleted together with the cache.
+   /// Values of other types are copied in memory.
+   ///
+   /// The values are uncompressed, chunk by chunk, while processing the returned dataframe: unlike with the other
+   /// overloads, the cached columns are not contiguous in memory.
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      auto staticSeq = std::make_index_sequence<sizeof...(ColumnTypes)>();
+      return CacheImpl<ColumnTypes...>(columnList, options, staticSeq);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
-   {
-      // Early return: if the list of columns is empty, just return an empty RDF
-      // If we proceed, the jitted call will not compile!
-      if (columnList.empty()) {
-         auto nEntries = *this->Count();
-         RInterface<RLoopManager> emptyRDF(std::make_shared<RLoopManager>(nEntries));
-         return emptyRDF;
-      }
-
-      auto tree = fLoopManager->GetTree();
-      const auto nsID = fLoopManager->GetID();
-      std::stringstream cacheCall;
-      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
-      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
-                                                                                      fCustomColumns, fDataSource);
-      // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
-      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
-      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
-                << RDFInternal::PrettyPrintAddr(&resRDF)
-                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
-                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList) { return JitCache(columnList, nullptr); }
 
-      const auto &customCols = fCustomColumns.GetNames();
-      for (auto &c : columnList) {
-         const auto isCustom = std::find(customCols.begin(), customCols.end(), c) != customCols.end();
-         const auto customColID = isCustom ? fCustomColumns.GetColumns()[c]->GetID() : 0;
-         cacheCall << RDFInternal::ColumnName2ColumnTypeName(c, nsID, tree, fDataSource, isCustom,
-                                                             /*vector2rvec=*/true, customColID)
-                   << ", ";
-      };
-      if (!columnList.empty())
-         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
-      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnList) << "));";
-      // jit cacheCall, return result
-      auto calcRes = RDFInternal::InterpreterCalc(cacheCall.str());
-      if (0 != calcRes.second) {
-         std::string msg = "Cannot jit Cache call. Interpreter error code is " + std::to_string(calcRes.second) + ".";
-         throw std::runtime_error(msg);
-      }
-      return resRDF;
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, in compressed chunks
+   /// \param[in] columns to be cached in memory
+   /// \param[in] options RCacheOptions steering the storage of the cached dataset.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// See the previous overloads for more information.
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      return JitCache(columnList, &options);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -663,6 +814,18 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, in compressed chunks
+   /// \param[in] columnNameRegexp The regular expression to match the column names to be selected, see the previous overloads.
+   /// \param[in] options RCacheOptions steering the storage of the cached dataset.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   RInterface<RLoopManager> Cache(std::string_view columnNameRegexp, const RCacheOptions &options)
+   {
+      auto selectedColumns = RDFInternal::ConvertRegexToColumns(fCustomColumns, fLoopManager->GetTree(), fDataSource,
+                                                                columnNameRegexp, "Cache");
+      return Cache(selectedColumns, options);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory.
@@ -675,6 +838,19 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, in compressed chunks
+   /// \param[in] columns to be cached in memory.
+   /// \param[in] options RCacheOptions steering the storage of the cached dataset.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// See the previous overloads for more information.
+   RInterface<RLoopManager> Cache(std::initializer_list<std::string> columnList, const RCacheOptions &options)
+   {
+      ColumnNames_t selectedColumns(columnList);
+      return Cache(selectedColumns, options);
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end)
@@ -684,19 +860,35 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   /// If EnableImplicitMT has been called, the range must be applied directly to the dataset (possibly after Defines,
+   /// but not after Filters or other Ranges) and entries are counted by their number in the dataset: the number of the
+   /// entry in the chain for TTrees, as returned by RDataSource::GetEntryRanges for data sources. The entries selected
+   /// are the same as in a single-thread event loop, while only the entries in the range are read. Ranges cannot be
+   /// used in multi-thread event loops on TTrees with an entry list.
    // clang-format on
    RInterface<RDFDetail::RRange<Proxied>, DS_t> Range(unsigned int begin, unsigned int end, unsigned int stride = 1)
    {
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
+      if (fLoopManager->IsMultiThreaded()) {
+         if (static_cast<RDFDetail::RNodeBase *>(fProxiedPtr.get()) != fLoopManager)
+            throw std::runtime_error("Range: with ImplicitMT enabled, Range can only be applied directly to the "
+                                     "dataset, not after Filters or other Ranges.");
+         auto tree = fLoopManager->GetTree();
+         if (tree && tree->GetEntryList())
+            throw std::runtime_error(
+               "Range: with ImplicitMT enabled, Range cannot be used on a TTree with an entry list.");
+      }
 
       using Range_t = RDFDetail::RRange<Proxied>;
+      auto variations = BookVaried<Range_t>({}, /*dependsOnNode=*/true, [begin, end, stride](RInterface &varied) {
+         return varied.Range(begin, end, stride);
+      });
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
       fLoopManager->Book(rangePtr.get());
       RInterface<RDFDetail::RRange<Proxied>> tdf_r(std::move(rangePtr), *fLoopManager, fCustomColumns, fDataSource);
+      SetVariedNodes(tdf_r, std::move(variations));
       return tdf_r;
    }
 
@@ -829,9 +1021,15 @@ public:
       auto cSPtr = std::make_shared<ULong64_t>(0);
       using Helper_t = RDFInternal::CountHelper;
       using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto variedResults = BookVariedActions(ColumnNames_t{}, cSPtr,
+                                             [](RInterface &varied, const std::shared_ptr<ULong64_t> &) {
+                                                return varied.Count();
+                                             });
       auto action = std::make_unique<Action_t>(Helper_t(cSPtr, nSlots), ColumnNames_t({}), fProxiedPtr, fCustomColumns);
       fLoopManager->Book(action.get());
-      return MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
+      auto resPtr = MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
+      SetVariedResults(resPtr, variedResults);
+      return resPtr;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -1511,6 +1709,45 @@ public:
       return MakeResultPtr(rep, *fLoopManager, std::move(action));
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Measure where the time of the event loop is spent
+   /// \return the resulting `RProfileReport` instance wrapped in a `RResultPtr`.
+   ///
+   /// The event loop that runs this action times all the nodes of the computation graph, whichever node this method
+   /// is called on: the evaluations of the filters, the computations of the custom columns, the executions of the
+   /// actions and the reads of the columns of the dataset. The time of a node excludes the time spent in the nodes
+   /// it triggers. For columns read from a TTree, the compressed bytes of the baskets read are counted too.
+   /// The report also gives the number of entries and the time spent reading and computing in each processing slot,
+   /// and the time span of each task, which can be exported as a Chrome trace with `RProfileReport::AsChromeTrace`.
+   ///
+   /// Timing the nodes has an overhead, the event loops not running this action are not profiled.
+   ///
+   /// This action is *lazy*: upon invocation of
+   /// this method the calculation is booked but not executed. See RResultPtr
+   /// documentation.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto df2 = df.Filter("x > 0").Define("y", "x * x");
+   /// auto h = df2.Histo1D("y");
+   /// auto profile = df2.Profile();
+   /// h->Draw();
+   /// profile->Print();
+   /// ~~~
+   RResultPtr<RProfileReport> Profile()
+   {
+      auto rep = std::make_shared<RProfileReport>();
+      using Helper_t = RDFInternal::ProfileHelper;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+
+      auto action = std::make_unique<Action_t>(Helper_t(rep, fLoopManager), ColumnNames_t({}), fProxiedPtr,
+                                               fCustomColumns);
+
+      fLoopManager->Book(action.get());
+      fLoopManager->EnableProfiling();
+      return MakeResultPtr(rep, *fLoopManager, std::move(action));
+   }
+
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Returns the names of the available columns
    /// \return the container of column names.
@@ -1562,7 +1799,7 @@ public:
          const auto colID = std::to_string(fCustomColumns.GetColumns()[std::string(column)]->GetID());
          const auto call = "ROOT::Internal::RDF::TypeID2TypeName(typeid(__tdf" + std::to_string(fLoopManager->GetID()) +
                            "::" + std::string(column) + colID + "_type))";
-         const auto calcRes = RDFInternal::InterpreterCalc(call.c_str());
+         const auto calcRes = RDFInternal::InterpreterCalc(call, *fLoopManager);
          return *reinterpret_cast<std::string *>(calcRes.first); // copy result to stack
       }
    }
@@ -1729,6 +1966,10 @@ public:
    /// * Result_t &PartialUpdate(unsigned int slot): this method is optional, i.e. can be omitted. If present, it should
    ///   return the value of the partial result of this action for the given 'slot'. Different threads might call this
    ///   method concurrently, but will always pass different 'slot' numbers.
+   /// * void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const ColumnTypes *...columnValues): this
+   ///   method is optional. If present, it is called instead of Exec when entries are processed in blocks (see
+   ///   RDataFrame::SetBulkSize), once per block of `n` entries: the values of the columns for entry `i` of the block
+   ///   are `columnValues[i]...`, and the entry must be processed only if `mask[i]` is not 0.
    /// * std::shared_ptr<Result_t> GetResultPtr() const: return a shared_ptr to the result of this action (of type
    ///   Result_t). The RResultPtr returned by Book will point to this object.
    ///
@@ -1844,7 +2085,7 @@ private:
       // Declare return type to the interpreter, for future use by jitted actions
       auto retTypeDeclaration = "namespace __tdf" + std::to_string(fLoopManager->GetID()) + " { using " + entryColName +
                                 std::to_string(entryColumn->GetID()) + "_type = ULong64_t; }";
-      RDFInternal::InterpreterDeclare(retTypeDeclaration);
+      RDFInternal::InterpreterDeclareDeferred(retTypeDeclaration, *fLoopManager);
 
       // Slot number column
       const auto slotColName = "rdfslot_";
@@ -1864,7 +2105,7 @@ private:
       // Declare return type to the interpreter, for future use by jitted actions
       retTypeDeclaration = "namespace __tdf" + std::to_string(fLoopManager->GetID()) + " { using " + slotColName +
                            std::to_string(slotColumn->GetID()) + "_type = unsigned int; }";
-      RDFInternal::InterpreterDeclare(retTypeDeclaration);
+      RDFInternal::InterpreterDeclareDeferred(retTypeDeclaration, *fLoopManager);
 
       fLoopManager->AddColumnAlias("tdfentry_", entryColName);
       fCustomColumns.AddName("tdfentry_");
@@ -1882,6 +2123,154 @@ private:
       return types;
    }
 
+   /// Return the name of the hidden custom column holding the varied values of a call to Vary. Its "rdf" prefix and "_"
+   /// suffix make it an internal column, see IsInternalColumn, left out of GetColumnNames and GetDefinedColumnNames.
+   std::string MakeVariationsColumnName() const
+   {
+      return "rdfvariations" + std::to_string(fCustomColumns.GetNames().size()) + "_";
+   }
+
+   /// Return the tags of the variations of a call to Vary, checking that they are new.
+   std::vector<std::string> MakeVariationTags(const std::string &variationName, const std::vector<std::string> &tags)
+   {
+      if (tags.empty())
+         throw std::runtime_error("Vary: at least one variation tag must be provided.");
+      std::vector<std::string> fullTags;
+      for (const auto &tag : tags) {
+         auto fullTag = variationName + ":" + tag;
+         const auto isKnown = [&fullTag](const RDFInternal::RVariation<Proxied> &v) { return v.fTag == fullTag; };
+         if (fullTag == "nominal" || std::any_of(fVariations.begin(), fVariations.end(), isKnown) ||
+             std::find(fullTags.begin(), fullTags.end(), fullTag) != fullTags.end())
+            throw std::runtime_error("Vary: variation \"" + fullTag + "\" is already defined.");
+         fullTags.emplace_back(std::move(fullTag));
+      }
+      return fullTags;
+   }
+
+   /// Whether a node reading `columns` must be booked again for a systematic variation: true if the variation changes
+   /// one of the columns or, for nodes that depend on the selection of entries, if it changes the previous node.
+   bool IsVaried(const RDFInternal::RVariation<Proxied> &variation, const ColumnNames_t &columns, bool dependsOnNode)
+   {
+      if (dependsOnNode && variation.fNode != fProxiedPtr)
+         return true;
+      const auto nominalCols = fCustomColumns.GetColumns();
+      const auto variedCols = variation.fCustomColumns.GetColumns();
+      for (const auto &column : columns) {
+         const auto nominal = nominalCols.find(column);
+         const auto varied = variedCols.find(column);
+         const auto nominalPtr = nominal == nominalCols.end() ? nullptr : nominal->second.get();
+         const auto variedPtr = varied == variedCols.end() ? nullptr : varied->second.get();
+         if (nominalPtr != variedPtr)
+            return true;
+      }
+      return false;
+   }
+
+   /// Return the columns read by a jitted expression, aliases resolved. Only needed in presence of variations.
+   ColumnNames_t GetColumnsUsedBy(std::string_view expression)
+   {
+      if (fVariations.empty())
+         return {};
+      const auto &aliasMap = fLoopManager->GetAliasMap();
+      auto columns =
+         RDFInternal::FindUsedColumnNames(expression, fLoopManager->GetBranchNames(), fCustomColumns.GetNames(),
+                                          fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{}, aliasMap);
+      for (auto &column : columns) {
+         const auto alias = aliasMap.find(column);
+         if (alias != aliasMap.end())
+            column = alias->second;
+      }
+      return columns;
+   }
+
+   /// For each systematic variation that changes the inputs of a new node (see IsVaried), book the node on the varied
+   /// branch of the graph with `book`, which takes the RInterface of the branch. The returned variations have a null
+   /// node for the other variations: SetVariedNodes or SetVariedColumns fill them once the nominal node is booked.
+   template <typename NewProxied, typename Book_t>
+   std::vector<RDFInternal::RVariation<NewProxied>>
+   BookVaried(const ColumnNames_t &columns, bool dependsOnNode, Book_t &&book)
+   {
+      std::vector<RDFInternal::RVariation<NewProxied>> variations;
+      variations.reserve(fVariations.size());
+      for (const auto &variation : fVariations) {
+         if (IsVaried(variation, columns, dependsOnNode)) {
+            RInterface varied(variation.fNode, *fLoopManager, variation.fCustomColumns, fDataSource);
+            auto newVaried = book(varied);
+            variations.push_back(
+               {variation.fTag, std::move(newVaried.fProxiedPtr), std::move(newVaried.fCustomColumns)});
+         } else {
+            variations.push_back({variation.fTag, nullptr, variation.fCustomColumns});
+         }
+      }
+      return variations;
+   }
+
+   /// Attach to a new filter or range the variations returned by BookVaried: the unchanged ones share the new node.
+   template <typename NewProxied>
+   static void SetVariedNodes(RInterface<NewProxied, DS_t> &newInterface,
+                              std::vector<RDFInternal::RVariation<NewProxied>> &&variations)
+   {
+      for (auto &variation : variations) {
+         if (!variation.fNode)
+            variation.fNode = newInterface.fProxiedPtr;
+      }
+      newInterface.fVariations = std::move(variations);
+   }
+
+   /// Attach to a new custom column the variations returned by BookVaried: the unchanged ones keep their node and
+   /// share the new column.
+   template <typename NewInterface_t>
+   void SetVariedColumns(NewInterface_t &newInterface, std::vector<RDFInternal::RVariation<Proxied>> &&variations,
+                         std::string_view name)
+   {
+      if (variations.empty())
+         return;
+      const auto newColumn = newInterface.fCustomColumns.GetColumns().at(std::string(name));
+      for (auto i = 0u; i < variations.size(); ++i) {
+         auto &variation = variations[i];
+         if (variation.fNode)
+            continue;
+         variation.fNode = fVariations[i].fNode;
+         variation.fCustomColumns.AddName(name);
+         variation.fCustomColumns.AddColumn(newColumn, name);
+      }
+      newInterface.fVariations = std::move(variations);
+   }
+
+   /// For each systematic variation that changes the inputs of a new action, book the action on the varied branch of
+   /// the graph with `book`, which takes the RInterface of the branch and a copy of the initial value of the result.
+   /// The returned results are null for the other variations. Display does not support variations.
+   template <typename ActionResultType, typename Book_t>
+   std::vector<RResultPtr<ActionResultType>>
+   BookVariedActions(const ColumnNames_t &columns, const std::shared_ptr<ActionResultType> &r, Book_t &&book)
+   {
+      std::vector<RResultPtr<ActionResultType>> variedResults;
+      if (std::is_same<ActionResultType, RDFInternal::RDisplay>::value)
+         return variedResults;
+      variedResults.reserve(fVariations.size());
+      for (const auto &variation : fVariations) {
+         if (IsVaried(variation, columns, /*dependsOnNode=*/true)) {
+            RInterface varied(variation.fNode, *fLoopManager, variation.fCustomColumns, fDataSource);
+            variedResults.emplace_back(book(varied, RDFInternal::MakeVariedResult(r)));
+         } else {
+            variedResults.emplace_back();
+         }
+      }
+      return variedResults;
+   }
+
+   template <typename ActionResultType>
+   void SetVariedResults(RResultPtr<ActionResultType> &resPtr,
+                         const std::vector<RResultPtr<ActionResultType>> &variedResults)
+   {
+      if (variedResults.empty())
+         return;
+      std::vector<std::string> tags;
+      for (const auto &variation : fVariations)
+         tags.emplace_back(variation.fTag);
+      RDFDetail::SetVariedResults(resPtr, tags, variedResults);
+   }
+
    void CheckIMTDisabled(std::string_view callerName)
    {
       if (ROOT::IsImplicitMTEnabled()) {
@@ -1905,10 +2294,17 @@ private:
 
       const auto nSlots = fLoopManager->GetNSlots();
 
+      auto bookVaried = [&validColumnNames](RInterface &varied, const std::shared_ptr<ActionResultType> &variedR) {
+         return varied.template CreateAction<ActionTag, BranchTypes...>(validColumnNames, variedR);
+      };
+      auto variedResults = BookVariedActions(validColumnNames, r, bookVaried);
+
       auto action =
          RDFInternal::BuildAction<BranchTypes...>(validColumnNames, r, nSlots, fProxiedPtr, ActionTag{}, newColumns);
       fLoopManager->Book(action.get());
-      return MakeResultPtr(r, *fLoopManager, std::move(action));
+      auto resPtr = MakeResultPtr(r, *fLoopManager, std::move(action));
+      SetVariedResults(resPtr, variedResults);
+      return resPtr;
    }
 
    // User did not specify type, do type inference
@@ -1924,6 +2320,12 @@ private:
       const auto validColumnNames = GetValidatedColumnNames(realNColumns, columns);
       const unsigned int nSlots = fLoopManager->GetNSlots();
 
+      auto variedResults = BookVariedActions(
+         validColumnNames, r,
+         [&validColumnNames, realNColumns](RInterface &varied, const std::shared_ptr<ActionResultType> &variedR) {
+            return varied.template CreateAction<ActionTag, BranchTypes...>(validColumnNames, variedR, realNColumns);
+         });
+
       auto tree = fLoopManager->GetTree();
       auto rOnHeap = RDFInternal::MakeSharedOnHeap(r);
 
@@ -1939,7 +2341,9 @@ private:
          tree, nSlots, fCustomColumns, fDataSource, jittedActionOnHeap, fLoopManager->GetID());
       fLoopManager->Book(jittedActionOnHeap->get());
       fLoopManager->ToJit(toJit);
-      return MakeResultPtr(r, *fLoopManager, *jittedActionOnHeap);
+      auto resPtr = MakeResultPtr(r, *fLoopManager, *jittedActionOnHeap);
+      SetVariedResults(resPtr, variedResults);
+      return resPtr;
    }
 
    template <typename F, typename CustomColumnType, typename RetType = typename TTraits::CallableTraits<F>::ret_type>
@@ -1959,6 +2363,12 @@ private:
 
       const auto validColumnNames = GetValidatedColumnNames(nColumns, columns);
 
+      auto variations = BookVaried<Proxied>(
+         validColumnNames, /*dependsOnNode=*/false, [name, &expression, &validColumnNames](RInterface &varied) {
+            return varied.template DefineImpl<F, CustomColumnType>(name, RDFInternal::CopyForVariation(expression),
+                                                                   validColumnNames);
+         });
+
       auto newColumns = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
 
       using NewCol_t = RDFDetail::RCustomColumn<F, CustomColumnType>;
@@ -1983,13 +2393,14 @@ private:
       const auto retTypeDeclaration = "namespace __tdf" + std::to_string(fLoopManager->GetID()) + " { " +
                                       retTypeNameFwdDecl + " using " + std::string(name) +
                                       std::to_string(newColumn->GetID()) + "_type = " + retTypeName + "; }";
-      RDFInternal::InterpreterDeclare(retTypeDeclaration);
+      RDFInternal::InterpreterDeclareDeferred(retTypeDeclaration, *fLoopManager);
 
       fLoopManager->RegisterCustomColumn(newColumn.get());
       newCols.AddName(name);
       newCols.AddColumn(newColumn, name);
 
       RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      SetVariedColumns(newInterface, std::move(variations), name);
 
       return newInterface;
    }
@@ -2084,6 +2495,87 @@ private:
       return cachedRDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of cache with options
+   template <typename... BranchTypes, std::size_t... S>
+   RInterface<RLoopManager>
+   CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options, std::index_sequence<S...>)
+   {
+      constexpr bool areCopyConstructible =
+         RDFInternal::TEvalAnd<std::is_copy_constructible<BranchTypes>::value...>::value;
+      static_assert(areCopyConstructible, "Columns of a type which is not copy constructible cannot be cached yet.");
+
+      RDFInternal::CheckTypesAndPars(sizeof...(BranchTypes), columnList.size());
+
+      const auto validColumnNames = GetValidatedColumnNames(columnList.size(), columnList);
+      auto newColumns = CheckAndFillDSColumns(validColumnNames, std::index_sequence_for<BranchTypes...>(),
+                                              TTraits::TypeList<BranchTypes...>());
+
+      using Helper_t = RDFInternal::CacheHelper<BranchTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto store = std::make_shared<RDFInternal::RCacheStore>(options);
+      const auto nSlots = fLoopManager->GetNSlots();
+
+      auto action = std::make_unique<Action_t>(Helper_t(store, nSlots), validColumnNames, fProxiedPtr, newColumns);
+      fLoopManager->Book(action.get());
+      auto storePtr = MakeResultPtr(store, *fLoopManager, std::move(action));
+
+      auto ds = std::make_unique<RDFInternal::RCacheDS<BranchTypes...>>(storePtr, columnList);
+      RInterface<RLoopManager> cachedRDF(std::make_shared<RLoopManager>(std::move(ds), columnList));
+      return cachedRDF;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Jit the call to Cache with the types of the columns, passing the options if not null
+   RInterface<RLoopManager> JitCache(const ColumnNames_t &columnList, const RCacheOptions *options)
+   {
+      // Early return: if the list of columns is empty, just return an empty RDF
+      // If we proceed, the jitted call will not compile!
+      if (columnList.empty()) {
+         auto nEntries = *this->Count();
+         RInterface<RLoopManager> emptyRDF(std::make_shared<RLoopManager>(nEntries));
+         return emptyRDF;
+      }
+
+      auto tree = fLoopManager->GetTree();
+      const auto nsID = fLoopManager->GetID();
+      std::stringstream cacheCall;
+      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
+      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
+                                                                                      fCustomColumns, fDataSource);
+      // build a string equivalent to
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList)[, *(RCacheOptions*)(options)])"
+      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
+      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
+                << RDFInternal::PrettyPrintAddr(&resRDF)
+                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
+                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
+
+      const auto &customCols = fCustomColumns.GetNames();
+      for (auto &c : columnList) {
+         const auto isCustom = std::find(customCols.begin(), customCols.end(), c) != customCols.end();
+         const auto customColID = isCustom ? fCustomColumns.GetColumns()[c]->GetID() : 0;
+         cacheCall << RDFInternal::ColumnName2ColumnTypeName(c, nsID, tree, fDataSource, isCustom,
+                                                             /*vector2rvec=*/true, customColID)
+                   << ", ";
+      };
+      if (!columnList.empty())
+         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
+      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
+                << RDFInternal::PrettyPrintAddr(&columnList) << ")";
+      if (options)
+         cacheCall << ", *reinterpret_cast<const ROOT::RDF::RCacheOptions*>(" << RDFInternal::PrettyPrintAddr(options)
+                   << ")";
+      cacheCall << ");";
+      // jit cacheCall, return result
+      auto calcRes = RDFInternal::InterpreterCalc(cacheCall.str(), *fLoopManager);
+      if (0 != calcRes.second) {
+         std::string msg = "Cannot jit Cache call. Interpreter error code is " + std::to_string(calcRes.second) + ".";
+         throw std::runtime_error(msg);
+      }
+      return resRDF;
+   }
+
 protected:
    RInterface(const std::shared_ptr<Proxied> &proxied, RLoopManager &lm, RDFInternal::RBookedCustomColumns columns,
               RDataSource *ds)
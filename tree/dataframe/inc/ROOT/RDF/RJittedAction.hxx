@@ -39,6 +39,7 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBulk(unsigned int slot, const RBulkBlock &block) final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -48,6 +49,7 @@ public:
    bool HasRun() const final;
    void SetHasRun() final;
    void ClearValueReaders(unsigned int slot) final;
+   void AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
 };
@@ -45,8 +45,11 @@ public:
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
+   void UpdateBulk(unsigned int slot, const RBulkBlock &block, const std::vector<char> &mask) final;
+   void *GetBulkValuePtr(unsigned int slot) final;
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
+   void AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const final;
 };
 
 } // ns RDF
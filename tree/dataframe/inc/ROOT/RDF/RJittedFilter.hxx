@@ -38,15 +38,18 @@ namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 /// at a later time, from jitted code.
 class RJittedFilter final : public RFilterBase {
    std::unique_ptr<RFilterBase> fConcreteFilter = nullptr;
+   std::unique_ptr<ROOT::RDF::RDataSource::RRangeCut> fRangeCut; ///< The cut equivalent to the expression, if any
 
 public:
    RJittedFilter(RLoopManager *lm, std::string_view name);
    ~RJittedFilter() { fLoopManager->Deregister(this); }
 
    void SetFilter(std::unique_ptr<RFilterBase> f);
+   void SetRangeCut(const ROOT::RDF::RDataSource::RRangeCut &cut);
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const std::vector<char> &CheckFiltersBulk(unsigned int slot, const RBulkBlock &block) final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -59,6 +62,9 @@ public:
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void ClearTask(unsigned int slot) final;
+   void AddDatasetColumns(std::set<std::string> &columns, std::set<const RCustomColumnBase *> &visited) const final;
+   bool HasChildren() const final;
+   const ROOT::RDF::RDataSource::RRangeCut *GetRangeCut() const final { return fRangeCut.get(); }
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
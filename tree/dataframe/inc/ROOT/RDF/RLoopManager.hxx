@@ -11,13 +11,18 @@
 #ifndef ROOT_RLOOPMANAGER
 #define ROOT_RLOOPMANAGER
 
+#include "ROOT/RDF/RBulkBlock.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/NodesUtils.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDataSource.hxx"
 
 #include <functional>
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 // forward declarations
@@ -35,6 +40,7 @@ ColumnNames_t GetBranchNames(TTree &t, bool allowDuplicates = true);
 
 class RActionBase;
 class GraphNode;
+struct RDeferredDeclaration;
 
 namespace GraphDrawing {
 class GraphCreatorHelper;
@@ -111,6 +117,9 @@ class RLoopManager : public RNodeBase {
    bool fMustRunNamedFilters{true};
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
    std::string fToJit;        ///< code that should be jitted and executed right before the event loop
+   /// Declarations needed by the jitted code of this computation graph, declared in a single batch before it is jitted.
+   /// Lambdas shared with other graphs appear in the queues of all of them, and are declared by the first batch.
+   std::vector<std::shared_ptr<RDFInternal::RDeferredDeclaration>> fToDeclare;
    const std::unique_ptr<RDataSource> fDataSource; ///< Owning pointer to a data-source object. Null if no data-source
    std::map<std::string, std::string> fAliasColumnNameMap; ///< ColumnNameAlias-columnName pairs
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
@@ -123,18 +132,38 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// Number of entries processed at a time by the nodes of the graph, 0 to process one entry at a time.
+   unsigned int fBulkSize{0};
+   std::vector<std::vector<RDFInternal::RBulkLoader>> fBulkLoaders; ///< Per slot, loaders of the columns read in bulk
+   std::vector<int> fCanRunBulk;                    ///< Per slot, whether all columns can be read in bulk
+   std::vector<std::vector<Long64_t>> fBulkEntries; ///< Per slot, entries of the current block
+   std::vector<ULong64_t> fBulkBlockIds;            ///< Per slot, id of the last block processed
+   std::vector<char> fBulkAllPass;                  ///< A mask selecting all entries of a block
+
+   /// Times the nodes during the event loop if requested with EnableProfiling(), null otherwise.
+   std::unique_ptr<RDFInternal::RProfiler> fProfiler;
+   bool fMustProfile{false};            ///< Whether the next event loop must be profiled
+   unsigned int fDataSourceProfileId{0}; ///< The id of RDataSource::SetEntry in fProfiler
+
    void RunEmptySourceMT();
    void RunEmptySource();
    void RunTreeProcessorMT();
    void RunTreeReader();
    void RunDataSourceMT();
    void RunDataSource();
+   bool SetDataSourceEntry(unsigned int slot, ULong64_t entry);
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void RunAndCheckFiltersBulk(unsigned int slot, const RBulkBlock &block);
+   template <typename NextEntry_t>
+   void RunBulk(unsigned int slot, NextEntry_t &&nextEntry);
+   bool MustRunBulk(unsigned int slot) const { return fBulkSize > 0 && fCanRunBulk[slot]; }
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
+   std::pair<ULong64_t, ULong64_t> GetEntriesBounds() const;
+   std::vector<ROOT::RDF::RDataSource::RRangeCut> GetEntryCuts() const;
    static unsigned int GetNextID();
 
 public:
@@ -145,6 +174,7 @@ public:
    RLoopManager &operator=(const RLoopManager &) = delete;
 
    void BuildJittedNodes();
+   static void BuildJittedNodes(const std::vector<RLoopManager *> &loopManagers);
    RLoopManager *GetLoopManagerUnchecked() final { return this; }
    void Run();
    const ColumnNames_t &GetDefaultColumnNames() const;
@@ -159,7 +189,13 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   const std::vector<char> &CheckFiltersBulk(unsigned int, const RBulkBlock &) final { return fBulkAllPass; }
    unsigned int GetNSlots() const { return fNSlots; }
+   bool IsMultiThreaded() const
+   {
+      return fLoopType == ELoopType::kROOTFilesMT || fLoopType == ELoopType::kNoFilesMT ||
+             fLoopType == ELoopType::kDataSourceMT;
+   }
    bool MustRunNamedFilters() const { return fMustRunNamedFilters; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
@@ -168,10 +204,42 @@ public:
    void IncrChildrenCount() final { ++fNChildren; }
    void StopProcessing() final { ++fNStopsReceived; }
    void ToJit(const std::string &s) { fToJit.append(s); }
+   void ToDeclare(const std::shared_ptr<RDFInternal::RDeferredDeclaration> &d) { fToDeclare.push_back(d); }
+   std::vector<std::shared_ptr<RDFInternal::RDeferredDeclaration>> &GetToDeclare() { return fToDeclare; }
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetID() const { return fID; }
+   void SetBulkSize(unsigned int bulkSize);
+   unsigned int GetBulkSize() const { return fBulkSize; }
+   /// Profile the next event loop, see RInterface::Profile.
+   void EnableProfiling() { fMustProfile = true; }
+   /// Return the profiler of the running event loop, null if it is not profiled.
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler.get(); }
+
+   /// Prepare the column values of a node for bulk processing in the given slot. If any of them cannot be read in
+   /// bulk, the slot processes its entries one at a time.
+   template <typename ValueTuple, std::size_t... S>
+   void EnableBulkValues(unsigned int slot, ValueTuple &values, std::index_sequence<S...>)
+   {
+      if (fBulkSize == 0)
+         return;
+      bool canRunBulk = true;
+      // hack to expand a parameter pack without c++17 fold expressions.
+      std::initializer_list<int> expander{
+         (canRunBulk = std::get<S>(values).EnableBulk(fBulkSize, fBulkLoaders[slot]) && canRunBulk, 0)...};
+      (void)expander; // avoid "unused variable" warnings
+      if (!canRunBulk)
+         fCanRunBulk[slot] = 0;
+   }
+
+   /// Make the given slot process its entries one at a time, e.g. because a node needs the column values of an
+   /// entry to stay at the same address across entries.
+   void DisableBulk(unsigned int slot)
+   {
+      if (fBulkSize > 0)
+         fCanRunBulk[slot] = 0;
+   }
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
@@ -192,6 +260,7 @@ public:
    std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph();
 
    const ColumnNames_t &GetBranchNames();
+   ColumnNames_t GetDatasetColumns() const;
 };
 
 } // ns RDF
@@ -11,6 +11,7 @@
 #ifndef ROOT_RDFNODEBASE
 #define ROOT_RDFNODEBASE
 
+#include "ROOT/RDF/RBulkBlock.hxx"
 #include "RtypesCore.h"
 
 #include <memory>
@@ -48,6 +49,8 @@ public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Bulk version of CheckFilters: return, for each entry of the block, whether it passes all filters.
+   virtual const std::vector<char> &CheckFiltersBulk(unsigned int slot, const RBulkBlock &block) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
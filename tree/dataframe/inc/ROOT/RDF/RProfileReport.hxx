@@ -0,0 +1,94 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+class RProfiler;
+} // End NS RDF
+} // End NS Internal
+
+namespace RDF {
+
+/// The time spent in the nodes of a computation graph during an event loop, as gathered by RInterface::Profile.
+///
+/// Times are in seconds. The time of a node excludes the time spent in the nodes it triggers, e.g. the time of an
+/// action does not include the time spent computing the custom columns it reads or reading its columns from the
+/// dataset, which are accounted to the corresponding nodes.
+class RProfileReport {
+   friend class ROOT::Internal::RDF::RProfiler;
+
+public:
+   enum class ENodeKind {
+      kFilter,    ///< The evaluation of a Filter
+      kDefine,    ///< The computation of a custom column
+      kAction,    ///< The execution of an action on the values of an entry (or of a block of entries)
+      kColumnRead ///< The reading of the values of a column from the dataset
+   };
+
+   struct RNodeInfo {
+      std::string fName;
+      ENodeKind fKind;
+      ULong64_t fCalls; ///< Number of evaluations of the node
+      double fTime;     ///< Time spent in the node, excluding the nodes it triggers
+      /// Compressed bytes of the baskets spanning the entries read, only for columns read from a TTree
+      ULong64_t fBytes;
+   };
+
+   struct RSlotInfo {
+      ULong64_t fTasks;   ///< Number of tasks processed in the slot
+      ULong64_t fEntries; ///< Number of entries processed in the slot
+      double fTaskTime;   ///< Time spent running tasks
+      double fReadTime;   ///< Time spent reading columns from the dataset
+      double GetComputeTime() const { return fTaskTime - fReadTime; }
+   };
+
+   struct RTaskInfo {
+      unsigned int fSlot;
+      double fStart;      ///< Start of the task, since the start of the event loop
+      double fEnd;        ///< End of the task, since the start of the event loop
+      ULong64_t fEntries; ///< Number of entries processed by the task
+      double fReadTime;   ///< Time spent by the task reading columns from the dataset
+   };
+
+private:
+   double fWallTime = 0.;
+   std::vector<RNodeInfo> fNodes;
+   std::vector<RSlotInfo> fSlots;
+   std::vector<RTaskInfo> fTasks;
+
+public:
+   /// Return the duration of the event loop.
+   double GetWallTime() const { return fWallTime; }
+   /// Return the custom columns, the filters and the actions, followed by the columns read from the dataset.
+   const std::vector<RNodeInfo> &GetNodes() const { return fNodes; }
+   const std::vector<RSlotInfo> &GetSlots() const { return fSlots; }
+   /// Return the tasks in the order in which they started.
+   const std::vector<RTaskInfo> &GetTasks() const { return fTasks; }
+   const RNodeInfo &operator[](std::string_view nodeName) const;
+   const RNodeInfo &At(std::string_view nodeName) const { return operator[](nodeName); }
+   void Print() const;
+   std::string AsJSON() const;
+   std::string AsChromeTrace() const;
+};
+
+} // End NS RDF
+
+} // End NS ROOT
+
+#endif
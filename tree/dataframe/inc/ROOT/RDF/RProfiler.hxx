@@ -0,0 +1,142 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDFPROFILER
+#define ROOT_RDFPROFILER
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+class TBranch;
+
+namespace ROOT {
+namespace Internal {
+
+class TTreeReaderValueBase;
+
+namespace RDF {
+
+/// Measures the time spent in the nodes of a computation graph during an event loop, see RInterface::Profile.
+///
+/// Nodes are registered before the event loop starts, from a single thread. During the event loop each slot times
+/// the nodes it runs with Start() and Stop(), which keep a stack of the nodes being run so that the time of a node
+/// excludes the time of the nodes it triggers. The methods taking a slot are only called by the thread holding it.
+class RProfiler {
+public:
+   using ENodeKind = ROOT::RDF::RProfileReport::ENodeKind;
+
+private:
+   using Clock_t = std::chrono::steady_clock;
+
+   struct RNode {
+      std::string fName;
+      ENodeKind fKind;
+   };
+   struct RNodeStats {
+      ULong64_t fCalls = 0;
+      Clock_t::duration fTime{0};
+      ULong64_t fBytes = 0;
+   };
+   struct RFrame {
+      unsigned int fNode;
+      Clock_t::time_point fStart;
+      Clock_t::duration fChildren;
+   };
+   /// The entries of the basket of a branch counted last, so that each basket is counted once
+   struct RBasketRange {
+      const TBranch *fBranch = nullptr;
+      Long64_t fFirst = -1;
+      Long64_t fEnd = -1;
+   };
+   struct RTask {
+      Clock_t::time_point fStart;
+      Clock_t::time_point fEnd;
+      ULong64_t fEntries;
+      Clock_t::duration fReadTime;
+   };
+   struct RSlot {
+      std::vector<RNodeStats> fStats;
+      std::vector<RFrame> fStack;
+      std::vector<RBasketRange> fBaskets; ///< Per node, only used by the nodes reading columns from a TTree
+      std::vector<RTask> fTasks;
+      bool fInTask = false;
+   };
+
+   const Clock_t::time_point fStart = Clock_t::now();
+   std::vector<RNode> fNodes;
+   std::vector<char> fIsRead;                       ///< Per node, whether it reads a column from the dataset
+   std::map<const void *, unsigned int> fNodeIds;   ///< The registered graph nodes
+   std::map<std::string, unsigned int> fColumnIds;  ///< The registered dataset columns
+   std::vector<RSlot> fSlots;
+
+   void CountBytes(RSlot &slot, unsigned int node, TBranch &branch);
+
+public:
+   RProfiler(unsigned int nSlots);
+   RProfiler(const RProfiler &) = delete;
+   RProfiler &operator=(const RProfiler &) = delete;
+
+   unsigned int AddNode(const void *node, ENodeKind kind, const std::string &name);
+   unsigned int AddColumn(const std::string &name);
+   /// Return the id of a dataset column, or -1 if it is not registered.
+   int GetColumnId(const std::string &name) const
+   {
+      const auto it = fColumnIds.find(name);
+      return it == fColumnIds.end() ? -1 : int(it->second);
+   }
+
+   void BeginTask(unsigned int slot);
+   void EndTask(unsigned int slot);
+   void EndTasks();
+   void CountEntries(unsigned int slot, ULong64_t nEntries) { fSlots[slot].fTasks.back().fEntries += nEntries; }
+
+   void Start(unsigned int slot, unsigned int node)
+   {
+      fSlots[slot].fStack.push_back({node, Clock_t::now(), Clock_t::duration(0)});
+   }
+
+   /// Stop timing the node started last in the slot. If value is not null, the node read its value from a TTree, and
+   /// the bytes of the basket read are counted.
+   void Stop(unsigned int slot, const ROOT::Internal::TTreeReaderValueBase *value = nullptr);
+
+   void FillReport(ROOT::RDF::RProfileReport &report) const;
+};
+
+/// Times a node of the computation graph for its lifetime, if profiler is not null.
+class RProfileScope {
+   RProfiler *const fProfiler;
+   const unsigned int fSlot;
+   const ROOT::Internal::TTreeReaderValueBase *const fValue;
+
+public:
+   RProfileScope(RProfiler *profiler, unsigned int slot, unsigned int node,
+                 const ROOT::Internal::TTreeReaderValueBase *value = nullptr)
+      : fProfiler(profiler), fSlot(slot), fValue(value)
+   {
+      if (fProfiler)
+         fProfiler->Start(fSlot, node);
+   }
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+   ~RProfileScope()
+   {
+      if (fProfiler)
+         fProfiler->Stop(fSlot, fValue);
+   }
+};
+
+} // End NS RDF
+} // End NS Internal
+} // End NS ROOT
+
+#endif
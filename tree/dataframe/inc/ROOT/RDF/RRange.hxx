@@ -48,9 +48,14 @@ public:
    // otherwise if fPrevDataFrame is fLoopManager we get a use after delete
    ~RRange() { fLoopManager->Deregister(this); }
 
-   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
+   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process.
+   /// In multi-thread event loops entries are processed in no particular order: the range then hangs directly from
+   /// the RLoopManager and selects entries by their number in the dataset, which needs no state shared among slots.
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (fIsMT)
+         return fPrevData.CheckFilters(slot, entry) && IsInRange(entry + 1);
+
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -60,11 +65,7 @@ public:
          } else {
             // apply range filter logic, cache the result
             ++fNProcessedEntries;
-            if (fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
-                (fStride != 1 && fNProcessedEntries % fStride != 0))
-               fLastResult = false;
-            else
-               fLastResult = true;
+            fLastResult = IsInRange(fNProcessedEntries);
             if (fNProcessedEntries == fStop) {
                fHasStopped = true;
                fPrevData.StopProcessing();
@@ -75,6 +76,35 @@ public:
       return fLastResult;
    }
 
+   /// Bulk version of CheckFilters
+   const std::vector<char> &CheckFiltersBulk(unsigned int slot, const RBulkBlock &block) final
+   {
+      auto &mask = fLastBulkMask[slot];
+      if (block.fId != fLastCheckedBlock[slot]) {
+         mask.assign(block.fSize, 0);
+         if (fIsMT) {
+            const auto &prevMask = fPrevData.CheckFiltersBulk(slot, block);
+            for (auto i = 0u; i < block.fSize; ++i)
+               mask[i] = prevMask[i] && IsInRange(block.fEntries[i] + 1);
+         } else if (!fHasStopped) {
+            const auto &prevMask = fPrevData.CheckFiltersBulk(slot, block);
+            for (auto i = 0u; i < block.fSize && !fHasStopped; ++i) {
+               if (!prevMask[i])
+                  continue;
+               // apply range filter logic
+               ++fNProcessedEntries;
+               mask[i] = IsInRange(fNProcessedEntries);
+               if (fNProcessedEntries == fStop) {
+                  fHasStopped = true;
+                  fPrevData.StopProcessing();
+               }
+            }
+         }
+         fLastCheckedBlock[slot] = block.fId;
+      }
+      return mask;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
@@ -14,6 +14,8 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
+#include <vector>
+
 namespace ROOT {
 
 // fwd decl
@@ -36,11 +38,20 @@ protected:
    unsigned int fStride;
    Long64_t fLastCheckedEntry{-1};
    bool fLastResult{true};
+   std::vector<ULong64_t> fLastCheckedBlock;     ///< Per slot, id of the last block checked in bulk mode
+   std::vector<std::vector<char>> fLastBulkMask; ///< Per slot, result of the range for the entries of that block
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   /// True if the event loop is multi-thread: entries are then selected by their number in the dataset
+   const bool fIsMT;
 
    void ResetCounters();
+   /// Whether the k-th entry reaching this node, counting from 1, is part of the range
+   bool IsInRange(ULong64_t k) const
+   {
+      return !(k <= fStart || (fStop > 0 && k > fStop) || (fStride != 1 && k % fStride != 0));
+   }
 
 public:
    RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
@@ -50,6 +61,9 @@ public:
    virtual ~RRangeBase();
 
    void InitNode() { ResetCounters(); }
+   unsigned int GetStart() const { return fStart; }
+   unsigned int GetStop() const { return fStop; }
+   bool HasChildren() const { return fNChildren > 0; }
    virtual std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph() = 0;
 };
 
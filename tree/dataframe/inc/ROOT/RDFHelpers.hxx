@@ -15,6 +15,7 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RResultHandle.hxx>
 #include <ROOT/RIntegerSequence.hxx>
 #include <ROOT/TypeTraits.hxx>
 
@@ -146,6 +147,13 @@ RNode AsRNode(NodeType node)
    return node;
 }
 
+// clang-format off
+/// Trigger the event loops of the computation graphs of several results at once, see the definition for details.
+/// \param[in] handles the results, of any type, whose computation graphs must run
+/// \return the number of event loops run
+// clang-format on
+unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
 } // namespace RDF
 } // namespace ROOT
 #endif
@@ -111,6 +111,13 @@ protected:
    virtual std::string AsString() { return "generic data source"; };
 
 public:
+   /// A cut on the values of a column of the dataset: the entries whose value is outside [fMin, fMax] fail it.
+   struct RRangeCut {
+      std::string fColumn;
+      double fMin;
+      double fMax;
+   };
+
    virtual ~RDataSource() = default;
 
    // clang-format off
@@ -156,7 +163,8 @@ public:
    // clang-format off
    /// \brief Return ranges of entries to distribute to tasks.
    /// They are required to be contiguous intervals with no entries skipped. Supposing a dataset with nEntries, the
-   /// intervals must start at 0 and end at nEntries, e.g. [0-5],[5-10] for 10 entries.
+   /// intervals must start at 0 and end at nEntries, e.g. [0-5],[5-10] for 10 entries. The only entries which can be
+   /// skipped are the ones known to fail all the cuts passed to SetEntryCuts().
    /// This function will be invoked repeatedly by RDataFrame as it needs additional entries to process.
    /// The same entry range should not be returned more than once.
    /// Returning an empty collection of ranges signals to RDataFrame that the processing can stop.
@@ -174,6 +182,15 @@ public:
    // clang-format on
    virtual bool SetEntry(unsigned int slot, ULong64_t entry) = 0;
 
+   // clang-format off
+   /// \brief Inform the data source that the event loop only needs the entries passing at least one of the cuts.
+   /// \param[in] cuts The cuts, empty if all entries are needed
+   /// Called before each event-loop, before Initialise(). Data sources which can tell, e.g. from statistics stored with
+   /// the dataset, that a part of the dataset fails all the cuts can leave it out of the entry ranges. They do not need
+   /// to check the cuts entry by entry: RDataFrame still does.
+   // clang-format on
+   virtual void SetEntryCuts(const std::vector<RRangeCut> & /*cuts*/) {}
+
    // clang-format off
    /// \brief Convenience method called before starting an event-loop.
    /// This method might be called multiple times over the lifetime of a RDataSource, since
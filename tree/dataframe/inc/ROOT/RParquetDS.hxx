@@ -0,0 +1,83 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPARQUETDS
+#define ROOT_RPARQUETDS
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDataSource.hxx"
+
+#include <memory>
+
+namespace arrow {
+class Schema;
+}
+
+namespace parquet {
+namespace arrow {
+class FileReader;
+}
+}
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+class TValueGetter;
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+class RParquetDS final : public RDataSource {
+private:
+   std::string fFileName;
+   /// One reader of the file per slot, so that the slots read their row groups concurrently
+   std::vector<std::unique_ptr<parquet::arrow::FileReader>> fReaders;
+   std::shared_ptr<arrow::Schema> fSchema;
+   std::vector<std::string> fColumnNames;
+   std::vector<int> fColumnIndices;            ///< Per column, the index of its values in the Parquet schema
+   std::vector<ULong64_t> fRowGroupFirstEntry; ///< The first entry of each row group, then the number of entries
+   std::vector<RRangeCut> fCuts;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+   size_t fNSlots = 0U;
+   std::vector<int> fRowGroupPerSlot; ///< Per slot, the row group read, -1 if none
+   /// Per column, the getter of its values, null if the column is not read
+   std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters;
+
+   std::unique_ptr<parquet::arrow::FileReader> OpenFile() const;
+   size_t GetColumnIndex(std::string_view colName) const;
+   bool MayPassCuts(int rowGroup) const;
+   void ReadRowGroup(unsigned int slot, ULong64_t entry);
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+
+public:
+   RParquetDS(std::string_view fileName, std::vector<std::string> const &columns = {});
+   ~RParquetDS();
+   const std::vector<std::string> &GetColumnNames() const override;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
+   std::string GetTypeName(std::string_view colName) const override;
+   bool HasColumn(std::string_view colName) const override;
+   bool SetEntry(unsigned int slot, ULong64_t entry) override;
+   void FinaliseSlot(unsigned int slot) override;
+   void SetNSlots(unsigned int nSlots) override;
+   void SetEntryCuts(const std::vector<RRangeCut> &cuts) override;
+   void Initialise() override;
+   std::string GetLabel() override;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame reading a Apache Parquet file.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the names of the columns to use, all the columns if empty.
+RDataFrame MakeParquetDataFrame(std::string_view fileName, std::vector<std::string> const &columns = {});
+
+} // namespace RDF
+
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,104 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRESULTHANDLE
+#define ROOT_RRESULTHANDLE
+
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+
+#include <memory>
+#include <sstream>
+#include <typeinfo>
+#include <stdexcept> // std::runtime_error
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+class RResultHandle;
+unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+/**
+\class ROOT::RDF::RResultHandle
+\ingroup dataframe
+\brief A type-erased version of RResultPtr, e.g. to collect the results of computation graphs of different types.
+
+RResultHandle is used by RunGraphs to trigger the event loops of several computation graphs at once. The wrapped result
+is accessed with GetValue, which triggers the event loop of its computation graph if needed, like RResultPtr does.
+~~~{.cpp}
+std::vector<ROOT::RDF::RResultHandle> handles{df1.Count(), df2.Histo1D<float>("x")};
+ROOT::RDF::RunGraphs(handles);
+auto h = handles[1].GetValue<TH1D>();
+~~~
+*/
+class RResultHandle {
+   /// Non-owning pointer to the RLoopManager at the root of the computation graph of the result
+   RDFDetail::RLoopManager *fLoopManager = nullptr;
+   std::shared_ptr<void> fObjPtr; ///< Type-erased shared pointer to the wrapped result
+   /// Owning pointer to the action that produces the result, shared with the RResultPtr
+   std::shared_ptr<RDFInternal::RActionBase> fActionPtr;
+   const std::type_info *fType = nullptr; ///< The type of the wrapped result
+
+   friend unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+   /// Get the pointer to the wrapped result, triggering the event loop if needed.
+   void *Get()
+   {
+      if (!fActionPtr->HasRun())
+         fLoopManager->Run();
+      return fObjPtr.get();
+   }
+
+   /// Throw if T is not the type of the wrapped result.
+   template <typename T>
+   void CheckType() const
+   {
+      if (typeid(T) != *fType) {
+         std::stringstream ss;
+         ss << "Got the type " << RDFInternal::TypeID2TypeName(typeid(T))
+            << " but the RResultHandle refers to a result of type " << RDFInternal::TypeID2TypeName(*fType) << ".";
+         throw std::runtime_error(ss.str());
+      }
+   }
+
+public:
+   template <typename T>
+   RResultHandle(const RResultPtr<T> &resultPtr)
+      : fLoopManager(resultPtr.fLoopManager), fObjPtr(resultPtr.fObjPtr), fActionPtr(resultPtr.fActionPtr),
+        fType(&typeid(T))
+   {
+   }
+
+   RResultHandle(const RResultHandle &) = default;
+   RResultHandle(RResultHandle &&) = default;
+   RResultHandle &operator=(const RResultHandle &) = default;
+   RResultHandle &operator=(RResultHandle &&) = default;
+
+   /// Get the wrapped result, triggering the event loop of its computation graph if it did not run yet.
+   /// Throws if T is not the type of the result.
+   template <typename T>
+   const T &GetValue()
+   {
+      CheckType<T>();
+      return *static_cast<T *>(Get());
+   }
+
+   /// Whether the event loop producing the result has already run.
+   bool IsReady() const { return fActionPtr->HasRun(); }
+
+   bool operator==(const RResultHandle &rhs) const { return fObjPtr == rhs.fObjPtr; }
+   bool operator!=(const RResultHandle &rhs) const { return fObjPtr != rhs.fObjPtr; }
+};
+
+} // ns RDF
+} // ns ROOT
+
+#endif // ROOT_RRESULTHANDLE
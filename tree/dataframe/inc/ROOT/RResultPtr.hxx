@@ -16,8 +16,11 @@
 #include "ROOT/TypeTraits.hxx"
 #include "TError.h" // Warning
 
+#include <map>
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -33,6 +36,8 @@ namespace RDF {
 template <typename T>
 class RResultPtr;
 
+class RResultHandle;
+
 } // ns RDF
 
 namespace Detail {
@@ -42,6 +47,9 @@ using ROOT::RDF::RResultPtr;
 template <typename T>
 RResultPtr<T> MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &df,
                             std::shared_ptr<ROOT::Internal::RDF::RActionBase> actionPtr);
+template <typename T>
+void SetVariedResults(RResultPtr<T> &resPtr, const std::vector<std::string> &tags,
+                      const std::vector<RResultPtr<T>> &variedResults);
 } // ns RDF
 } // ns Detail
 namespace RDF {
@@ -92,9 +100,16 @@ class RResultPtr {
    friend bool operator!=(const RResultPtr<T1> &lhs, std::nullptr_t rhs);
    template <class T1>
    friend bool operator!=(std::nullptr_t lhs, const RResultPtr<T1> &rhs);
+   template <typename T1>
+   friend void RDFDetail::SetVariedResults(RResultPtr<T1> &, const std::vector<std::string> &,
+                                           const std::vector<RResultPtr<T1>> &);
+   template <typename T1>
+   friend std::map<std::string, RResultPtr<T1>> VariationsFor(const RResultPtr<T1> &resPtr);
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
 
+   friend class RResultHandle;
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
@@ -118,6 +133,9 @@ class RResultPtr {
    /// Owning pointer to the action that will produce this result.
    /// Ownership is shared with other copies of this ResultPtr.
    std::shared_ptr<RDFInternal::RActionBase> fActionPtr;
+   /// Results of the same action for each systematic variation of its inputs, see VariationsFor.
+   /// Null if the action does not depend on systematic variations.
+   std::shared_ptr<const std::map<std::string, RResultPtr<T>>> fVariedResults;
 
    /// Triggers the event loop in the RLoopManager
    void TriggerRun();
@@ -334,10 +352,43 @@ bool operator!=(std::nullptr_t lhs, const RResultPtr<T1> &rhs)
    return lhs != rhs.fObjPtr;
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// \brief Return the results of an action for each systematic variation of the dataset, see RInterface::Vary.
+/// \param[in] resPtr The result of an action booked downstream of the varied columns.
+/// \return a map from the variation tags to the corresponding results, plus the nominal result under "nominal".
+///
+/// Variations that do not change the inputs of the action share the nominal result. Results of actions that do not
+/// support systematic variations (only the histograms, graphs, profiles, `Fill`, `Min`, `Max`, `Mean`, `StdDev`,
+/// `Sum` and `Count` do), or booked on nodes without variations, only contain the nominal result.
+/// As for the nominal result, accessing any of the varied ones triggers the event loop, which produces all of them.
+template <typename T>
+std::map<std::string, RResultPtr<T>> VariationsFor(const RResultPtr<T> &resPtr)
+{
+   std::map<std::string, RResultPtr<T>> results;
+   if (resPtr.fVariedResults)
+      results = *resPtr.fVariedResults;
+   results["nominal"] = resPtr;
+   return results;
+}
+
 } // end NS RDF
 
 namespace Detail {
 namespace RDF {
+/// Attach to resPtr the results of the same action for the systematic variations with the given tags. A null
+/// varied result means that the variation does not change the inputs of the action: the nominal result is used.
+template <typename T>
+void SetVariedResults(RResultPtr<T> &resPtr, const std::vector<std::string> &tags,
+                      const std::vector<RResultPtr<T>> &variedResults)
+{
+   if (tags.empty())
+      return;
+   auto results = std::make_shared<std::map<std::string, RResultPtr<T>>>();
+   for (auto i = 0u; i < tags.size(); ++i)
+      (*results)[tags[i]] = variedResults[i] ? variedResults[i] : resPtr;
+   resPtr.fVariedResults = std::move(results);
+}
+
 /// Create a RResultPtr and set its pointer to the corresponding RAction
 /// This overload is invoked by non-jitted actions, as they have access to RAction before constructing RResultPtr.
 template <typename T>
@@ -35,6 +35,9 @@ struct RSnapshotOptions {
    int fAutoFlush = 0;                         ///< AutoFlush value for output tree
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Delay the snapshot of the dataset
+   /// Number of entries written at once with TTree::FillBulk when all columns are of arithmetic types other than
+   /// bool; 0 writes the entries one at a time with TTree::Fill
+   int fBulkFillSize = 1000;
 };
 } // ns RDF
 } // ns ROOT
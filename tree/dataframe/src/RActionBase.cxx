@@ -16,5 +16,14 @@ using namespace ROOT::Internal::RDF;
 RActionBase::RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RBookedCustomColumns &customColumns)
    : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fCustomColumns(customColumns) { }
 
+////////////////////////////////////////////////////////////////////////////
+/// Add to columns the columns of the dataset which this action reads, directly or through custom columns.
+/// The columns read by the upstream filters are not added.
+void RActionBase::AddDatasetColumns(std::set<std::string> &columns,
+                                    std::set<const RCustomColumnBase *> &visited) const
+{
+   fCustomColumns.AddDatasetColumns(fColumnNames, columns, visited);
+}
+
 // outlined to pin virtual table
 RActionBase::~RActionBase() {}
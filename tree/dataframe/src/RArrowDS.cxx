@@ -17,12 +17,20 @@ The RArrowDS implements a proxy RDataSource to be able to use Apache Arrow
 tables with RDataFrame.
 
 A RDataFrame that adapts an arrow::Table class can be constructed using the factory method
-ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
-1. An arrow::Table smart pointer.
+ROOT::RDF::MakeArrowDataFrame, which accepts two parameters:
+1. An arrow::Table smart pointer, or the path of a file in the Arrow IPC file format (Feather V2).
+2. The names of the columns to use, all the columns if empty.
 
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+Each task of the event loop processes whole record batches: the entry ranges follow the boundaries of the chunks of
+the table (a table made of a single chunk is split in one range per slot). Files are memory-mapped and their record
+batches are read lazily, one per slot at a time, so that only the batches being processed are held in memory.
+The values of the numeric columns and of the elements of the list columns, exposed as RVecs, are not copied: they
+point directly into the Arrow buffers. The values of boolean and string columns, which Arrow does not store as
+such, are copied.
+
 */
 // clang-format on
 
@@ -31,6 +39,8 @@ arrow::Schema.
 #include <ROOT/RArrowDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
 
+#include "RArrowUtils.hxx"
+
 #include <algorithm>
 #include <sstream>
 #include <string>
@@ -40,349 +50,24 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
-#include <arrow/table.h>
-#include <arrow/stl.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
 
 namespace ROOT {
-namespace Internal {
-namespace RDF {
-
-// This is needed by Arrow 0.12.0 which dropped 
-//
-//      using ArrowType = ArrowType_;
-//
-// from ARROW_STL_CONVERSION
-template <typename T>
-struct RootConversionTraits {};
-
-#define ROOT_ARROW_STL_CONVERSION(c_type, ArrowType_)  \
-   template <>                                         \
-   struct RootConversionTraits<c_type> {               \
-   using ArrowType = ::arrow::ArrowType_;              \
-   };
-
-ROOT_ARROW_STL_CONVERSION(bool, BooleanType)
-ROOT_ARROW_STL_CONVERSION(int8_t, Int8Type)
-ROOT_ARROW_STL_CONVERSION(int16_t, Int16Type)
-ROOT_ARROW_STL_CONVERSION(int32_t, Int32Type)
-ROOT_ARROW_STL_CONVERSION(int64_t, Int64Type)
-ROOT_ARROW_STL_CONVERSION(uint8_t, UInt8Type)
-ROOT_ARROW_STL_CONVERSION(uint16_t, UInt16Type)
-ROOT_ARROW_STL_CONVERSION(uint32_t, UInt32Type)
-ROOT_ARROW_STL_CONVERSION(uint64_t, UInt64Type)
-ROOT_ARROW_STL_CONVERSION(float, FloatType)
-ROOT_ARROW_STL_CONVERSION(double, DoubleType)
-ROOT_ARROW_STL_CONVERSION(std::string, StringType)
-
-// Per slot visitor of an Array.
-class ArrayPtrVisitor : public ::arrow::ArrayVisitor {
-private:
-   /// The pointer to update.
-   void **fResult;
-   bool fCachedBool{false}; // Booleans need to be unpacked, so we use a cached entry.
-   // FIXME: I should really use a variant here
-   RVec<float> fCachedRVecFloat;
-   RVec<double> fCachedRVecDouble;
-   RVec<ULong64_t> fCachedRVecULong64;
-   RVec<UInt_t> fCachedRVecUInt;
-   RVec<Long64_t> fCachedRVecLong64;
-   RVec<Int_t> fCachedRVecInt;
-   std::string fCachedString;
-   /// The entry in the array which should be looked up.
-   ULong64_t fCurrentEntry;
-
-   template <typename T>
-   void *getTypeErasedPtrFrom(arrow::ListArray const &array, int32_t entry, RVec<T> &cache)
-   {
-      using ArrowType = typename RootConversionTraits<T>::ArrowType;
-      using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
-      auto values = reinterpret_cast<ArrayType *>(array.values().get());
-      auto offset = array.value_offset(entry);
-      RVec<T> tmp(const_cast<T *>(values->raw_values()) + offset, array.value_length(entry));
-      cache.swap(tmp);
-      return (void *)(&cache);
-   }
-
-public:
-   ArrayPtrVisitor(void **result) : fResult{result}, fCurrentEntry{0} {}
-
-   void SetEntry(ULong64_t entry) { fCurrentEntry = entry; }
-
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::Int32Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::Int64Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::UInt32Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::UInt64Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::FloatArray const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::DoubleArray const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::BooleanArray const &array) final
-   {
-      fCachedBool = array.Value(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedBool);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::StringArray const &array) final
-   {
-      fCachedString = array.GetString(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedString);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::ListArray const &array) final
-   {
-      switch (array.value_type()->id()) {
-      case arrow::Type::FLOAT: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecFloat);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::DOUBLE: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecDouble);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecUInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecULong64);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecLong64);
-         return arrow::Status::OK();
-      }
-      default: return arrow::Status::TypeError("Type not supported");
-      }
-   }
-
-   using ::arrow::ArrayVisitor::Visit;
-};
-
-/// Helper class which keeps track for each slot where to get the entry.
-class TValueGetter {
-private:
-   std::vector<void *> fValuesPtrPerSlot;
-   std::vector<ULong64_t> fLastEntryPerSlot;
-   std::vector<ULong64_t> fLastChunkPerSlot;
-   std::vector<ULong64_t> fFirstEntryPerChunk;
-   std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
-   /// Since data can be chunked in different arrays we need to construct an
-   /// index which contains the first element of each chunk, so that we can
-   /// quickly move to the correct chunk.
-   std::vector<ULong64_t> fChunkIndex;
-   arrow::ArrayVector fChunks;
-
-public:
-   TValueGetter(size_t slots, arrow::ArrayVector chunks)
-      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots, 0), fLastChunkPerSlot(slots, 0), fChunks{chunks}
-   {
-      fChunkIndex.reserve(fChunks.size());
-      size_t next = 0;
-      for (auto &chunk : chunks) {
-         fFirstEntryPerChunk.push_back(next);
-         next += chunk->length();
-         fChunkIndex.push_back(next);
-      }
-      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
-         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
-      }
-   }
-
-   /// This returns the ptr to the ptr to actual data.
-   std::vector<void *> SlotPtrs()
-   {
-      std::vector<void *> result;
-      for (size_t i = 0; i < fValuesPtrPerSlot.size(); ++i) {
-         result.push_back(fValuesPtrPerSlot.data() + i);
-      }
-      return result;
-   }
-
-   // Convenience method to avoid code duplication between
-   // SetEntry and InitSlot
-   void UncachedSlotLookup(unsigned int slot, ULong64_t entry)
-   {
-      // If entry is greater than the previous one,
-      // we can skip all the chunks before the last one we
-      // queried.
-      size_t ci = 0;
-      assert(slot < fLastChunkPerSlot.size());
-      if (fLastEntryPerSlot[slot] < entry) {
-         ci = fLastChunkPerSlot.at(slot);
-      }
-
-      for (size_t ce = fChunkIndex.size(); ci != ce; ++ci) {
-         if (entry < fChunkIndex[ci]) {
-            assert(slot < fLastChunkPerSlot.size());
-            fLastChunkPerSlot[slot] = ci;
-            break;
-         }
-      }
-
-      // Update the pointer to the requested entry.
-      // Notice that we need to find the entry
-      auto chunk = fChunks.at(fLastChunkPerSlot[slot]);
-      assert(slot < fArrayVisitorPerSlot.size());
-      fArrayVisitorPerSlot[slot].SetEntry(entry - fFirstEntryPerChunk[fLastChunkPerSlot[slot]]);
-      auto status = chunk->Accept(fArrayVisitorPerSlot.data() + slot);
-      if (!status.ok()) {
-         std::string msg = "Could not get pointer for slot ";
-         msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
-         throw std::runtime_error(msg);
-      }
-   }
-
-   /// Set the current entry to be retrieved
-   void SetEntry(unsigned int slot, ULong64_t entry)
-   {
-      // Same entry as before
-      if (fLastEntryPerSlot[slot] == entry) {
-         return;
-      }
-      UncachedSlotLookup(slot, entry);
-   }
-};
-
-} // namespace RDF
-} // namespace Internal
 
 namespace RDF {
 
-/// Helper to get the contents of a given column
-
-/// Helper to get the human readable name of type
-class RDFTypeNameGetter : public ::arrow::TypeVisitor {
-private:
-   std::vector<std::string> fTypeName;
-
-public:
-   arrow::Status Visit(const arrow::Int64Type &) override
-   {
-      fTypeName.push_back("Long64_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::Int32Type &) override
-   {
-      fTypeName.push_back("Int_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::UInt64Type &) override
-   {
-      fTypeName.push_back("ULong64_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::UInt32Type &) override
-   {
-      fTypeName.push_back("UInt_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::FloatType &) override
-   {
-      fTypeName.push_back("float");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::DoubleType &) override
-   {
-      fTypeName.push_back("double");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::StringType &) override
-   {
-      fTypeName.push_back("string");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::BooleanType &) override
-   {
-      fTypeName.push_back("bool");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::ListType &l) override
-   {
-      /// Recursively visit List types and map them to
-      /// an RVec. We accumulate the result of the recursion on
-      /// fTypeName so that we can create the actual type
-      /// when the recursion is done.
-      fTypeName.push_back("ROOT::VecOps::RVec<%s>");
-      return l.value_type()->Accept(this);
-   }
-   std::string result()
-   {
-      // This recursively builds a nested type.
-      std::string result = "%s";
-      char buffer[8192];
-      for (size_t i = 0; i < fTypeName.size(); ++i) {
-         snprintf(buffer, 8192, result.c_str(), fTypeName[i].c_str());
-         result = buffer;
-      }
-      return result;
-   }
-
-   using ::arrow::TypeVisitor::Visit;
-};
-
-/// Helper to determine if a given Column is a supported type.
-class VerifyValidColumnType : public ::arrow::TypeVisitor {
-private:
-public:
-   virtual arrow::Status Visit(const arrow::Int64Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::UInt64Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::Int32Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::UInt32Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::FloatType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::DoubleType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::StringType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::BooleanType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::ListType &) override { return arrow::Status::OK(); }
-
-   using ::arrow::TypeVisitor::Visit;
-};
-
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create an Arrow RDataSource for RDataFrame.
 /// \param[in] table the arrow Table to observe.
 /// \param[in] columns the name of the columns to use
 /// In case columns is empty, we use all the columns found in the table
 RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::string> const &inColumns)
-   : fTable{inTable}, fColumnNames{inColumns}
+   : fTable{inTable}, fSchema{inTable->schema()}, fColumnNames{inColumns}
 {
    auto &columnNames = fColumnNames;
    auto &table = fTable;
@@ -439,7 +124,7 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    resetGetterIndex();
    auto nRecords = getRecordsFirstColumn();
    for (auto &columnName : fColumnNames) {
-      auto columnIdx = fTable->schema()->GetFieldIndex(columnName);
+      auto columnIdx = fSchema->GetFieldIndex(columnName);
       addColumnToGetterIndex(columnIdx);
 
       auto column = fTable->column(columnIdx);
@@ -448,6 +133,46 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    }
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource for RDataFrame reading a file.
+/// \param[in] fileName the path of a file in the Arrow IPC file format (Feather V2).
+/// \param[in] columns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the file.
+/// The file is memory-mapped and its record batches are only read during the event loop.
+RArrowDS::RArrowDS(std::string_view fileName, std::vector<std::string> const &inColumns) : fColumnNames{inColumns}
+{
+   const std::string name(fileName);
+   std::shared_ptr<arrow::io::MemoryMappedFile> file;
+   auto status = arrow::io::MemoryMappedFile::Open(name, arrow::io::FileMode::READ, &file);
+   if (status.ok()) {
+      status = arrow::ipc::RecordBatchFileReader::Open(file, &fFileReader);
+   }
+   if (!status.ok()) {
+      throw std::runtime_error("Cannot read the Arrow file " + name + ": " + status.ToString());
+   }
+   fSchema = fFileReader->schema();
+
+   if (fColumnNames.empty()) {
+      for (auto &field : fSchema->fields()) {
+         fColumnNames.push_back(field->name());
+      }
+   }
+   if (fColumnNames.empty()) {
+      throw std::runtime_error("At least one column required");
+   }
+   for (auto &columnName : fColumnNames) {
+      const auto columnIdx = fSchema->GetFieldIndex(columnName);
+      if (columnIdx < 0) {
+         throw std::runtime_error("The dataset does not have column " + columnName);
+      }
+      VerifyValidColumnType verifyType;
+      if (!fSchema->field(columnIdx)->type()->Accept(&verifyType).ok()) {
+         throw std::runtime_error("Column " + columnName + " contains an unsupported type.");
+      }
+      fGetterIndex.emplace_back(columnIdx, fGetterIndex.size());
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
 RArrowDS::~RArrowDS()
@@ -461,13 +186,16 @@ const std::vector<std::string> &RArrowDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RArrowDS::GetEntryRanges()
 {
+   if (fFileReader) {
+      return ReadNextBatches();
+   }
    auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
    return entryRanges;
 }
 
 std::string RArrowDS::GetTypeName(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       std::string msg = "The dataset does not have column ";
       msg += colName;
@@ -485,7 +213,7 @@ std::string RArrowDS::GetTypeName(std::string_view colName) const
 
 bool RArrowDS::HasColumn(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       return false;
    }
@@ -495,7 +223,6 @@ bool RArrowDS::HasColumn(std::string_view colName) const
 bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    for (auto link : fGetterIndex) {
-      auto column = fTable->column(link.first);
       auto &getter = fValueGetters[link.second];
       getter->SetEntry(slot, entry);
    }
@@ -505,7 +232,6 @@ bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 void RArrowDS::InitSlot(unsigned int slot, ULong64_t entry)
 {
    for (auto link : fGetterIndex) {
-      auto column = fTable->column(link.first);
       auto &getter = fValueGetters[link.second];
       getter->UncachedSlotLookup(slot, entry);
    }
@@ -527,6 +253,28 @@ void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, in
    ranges.back().second += remainder;
 }
 
+/// Return the ranges of entries between the chunk boundaries of any of the columns, so that each range spans a
+/// single chunk, i.e. a record batch, of every column.
+std::vector<std::pair<ULong64_t, ULong64_t>>
+getBatchRanges(const std::vector<arrow::ArrayVector> &columnsChunks, ULong64_t nRecords)
+{
+   std::vector<ULong64_t> boundaries{0ULL, nRecords};
+   for (auto &chunks : columnsChunks) {
+      ULong64_t end = 0ULL;
+      for (auto &chunk : chunks) {
+         end += chunk->length();
+         boundaries.push_back(end);
+      }
+   }
+   std::sort(boundaries.begin(), boundaries.end());
+   boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   for (size_t i = 1; i < boundaries.size(); ++i) {
+      ranges.emplace_back(boundaries[i - 1], boundaries[i]);
+   }
+   return ranges;
+}
+
 int getNRecords(std::shared_ptr<arrow::Table> &table, std::vector<std::string> &columnNames)
 {
    auto index = table->schema()->GetFieldIndex(columnNames.front());
@@ -542,8 +290,12 @@ void RArrowDS::SetNSlots(unsigned int nSlots)
 
    fValueGetters.clear();
    for (size_t ci = 0; ci != nColumns; ++ci) {
-      auto chunkedArray = fTable->column(fGetterIndex[ci].first)->data();
-      fValueGetters.emplace_back(std::make_unique<ROOT::Internal::RDF::TValueGetter>(nSlots, chunkedArray->chunks()));
+      // The chunks of a file are set as its record batches are read
+      arrow::ArrayVector chunks;
+      if (fTable) {
+         chunks = fTable->column(fGetterIndex[ci].first)->data()->chunks();
+      }
+      fValueGetters.emplace_back(std::make_unique<ROOT::Internal::RDF::TValueGetter>(nSlots, std::move(chunks)));
    }
 }
 
@@ -561,7 +313,7 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
       throw std::runtime_error("No column found at index " + std::to_string(column));
    };
 
-   const int columnIdx = fTable->schema()->GetFieldIndex(std::string(colName));
+   const int columnIdx = fSchema->GetFieldIndex(std::string(colName));
    const int getterIdx = findGetterIndex(columnIdx);
    assert(getterIdx != -1);
    assert((unsigned int)getterIdx < fValueGetters.size());
@@ -570,8 +322,56 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 
 void RArrowDS::Initialise()
 {
+   if (fFileReader) {
+      fNextBatch = 0;
+      fNextEntry = 0ULL;
+      return;
+   }
    auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   std::vector<arrow::ArrayVector> columnsChunks;
+   bool isChunked = false;
+   for (auto &link : fGetterIndex) {
+      columnsChunks.emplace_back(fTable->column(link.first)->data()->chunks());
+      isChunked |= columnsChunks.back().size() > 1;
+   }
+   // Tasks process whole record batches. A table which is not chunked is split in equal parts instead.
+   if (isChunked) {
+      fEntryRanges = getBatchRanges(columnsChunks, nRecords);
+   } else {
+      splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Read the next record batches of the file, one per slot, and return their ranges of entries. The value getters
+/// are moved to the new batches, so that the batches read before are released. The arrays of the batches read from
+/// the memory-mapped file point into the mapping, their values are not copied.
+std::vector<std::pair<ULong64_t, ULong64_t>> RArrowDS::ReadNextBatches()
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   std::vector<arrow::ArrayVector> columnsChunks(fGetterIndex.size());
+   const auto firstEntry = fNextEntry;
+   const auto nBatches = fFileReader->num_record_batches();
+   for (; fNextBatch < nBatches && ranges.size() < fNSlots; ++fNextBatch) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      auto status = fFileReader->ReadRecordBatch(fNextBatch, &batch);
+      if (!status.ok()) {
+         throw std::runtime_error("Cannot read record batch " + std::to_string(fNextBatch) + ": " + status.ToString());
+      }
+      const ULong64_t nRows = batch->num_rows();
+      if (nRows == 0) {
+         continue;
+      }
+      for (auto &link : fGetterIndex) {
+         columnsChunks[link.second].push_back(batch->column(link.first));
+      }
+      ranges.emplace_back(fNextEntry, fNextEntry + nRows);
+      fNextEntry += nRows;
+   }
+   for (auto &link : fGetterIndex) {
+      fValueGetters[link.second]->SetChunks(std::move(columnsChunks[link.second]), firstEntry);
+   }
+   return ranges;
 }
 
 std::string RArrowDS::GetLabel()
@@ -589,6 +389,16 @@ RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<s
    return tdf;
 }
 
+/// Creates a RDataFrame reading a file in the Arrow IPC file format (Feather V2).
+/// \param[in] fileName the path of the file
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(fileName, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
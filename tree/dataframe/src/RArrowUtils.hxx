@@ -0,0 +1,421 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The helpers to expose the values of Arrow arrays to RDataFrame, shared by the data sources based on Arrow
+// (RArrowDS, RParquetDS).
+
+#ifndef ROOT_RDF_RARROWUTILS
+#define ROOT_RDF_RARROWUTILS
+
+#include <ROOT/RDF/Utils.hxx>
+#include <ROOT/RVec.hxx>
+#include <RtypesCore.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/table.h>
+#include <arrow/stl.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+// This is needed by Arrow 0.12.0 which dropped 
+//
+//      using ArrowType = ArrowType_;
+//
+// from ARROW_STL_CONVERSION
+template <typename T>
+struct RootConversionTraits {};
+
+#define ROOT_ARROW_STL_CONVERSION(c_type, ArrowType_)  \
+   template <>                                         \
+   struct RootConversionTraits<c_type> {               \
+   using ArrowType = ::arrow::ArrowType_;              \
+   };
+
+ROOT_ARROW_STL_CONVERSION(bool, BooleanType)
+ROOT_ARROW_STL_CONVERSION(int8_t, Int8Type)
+ROOT_ARROW_STL_CONVERSION(int16_t, Int16Type)
+ROOT_ARROW_STL_CONVERSION(int32_t, Int32Type)
+ROOT_ARROW_STL_CONVERSION(int64_t, Int64Type)
+ROOT_ARROW_STL_CONVERSION(uint8_t, UInt8Type)
+ROOT_ARROW_STL_CONVERSION(uint16_t, UInt16Type)
+ROOT_ARROW_STL_CONVERSION(uint32_t, UInt32Type)
+ROOT_ARROW_STL_CONVERSION(uint64_t, UInt64Type)
+ROOT_ARROW_STL_CONVERSION(float, FloatType)
+ROOT_ARROW_STL_CONVERSION(double, DoubleType)
+ROOT_ARROW_STL_CONVERSION(std::string, StringType)
+
+// Per slot visitor of an Array.
+class ArrayPtrVisitor : public ::arrow::ArrayVisitor {
+private:
+   /// The pointer to update.
+   void **fResult;
+   bool fCachedBool{false}; // Booleans need to be unpacked, so we use a cached entry.
+   // FIXME: I should really use a variant here
+   RVec<float> fCachedRVecFloat;
+   RVec<double> fCachedRVecDouble;
+   RVec<ULong64_t> fCachedRVecULong64;
+   RVec<UInt_t> fCachedRVecUInt;
+   RVec<Long64_t> fCachedRVecLong64;
+   RVec<Int_t> fCachedRVecInt;
+   std::string fCachedString;
+   /// The entry in the array which should be looked up.
+   ULong64_t fCurrentEntry;
+   /// The values of the array visited last, if it is an array of numbers, null otherwise.
+   const char *fRawValues = nullptr;
+   std::size_t fValueSize = 0;
+
+   template <typename ArrayType>
+   arrow::Status VisitPrimitive(ArrayType const &array)
+   {
+      fRawValues = reinterpret_cast<const char *>(array.raw_values());
+      fValueSize = sizeof(*array.raw_values());
+      *fResult = (void *)(array.raw_values() + fCurrentEntry);
+      return arrow::Status::OK();
+   }
+
+   template <typename T>
+   void *getTypeErasedPtrFrom(arrow::ListArray const &array, int32_t entry, RVec<T> &cache)
+   {
+      using ArrowType = typename RootConversionTraits<T>::ArrowType;
+      using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+      auto values = reinterpret_cast<ArrayType *>(array.values().get());
+      auto offset = array.value_offset(entry);
+      // The RVec adopts the memory of the values, which is not copied
+      RVec<T> tmp(const_cast<T *>(values->raw_values()) + offset, array.value_length(entry));
+      cache.swap(tmp);
+      return (void *)(&cache);
+   }
+
+public:
+   ArrayPtrVisitor(void **result) : fResult{result}, fCurrentEntry{0} {}
+
+   void SetEntry(ULong64_t entry) { fCurrentEntry = entry; }
+
+   /// Point the result to the value of entry in the array visited last, without visiting it again. This is only
+   /// possible for arrays of numbers: false is returned otherwise.
+   bool SetEntryFast(ULong64_t entry)
+   {
+      if (!fRawValues)
+         return false;
+      *fResult = (void *)(fRawValues + entry * fValueSize);
+      return true;
+   }
+
+   /// Forget the array visited last, e.g. because its memory is released.
+   void Reset() { fRawValues = nullptr; }
+
+   virtual arrow::Status Visit(arrow::Int32Array const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::Int64Array const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::UInt32Array const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::UInt64Array const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::FloatArray const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::DoubleArray const &array) final { return VisitPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::BooleanArray const &array) final
+   {
+      fRawValues = nullptr;
+      fCachedBool = array.Value(fCurrentEntry);
+      *fResult = reinterpret_cast<void *>(&fCachedBool);
+      return arrow::Status::OK();
+   }
+
+   virtual arrow::Status Visit(arrow::StringArray const &array) final
+   {
+      fRawValues = nullptr;
+      fCachedString = array.GetString(fCurrentEntry);
+      *fResult = reinterpret_cast<void *>(&fCachedString);
+      return arrow::Status::OK();
+   }
+
+   virtual arrow::Status Visit(arrow::ListArray const &array) final
+   {
+      fRawValues = nullptr;
+      switch (array.value_type()->id()) {
+      case arrow::Type::FLOAT: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecFloat);
+         return arrow::Status::OK();
+      }
+      case arrow::Type::DOUBLE: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecDouble);
+         return arrow::Status::OK();
+      }
+      case arrow::Type::UINT32: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecUInt);
+         return arrow::Status::OK();
+      }
+      case arrow::Type::UINT64: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecULong64);
+         return arrow::Status::OK();
+      }
+      case arrow::Type::INT32: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecInt);
+         return arrow::Status::OK();
+      }
+      case arrow::Type::INT64: {
+         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecLong64);
+         return arrow::Status::OK();
+      }
+      default: return arrow::Status::TypeError("Type not supported");
+      }
+   }
+
+   using ::arrow::ArrayVisitor::Visit;
+};
+
+/// Helper class which keeps track for each slot where to get the entry.
+/// The slots read the same chunks of the column (SetChunks(chunks, firstEntry)), or each slot reads its own chunks
+/// (SetChunks(slot, chunks, firstEntry)), e.g. the record batches of the task it is processing. The methods taking a
+/// slot can be called concurrently for different slots.
+class TValueGetter {
+private:
+   static constexpr ULong64_t kNoEntry = std::numeric_limits<ULong64_t>::max();
+   /// The chunks of the column read by a slot. Since data can be chunked in different arrays we need to construct an
+   /// index which contains the end of each chunk, so that we can quickly move to the correct chunk.
+   struct RChunks {
+      arrow::ArrayVector fChunks;
+      std::vector<ULong64_t> fFirstEntryPerChunk;
+      std::vector<ULong64_t> fChunkIndex;
+   };
+
+   std::vector<void *> fValuesPtrPerSlot;
+   std::vector<ULong64_t> fLastEntryPerSlot;
+   std::vector<size_t> fLastChunkPerSlot;
+   std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
+   std::vector<std::shared_ptr<const RChunks>> fChunksPerSlot;
+
+   static std::shared_ptr<const RChunks> MakeChunks(arrow::ArrayVector chunks, ULong64_t firstEntry)
+   {
+      auto result = std::make_shared<RChunks>();
+      result->fChunks = std::move(chunks);
+      auto next = firstEntry;
+      for (auto &chunk : result->fChunks) {
+         result->fFirstEntryPerChunk.push_back(next);
+         next += chunk->length();
+         result->fChunkIndex.push_back(next);
+      }
+      return result;
+   }
+
+   void ResetSlot(unsigned int slot)
+   {
+      fLastEntryPerSlot[slot] = kNoEntry;
+      fLastChunkPerSlot[slot] = 0;
+      fArrayVisitorPerSlot[slot].Reset();
+   }
+
+   void VisitChunk(unsigned int slot, ULong64_t entry)
+   {
+      const auto &chunks = *fChunksPerSlot[slot];
+      const auto ci = fLastChunkPerSlot[slot];
+      auto &visitor = fArrayVisitorPerSlot[slot];
+      visitor.SetEntry(entry - chunks.fFirstEntryPerChunk[ci]);
+      auto status = chunks.fChunks[ci]->Accept(&visitor);
+      if (!status.ok()) {
+         std::string msg = "Could not get pointer for slot ";
+         msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
+         throw std::runtime_error(msg);
+      }
+      fLastEntryPerSlot[slot] = entry;
+   }
+
+public:
+   TValueGetter(size_t slots, arrow::ArrayVector chunks, ULong64_t firstEntry = 0)
+      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots), fLastChunkPerSlot(slots)
+   {
+      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
+         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
+      }
+      SetChunks(std::move(chunks), firstEntry);
+   }
+
+   /// Replace the chunks of the column read by all slots, the first one starting at firstEntry. The pointers returned
+   /// by SlotPtrs() stay valid.
+   void SetChunks(arrow::ArrayVector chunks, ULong64_t firstEntry)
+   {
+      const auto sharedChunks = MakeChunks(std::move(chunks), firstEntry);
+      fChunksPerSlot.assign(fValuesPtrPerSlot.size(), sharedChunks);
+      for (size_t slot = 0; slot < fValuesPtrPerSlot.size(); ++slot) {
+         ResetSlot(slot);
+      }
+   }
+
+   /// Replace the chunks of the column read by slot, the first one starting at firstEntry.
+   void SetChunks(unsigned int slot, arrow::ArrayVector chunks, ULong64_t firstEntry)
+   {
+      fChunksPerSlot[slot] = MakeChunks(std::move(chunks), firstEntry);
+      ResetSlot(slot);
+   }
+
+   /// This returns the ptr to the ptr to actual data.
+   std::vector<void *> SlotPtrs()
+   {
+      std::vector<void *> result;
+      for (size_t i = 0; i < fValuesPtrPerSlot.size(); ++i) {
+         result.push_back(fValuesPtrPerSlot.data() + i);
+      }
+      return result;
+   }
+
+   // Convenience method to avoid code duplication between
+   // SetEntry and InitSlot
+   void UncachedSlotLookup(unsigned int slot, ULong64_t entry)
+   {
+      assert(slot < fLastChunkPerSlot.size());
+      const auto &chunks = *fChunksPerSlot[slot];
+      // The chunk holding the entry is the first one ending after it
+      const auto chunkEnd = std::upper_bound(chunks.fChunkIndex.begin(), chunks.fChunkIndex.end(), entry);
+      if (chunkEnd == chunks.fChunkIndex.end() || entry < chunks.fFirstEntryPerChunk.front()) {
+         throw std::runtime_error("Entry " + std::to_string(entry) + " is not in the chunks read");
+      }
+      fLastChunkPerSlot[slot] = chunkEnd - chunks.fChunkIndex.begin();
+      VisitChunk(slot, entry);
+   }
+
+   /// Set the current entry to be retrieved
+   void SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      // Same entry as before
+      if (fLastEntryPerSlot[slot] == entry) {
+         return;
+      }
+      const auto &chunks = *fChunksPerSlot[slot];
+      const auto ci = fLastChunkPerSlot[slot];
+      if (ci >= chunks.fChunks.size() || entry < chunks.fFirstEntryPerChunk[ci] || entry >= chunks.fChunkIndex[ci]) {
+         UncachedSlotLookup(slot, entry);
+         return;
+      }
+      // Within the chunk of the previous entry, the numbers are found without visiting the chunk again
+      if (fArrayVisitorPerSlot[slot].SetEntryFast(entry - chunks.fFirstEntryPerChunk[ci])) {
+         fLastEntryPerSlot[slot] = entry;
+         return;
+      }
+      VisitChunk(slot, entry);
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+/// Helper to get the contents of a given column
+
+/// Helper to get the human readable name of type
+class RDFTypeNameGetter : public ::arrow::TypeVisitor {
+private:
+   std::vector<std::string> fTypeName;
+
+public:
+   arrow::Status Visit(const arrow::Int64Type &) override
+   {
+      fTypeName.push_back("Long64_t");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::Int32Type &) override
+   {
+      fTypeName.push_back("Int_t");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::UInt64Type &) override
+   {
+      fTypeName.push_back("ULong64_t");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::UInt32Type &) override
+   {
+      fTypeName.push_back("UInt_t");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::FloatType &) override
+   {
+      fTypeName.push_back("float");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::DoubleType &) override
+   {
+      fTypeName.push_back("double");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::StringType &) override
+   {
+      fTypeName.push_back("string");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::BooleanType &) override
+   {
+      fTypeName.push_back("bool");
+      return arrow::Status::OK();
+   }
+   arrow::Status Visit(const arrow::ListType &l) override
+   {
+      /// Recursively visit List types and map them to
+      /// an RVec. We accumulate the result of the recursion on
+      /// fTypeName so that we can create the actual type
+      /// when the recursion is done.
+      fTypeName.push_back("ROOT::VecOps::RVec<%s>");
+      return l.value_type()->Accept(this);
+   }
+   std::string result()
+   {
+      // This recursively builds a nested type.
+      std::string result = "%s";
+      char buffer[8192];
+      for (size_t i = 0; i < fTypeName.size(); ++i) {
+         snprintf(buffer, 8192, result.c_str(), fTypeName[i].c_str());
+         result = buffer;
+      }
+      return result;
+   }
+
+   using ::arrow::TypeVisitor::Visit;
+};
+
+/// Helper to determine if a given Column is a supported type.
+class VerifyValidColumnType : public ::arrow::TypeVisitor {
+private:
+public:
+   virtual arrow::Status Visit(const arrow::Int64Type &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::UInt64Type &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::Int32Type &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::UInt32Type &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::FloatType &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::DoubleType &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::StringType &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::BooleanType &) override { return arrow::Status::OK(); }
+   virtual arrow::Status Visit(const arrow::ListType &) override { return arrow::Status::OK(); }
+
+   using ::arrow::TypeVisitor::Visit;
+};
+
+} // namespace RDF
+
+} // namespace ROOT
+
+#endif
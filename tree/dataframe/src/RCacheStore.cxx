@@ -0,0 +1,199 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RCacheStore.hxx"
+#include "RZip.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress in into out, in blocks of at most kMAXZIPBUF bytes as the baskets do.
+/// Return false if the bytes cannot be compressed or do not get smaller.
+bool Compress(const std::vector<char> &in, std::vector<char> &out, int level, ROOT::ECompressionAlgorithm algorithm)
+{
+   if (in.empty())
+      return false;
+   out.resize(in.size());
+   std::size_t nOut = 0;
+   for (std::size_t pos = 0; pos < in.size(); pos += kMAXZIPBUF) {
+      int srcSize = std::min<std::size_t>(kMAXZIPBUF, in.size() - pos);
+      int tgtSize = std::min<std::size_t>(kMAXZIPBUF, out.size() - nOut);
+      int irep = 0;
+      R__zipMultipleAlgorithm(level, &srcSize, const_cast<char *>(in.data() + pos), &tgtSize, out.data() + nOut,
+                              &irep, static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(algorithm));
+      nOut += irep;
+      if (irep == 0 || nOut >= in.size())
+         return false;
+   }
+   out.resize(nOut);
+   out.shrink_to_fit();
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Uncompress the srcSize bytes of src, made of blocks written by Compress, into the tgtSize bytes of tgt.
+bool Uncompress(const char *src, std::size_t srcSize, char *tgt, std::size_t tgtSize)
+{
+   std::size_t nIn = 0;
+   std::size_t nOut = 0;
+   while (nOut < tgtSize) {
+      auto block = reinterpret_cast<unsigned char *>(const_cast<char *>(src + nIn));
+      int blockIn = 0;
+      int blockOut = 0;
+      if (nIn >= srcSize || R__unzip_header(&blockIn, block, &blockOut) != 0)
+         return false;
+      int irep = 0;
+      R__unzip(&blockIn, block, &blockOut, reinterpret_cast<unsigned char *>(tgt + nOut), &irep);
+      if (irep == 0)
+         return false;
+      nIn += blockIn;
+      nOut += irep;
+   }
+   return nOut == tgtSize;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RCacheStore::RCacheStore(const ROOT::RDF::RCacheOptions &options) : fOptions(options)
+{
+   if (fOptions.fChunkSize == 0)
+      throw std::runtime_error("RDataFrame::Cache: the chunk size must be greater than zero.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close and delete the scratch file, if any.
+RCacheStore::~RCacheStore()
+{
+   if (fSpillFile) {
+      std::fclose(fSpillFile);
+      gSystem->Unlink(fSpillFileName.c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the columns of chunk to the scratch file, creating it if needed. Called with fMutex locked.
+void RCacheStore::Spill(RChunk &chunk)
+{
+   if (!fSpillFile) {
+      TString name("rdfcache");
+      const char *dir = fOptions.fSpillDir.empty() ? nullptr : fOptions.fSpillDir.c_str();
+      fSpillFile = gSystem->TempFileName(name, dir);
+      if (!fSpillFile)
+         throw std::runtime_error("RDataFrame::Cache: cannot create the scratch file in " +
+                                  std::string(dir ? dir : gSystem->TempDirectory()) + ".");
+      fSpillFileName = name.Data();
+   }
+   for (auto &column : chunk.fColumns) {
+      if (column.fBytes.empty())
+         continue;
+      std::fseek(fSpillFile, 0, SEEK_END);
+      const auto offset = std::ftell(fSpillFile);
+      if (offset < 0 || std::fwrite(column.fBytes.data(), 1, column.fStoredSize, fSpillFile) != column.fStoredSize)
+         throw std::runtime_error("RDataFrame::Cache: cannot write to the scratch file " + fSpillFileName + ".");
+      column.fSpillOffset = offset;
+      std::vector<char>().swap(column.fBytes);
+      fMemoryBytes -= column.fStoredSize;
+      fSpilledBytes += column.fStoredSize;
+   }
+   std::fflush(fSpillFile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a chunk of nEntries entries following the ones of the chunks already added,
+/// with the values of each column in the order of the columns of the cached dataset.
+///
+/// The serialized values are compressed by the calling thread. If the memory used
+/// by the chunks then exceeds the limit of the options, the chunk is spilled.
+void RCacheStore::AddChunk(ULong64_t nEntries, std::vector<RCacheColumnData> &&columns)
+{
+   RChunk chunk;
+   chunk.fNEntries = nEntries;
+   chunk.fColumns.resize(columns.size());
+   ULong64_t bytes = 0;
+   for (std::size_t i = 0; i < columns.size(); ++i) {
+      auto &column = chunk.fColumns[i];
+      column.fSize = columns[i].fBytes.size();
+      column.fObjects = std::move(columns[i].fObjects);
+      if (fOptions.fCompressionLevel > 0)
+         column.fCompressed =
+            Compress(columns[i].fBytes, column.fBytes, fOptions.fCompressionLevel, fOptions.fCompressionAlgorithm);
+      if (!column.fCompressed)
+         column.fBytes = std::move(columns[i].fBytes);
+      column.fStoredSize = column.fBytes.size();
+      bytes += column.fStoredSize;
+   }
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   chunk.fFirstEntry = fNEntries;
+   fNEntries += nEntries;
+   fMemoryBytes += bytes;
+   fChunks.emplace_back(std::move(chunk));
+   if (fOptions.fMaxMemory > 0 && fMemoryBytes > fOptions.fMaxMemory)
+      Spill(fChunks.back());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill bytes with the serialized values of column of chunk, reading them from the
+/// scratch file and uncompressing them as needed, and return the values of the
+/// column if it is not serialized.
+std::shared_ptr<void> RCacheStore::ReadColumn(std::size_t chunk, std::size_t column, std::vector<char> &bytes) const
+{
+   const auto &col = fChunks[chunk].fColumns[column];
+   std::vector<char> spilled;
+   const char *stored = col.fBytes.data();
+   if (col.fSpillOffset >= 0) {
+      spilled.resize(col.fStoredSize);
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (std::fseek(fSpillFile, col.fSpillOffset, SEEK_SET) != 0 ||
+          std::fread(spilled.data(), 1, col.fStoredSize, fSpillFile) != col.fStoredSize)
+         throw std::runtime_error("RDataFrame::Cache: cannot read from the scratch file " + fSpillFileName + ".");
+      stored = spilled.data();
+   }
+
+   if (!col.fCompressed) {
+      bytes.assign(stored, stored + col.fSize);
+   } else {
+      bytes.resize(col.fSize);
+      if (!Uncompress(stored, col.fStoredSize, bytes.data(), col.fSize))
+         throw std::runtime_error("RDataFrame::Cache: cannot uncompress the values of a cached column.");
+   }
+   return col.fObjects;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the chunk holding entry.
+std::size_t RCacheStore::FindChunk(ULong64_t entry) const
+{
+   auto it = std::upper_bound(fChunks.begin(), fChunks.end(), entry,
+                              [](ULong64_t e, const RChunk &chunk) { return e < chunk.fFirstEntry; });
+   return std::distance(fChunks.begin(), it) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the range of entries, begin inclusive and end exclusive, of each chunk.
+std::vector<std::pair<ULong64_t, ULong64_t>> RCacheStore::GetChunkRanges() const
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   ranges.reserve(fChunks.size());
+   for (const auto &chunk : fChunks)
+      ranges.emplace_back(chunk.fFirstEntry, chunk.fFirstEntry + chunk.fNEntries);
+   return ranges;
+}
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
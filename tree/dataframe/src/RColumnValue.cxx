@@ -9,12 +9,82 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RColumnValue.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeName2TypeID
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TLeaf.h"
+#include "TTree.h"
 
 #include <vector>
 
 namespace ROOT {
 namespace Internal {
 namespace RDF {
+
+RBulkArrayReader::RBulkArrayReader(TTreeReader &r, const std::string &branchName, const std::type_info &valueType)
+   : fTreeReader(&r), fBranchName(branchName), fValueType(valueType)
+{
+}
+
+RBulkArrayReader::~RBulkArrayReader() = default;
+
+/// Look up the branch in the tree currently loaded by the reader and check that it can be read in bulk.
+bool RBulkArrayReader::SetupBranch()
+{
+   fBranch = nullptr;
+   fFirstEntry = -1;
+   fNEntries = 0;
+   auto readerTree = fTreeReader->GetTree();
+   if (!readerTree || !readerTree->GetTree())
+      return false;
+   fTree = readerTree->GetTree();
+   fTreeNumber = readerTree->GetTreeNumber();
+
+   auto branch = fTree->GetBranch(fBranchName.c_str());
+   // Only plain leaflist branches of the tree itself (not of its friends) are supported
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetTree() != fTree || branch->GetNleaves() != 1)
+      return false;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   try {
+      if (TypeName2TypeID(leaf->GetTypeName()) != fValueType)
+         return false;
+   } catch (const std::runtime_error &) {
+      return false;
+   }
+   // Scalars are not arrays: RColumnValue would need an RVec of size one for those
+   if (!leaf->GetLeafCount() && leaf->GetLenStatic() < 2)
+      return false;
+
+   fBranch = branch;
+   if (!fBuffer)
+      fBuffer = std::make_unique<TBufferFile>(TBuffer::kRead, 10000);
+   return true;
+}
+
+bool RBulkArrayReader::Get(void *&values, std::size_t &size)
+{
+   auto readerTree = fTreeReader->GetTree();
+   if (!fBranch || readerTree->GetTree() != fTree || readerTree->GetTreeNumber() != fTreeNumber) {
+      if (!SetupBranch())
+         return false;
+   }
+
+   const auto entry = fTree->GetReadEntry();
+   if (entry < fFirstEntry || entry >= fFirstEntry + fNEntries) {
+      const auto nentries = fBranch->GetBulkEntries(entry, *fBuffer, &fOffsets);
+      if (nentries <= 0)
+         return false;
+      fFirstEntry = entry;
+      fNEntries = nentries;
+   }
+
+   const auto idx = entry - fFirstEntry;
+   const auto valueSize = static_cast<TLeaf *>(fBranch->GetListOfLeaves()->UncheckedAt(0))->GetLenType();
+   values = fBuffer->Buffer() + fOffsets[idx];
+   size = (fOffsets[idx + 1] - fOffsets[idx]) / valueSize;
+   return true;
+}
+
 // Some extern instaniations to speed-up compilation/interpretation time
 // These are not active if c++17 is enabled because of a bug in our clang
 // See ROOT-9499.
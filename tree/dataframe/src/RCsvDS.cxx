@@ -22,14 +22,18 @@ ROOT::RDF::MakeCsvDataFrame, which accepts three parameters:
 not (optional, default `true`). If `false`, header names will be automatically generated as Col0, Col1, ..., ColN.
 3. Delimiter (optional, default ',').
 
-The types of the columns in the CSV file are automatically inferred. The supported
-types are:
+The types of the columns in the CSV file are automatically inferred from their values in the first
+10 records. The supported types are:
 - Integer: stored as a 64-bit long long int.
 - Floating point number: stored with double precision.
 - Boolean: matches the literals `true` and `false`.
 - String: stored as an std::string, matches anything that does not fall into any of the
 previous types.
 
+A column whose values are integers and floating point numbers is a floating point column. A column whose values
+are of different types otherwise is a string column. Empty values are not considered, and the values of the
+records beyond the first 10 are converted to the type of their column.
+
 These are some formatting rules expected by the RCsvDS implementation:
 - All records must have the same number of fields, in the same order.
 - Any field may be quoted.
@@ -65,9 +69,11 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+The CSV file is mapped in memory, or read in memory if it cannot be mapped. Before RDataFrame processes them, the
+records are parsed into one buffer of typed values per column: all records at once, or in chunks of
+`linesChunkSize` records if specified. When implicit multi-threading is enabled, large files are split at line
+boundaries and their parts are parsed in parallel. The memory needed is therefore about the size of the values of
+the records of a chunk, plus the pages of the file mapped by the operating system.
 */
 // clang-format on
 
@@ -75,13 +81,74 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
+#include <RConfigure.h> // R__USE_IMT
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <algorithm>
-#include <iostream>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <string>
 
+namespace {
+
+/// Number of records used to infer the types of the columns.
+constexpr unsigned int kNTypeInferenceRecords = 10;
+/// Minimum number of bytes of the records parsed by a task.
+constexpr std::size_t kMinBytesPerTask = 1 << 16;
+
+/// Return the end of the line starting at `line`, i.e. the position of its newline character or `end`.
+const char *FindLineEnd(const char *line, const char *end)
+{
+   const auto newline = static_cast<const char *>(std::memchr(line, '\n', end - line));
+   return newline ? newline : end;
+}
+
+/// Return the beginning of the line following the one of `pos`, or `end` if there is none.
+const char *NextLine(const char *pos, const char *end)
+{
+   const auto lineEnd = FindLineEnd(pos, end);
+   return lineEnd == end ? end : lineEnd + 1;
+}
+
+ULong64_t CountLines(const char *begin, const char *end)
+{
+   ULong64_t nLines = 0ULL;
+   for (auto line = begin; line < end; line = NextLine(line, end))
+      ++nLines;
+   return nLines;
+}
+
+/// Run `f` on the indices of the parts of a chunk of records, in parallel if there are several parts.
+template <typename F>
+void ForEachPart(unsigned int nParts, F &&f)
+{
+#ifdef R__USE_IMT
+   if (nParts > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(f, ROOT::TSeqU(nParts));
+      return;
+   }
+#endif
+   for (auto part = 0U; part < nParts; ++part)
+      f(part);
+}
+
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -101,46 +168,39 @@ TRegexp RCsvDS::falseRegex("^false$");
 const std::map<RCsvDS::ColType_t, std::string>
    RCsvDS::fgColTypeMap({{'b', "bool"}, {'d', "double"}, {'l', "Long64_t"}, {'s', "std::string"}});
 
-void RCsvDS::FillHeaders(const std::string &line)
-{
-   auto columns = ParseColumns(line);
-   for (auto &col : columns) {
-      fHeaders.emplace_back(col);
-   }
-}
-
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+////////////////////////////////////////////////////////////////////////
+/// Parse the records of the lines in [begin, end) into the column buffers, starting at index firstRecord.
+/// Called concurrently on disjoint sets of records.
+void RCsvDS::FillRecords(const char *begin, const char *end, ULong64_t firstRecord)
 {
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
-
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
+   const auto nColumns = fColTypesList.size();
+   std::string value;
+   auto record = firstRecord;
+   for (auto line = begin; line < end; line = NextLine(line, end), ++record) {
+      const auto lineEnd = FindLineEnd(line, end);
+      auto pos = line;
+      for (auto col = 0U; col < nColumns && pos < lineEnd; ++col, ++pos) {
+         pos = ParseValue(pos, lineEnd, value);
+
+         switch (fColTypesList[col]) {
+         case 'd': {
+            fDoubleColumns[col][record] = std::strtod(value.c_str(), nullptr);
+            break;
+         }
+         case 'l': {
+            fLong64Columns[col][record] = std::strtoll(value.c_str(), nullptr, 10);
+            break;
+         }
+         case 'b': {
+            fBoolColumns[col][record] = value == "true";
+            break;
+         }
+         case 's': {
+            fStringColumns[col][record] = value;
+            break;
+         }
+         }
       }
-      ++i;
    }
 }
 
@@ -166,33 +226,49 @@ std::vector<void *> RCsvDS::GetColumnReadersImpl(std::string_view colName, const
 
    const auto &colNames = GetColumnNames();
    const auto index = std::distance(colNames.begin(), std::find(colNames.begin(), colNames.end(), colName));
+   // SetEntry points the addresses to the values of the entry in the column buffers
    std::vector<void *> ret(fNSlots);
    for (auto slot : ROOT::TSeqU(fNSlots)) {
-      auto &val = fColAddresses[index][slot];
-      if (ti == typeid(double)) {
-         val = &fDoubleEvtValues[index][slot];
-      } else if (ti == typeid(Long64_t)) {
-         val = &fLong64EvtValues[index][slot];
-      } else if (ti == typeid(std::string)) {
-         val = &fStringEvtValues[index][slot];
-      } else {
-         val = &fBoolEvtValues[index][slot];
-      }
-      ret[slot] = &val;
+      ret[slot] = &fColAddresses[index][slot];
    }
    return ret;
 }
 
-void RCsvDS::InferColTypes(std::vector<std::string> &columns)
+////////////////////////////////////////////////////////////////////////
+/// Infer the types of the columns from the records of the lines in [begin, end). Generate the headers from the
+/// first record if the file has none.
+void RCsvDS::InferColTypes(const char *begin, const char *end)
 {
-   auto i = 0U;
-   for (auto &col : columns) {
-      InferType(col, i);
-      ++i;
+   std::vector<ColType_t> types(fHeaders.size(), 0);
+   for (auto line = begin; line < end; line = NextLine(line, end)) {
+      const auto columns = ParseColumns(line, FindLineEnd(line, end));
+      if (!fReadHeaders && fHeaders.empty()) {
+         GenerateHeaders(columns.size());
+         types.resize(fHeaders.size(), 0);
+      }
+
+      for (auto i = 0U; i < std::min(columns.size(), types.size()); ++i) {
+         if (columns[i].empty())
+            continue;
+         const auto type = InferType(columns[i]);
+         if (types[i] == 0 || types[i] == type) {
+            types[i] = type;
+         } else if ((types[i] == 'l' && type == 'd') || (types[i] == 'd' && type == 'l')) {
+            types[i] = 'd'; // integers and floating point numbers are read as double
+         } else {
+            types[i] = 's'; // values of different types are read as strings
+         }
+      }
+   }
+
+   for (auto i = 0U; i < types.size(); ++i) {
+      const auto type = types[i] == 0 ? 's' : types[i];
+      fColTypes[fHeaders[i]] = type;
+      fColTypesList.push_back(type);
    }
 }
 
-void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
+RCsvDS::ColType_t RCsvDS::InferType(const std::string &col)
 {
    ColType_t type;
    int dummy;
@@ -208,44 +284,74 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    }
    // TODO: Date
 
-   fColTypes[fHeaders[idxCol]] = type;
-   fColTypesList.push_back(type);
+   return type;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Map the file in memory. If it cannot be mapped, read it in fBuffer instead.
+void RCsvDS::MapFile(const std::string &fileName)
+{
+#ifndef WIN32
+   const auto fd = open(fileName.c_str(), O_RDONLY);
+   if (fd >= 0) {
+      struct stat st;
+      if (0 == fstat(fd, &st) && st.st_size > 0) {
+         void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (addr != MAP_FAILED) {
+            fData = static_cast<const char *>(addr);
+            fDataSize = st.st_size;
+            fIsMapped = true;
+         }
+      }
+      close(fd);
+      if (fIsMapped)
+         return;
+   }
+#endif
+   std::ifstream stream(fileName, std::ios::binary);
+   fBuffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+   fData = fBuffer.data();
+   fDataSize = fBuffer.size();
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(const char *begin, const char *end)
 {
    std::vector<std::string> columns;
+   std::string value;
 
-   for (size_t i = 0; i < line.size(); ++i) {
-      i = ParseValue(line, columns, i);
+   for (auto pos = begin; pos < end; ++pos) {
+      pos = ParseValue(pos, end, value);
+      columns.emplace_back(value);
    }
 
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+////////////////////////////////////////////////////////////////////////
+/// Parse the value starting at `begin` in `value`, removing its quotes. Return the position of the delimiter that
+/// ends it, or `end`.
+const char *RCsvDS::ParseValue(const char *begin, const char *end, std::string &value)
 {
-   std::stringstream val;
+   value.clear();
    bool quoted = false;
 
-   for (; i < line.size(); ++i) {
-      if (line[i] == fDelimiter && !quoted) {
+   auto pos = begin;
+   for (; pos < end; ++pos) {
+      if (*pos == fDelimiter && !quoted) {
          break;
-      } else if (line[i] == '"') {
+      } else if (*pos == '"') {
          // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
+         if (pos + 1 == end || pos[1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            value += *++pos;
          }
       } else {
-         val << line[i];
+         value += *pos;
       }
    }
 
-   columns.emplace_back(val.str());
-
-   return i;
+   return pos;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -254,82 +360,59 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Number of records parsed at a time, -1 to parse all records at once (default -1).
 RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize) // TODO: Let users specify types?
    : fReadHeaders(readHeaders),
-     fStream(std::string(fileName)),
      fDelimiter(delimiter),
      fLinesChunkSize(linesChunkSize)
 {
-   std::string line;
+   MapFile(std::string(fileName));
+   const auto end = fData + fDataSize;
 
    // Read the headers if present
    if (fReadHeaders) {
-      if (std::getline(fStream, line)) {
-         FillHeaders(line);
-      } else {
+      if (0 == fDataSize) {
          std::string msg = "Error reading headers of CSV file ";
          msg += fileName;
          throw std::runtime_error(msg);
       }
+      fHeaders = ParseColumns(fData, FindLineEnd(fData, end));
+      fDataPos = NextLine(fData, end) - fData;
    }
+   fCursor = fDataPos;
 
-   fDataPos = fStream.tellg();
-   if (std::getline(fStream, line)) {
-      auto columns = ParseColumns(line);
-
-      // Generate headers if not present
-      if (!fReadHeaders) {
-         GenerateHeaders(columns.size());
-      }
-
-      // Infer types of columns with first record
-      InferColTypes(columns);
-
-      // rewind one line
-      fStream.seekg(fDataPos);
-   }
+   // Infer types of columns with the first records
+   auto sampleEnd = fData + fDataPos;
+   for (auto i = 0U; i < kNTypeInferenceRecords && sampleEnd < end; ++i)
+      sampleEnd = NextLine(sampleEnd, end);
+   InferColTypes(fData + fDataPos, sampleEnd);
 }
 
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
-   fRecords.clear();
+   for (auto &column : fDoubleColumns)
+      column.clear();
+   for (auto &column : fLong64Columns)
+      column.clear();
+   for (auto &column : fStringColumns)
+      column.clear();
+   for (auto &column : fBoolColumns)
+      column.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
 RCsvDS::~RCsvDS()
 {
-   FreeRecords();
+#ifndef WIN32
+   if (fIsMapped)
+      munmap(const_cast<char *>(fData), fDataSize);
+#endif
 }
 
 void RCsvDS::Finalise()
 {
-   fStream.clear();
-   fStream.seekg(fDataPos);
+   fCursor = fDataPos;
    fProcessedLines = 0ULL;
    fEntryRangesRequested = 0ULL;
    FreeRecords();
@@ -342,19 +425,53 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
-
-   // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead--) && std::getline(fStream, line)) {
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+   // Find the records of the chunk
+   const auto begin = fData + fCursor;
+   const auto dataEnd = fData + fDataSize;
+   auto chunkEnd = dataEnd;
+   if (-1LL != fLinesChunkSize) {
+      chunkEnd = begin;
+      for (auto i = 0LL; i < fLinesChunkSize && chunkEnd < dataEnd; ++i)
+         chunkEnd = NextLine(chunkEnd, dataEnd);
+   }
+   fCursor = chunkEnd - fData;
+
+   // Split them in parts starting at the beginning of a line, to be parsed in parallel
+   auto nParts = 1U;
+   if (ROOT::IsImplicitMTEnabled()) {
+      nParts = std::max<std::size_t>(1U, std::min<std::size_t>(fNSlots, (chunkEnd - begin) / kMinBytesPerTask));
+   }
+   std::vector<const char *> partBegins(nParts + 1, chunkEnd);
+   partBegins[0] = begin;
+   for (auto part = 1U; part < nParts; ++part) {
+      const auto pos = begin + (chunkEnd - begin) * part / nParts;
+      partBegins[part] = std::max(partBegins[part - 1], NextLine(pos - 1, chunkEnd));
+   }
+
+   // Count the records of each part, to know where each part stores them
+   std::vector<ULong64_t> partFirstRecords(nParts + 1, 0ULL);
+   ForEachPart(nParts, [&](unsigned int part) {
+      partFirstRecords[part + 1] = CountLines(partBegins[part], partBegins[part + 1]);
+   });
+   for (auto part = 0U; part < nParts; ++part)
+      partFirstRecords[part + 1] += partFirstRecords[part];
+   const auto nRecords = partFirstRecords[nParts];
+
+   for (auto col = 0U; col < fColTypesList.size(); ++col) {
+      switch (fColTypesList[col]) {
+      case 'd': fDoubleColumns[col].resize(nRecords); break;
+      case 'l': fLong64Columns[col].resize(nRecords); break;
+      case 'b': fBoolColumns[col].resize(nRecords); break;
+      case 's': fStringColumns[col].resize(nRecords); break;
+      }
    }
+   ForEachPart(nParts, [&](unsigned int part) {
+      FillRecords(partBegins[part], partBegins[part + 1], partFirstRecords[part]);
+   });
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
    if (0 == nRecords)
       return entryRanges;
 
@@ -362,6 +479,7 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
    auto start = 0ULL == fEntryRangesRequested ? 0ULL : fProcessedLines;
    auto end = start;
+   fFirstRecordEntry = start;
 
    for (auto i : ROOT::TSeqU(fNSlots)) {
       start = end;
@@ -401,30 +519,28 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   const auto recordPos = entry - fFirstRecordEntry;
+   // The values are read in place from the column buffers
+   for (auto colIndex = 0U; colIndex < fColTypesList.size(); ++colIndex) {
+      auto &address = fColAddresses[colIndex][slot];
+      switch (fColTypesList[colIndex]) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         address = &fDoubleColumns[colIndex][recordPos];
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         address = &fLong64Columns[colIndex][recordPos];
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         address = &fBoolColumns[colIndex][recordPos];
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         address = &fStringColumns[colIndex][recordPos];
          break;
       }
       }
-      colIndex++;
    }
    return true;
 }
@@ -439,11 +555,11 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    // Initialise the entire set of addresses
    fColAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
 
-   // Initialize the per event data holders
-   fDoubleEvtValues.resize(nColumns, std::vector<double>(fNSlots));
-   fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
-   fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
-   fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+   // Initialize the column buffers, filled by GetEntryRanges
+   fDoubleColumns.resize(nColumns);
+   fLong64Columns.resize(nColumns);
+   fStringColumns.resize(nColumns);
+   fBoolColumns.resize(nColumns);
 }
 
 std::string RCsvDS::GetLabel()
@@ -8,6 +8,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include "ROOT/RDF/InterfaceUtils.hxx" // IsInternalColumn
 #include "ROOT/RDF/RCustomColumnBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RStringView.hxx"
@@ -48,4 +49,12 @@ std::string RCustomColumnBase::GetName() const
 void RCustomColumnBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   // the implicit columns are not worth a line in the profile
+   fProfiler = RDFInternal::IsInternalColumn(fName) ? nullptr : fLoopManager->GetProfiler();
+   if (fProfiler) {
+      // data-source columns only hand out the values read by the data source
+      const auto kind = fIsDataSourceColumn ? RDFInternal::RProfiler::ENodeKind::kColumnRead
+                                            : RDFInternal::RProfiler::ENodeKind::kDefine;
+      fProfileId = fProfiler->AddNode(this, kind, fName);
+   }
 }
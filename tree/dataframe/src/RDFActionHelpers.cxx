@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 
 namespace ROOT {
 namespace Internal {
@@ -37,6 +38,12 @@ ULong64_t &CountHelper::PartialUpdate(unsigned int slot)
    return fCounts[slot];
 }
 
+void ProfileHelper::Finalize()
+{
+   if (auto profiler = fLoopManager->GetProfiler())
+      profiler->FillReport(*fReport);
+}
+
 void FillHelper::UpdateMinMax(unsigned int slot, double v)
 {
    auto &thisMin = fMin[slot];
@@ -1,4 +1,5 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
 
 namespace ROOT {
 namespace Internal {
@@ -25,6 +26,22 @@ void RBookedCustomColumns::AddName(std::string_view name)
    fCustomColumnsNames = newColsNames;
 }
 
+/// Names which are not custom columns are columns of the dataset. The custom columns are followed recursively, each
+/// at most once thanks to visited.
+void RBookedCustomColumns::AddDatasetColumns(const ColumnNames_t &names, std::set<std::string> &datasetColumns,
+                                             std::set<const RDFDetail::RCustomColumnBase *> &visited) const
+{
+   for (const auto &name : names) {
+      const auto it = fCustomColumns->find(name);
+      if (it == fCustomColumns->end()) {
+         datasetColumns.insert(name);
+         continue;
+      }
+      if (visited.insert(it->second.get()).second)
+         it->second->AddDatasetColumns(datasetColumns, visited);
+   }
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -0,0 +1,73 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RResultHandle.hxx"
+#include "TError.h" // Warning
+#include "TROOT.h"  // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
+using ROOT::Detail::RDF::RLoopManager;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Trigger the event loops of the computation graphs of several results at once.
+///
+/// The event loop of each computation graph runs once, even if several of the results belong to it; results that are
+/// already available are skipped, with a warning. The code of all graphs is just-in-time compiled with a single
+/// invocation of the interpreter. With implicit multi-threading enabled, the event loops run concurrently on the
+/// shared thread pool: the tasks of all graphs are interleaved, so that the threads that run out of work on one graph,
+/// e.g. on a small dataset or in the tail of its event loop, process the tasks of the others. This is much faster than
+/// triggering the event loops one after the other when each graph has little work compared to the number of threads.
+/// Without implicit multi-threading, the event loops run one after the other.
+/// ~~~{.cpp}
+/// std::vector<ROOT::RDF::RResultHandle> handles;
+/// for (auto &df : dataframes)
+///    handles.emplace_back(df.Histo1D<float>("x"));
+/// ROOT::RDF::RunGraphs(handles);
+/// ~~~
+/// \param[in] handles the results, of any type, whose computation graphs must run
+/// \return the number of event loops run
+unsigned int ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+{
+   std::vector<RLoopManager *> loopManagers;
+   unsigned int nAlreadyRun = 0;
+   for (const auto &handle : handles) {
+      if (handle.IsReady()) {
+         ++nAlreadyRun;
+         continue;
+      }
+      if (std::find(loopManagers.begin(), loopManagers.end(), handle.fLoopManager) == loopManagers.end())
+         loopManagers.push_back(handle.fLoopManager);
+   }
+   if (nAlreadyRun > 0)
+      Warning("RunGraphs", "%u of the %zu results passed were already available, their event loops are not run again.",
+              nAlreadyRun, handles.size());
+
+   RLoopManager::BuildJittedNodes(loopManagers);
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && loopManagers.size() > 1) {
+      // each event loop splits its work in tasks on the same pool: idle threads pick up the tasks of any graph
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([](RLoopManager *lm) { lm->Run(); }, loopManagers);
+      return loopManagers.size();
+   }
+#endif
+
+   for (auto lm : loopManagers)
+      lm->Run();
+   return loopManagers.size();
+}
@@ -18,18 +18,32 @@
 #include <TChain.h>
 #include <TClass.h>
 #include <TClassEdit.h>
+#include <TEnv.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
+#include <TLockFile.h>
+#include <TMD5.h>
 #include <TObject.h>
 #include <TRegexp.h>
 #include <TPRegexp.h>
+#include <TROOT.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iosfwd>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace ROOT {
 namespace Detail {
@@ -55,13 +69,219 @@ namespace RDF {
 // the one in the vector
 class RActionBase;
 
+/// A declaration whose compilation is deferred to the next batch of the computation graphs that need it, see
+/// InterpreterDeclareDeferred.
+struct RDeferredDeclaration {
+   std::string fCode;
+   std::string fExpression; ///< The user expression the code was generated from, if any, for error messages
+   std::string fLambdaKey;  ///< The key in the lambda cache of the lambda declared by the code, if any
+   std::string fLambdaName; ///< The name of the variable holding the lambda, if any
+   std::string fParams;     ///< The parameters of the lambda, if it can be compiled in the on-disk jit cache
+   std::string fArgs;       ///< The names of the parameters of the lambda, comma-separated
+   std::string fBody;       ///< The expression returned by the lambda
+   bool fIsDeclared = false;
+};
+
+namespace {
+/// The lambdas generated from string expressions by all RDataFrames of the process, each declared once in namespace
+/// __rdf_jit and reused by all nodes with the same code. A lambda requested by several computation graphs is in the
+/// queues of all of them until one of them declares it.
+struct RJitCache {
+   std::mutex fMutex;
+   /// Lambda code -> its declaration
+   std::unordered_map<std::string, std::shared_ptr<RDeferredDeclaration>> fLambdas;
+   unsigned int fNLambdas = 0;
+   /// Libraries of the on-disk jit cache that could not be compiled or loaded in this process
+   std::unordered_set<std::string> fUncached;
+};
+
+RJitCache &GetJitCache()
+{
+   static RJitCache cache;
+   return cache;
+}
+std::string MD5(const std::string &s)
+{
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(s.data()), s.size());
+   md5.Final();
+   return md5.AsString();
+}
+
+/// Compile each lambda of the batch that only depends on ROOT and the standard library in its own shared library of
+/// the on-disk jit cache cacheDir, or load it if a previous process already compiled the same lambda with the same
+/// ROOT version. The lambda is then declared as a call to a function of the library, whose prototype is all the
+/// interpreter needs to parse: the body is hidden from the interpreter, and the return type is read from the library.
+/// A lambda that cannot be compiled on its own, e.g. because it calls a function declared to the interpreter, is
+/// declared as usual, and a .failed marker next to its source tells the next processes not to try again.
+void LoadFromJitCacheDir(const std::vector<RDeferredDeclaration *> &deferred, const std::string &cacheDir,
+                         RJitCache &cache)
+{
+   for (const auto declaration : deferred) {
+      if (declaration->fBody.empty())
+         continue;
+      const auto hash = MD5(declaration->fLambdaKey);
+      const auto fnName = "fn_" + hash;
+      const auto typeFnName = "rdfjit_type_" + hash;
+      const std::string source =
+         "// Generated by RDataFrame, see RDataFrame.JitCacheDir in system.rootrc\n"
+         "// The code is hidden from the interpreter, which only needs the prototype of the function\n"
+         "#ifndef __CLING__\n"
+         "#include \"ROOT/RVec.hxx\"\n"
+         "#include \"Rtypes.h\"\n"
+         "#include \"TClassEdit.h\"\n"
+         "#include \"TMath.h\"\n"
+         "#include <cmath>\n"
+         "#include <cstdlib>\n"
+         "#include <string>\n"
+         "#include <type_traits>\n"
+         "#include <typeinfo>\n"
+         "#include <vector>\n"
+         "using namespace std;\n"
+         "namespace __rdf_jit {\n"
+         "auto " + fnName + "(" + declaration->fParams + ") -> typename std::decay<decltype(" + declaration->fBody +
+         ")>::type { return " + declaration->fBody + "\n; }\n"
+         "template <typename R, typename... Args>\n"
+         "const std::type_info &ReturnTypeOf(R (*)(Args...)) { return typeid(R); }\n"
+         "}\n"
+         "extern \"C\" const char *" + typeFnName + "()\n"
+         "{\n"
+         "   static const std::string name = [] {\n"
+         "      int err = 0;\n"
+         "      char *n = TClassEdit::DemangleTypeIdName(__rdf_jit::ReturnTypeOf(&__rdf_jit::" + fnName + "), err);\n"
+         "      const std::string res = n && err == 0 ? n : \"\";\n"
+         "      free(n);\n"
+         "      return res;\n"
+         "   }();\n"
+         "   return name.c_str();\n"
+         "}\n"
+         "#endif\n";
+      const auto baseName =
+         cacheDir + "/rdfjit_" + MD5(std::string(gROOT->GetVersion()) + gROOT->GetGitCommit() + "\n" + source);
+      if (cache.fUncached.count(baseName))
+         continue;
+      const auto sourceName = baseName + ".cxx";
+      const auto failedName = baseName + ".failed";
+
+      std::string retType;
+      {
+         // Other processes might be compiling the same library at the same time
+         gSystem->mkdir(cacheDir.c_str(), kTRUE);
+         TLockFile lock((baseName + ".lock").c_str(), 600);
+         if (!gSystem->AccessPathName(failedName.c_str())) {
+            // a previous process could not compile this lambda, declare it as usual
+            cache.fUncached.insert(baseName);
+            continue;
+         }
+         if (gSystem->AccessPathName(sourceName.c_str())) {
+            // write a copy, then move it in place, so that the source is never seen half-written
+            const auto tmpName = sourceName + "." + std::to_string(gSystem->GetPid());
+            {
+               std::ofstream out(tmpName);
+               out << source;
+            }
+            gSystem->Rename(tmpName.c_str(), sourceName.c_str());
+         }
+         const bool isCompiled = gSystem->CompileMacro(sourceName.c_str(), "kOs-", "", cacheDir.c_str());
+         const auto typeFn = isCompiled ? reinterpret_cast<const char *(*)()>(
+                                             gSystem->DynFindSymbol("*", typeFnName.c_str()))
+                                        : nullptr;
+         retType = typeFn ? typeFn() : "";
+         if (retType.empty() || (!gROOT->GetType(retType.c_str()) && !TClass::GetClass(retType.c_str()))) {
+            Warning("RDataFrame", "Could not compile the jitted expression \"%s\" in %s, it is not cached.",
+                    declaration->fBody.c_str(), sourceName.c_str());
+            std::ofstream marker(failedName);
+            cache.fUncached.insert(baseName);
+            continue;
+         }
+      }
+
+      declaration->fCode = "namespace __rdf_jit { " + retType + " " + fnName + "(" + declaration->fParams +
+                           "); auto " + declaration->fLambdaName + " = [](" + declaration->fParams + "){ return " +
+                           fnName + "(" + declaration->fArgs + "); }; }\n";
+   }
+}
+} // anonymous namespace
+
 bool InterpreterDeclare(const std::string &code)
 {
    return gInterpreter->Declare(code.c_str());
 }
 
-std::pair<Long64_t, int> InterpreterCalc(const std::string &code)
+void InterpreterDeclareDeferred(const std::string &code, RLoopManager &lm)
 {
+   auto declaration = std::make_shared<RDeferredDeclaration>();
+   declaration->fCode = code + "\n";
+   lm.ToDeclare(declaration);
+}
+
+void InterpreterDeclareDeferredCode(const std::vector<RLoopManager *> &loopManagers)
+{
+   auto &cache = GetJitCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+
+   // the declarations not declared yet by this or another batch, once each as graphs can share lambdas
+   std::vector<RDeferredDeclaration *> deferred;
+   std::unordered_set<RDeferredDeclaration *> seen;
+   for (auto lm : loopManagers) {
+      for (const auto &declaration : lm->GetToDeclare()) {
+         if (!declaration->fIsDeclared && seen.insert(declaration.get()).second)
+            deferred.push_back(declaration.get());
+      }
+   }
+   auto removeDeclared = [&loopManagers]() {
+      for (auto lm : loopManagers) {
+         auto &toDeclare = lm->GetToDeclare();
+         toDeclare.erase(std::remove_if(toDeclare.begin(), toDeclare.end(),
+                                        [](const std::shared_ptr<RDeferredDeclaration> &d) { return d->fIsDeclared; }),
+                         toDeclare.end());
+      }
+   };
+   if (deferred.empty()) {
+      removeDeclared();
+      return;
+   }
+
+   const std::string cacheDir = gEnv->GetValue("RDataFrame.JitCacheDir", "");
+   if (!cacheDir.empty())
+      LoadFromJitCacheDir(deferred, cacheDir, cache);
+   std::string code;
+   for (const auto declaration : deferred)
+      code += declaration->fCode;
+   if (gInterpreter->Declare(code.c_str())) {
+      for (auto declaration : deferred)
+         declaration->fIsDeclared = true;
+      removeDeclared();
+      return;
+   }
+
+   // Some code does not compile: declare the pieces one by one to report the faulty expression. The faulty pieces
+   // stay in the queues of their graphs, so that running them reports the error again, while the lambda cache
+   // forgets them, so that they are declared again if booked again.
+   std::string msg;
+   for (auto declaration : deferred) {
+      if (gInterpreter->Declare(declaration->fCode.c_str())) {
+         declaration->fIsDeclared = true;
+         continue;
+      }
+      if (!declaration->fLambdaKey.empty()) {
+         const auto it = cache.fLambdas.find(declaration->fLambdaKey);
+         if (it != cache.fLambdas.end() && it->second.get() == declaration)
+            cache.fLambdas.erase(it);
+      }
+      if (msg.empty() && !declaration->fExpression.empty())
+         msg = "Cannot interpret the following expression:\n" + declaration->fExpression +
+               "\n\nMake sure it is valid C++.";
+   }
+   removeDeclared();
+   if (msg.empty())
+      msg = "An error occurred while declaring just-in-time compiled code. The lines above might indicate the cause.";
+   throw std::runtime_error(msg);
+}
+
+std::pair<Long64_t, int> InterpreterCalc(const std::string &code, RLoopManager &lm)
+{
+   InterpreterDeclareDeferredCode({&lm});
    TInterpreter::EErrorCode errorCode(TInterpreter::kNoError);
    auto res = gInterpreter->Calc(code.c_str(), &errorCode);
    return std::make_pair(res, errorCode);
@@ -361,7 +581,9 @@ std::vector<std::string> FindUsedColumnNames(std::string_view expression, const
       std::string bNameRegexContent = regexBit + escapedBrName + regexBit;
       TRegexp bNameRegex(bNameRegexContent.c_str());
       if (-1 != bNameRegex.Index(paddedExpr.c_str(), &matchedLen)) {
-         usedBranches.emplace_back(brName);
+         // if not already found among the custom columns, which take the place of branches in systematic variations
+         if (std::find(usedBranches.begin(), usedBranches.end(), brName) == usedBranches.end())
+            usedBranches.emplace_back(brName);
       }
    }
 
@@ -461,36 +683,6 @@ std::vector<std::string> ColumnTypesAsString(ColumnNames_t &colNames, ColumnName
    return colTypes;
 }
 
-// Jit expression "in the vacuum", throw if cling exits with an error
-// This is to make sure that column names, types and expression string are proper C++
-void TryToJitExpression(const std::string &expression, const ColumnNames_t &colNames,
-                        const std::vector<std::string> &colTypes, bool hasReturnStmt)
-{
-   R__ASSERT(colNames.size() == colTypes.size());
-
-   static unsigned int iNs = 0U;
-   std::stringstream dummyDecl;
-   dummyDecl << "namespace __tdf_" << std::to_string(iNs++) << "{ auto tdf_f = []() {";
-
-   for (auto col = colNames.begin(), type = colTypes.begin(); col != colNames.end(); ++col, ++type) {
-      dummyDecl << *type << " " << *col << ";\n";
-   }
-
-   // Now that branches are declared as variables, put the body of the
-   // lambda in dummyDecl and close scopes of f and namespace __tdf_N
-   if (hasReturnStmt)
-      dummyDecl << expression << "\n;};}";
-   else
-      dummyDecl << "return " << expression << "\n;};}";
-
-   // Try to declare the dummy lambda, error out if it does not compile
-   if (!gInterpreter->Declare(dummyDecl.str().c_str())) {
-      auto msg =
-         "Cannot interpret the following expression:\n" + std::string(expression) + "\n\nMake sure it is valid C++.";
-      throw std::runtime_error(msg);
-   }
-}
-
 std::string
 BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes, bool hasReturnStmt)
 {
@@ -514,6 +706,42 @@ BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const Colu
    return ss.str();
 }
 
+// Return the name of a variable holding the lambda, shared by all the nodes of all RDataFrames that use the same
+// code. The first time some code is requested, its declaration is deferred to the next batch, see
+// InterpreterDeclareDeferred: if the expression is not valid C++, the error is reported then.
+// Lambdas with a single return statement and no parameter of the type of a jitted custom column are compiled in
+// the on-disk jit cache, if RDataFrame.JitCacheDir is set.
+std::string GetJittedLambda(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes,
+                            bool hasReturnStmt, std::string_view expression, RLoopManager &lm)
+{
+   const auto lambdaCode = BuildLambdaString(expr, vars, varTypes, hasReturnStmt);
+   auto &cache = GetJitCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   auto &declaration = cache.fLambdas[lambdaCode];
+   if (!declaration) {
+      const auto varName = "lambda" + std::to_string(cache.fNLambdas++);
+      declaration = std::make_shared<RDeferredDeclaration>();
+      declaration->fCode = "namespace __rdf_jit { auto " + varName + " = " + lambdaCode + "; }\n";
+      declaration->fExpression = std::string(expression);
+      declaration->fLambdaKey = lambdaCode;
+      declaration->fLambdaName = varName;
+      const auto isCacheable =
+         !hasReturnStmt && std::none_of(varTypes.begin(), varTypes.end(),
+                                        [](const std::string &t) { return t.find("__tdf") != std::string::npos; });
+      if (isCacheable) {
+         for (auto i = 0u; i < vars.size(); ++i) {
+            declaration->fParams += (i ? ", " : "") + varTypes[i] + "& " + vars[i];
+            declaration->fArgs += (i ? ", " : "") + vars[i];
+         }
+         declaration->fBody = expr;
+      }
+   }
+   // declared with the next batch of this graph, unless another graph declares it first
+   if (!declaration->fIsDeclared)
+      lm.ToDeclare(declaration);
+   return "__rdf_jit::" + declaration->fLambdaName;
+}
+
 std::string PrettyPrintAddr(const void *const addr)
 {
    std::stringstream s;
@@ -522,6 +750,66 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Return whether expression is a range cut on column, i.e. one comparison or a conjunction (`&&`) of comparisons of
+/// column with numbers, such as `x > 1 && x <= 3` or `2 < x`. If it is, cut is set to the closed interval of the
+/// values passing it; strict comparisons are treated as inclusive, so that the values passing the cut are a subset
+/// of the interval.
+bool ParseRangeCut(std::string_view expression, const std::string &column, RDataSource::RRangeCut &cut)
+{
+   std::string expr(expression);
+   if (expr.find("||") != std::string::npos)
+      return false;
+
+   // Since we support gcc48 and it does not provide in its stl std::regex, we use TPRegexp
+   TPRegexp columnFirst("^\\s*\\(?\\s*([a-zA-Z_][a-zA-Z0-9_]*)\\s*(<=|>=|==|<|>)\\s*([^\\s()]+)\\s*\\)?\\s*$");
+   TPRegexp numberFirst("^\\s*\\(?\\s*([^\\s()<>=]+)\\s*(<=|>=|==|<|>)\\s*([a-zA-Z_][a-zA-Z0-9_]*)\\s*\\)?\\s*$");
+   auto toNumber = [](const TString &s, double &d) {
+      char *end = nullptr;
+      d = std::strtod(s.Data(), &end);
+      return end != s.Data() && *end == '\0' && std::isfinite(d);
+   };
+
+   cut = {column, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+   std::string::size_type begin = 0;
+   while (begin <= expr.size()) {
+      auto end = expr.find("&&", begin);
+      if (end == std::string::npos)
+         end = expr.size();
+      const TString term(expr.substr(begin, end - begin));
+      begin = end + 2;
+
+      // the comparison is normalized to `column op value`
+      TString op;
+      double value;
+      auto matches = columnFirst.MatchS(term);
+      if (matches->GetLast() == 3 && matches->At(1)->GetName() == column &&
+          toNumber(matches->At(3)->GetName(), value)) {
+         op = matches->At(2)->GetName();
+      } else {
+         delete matches;
+         matches = numberFirst.MatchS(term);
+         if (matches->GetLast() != 3 || matches->At(3)->GetName() != column ||
+             !toNumber(matches->At(1)->GetName(), value)) {
+            delete matches;
+            return false;
+         }
+         op = matches->At(2)->GetName();
+         if (op.BeginsWith("<"))
+            op.Replace(0, 1, ">");
+         else if (op.BeginsWith(">"))
+            op.Replace(0, 1, "<");
+      }
+      delete matches;
+
+      if (op == "==" || op.BeginsWith(">"))
+         cut.fMin = std::max(cut.fMin, value);
+      if (op == "==" || op.BeginsWith("<"))
+         cut.fMax = std::min(cut.fMax, value);
+   }
+   return true;
+}
+
 // Jit a string filter expression and jit-and-call this->Filter with the appropriate arguments
 // Return pointer to the new functional chain node returned by the call, cast to Long_t
 
@@ -543,9 +831,9 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
    Ssiz_t matchedLen;
    const bool hasReturnStmt = re.Index(dotlessExpr, &matchedLen) != -1;
 
-   TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
-
-   const auto filterLambda = BuildLambdaString(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   const auto filterLambda =
+      GetJittedLambda(dotlessExpr, varNames, usedColTypes, hasReturnStmt, expression,
+                      *jittedFilter->GetLoopManagerUnchecked());
 
    const auto jittedFilterAddr = PrettyPrintAddr(jittedFilter);
    const auto prevNodeAddr = PrettyPrintAddr(prevNodeOnHeap);
@@ -557,7 +845,8 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
    // Produce code snippet that creates the filter and registers it with the corresponding RJittedFilter
    // Windows requires std::hex << std::showbase << (size_t)pointer to produce notation "0x1234"
    std::stringstream filterInvocation;
-   filterInvocation << "ROOT::Internal::RDF::JitFilterHelper(" << filterLambda << ", {";
+   filterInvocation << "ROOT::Internal::RDF::JitFilterHelper(decltype(" << filterLambda << ")(" << filterLambda
+                    << "), {";
    for (const auto &brName : usedBranches) {
       // Here we selectively replace the brName with the real column name if it's necessary.
       const auto aliasMapIt = aliasMap.find(brName);
@@ -572,6 +861,17 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
                     << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(" << columnsOnHeapAddr << ")"
                     << ");";
 
+   // a filter on a single column of the data source, hanging directly from the loop manager, can be pushed down to
+   // the data source if it is a range cut, see RLoopManager::GetEntryCuts
+   auto prevNode = static_cast<std::shared_ptr<RNodeBase> *>(prevNodeOnHeap)->get();
+   if (ds && prevNode == jittedFilter->GetLoopManagerUnchecked() && usedBranches.size() == 1 &&
+       !customCols.HasName(usedBranches[0]) && aliasMap.find(usedBranches[0]) == aliasMap.end() &&
+       ds->HasColumn(usedBranches[0])) {
+      RDataSource::RRangeCut cut;
+      if (ParseRangeCut(expression, usedBranches[0], cut))
+         jittedFilter->SetRangeCut(cut);
+   }
+
    jittedFilter->GetLoopManagerUnchecked()->ToJit(filterInvocation.str());
 }
 
@@ -596,26 +896,25 @@ void BookDefineJit(std::string_view name, std::string_view expression, RLoopMana
    Ssiz_t matchedLen;
    const bool hasReturnStmt = re.Index(dotlessExpr, &matchedLen) != -1;
 
-   TryToJitExpression(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
-
-   const auto definelambda = BuildLambdaString(dotlessExpr, varNames, usedColTypes, hasReturnStmt);
+   const auto defineLambda =
+      GetJittedLambda(dotlessExpr, varNames, usedColTypes, hasReturnStmt, expression, lm);
    const auto customColID = std::to_string(jittedCustomColumn->GetID());
-   const auto lambdaName = "eval_" + std::string(name) + customColID;
    const auto ns = "__tdf" + std::to_string(namespaceID);
 
    auto customColumnsCopy = new RDFInternal::RBookedCustomColumns(customCols);
    auto customColumnsAddr = PrettyPrintAddr(customColumnsCopy);
 
-   // Declare the lambda variable and an alias for the type of the defined column in namespace __tdf
+   // Declare an alias for the type of the defined column in namespace __tdf, with the next batch of declarations
    // This assumes that a given variable is Define'd once per RDataFrame -- we might want to relax this requirement
    // to let python users execute a Define cell multiple times
-   const auto defineDeclaration =
-      "namespace " + ns + " { auto " + lambdaName + " = " + definelambda + ";\n" + "using " + std::string(name) +
-      customColID + "_type = typename ROOT::TypeTraits::CallableTraits<decltype(" + lambdaName + " )>::ret_type;  }\n";
-   gInterpreter->Declare(defineDeclaration.c_str());
+   InterpreterDeclareDeferred("namespace " + ns + " { using " + std::string(name) + customColID +
+                              "_type = typename ROOT::TypeTraits::CallableTraits<decltype(" + defineLambda +
+                              ")>::ret_type; }",
+                              lm);
 
    std::stringstream defineInvocation;
-   defineInvocation << "ROOT::Internal::RDF::JitDefineHelper(" << definelambda << ", {";
+   defineInvocation << "ROOT::Internal::RDF::JitDefineHelper(decltype(" << defineLambda << ")(" << defineLambda
+                    << "), {";
    for (auto brName : usedBranches) {
       // Here we selectively replace the brName with the real column name if it's necessary.
       auto aliasMapIt = aliasMap.find(brName);
@@ -659,20 +958,18 @@ std::string JitBuildAction(const ColumnNames_t &bl, void *prevNode, const std::t
    }
 
    // retrieve type of result of the action as a string
-   auto actionResultTypeClass = TClass::GetClass(art);
-   if (!actionResultTypeClass) {
+   const auto actionResultTypeName = TypeID2TypeName(art);
+   if (actionResultTypeName.empty()) {
       std::string exceptionText = "An error occurred while inferring the result type of an operation.";
       throw std::runtime_error(exceptionText.c_str());
    }
-   const auto actionResultTypeName = actionResultTypeClass->GetName();
 
    // retrieve type of action as a string
-   auto actionTypeClass = TClass::GetClass(at);
-   if (!actionTypeClass) {
+   const auto actionTypeName = TypeID2TypeName(at);
+   if (actionTypeName.empty()) {
       std::string exceptionText = "An error occurred while inferring the action type of the operation.";
       throw std::runtime_error(exceptionText.c_str());
    }
-   const auto actionTypeName = actionTypeClass->GetName();
 
    auto customColumnsCopy = new RDFInternal::RBookedCustomColumns(customCols); // deleted in jitted CallBuildAction
    auto customColumnsAddr = PrettyPrintAddr(customColumnsCopy);
@@ -22,9 +22,12 @@
 #include "TROOT.h" // IsImplicitMTEnabled, GetImplicitMTPoolSize
 #include "TTree.h"
 
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <typeindex>
 #include <typeinfo>
+#include <unordered_map>
 
 using namespace ROOT::Detail::RDF;
 using namespace ROOT::RDF;
@@ -75,11 +78,8 @@ const std::type_info &TypeName2TypeID(const std::string &name)
    }
 }
 
-/// Returns the name of a type starting from its type_info
-/// An empty string is returned in case of failure
-/// References and pointers are not supported since those cannot be stored in
-/// columns.
-std::string TypeID2TypeName(const std::type_info &id)
+namespace {
+std::string TypeID2TypeNameImpl(const std::type_info &id)
 {
    if (auto c = TClass::GetClass(id)) {
       return c->GetName();
@@ -112,6 +112,31 @@ std::string TypeID2TypeName(const std::type_info &id)
    else
       return "";
 }
+} // anonymous namespace
+
+/// Returns the name of a type starting from its type_info
+/// An empty string is returned in case of failure
+/// References and pointers are not supported since those cannot be stored in
+/// columns.
+/// Names are cached, as they are looked up at each booking of a node and the lookup might involve the interpreter.
+std::string TypeID2TypeName(const std::type_info &id)
+{
+   static std::mutex mutex;
+   static std::unordered_map<std::type_index, std::string> names;
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto it = names.find(id);
+      if (it != names.end())
+         return it->second;
+   }
+   auto name = TypeID2TypeNameImpl(id);
+   // a failed lookup is not cached: the type might be made known to the interpreter later
+   if (!name.empty()) {
+      std::lock_guard<std::mutex> lock(mutex);
+      names.emplace(id, name);
+   }
+   return name;
+}
 
 std::string ComposeRVecTypeName(const std::string &valueType)
 {
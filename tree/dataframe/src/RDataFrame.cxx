@@ -69,6 +69,7 @@ Transformations are a way to manipulated the data.
 | [DefineSlotEntry](classROOT_1_1RDF_1_1RInterface.html#a4f17074d5771916e3df18f8458186de7) | Same as `DefineSlot`, but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | [Filter](classROOT_1_1RDF_1_1RInterface.html#a70284a3bedc72b19610aaa91b5007ebd) | Filter the rows of the dataset. |
 | [Range](classROOT_1_1RDF_1_1RInterface.html#a1b36b7868831de2375e061bb06cfc225) | Creates a node that filters entries based on range of entries |
+| [Vary](classROOT_1_1RDF_1_1RInterface.html) | Declares systematic variations of a column: downstream results are also computed for each variation, in the same event loop. |
 
 ### Actions
 Actions are a way to produce a result out of the data. Each one is described in more detail in the reference guide.
@@ -84,7 +85,7 @@ produce several different results in one event loop. Instant actions trigger the
 |------------------|-----------------|
 | [Aggregate](classROOT_1_1RDF_1_1RInterface.html#ae540b00addc441f9b504cbae0ef0a24d) | Execute a user-defined accumulation operation on the processed column values. |
 | [Book](classROOT_1_1RDF_1_1RInterface.html#a9b2f61f3333d1669e57055b9ae8be9d9) | Book execution of a custom action using a user-defined helper object. |
-| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). With `RCacheOptions`, entries are stored in chunks, compressed and possibly moved to a scratch file, processed in parallel. |
 | [Count](classROOT_1_1RDF_1_1RInterface.html#a37f9e00c2ece7f53fae50b740adc1456) | Return the number of events processed. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#aee68f4411f16f00a1d46eccb6d296f01) | Obtains the events in the dataset for the requested columns. The method returns a [RDisplay](classROOT_1_1RDF_1_1RDisplay.html) instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | [Fill](classROOT_1_1RDF_1_1RInterface.html#a0cac4d08297c23d16de81ff25545440a) | Fill a user-defined object with the values of the specified branches, as if by calling `Obj.Fill(branch1, branch2, ...). |
@@ -93,6 +94,7 @@ produce several different results in one event loop. Instant actions trigger the
 | [Max](classROOT_1_1RDF_1_1RInterface.html#a057179b1e77599466a0b02200d5cd8c3) | Return the maximum of processed branch values. If the type of the column is inferred, the return type is `double`, the type of the column otherwise.|
 | [Mean](classROOT_1_1RDF_1_1RInterface.html#ade6b020284f2f4fe9d3b09246b5f376a) | Return the mean of processed branch values.|
 | [Min](classROOT_1_1RDF_1_1RInterface.html#a7005702189e601972b6d19ecebcdc80c) | Return the minimum of processed branch values. If the type of the column is inferred, the return type is `double`, the type of the column otherwise.|
+| [Profile](classROOT_1_1RDF_1_1RInterface.html) | Measures where the time of the event loop is spent. See the section on [profiling](#profiling) for a more detailed explanation. The method returns a RProfileReport instance with the time spent in each node of the computation graph and in each processing slot. |
 | [Profile{1D,2D}](classROOT_1_1RDF_1_1RInterface.html#a8ef7dc16b0e9f7bc9cfbe2d9e5de0cef) | Fill a {one,two}-dimensional profile with the branch values that passed all filters. |
 | [Reduce](classROOT_1_1RDF_1_1RInterface.html#a118e723ae29834df8f2a992ded347354) | Reduce (e.g. sum, merge) entries using the function (lambda, functor...) passed as argument. The function must have signature `T(T,T)` where `T` is the type of the branch. Return the final result of the reduction operation. An optional parameter allows initialization of the result object to non-default values. |
 | [Report](classROOT_1_1RDF_1_1RInterface.html#a94f322531dcb25beb8f53a602e5d6332) | Obtains statistics on how many entries have been accepted and rejected by the filters. See the section on [named filters](#named-filters-and-cutflow-reports) for a more detailed explanation. The method returns a RCutFlowReport instance which can be queried programmatically to get information about the effects of the individual cuts. |
@@ -119,6 +121,7 @@ produce several different results in one event loop. Instant actions trigger the
 | [GetFilterNames](classROOT_1_1RDF_1_1RInterface.html#a25026681111897058299161a70ad9bb2) | Get all the filters defined. If called on a root node, all filters will be returned. For any other node, only the filters upstream of that node. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#a652f9ab3e8d2da9335b347b540a9a941) | Provides an ASCII representation of the columns types and contents of the dataset printable by the user. |
 | [SaveGraph](namespaceROOT_1_1RDF.html#adc17882b283c3d3ba85b1a236197c533) | Store the computation graph of an RDataFrame in graphviz format for easy inspection. |
+| [RunGraphs](namespaceROOT_1_1RDF.html) | Run the event loops of several computation graphs at once, concurrently with implicit multi-threading. |
 
 
 ## <a name="introduction"></a>Introduction
@@ -428,6 +431,45 @@ and return nothing. RDataFrame will invoke registered callbacks passing partial
 
 Read more on RResultPtr::OnPartialResult().
 
+### <a name="bulk-processing"></a>Bulk processing
+By default, each entry goes through the whole computation graph before the next one is read. For simple, fast
+selections on flat datasets the cost of moving from one node to the next can then dominate the event loop.
+`SetBulkSize` changes this: entries are read in blocks, the values of the columns of each block are copied
+in contiguous arrays and each node (filter, custom column, action) processes the whole block before the next node
+runs. Filters compute a selection mask for the block, which downstream nodes use to skip the rejected entries.
+Each node receives the values of its columns for the whole block as contiguous arrays, and loops over them without
+any per-entry dispatch: simple expressions and the `Count`, `Sum`, `Min`, `Max` and `Mean` actions run as tight loops
+over these arrays, which the compiler can vectorize.
+~~~{.cpp}
+ROOT::RDataFrame d("myTree", "file.root");
+d.SetBulkSize(1024); // applies to all event loops that run from now on
+auto h = d.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+~~~
+Results do not change, but the order in which the expressions of different nodes are called does: user code must not
+rely on it. Bulk processing requires all columns read from a TTree or a data source to be of fundamental types, and
+does not apply to `Snapshot`: if that is not the case, the entries are processed one at a time. When an event loop is
+stopped early by `Range`, named filters may have evaluated up to a block of entries more than otherwise, as reported
+by `Report`.
+
+### <a name="systematic-variations"></a>Systematic variations
+`Vary` declares alternative values of a column, e.g. the result of varying a calibration up and down. Every
+transformation and action booked downstream is then also computed for each variation, in the same event loop:
+`ROOT::RDF::VariationsFor` returns the results of an action for all the variations, keyed by their names.
+~~~{.cpp}
+auto df = d.Vary("pt", [](float pt) { return ROOT::RVec<float>{pt * 0.98f, pt * 1.02f}; }, {"pt"}, {"down", "up"},
+                 "ptScale");
+auto h = df.Filter("pt > 20").Define("pt2", "pt * pt").Histo1D<float>("pt2");
+auto hs = ROOT::RDF::VariationsFor(h);
+hs["nominal"]->Draw();
+hs["ptScale:up"]->Draw("SAME");
+~~~
+Only the part of the computation graph that depends on a varied column is evaluated again for a variation: filters,
+custom columns and actions that do not read it, directly or through other custom columns, are shared with the nominal
+results and evaluated once per entry. The varied values must have the same type as the column they replace. Variations
+declared by different calls to `Vary` are independent, each one changing a single column. Varied filters are not
+named, so they do not appear in `Report`, and `Cache`, `Snapshot`, `Take`, `Foreach`, `Reduce`, `Aggregate`, `Book` and
+`Display` only produce nominal results.
+
 ### Default branch lists
 When constructing a `RDataFrame` object, it is possible to specify a **default column list** for your analysis, in the
 usual form of a list of strings representing branch/column names. The default column list will be used as a fallback
@@ -541,6 +583,13 @@ RDataFrame d(t);
 auto f = d.Filter("myFriend.MyCol == 42");
 ~~~
 
+### Branches read during the event loop
+Right before the event loop starts, RDataFrame collects the columns read by the filters and actions of the
+computation graph, directly or through custom columns. Only their branches are enabled in the tree and its friends
+while the event loop runs, and the `TTreeCache` of each tree is set up to prefetch exactly those branches. The branch
+statuses are restored at the end of the event loop. If some branches of the tree were disabled by the user, e.g. with
+`TTree::SetBranchStatus`, RDataFrame reads the branches the user enabled instead.
+
 ### Reading file formats different from ROOT's
 RDataFrame can be interfaced with RDataSources. The RDataSource interface defines an API that RDataFrame can use to read arbitrary data formats.
 
@@ -558,6 +607,12 @@ auto h = filteredEvents.Histo1D("m");
 h->Draw();
 ~~~
 
+Apache Parquet files can be read with `ROOT::RDF::MakeParquetDataFrame`. Its entry ranges are the row groups of the
+file, and only the columns used by the computation graph are read. When every path of the graph starts with a jitted
+Filter which cuts a range of values of a single column of the file, e.g. `Filter("x > 10 && x < 20")`, the cuts are
+passed to the data source with `RDataSource::SetEntryCuts`, and the row groups whose statistics show that no entry can
+pass the cuts are not read at all.
+
 ### <a name="callgraphs"></a>Call graphs (storing and reusing sets of transformations)
 **Sets of transformations can be stored as variables** and reused multiple times to create **call graphs** in which
 several paths of filtering/creation of columns are executed simultaneously; we often refer to this as "storing the
@@ -684,10 +739,24 @@ relative all named filters in the section of the chain between the main `RDataFr
 Stats are stored in the same order as named filters have been added to the graph, and *refer to the latest event-loop*
 that has been run using the relevant `RDataFrame`.
 
+#### <a name="profiling"></a>Profiling
+Booking a `Profile` action makes the next event loop time every node of the computation graph: the evaluations of the
+filters, the computations of the custom columns, the executions of the actions and the reads of the columns of the
+dataset. The time of a node excludes the time spent in the nodes it triggers, so that the time of an action does not
+include the time spent reading its columns. The returned RProfileReport also gives the compressed bytes read for the
+columns of a TTree, and the entries processed and the time spent reading and computing in each processing slot:
+~~~{.cpp}
+auto df = d.Filter("x > 0").Define("y", "x * x");
+auto h = df.Histo1D("y");
+auto profile = df.Profile();
+profile->Print();
+std::ofstream("trace.json") << profile->AsChromeTrace(); // the tasks of each slot, see chrome://tracing
+~~~
+`RProfileReport::AsJSON` returns all measurements as JSON. Event loops without a `Profile` action are not timed.
+
 ### <a name="ranges"></a>Ranges
-When `RDataFrame` is not being used in a multi-thread environment (i.e. no call to `EnableImplicitMT` was made),
-`Range` transformations are available. These act very much like filters but instead of basing their decision on
-a filter expression, they rely on `begin`,`end` and `stride` parameters.
+`Range` transformations act very much like filters but instead of basing their decision on a filter expression, they
+rely on `begin`,`end` and `stride` parameters.
 
 - `begin`: initial entry number considered for this range.
 - `end`: final entry number (excluded) considered for this range. 0 means that the range goes until the end of the dataset.
@@ -704,6 +773,13 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+In a multi-thread environment (i.e. after a call to `EnableImplicitMT`) entries are processed in no particular order,
+so ranges can only hang directly from the `RDataFrame` (possibly after `Define`s, but not after filters or other
+ranges), and they select entries by their number in the dataset: for TTrees and TChains, the entry number in the
+chain. The selected entries are the same as in a single-thread event loop, but they reach the downstream nodes in no
+particular order. Only the clusters of entries that can pass the ranges are read, so that the event-loop ends early
+as well if all branches of execution hang from ranges. Multi-thread ranges cannot be used on TTrees with an entry list.
+
 ### <a name="custom-columns"></a> Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
 (function, lambda expression, functor class...); it takes the values of the columns listed in `columnList` (a list of
@@ -731,6 +807,27 @@ will create a new column called "pt" the value of which is calculated starting f
 builds a just-in-time compiled function starting from the expression after having deduced the list of necessary branches
 from the names of the variables specified by the user.
 
+The functions built from the expressions of all filters and custom columns booked on a computation graph are compiled
+together, right before its event loop: booking many expressions costs a single invocation of the interpreter. Functions
+with the same code, i.e. the same expression applied to columns of the same types, are compiled only once and shared by
+all nodes, of any `RDataFrame`. As a consequence, an expression that is not valid C++ is reported by an exception when
+the event loop of its computation graph is triggered rather than when the node is booked; the other computation graphs
+are not affected.
+
+The compiled functions can also be shared among processes, e.g. the many jobs of a batch submission, by setting
+`RDataFrame.JitCacheDir` in `.rootrc` to a directory, possibly shared:
+
+~~~
+RDataFrame.JitCacheDir: /path/to/jit/cache
+~~~
+
+Expressions that only use ROOT and the standard library (and not the types of other just-in-time compiled custom
+columns) are then compiled, with ACLiC, each in a shared library stored in that directory, named after a hash of its
+code and of the ROOT version. The following processes that build the same expression load the library instead of
+compiling it, and the interpreter only parses the prototype of the function. Processes sharing the directory compile a
+given library one at a time. If an expression cannot be compiled on its own, e.g. because it calls a function declared
+to the interpreter, it is compiled as usual, without affecting the other expressions.
+
 #### Custom columns as function of slot and entry number
 
 It is possible to create custom columns also as a function of the processing slot and entry numbers. The methods that can
@@ -756,6 +853,25 @@ processing of these batches. There are no guarantees on the order the batches ar
 order entries of the dataset are processed. Note that this in turn means that, for multi-thread event loops, there is no
 guarantee on the order in which `Snapshot` will _write_ entries: they could be scrambled with respect to the input dataset.
 
+### <a name="run-graphs"></a>Running several computation graphs concurrently
+Each `RDataFrame` runs its own event loop. When analysing many datasets, e.g. one `RDataFrame` per sample, triggering
+the event loops one after the other leaves threads idle whenever a dataset has few entries compared to the number of
+threads, and in the tail of each event loop. `ROOT::RDF::RunGraphs` runs the event loops of several computation graphs
+at once, interleaving their tasks on the same thread pool and just-in-time compiling the code of all graphs with a
+single invocation of the interpreter. The results are passed as `ROOT::RDF::RResultHandle`s, which wrap `RResultPtr`s
+of any type:
+~~~{.cpp}
+ROOT::EnableImplicitMT();
+std::vector<ROOT::RDF::RResultHandle> handles;
+std::vector<ROOT::RDF::RResultPtr<TH1D>> histos;
+for (auto &df : dataframes) {
+   histos.emplace_back(df.Filter("x > 0").Histo1D("x"));
+   handles.emplace_back(histos.back());
+}
+ROOT::RDF::RunGraphs(handles); // all histograms are filled concurrently
+~~~
+User-defined expressions of different graphs may then run concurrently, and must not share state unprotected.
+
 ### Thread-safety of user-defined expressions
 RDataFrame operations such as `Histo1D` or `Snapshot` are guaranteed to work correctly in multi-thread event loops.
 User-defined expressions, such as strings or lambdas passed to `Filter`, `Define`, `Foreach`, `Reduce` or `Aggregate`
@@ -896,6 +1012,16 @@ RDataFrame::RDataFrame(std::unique_ptr<ROOT::RDF::RDataSource> ds, const ColumnN
 {
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// \brief Process the entries of the following event loops in blocks of bulkSize entries.
+/// \param[in] bulkSize The number of entries of a block, 0 to process entries one at a time (the default).
+///
+/// See [Bulk processing](#bulk-processing).
+void RDataFrame::SetBulkSize(unsigned int bulkSize)
+{
+   GetLoopManager()->SetBulkSize(bulkSize);
+}
+
 } // namespace ROOT
 
 namespace cling {
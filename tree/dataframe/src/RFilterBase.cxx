@@ -10,14 +10,15 @@
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include <numeric> // std::accumulate
 
 using namespace ROOT::Detail::RDF;
 
 RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const unsigned int nSlots,
                          const RDFInternal::RBookedCustomColumns &customColumns)
-   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fName(name), fNSlots(nSlots),
-     fCustomColumns(customColumns) {}
+   : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fLastCheckedBlock(nSlots, 0ull),
+     fLastBulkMask(nSlots), fName(name), fNSlots(nSlots), fCustomColumns(customColumns) {}
 
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
@@ -46,4 +47,8 @@ void RFilterBase::InitNode()
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
+   fProfiler = fLoopManager->GetProfiler();
+   if (fProfiler)
+      fProfileId = fProfiler->AddNode(this, RDFInternal::RProfiler::ENodeKind::kFilter,
+                                      fName.empty() ? "Unnamed Filter" : fName);
 }
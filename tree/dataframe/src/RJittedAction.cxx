@@ -24,6 +24,12 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBulk(unsigned int slot, const RBulkBlock &block)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunBulk(slot, block);
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -82,6 +88,13 @@ void RJittedAction::ClearValueReaders(unsigned int slot)
    return fConcreteAction->ClearValueReaders(slot);
 }
 
+void RJittedAction::AddDatasetColumns(std::set<std::string> &columns,
+                                      std::set<const RCustomColumnBase *> &visited) const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->AddDatasetColumns(columns, visited);
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    R__ASSERT(fConcreteAction != nullptr);
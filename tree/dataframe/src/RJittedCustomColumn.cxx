@@ -37,6 +37,18 @@ void RJittedCustomColumn::Update(unsigned int slot, Long64_t entry)
    fConcreteCustomColumn->Update(slot, entry);
 }
 
+void RJittedCustomColumn::UpdateBulk(unsigned int slot, const RBulkBlock &block, const std::vector<char> &mask)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   fConcreteCustomColumn->UpdateBulk(slot, block, mask);
+}
+
+void *RJittedCustomColumn::GetBulkValuePtr(unsigned int slot)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetBulkValuePtr(slot);
+}
+
 void RJittedCustomColumn::ClearValueReaders(unsigned int slot)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
@@ -48,3 +60,10 @@ void RJittedCustomColumn::InitNode()
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->InitNode();
 }
+
+void RJittedCustomColumn::AddDatasetColumns(std::set<std::string> &columns,
+                                            std::set<const RCustomColumnBase *> &visited) const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   fConcreteCustomColumn->AddDatasetColumns(columns, visited);
+}
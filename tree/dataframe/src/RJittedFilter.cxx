@@ -12,6 +12,7 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RJittedFilter.hxx"
+#include "ROOT/RMakeUnique.hxx"
 
 using namespace ROOT::Detail::RDF;
 
@@ -23,6 +24,18 @@ void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
    fConcreteFilter = std::move(f);
 }
 
+/// Set the cut on a column of the data source equivalent to this filter, which hangs directly from the loop manager.
+void RJittedFilter::SetRangeCut(const ROOT::RDF::RDataSource::RRangeCut &cut)
+{
+   fRangeCut = std::make_unique<ROOT::RDF::RDataSource::RRangeCut>(cut);
+}
+
+bool RJittedFilter::HasChildren() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->HasChildren();
+}
+
 void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -35,6 +48,12 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const std::vector<char> &RJittedFilter::CheckFiltersBulk(unsigned int slot, const RBulkBlock &block)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBulk(slot, block);
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -95,6 +114,13 @@ void RJittedFilter::ClearTask(unsigned int slot)
    fConcreteFilter->ClearTask(slot);
 }
 
+void RJittedFilter::AddDatasetColumns(std::set<std::string> &columns,
+                                      std::set<const RCustomColumnBase *> &visited) const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->AddDatasetColumns(columns, visited);
+}
+
 void RJittedFilter::InitNode()
 {
    R__ASSERT(fConcreteFilter != nullptr);
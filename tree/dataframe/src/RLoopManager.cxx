@@ -1,4 +1,5 @@
 #include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RDF/InterfaceUtils.hxx" // InterpreterDeclareDeferredCode
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RCustomColumnBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
@@ -11,16 +12,22 @@
 #include "TEntryList.h"
 #include "TError.h"
 #include "TInterpreter.h"
+#include "TChain.h"
+#include "TFriendElement.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TTreeCache.h"
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -173,6 +180,192 @@ ColumnNames_t ROOT::Internal::RDF::GetBranchNames(TTree &t, bool allowDuplicates
    return bNames;
 }
 
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+/// Add t and its friend trees, recursively, to trees.
+void GetTreeAndFriends(TTree &t, std::vector<TTree *> &trees)
+{
+   if (std::find(trees.begin(), trees.end(), &t) != trees.end())
+      return;
+   trees.emplace_back(&t);
+   auto friendTrees = t.GetListOfFriends();
+   if (!friendTrees)
+      return;
+   for (auto friendTreeObj : *friendTrees) {
+      auto friendTree = static_cast<TFriendElement *>(friendTreeObj)->GetTree();
+      if (friendTree)
+         GetTreeAndFriends(*friendTree, trees);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Whether the user disabled some branches of t, in which case RDataFrame leaves the statuses of the branches alone.
+bool HasDisabledBranches(TTree &t)
+{
+   auto chain = dynamic_cast<TChain *>(&t);
+   if (chain && chain->GetStatus() && chain->GetStatus()->GetSize() > 0)
+      return true;
+   auto leaves = t.GetListOfLeaves();
+   if (!leaves)
+      return false;
+   for (auto leaf : *leaves) {
+      auto branch = static_cast<TLeaf *>(leaf)->GetBranch();
+      if (branch && branch->TestBit(kDoNotProcess))
+         return true;
+   }
+   return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Return the branch, of t or of one of its friends, holding the values of the column, null if there is none.
+TBranch *FindColumnBranch(TTree &t, const std::string &column)
+{
+   if (auto branch = t.FindBranch(column.c_str()))
+      return branch;
+   if (auto leaf = t.FindLeaf(column.c_str()))
+      return leaf->GetBranch();
+   return t.GetBranch(column.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Enable branch and all its sub-branches, together with their leaf count branches.
+void EnableBranch(TTree &t, TBranch &branch, std::vector<TBranch *> &enabled)
+{
+   UInt_t found = 0; // passing it silences the errors about branches only present in some of the trees
+   t.SetBranchStatus(branch.GetName(), true, &found);
+   enabled.emplace_back(&branch);
+   for (auto subBranch : *branch.GetListOfBranches())
+      EnableBranch(t, *static_cast<TBranch *>(subBranch), enabled);
+}
+
+/// The state of a TTreeCache before PruneBranches set it up, to restore it afterwards.
+struct RCacheState {
+   TTreeCache *fCache = nullptr;
+   bool fWasLearning = false;            ///< Whether the cache was learning which branches to cache
+   std::vector<std::string> fAddedNames; ///< The names of the branches added to the cache
+   bool fCreated = false;                ///< Whether PruneBranches created the cache, for a friend tree
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// Enable only the branches of t and of its friends which hold the given columns, and set up the TTreeCache of each
+/// tree reading them with exactly those branches, skipping its learning phase. The previous state of the caches is
+/// appended to cacheStates, including the ones created for the friend trees.
+/// Return false, leaving t untouched, if some of the branches are already disabled or if some of the columns cannot
+/// be associated with a branch, e.g. because they refer to data members of unsplit objects.
+bool PruneBranches(TTree &t, const ColumnNames_t &columns, std::vector<RCacheState> &cacheStates)
+{
+   std::vector<TTree *> trees;
+   GetTreeAndFriends(t, trees);
+   for (auto tree : trees) {
+      if (HasDisabledBranches(*tree))
+         return false;
+   }
+
+   std::vector<TBranch *> branches;
+   for (const auto &column : columns) {
+      auto branch = FindColumnBranch(t, column);
+      if (!branch)
+         return false;
+      // the values of sub-branches may be read through their top-level branch
+      branches.emplace_back(branch->GetMother() ? branch->GetMother() : branch);
+   }
+
+   t.SetBranchStatus("*", false);
+   std::vector<TBranch *> enabled;
+   for (auto branch : branches)
+      EnableBranch(t, *branch, enabled);
+
+   std::vector<TTree *> cachedTrees;
+   for (auto branch : enabled) {
+      auto tree = branch->GetTree();
+      auto file = tree->GetCurrentFile();
+      const bool isFriend = tree != &t && tree != t.GetTree();
+      const bool hadCache = file && tree->GetReadCache(file);
+      auto cache = file ? tree->GetReadCache(file, true) : nullptr;
+      if (!cache)
+         continue; // no TTreeCache to set up
+      auto state = std::find_if(cacheStates.begin(), cacheStates.end(),
+                                [cache](const RCacheState &c) { return c.fCache == cache; });
+      if (state == cacheStates.end()) {
+         cacheStates.push_back({cache, static_cast<bool>(cache->IsLearning()), {}, isFriend && !hadCache});
+         state = cacheStates.end() - 1;
+      }
+      const auto cached = cache->GetCachedBranches();
+      if (!cached || cached->IndexOf(branch) < 0)
+         state->fAddedNames.emplace_back(branch->GetName());
+      tree->AddBranchToCache(branch, false);
+      if (std::find(cachedTrees.begin(), cachedTrees.end(), tree) == cachedTrees.end())
+         cachedTrees.emplace_back(tree);
+   }
+   for (auto tree : cachedTrees)
+      tree->StopCacheLearningPhase();
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Undo PruneBranches: enable all branches of t and of its friends again, and restore the state of the caches it set
+/// up. A cache that was learning starts learning again, otherwise only the branches PruneBranches added are dropped.
+/// The caches created for the friend trees are deleted.
+void RestoreBranches(TTree &t, const std::vector<RCacheState> &cacheStates)
+{
+   for (const auto &state : cacheStates) {
+      if (state.fCreated) {
+         state.fCache->WaitFinishPrefetch();
+         if (auto file = state.fCache->GetFile())
+            file->SetCacheRead(nullptr, state.fCache->GetTree());
+         delete state.fCache;
+      } else if (state.fWasLearning) {
+         state.fCache->StartLearningPhase();
+      } else {
+         for (const auto &name : state.fAddedNames)
+            state.fCache->DropBranch(name.c_str(), false);
+      }
+   }
+   t.SetBranchStatus("*", true);
+   std::vector<TTree *> trees;
+   GetTreeAndFriends(t, trees);
+   for (auto tree : trees) {
+      // chains apply the recorded statuses to each tree they load: forget them
+      auto chain = dynamic_cast<TChain *>(tree);
+      if (chain && chain->GetStatus())
+         chain->GetStatus()->Delete();
+   }
+}
+
+/// Restricts the branches read from a tree and its friends to the given columns during its lifetime.
+class RBranchPruner {
+   TTree *fTree = nullptr; ///< The pruned tree, null if it was left untouched
+   std::vector<RCacheState> fCacheStates;
+
+public:
+   RBranchPruner(TTree &t, const ColumnNames_t &columns)
+   {
+      if (PruneBranches(t, columns, fCacheStates))
+         fTree = &t;
+   }
+   RBranchPruner(const RBranchPruner &) = delete;
+   RBranchPruner &operator=(const RBranchPruner &) = delete;
+   ~RBranchPruner()
+   {
+      if (fTree)
+         RestoreBranches(*fTree, fCacheStates);
+   }
+};
+
+/// Detaches the profiler of an event loop from its RLoopManager at the end of the loop, also if the loop throws.
+class RProfilerReset {
+   std::unique_ptr<RDFInternal::RProfiler> &fProfiler;
+
+public:
+   explicit RProfilerReset(std::unique_ptr<RDFInternal::RProfiler> &profiler) : fProfiler(profiler) {}
+   RProfilerReset(const RProfilerReset &) = delete;
+   RProfilerReset &operator=(const RProfilerReset &) = delete;
+   ~RProfilerReset() { fProfiler.reset(); }
+};
+
+} // anonymous namespace
+
 
 RLoopManager::RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches)
    : fTree(std::shared_ptr<TTree>(tree, [](TTree *) {})), fDefaultColumns(defaultBranches),
@@ -200,13 +393,17 @@ void RLoopManager::RunEmptySourceMT()
 {
 #ifdef R__USE_IMT
    RSlotStack slotStack(fNSlots);
-   // Working with an empty tree.
+   // Working with an empty tree: only the entries that the ranges can select, if any, are generated.
+   const auto bounds = GetEntriesBounds();
+   const auto firstEntry = std::min(bounds.first, fNEmptyEntries);
+   const auto endEntry = bounds.second > 0 ? std::min(bounds.second, fNEmptyEntries) : fNEmptyEntries;
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto nEntries = endEntry - firstEntry;
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   ULong64_t start = firstEntry;
+   while (start < endEntry) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -220,8 +417,16 @@ void RLoopManager::RunEmptySourceMT()
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       auto slot = slotStack.GetSlot();
       InitNodeSlots(nullptr, slot);
-      for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-         RunAndCheckFilters(slot, currEntry);
+      if (MustRunBulk(slot)) {
+         auto currEntry = range.first;
+         RunBulk(slot, [&currEntry, &range](Long64_t &entry) {
+            entry = currEntry++;
+            return entry < (Long64_t)range.second;
+         });
+      } else {
+         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+            RunAndCheckFilters(slot, currEntry);
+         }
       }
       CleanUpTask(slot);
       slotStack.ReturnSlot(slot);
@@ -237,6 +442,14 @@ void RLoopManager::RunEmptySourceMT()
 void RLoopManager::RunEmptySource()
 {
    InitNodeSlots(nullptr, 0);
+   if (MustRunBulk(0)) {
+      ULong64_t currEntry = 0;
+      RunBulk(0, [this, &currEntry](Long64_t &entry) {
+         entry = currEntry++;
+         return entry < (Long64_t)fNEmptyEntries;
+      });
+      return;
+   }
    for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
       RunAndCheckFilters(0, currEntry);
    }
@@ -250,17 +463,37 @@ void RLoopManager::RunTreeProcessorMT()
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList);
 
+   // ranges select entries by their number in the chain: readers must then use global entry numbers, and only the
+   // clusters that the ranges can select are processed
+   const bool useGlobalEntries = !fBookedRanges.empty();
+   if (useGlobalEntries) {
+      const auto bounds = GetEntriesBounds();
+      tp->SetEntriesRange(bounds.first, bounds.second > 0 ? Long64_t(bounds.second) : -1);
+   }
+
    std::atomic<ULong64_t> entryCount(0ull);
+   const auto datasetColumns = GetDatasetColumns();
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   tp->Process([this, &slotStack, &entryCount, useGlobalEntries, &datasetColumns](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
+      // each thread reuses its tree across tasks: the branches are pruned for the duration of the task
+      RBranchPruner pruner(*r.GetTree(), datasetColumns);
       InitNodeSlots(&r, slot);
       const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
       const auto nEntries = entryRange.second - entryRange.first;
       auto count = entryCount.fetch_add(nEntries);
-      // recursive call to check filters and conditionally execute actions
-      while (r.Next()) {
-         RunAndCheckFilters(slot, count++);
+      if (MustRunBulk(slot)) {
+         RunBulk(slot, [&r, &count, useGlobalEntries](Long64_t &entry) {
+            if (!r.Next())
+               return false;
+            entry = useGlobalEntries ? r.GetCurrentEntry() : count++;
+            return true;
+         });
+      } else {
+         // recursive call to check filters and conditionally execute actions
+         while (r.Next()) {
+            RunAndCheckFilters(slot, useGlobalEntries ? r.GetCurrentEntry() : count++);
+         }
       }
       CleanUpTask(slot);
       slotStack.ReturnSlot(slot);
@@ -274,8 +507,19 @@ void RLoopManager::RunTreeReader()
    TTreeReader r(fTree.get(), fTree->GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   RBranchPruner pruner(*fTree, GetDatasetColumns());
    InitNodeSlots(&r, 0);
 
+   if (MustRunBulk(0)) {
+      RunBulk(0, [&r](Long64_t &entry) {
+         if (!r.Next())
+            return false;
+         entry = r.GetCurrentEntry();
+         return true;
+      });
+      return;
+   }
+
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    while (r.Next() && fNStopsReceived < fNChildren) {
@@ -294,8 +538,21 @@ void RLoopManager::RunDataSource()
       fDataSource->InitSlot(0u, 0ull);
       for (const auto &range : ranges) {
          auto end = range.second;
+         if (MustRunBulk(0u)) {
+            auto currEntry = range.first;
+            RunBulk(0u, [this, &currEntry, end](Long64_t &entry) {
+               for (; currEntry < end; ++currEntry) {
+                  if (SetDataSourceEntry(0u, currEntry)) {
+                     entry = currEntry++;
+                     return true;
+                  }
+               }
+               return false;
+            });
+            continue;
+         }
          for (auto entry = range.first; entry < end; ++entry) {
-            if (fDataSource->SetEntry(0u, entry)) {
+            if (SetDataSourceEntry(0u, entry)) {
                RunAndCheckFilters(0u, entry);
             }
          }
@@ -320,9 +577,22 @@ void RLoopManager::RunDataSourceMT()
       InitNodeSlots(nullptr, slot);
       fDataSource->InitSlot(slot, range.first);
       const auto end = range.second;
-      for (auto entry = range.first; entry < end; ++entry) {
-         if (fDataSource->SetEntry(slot, entry)) {
-            RunAndCheckFilters(slot, entry);
+      if (MustRunBulk(slot)) {
+         auto currEntry = range.first;
+         RunBulk(slot, [this, slot, &currEntry, end](Long64_t &entry) {
+            for (; currEntry < end; ++currEntry) {
+               if (SetDataSourceEntry(slot, currEntry)) {
+                  entry = currEntry++;
+                  return true;
+               }
+            }
+            return false;
+         });
+      } else {
+         for (auto entry = range.first; entry < end; ++entry) {
+            if (SetDataSourceEntry(slot, entry)) {
+               RunAndCheckFilters(slot, entry);
+            }
          }
       }
       CleanUpTask(slot);
@@ -330,20 +600,44 @@ void RLoopManager::RunDataSourceMT()
       slotStack.ReturnSlot(slot);
    };
 
+   // only the entries that the ranges can select, if any, are processed
+   const auto bounds = GetEntriesBounds();
+   auto clipRanges = [&bounds](std::vector<std::pair<ULong64_t, ULong64_t>> &ranges) {
+      std::vector<std::pair<ULong64_t, ULong64_t>> clipped;
+      for (const auto &range : ranges) {
+         const auto start = std::max(range.first, bounds.first);
+         const auto end = bounds.second > 0 ? std::min(range.second, bounds.second) : range.second;
+         if (start < end)
+            clipped.emplace_back(start, end);
+      }
+      ranges.swap(clipped);
+   };
+
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
-      pool.Foreach(runOnRange, ranges);
+      clipRanges(ranges);
+      if (!ranges.empty())
+         pool.Foreach(runOnRange, ranges);
       ranges = fDataSource->GetEntryRanges();
    }
    fDataSource->Finalise();
 #endif // not implemented otherwise (never called)
 }
 
+/// Load the entry of the data source in the slot, timing it if the event loop is profiled.
+bool RLoopManager::SetDataSourceEntry(unsigned int slot, ULong64_t entry)
+{
+   RDFInternal::RProfileScope scope(fProfiler.get(), slot, fDataSourceProfileId);
+   return fDataSource->SetEntry(slot, entry);
+}
+
 /// Execute actions and make sure named filters are called for each event.
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   if (fProfiler)
+      fProfiler->CountEntries(slot, 1ull);
    for (auto &actionPtr : fBookedActions)
       actionPtr->Run(slot, entry);
    for (auto &namedFilterPtr : fBookedNamedFilters)
@@ -352,6 +646,43 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Bulk version of RunAndCheckFilters: each node processes all entries of the block before the next node.
+void RLoopManager::RunAndCheckFiltersBulk(unsigned int slot, const RBulkBlock &block)
+{
+   if (fProfiler)
+      fProfiler->CountEntries(slot, block.fSize);
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBulk(slot, block);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBulk(slot, block);
+   for (auto &callback : fCallbacks)
+      for (auto i = 0u; i < block.fSize; ++i)
+         callback(slot);
+}
+
+/// Process entries in blocks of fBulkSize. `nextEntry` reads the next entry, setting its argument to the entry number,
+/// and returns false when there are no more entries. The values of the columns read in bulk are copied right after
+/// each entry is read; once the block is full it is processed by the nodes.
+/// In the non-MT case processing can be stopped early by ranges, which is checked after each block.
+template <typename NextEntry_t>
+void RLoopManager::RunBulk(unsigned int slot, NextEntry_t &&nextEntry)
+{
+   auto &entries = fBulkEntries[slot];
+   entries.resize(fBulkSize);
+   const auto &loaders = fBulkLoaders[slot];
+   bool hasMoreEntries = true;
+   while (hasMoreEntries && fNStopsReceived < fNChildren) {
+      auto nEntries = 0u;
+      while (nEntries < fBulkSize && (hasMoreEntries = nextEntry(entries[nEntries]))) {
+         for (const auto &loader : loaders)
+            loader.fLoad(loader.fColumn, nEntries, entries[nEntries]);
+         ++nEntries;
+      }
+      if (nEntries > 0)
+         RunAndCheckFiltersBulk(slot, {++fBulkBlockIds[slot], entries.data(), nEntries});
+   }
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -359,6 +690,13 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// a particular slot will be using.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (fProfiler)
+      fProfiler->BeginTask(slot);
+   if (fBulkSize > 0) {
+      // nodes register the columns they read in bulk, or disable bulk processing, in their InitSlot
+      fBulkLoaders[slot].clear();
+      fCanRunBulk[slot] = 1;
+   }
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
@@ -384,6 +722,20 @@ void RLoopManager::InitNodes()
       ptr->Initialize();
 }
 
+/// Return the names of the columns of the dataset read by the booked filters and actions, directly or through the
+/// custom columns they use, in alphabetical order. Aliases are already resolved to the names of the columns.
+/// The nodes must have been jitted already, see BuildJittedNodes().
+ColumnNames_t RLoopManager::GetDatasetColumns() const
+{
+   std::set<std::string> columns;
+   std::set<const RCustomColumnBase *> visited;
+   for (auto action : fBookedActions)
+      action->AddDatasetColumns(columns, visited);
+   for (auto filter : fBookedFilters)
+      filter->AddDatasetColumns(columns, visited);
+   return ColumnNames_t(columns.begin(), columns.end());
+}
+
 /// Perform clean-up operations. To be called at the end of each event loop.
 void RLoopManager::CleanUpNodes()
 {
@@ -415,19 +767,38 @@ void RLoopManager::CleanUpTask(unsigned int slot)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->ClearTask(slot);
+   if (fProfiler)
+      fProfiler->EndTask(slot);
 }
 
 /// Jit all actions that required runtime column type inference, and clean the `fToJit` member variable.
 void RLoopManager::BuildJittedNodes()
 {
+   BuildJittedNodes({this});
+}
+
+/// Jit the nodes of several computation graphs in a single interpreter call, and clean their `fToJit` member variables.
+/// Invoking the interpreter once amortizes its fixed cost over the graphs, e.g. when they are run by RunGraphs.
+void RLoopManager::BuildJittedNodes(const std::vector<RLoopManager *> &loopManagers)
+{
+   std::string toJit;
+   for (auto lm : loopManagers)
+      toJit += lm->fToJit;
+   if (toJit.empty())
+      return;
+
+   // the jitted calls use the lambdas and types queued by these graphs, declared in a single batch
+   InterpreterDeclareDeferredCode(loopManagers);
+
    auto error = TInterpreter::EErrorCode::kNoError;
-   gInterpreter->Calc(fToJit.c_str(), &error);
+   gInterpreter->Calc(toJit.c_str(), &error);
    if (TInterpreter::EErrorCode::kNoError != error) {
       std::string exceptionText =
          "An error occurred while jitting. The lines above might indicate the cause of the crash\n";
       throw std::runtime_error(exceptionText.c_str());
    }
-   fToJit.clear();
+   for (auto lm : loopManagers)
+      lm->fToJit.clear();
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -444,6 +815,49 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Return the entries [begin, end) that can be selected by the ranges of a multi-thread event loop, which hang
+/// directly from this node, `end == 0` meaning the end of the dataset. If some of the children of this node are not
+/// ranges, all entries are needed and [0, 0) is returned. Must be called after EvalChildrenCounts.
+std::pair<ULong64_t, ULong64_t> RLoopManager::GetEntriesBounds() const
+{
+   unsigned int nActiveRanges = 0;
+   ULong64_t begin = std::numeric_limits<ULong64_t>::max();
+   ULong64_t end = 0;
+   bool isUnbounded = false;
+   for (auto range : fBookedRanges) {
+      if (!range->HasChildren())
+         continue;
+      ++nActiveRanges;
+      begin = std::min<ULong64_t>(begin, range->GetStart());
+      if (range->GetStop() == 0)
+         isUnbounded = true;
+      else
+         end = std::max<ULong64_t>(end, range->GetStop());
+   }
+   if (nActiveRanges == 0 || nActiveRanges != fNChildren)
+      return {0ull, 0ull};
+   return {begin, isUnbounded ? 0ull : end};
+}
+
+/// Return the cuts on the columns of the data source which an entry must pass, one of them at least, to be needed by
+/// the event loop: the range cuts of the filters hanging directly from this node, if all the children of this node
+/// are such filters. Otherwise, or if named filters must report on all entries, no cuts are returned.
+/// Must be called after EvalChildrenCounts.
+std::vector<ROOT::RDF::RDataSource::RRangeCut> RLoopManager::GetEntryCuts() const
+{
+   if (!fBookedNamedFilters.empty())
+      return {};
+   std::vector<ROOT::RDF::RDataSource::RRangeCut> cuts;
+   for (auto filter : fBookedFilters) {
+      const auto cut = filter->GetRangeCut();
+      if (cut && filter->HasChildren())
+         cuts.emplace_back(*cut);
+   }
+   if (cuts.size() != fNChildren)
+      return {};
+   return cuts;
+}
+
 unsigned int RLoopManager::GetNextID()
 {
    static unsigned int id = 0;
@@ -458,8 +872,27 @@ void RLoopManager::Run()
    if (!fToJit.empty())
       BuildJittedNodes();
 
+   RProfilerReset profilerReset(fProfiler);
+   if (fMustProfile) {
+      fProfiler = std::make_unique<RDFInternal::RProfiler>(fNSlots);
+      fMustProfile = false;
+   }
+
    InitNodes();
 
+   if (fDataSource)
+      fDataSource->SetEntryCuts(GetEntryCuts());
+
+   if (fProfiler) {
+      // the columns read from a TTree are registered after the nodes, the ones of a data source are custom columns
+      if (fTree)
+         for (const auto &column : GetDatasetColumns())
+            fProfiler->AddColumn(column);
+      if (fDataSource)
+         fDataSourceProfileId = fProfiler->AddNode(fDataSource.get(), RDFInternal::RProfiler::ENodeKind::kColumnRead,
+                                                   fDataSource->GetLabel() + "::SetEntry");
+   }
+
    switch (fLoopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
    case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
@@ -469,6 +902,9 @@ void RLoopManager::Run()
    case ELoopType::kDataSource: RunDataSource(); break;
    }
 
+   if (fProfiler)
+      fProfiler->EndTasks();
+
    CleanUpNodes();
 }
 
@@ -483,6 +919,17 @@ TTree *RLoopManager::GetTree() const
    return fTree.get();
 }
 
+/// Process entries in blocks of bulkSize entries, 0 to process them one at a time (the default).
+void RLoopManager::SetBulkSize(unsigned int bulkSize)
+{
+   fBulkSize = bulkSize;
+   fBulkLoaders.resize(fNSlots);
+   fCanRunBulk.resize(fNSlots, 0);
+   fBulkEntries.resize(fNSlots);
+   fBulkBlockIds.resize(fNSlots, 0ull);
+   fBulkAllPass.assign(bulkSize, 1);
+}
+
 void RLoopManager::Book(RDFInternal::RActionBase *actionPtr)
 {
    fBookedActions.emplace_back(actionPtr);
@@ -0,0 +1,344 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::RDF::RParquetDS
+    \ingroup dataframe
+    \brief RDataFrame data source class to read Apache Parquet files.
+
+The RParquetDS implements a RDataSource reading the columns of a Parquet file through the Parquet reader of the
+Apache Arrow C++ libraries. A RDataFrame reading a Parquet file can be constructed using the factory method
+ROOT::RDF::MakeParquetDataFrame, which accepts two parameters:
+1. The path of the Parquet file.
+2. The names of the columns to use, all the columns if empty.
+
+The columns can hold integers, floating point numbers, booleans and strings, or lists of numbers, which are read as
+RVecs. The types of the columns are derived from the types in the associated arrow::Schema, as for RArrowDS.
+
+Each row group of the file is a range of entries, so that the tasks of a multi-thread event loop read and decode
+different row groups concurrently. Only the columns used by the computation graph are read.
+
+If all the nodes of the computation graph hang from filters which are simple range cuts on a column of the file,
+e.g. `Filter("x > 10")` or `Filter("x >= 0 && x < 1")`, the row groups whose minimum and maximum values of the column,
+as stored in the metadata of the file, show that no entries can pass the cuts are not read at all.
+
+~~~{.cpp}
+auto rdf = ROOT::RDF::MakeParquetDataFrame("data.parquet");
+auto h = rdf.Filter("pt > 100").Histo1D("pt");
+~~~
+*/
+// clang-format on
+
+#include <ROOT/RMakeUnique.hxx>
+#include <ROOT/RParquetDS.hxx>
+
+#include "RArrowUtils.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/io/file.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+template <typename ParquetType>
+void GetTypedMinMax(const parquet::RowGroupStatistics &stats, double &min, double &max)
+{
+   const auto &typed = static_cast<const parquet::TypedRowGroupStatistics<ParquetType> &>(stats);
+   min = typed.min();
+   max = typed.max();
+}
+
+/// Set min and max to the smallest and largest values of the column chunk, if they are stored in its statistics.
+/// The statistics of unsigned integers, which older writers sorted as signed, are not used.
+bool GetMinMax(const parquet::ColumnChunkMetaData &column, const arrow::DataType &type, double &min, double &max)
+{
+   if (!column.is_stats_set())
+      return false;
+   const auto stats = column.statistics();
+   if (!stats || !stats->HasMinMax())
+      return false;
+   switch (type.id()) {
+   case arrow::Type::INT32: GetTypedMinMax<parquet::Int32Type>(*stats, min, max); break;
+   case arrow::Type::INT64: GetTypedMinMax<parquet::Int64Type>(*stats, min, max); break;
+   case arrow::Type::FLOAT: GetTypedMinMax<parquet::FloatType>(*stats, min, max); break;
+   case arrow::Type::DOUBLE: GetTypedMinMax<parquet::DoubleType>(*stats, min, max); break;
+   default: return false;
+   }
+   return !std::isnan(min) && !std::isnan(max);
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create a Parquet RDataSource for RDataFrame.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the names of the columns to use, all the columns of the file if empty.
+RParquetDS::RParquetDS(std::string_view fileName, std::vector<std::string> const &columns)
+   : fFileName(fileName), fColumnNames(columns)
+{
+   fReaders.emplace_back(OpenFile());
+   auto &reader = *fReaders.front();
+   auto status = reader.GetSchema(&fSchema);
+   if (!status.ok()) {
+      throw std::runtime_error("Cannot read the schema of the Parquet file " + fFileName + ": " + status.ToString());
+   }
+
+   if (fColumnNames.empty()) {
+      for (auto &field : fSchema->fields()) {
+         fColumnNames.push_back(field->name());
+      }
+   }
+
+   // The values of a column are stored in the leaves of the Parquet schema whose path starts with its name. The
+   // supported types, including the lists of numbers, have a single leaf.
+   const auto metadata = reader.parquet_reader()->metadata();
+   const auto parquetSchema = metadata->schema();
+   std::map<std::string, std::vector<int>> leaves;
+   for (int i = 0; i < parquetSchema->num_columns(); ++i) {
+      leaves[parquetSchema->Column(i)->path()->ToDotVector().front()].push_back(i);
+   }
+   for (auto &columnName : fColumnNames) {
+      const auto field = fSchema->GetFieldByName(columnName);
+      if (!field) {
+         throw std::runtime_error("The dataset does not have column " + columnName);
+      }
+      VerifyValidColumnType verifyType;
+      const auto &columnLeaves = leaves[columnName];
+      if (!field->type()->Accept(&verifyType).ok() || columnLeaves.size() != 1) {
+         throw std::runtime_error("Column " + columnName + " contains an unsupported type.");
+      }
+      fColumnIndices.push_back(columnLeaves.front());
+   }
+
+   fRowGroupFirstEntry.push_back(0ULL);
+   for (int rowGroup = 0; rowGroup < metadata->num_row_groups(); ++rowGroup) {
+      fRowGroupFirstEntry.push_back(fRowGroupFirstEntry.back() + metadata->RowGroup(rowGroup)->num_rows());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+RParquetDS::~RParquetDS()
+{
+}
+
+std::unique_ptr<parquet::arrow::FileReader> RParquetDS::OpenFile() const
+{
+   std::shared_ptr<arrow::io::ReadableFile> file;
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   auto status = arrow::io::ReadableFile::Open(fFileName, &file);
+   if (status.ok()) {
+      status = parquet::arrow::OpenFile(file, arrow::default_memory_pool(), &reader);
+   }
+   if (!status.ok()) {
+      throw std::runtime_error("Cannot read the Parquet file " + fFileName + ": " + status.ToString());
+   }
+   return reader;
+}
+
+/// Return the index of the column in fColumnNames.
+size_t RParquetDS::GetColumnIndex(std::string_view colName) const
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), std::string(colName));
+   if (it == fColumnNames.end()) {
+      std::string msg = "The dataset does not have column ";
+      msg += colName;
+      throw std::runtime_error(msg);
+   }
+   return it - fColumnNames.begin();
+}
+
+const std::vector<std::string> &RParquetDS::GetColumnNames() const
+{
+   return fColumnNames;
+}
+
+std::string RParquetDS::GetTypeName(std::string_view colName) const
+{
+   const auto &field = fSchema->GetFieldByName(fColumnNames[GetColumnIndex(colName)]);
+   RDFTypeNameGetter typeGetter;
+   auto status = field->type()->Accept(&typeGetter);
+   if (status.ok() == false) {
+      std::string msg = "RParquetDS does not support a column of type ";
+      msg += field->type()->name();
+      throw std::runtime_error(msg);
+   }
+   return typeGetter.result();
+}
+
+bool RParquetDS::HasColumn(std::string_view colName) const
+{
+   return std::find(fColumnNames.begin(), fColumnNames.end(), std::string(colName)) != fColumnNames.end();
+}
+
+void RParquetDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+   fNSlots = nSlots;
+   while (fReaders.size() < fNSlots) {
+      fReaders.emplace_back(OpenFile());
+   }
+   fRowGroupPerSlot.assign(fNSlots, -1);
+   fValueGetters.resize(fColumnNames.size());
+}
+
+/// The getters are only created for the columns requested, the other columns are not read.
+std::vector<void *> RParquetDS::GetColumnReadersImpl(std::string_view colName, const std::type_info &)
+{
+   assert(fNSlots > 0U && "The number of slots must be set before getting the column readers.");
+   auto &getter = fValueGetters[GetColumnIndex(colName)];
+   if (!getter) {
+      getter = std::make_unique<ROOT::Internal::RDF::TValueGetter>(fNSlots, arrow::ArrayVector{});
+   }
+   return getter->SlotPtrs();
+}
+
+void RParquetDS::SetEntryCuts(const std::vector<RRangeCut> &cuts)
+{
+   fCuts = cuts;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Return whether some entries of the row group may pass one of the cuts, according to the minimum and maximum
+/// values of the columns stored in the metadata of the file. Cuts on columns without such statistics may be passed
+/// by all row groups.
+bool RParquetDS::MayPassCuts(int rowGroup) const
+{
+   if (fCuts.empty()) {
+      return true;
+   }
+   const auto rowGroupMetaData = fReaders.front()->parquet_reader()->metadata()->RowGroup(rowGroup);
+   for (const auto &cut : fCuts) {
+      const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), cut.fColumn);
+      if (it == fColumnNames.end()) {
+         return true;
+      }
+      const auto columnIdx = it - fColumnNames.begin();
+      const auto column = rowGroupMetaData->ColumnChunk(fColumnIndices[columnIdx]);
+      double min, max;
+      if (!GetMinMax(*column, *fSchema->GetFieldByName(cut.fColumn)->type(), min, max) ||
+          (max >= cut.fMin && min <= cut.fMax)) {
+         return true;
+      }
+   }
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// The entry ranges are the row groups, except the ones which no entries can pass the cuts.
+void RParquetDS::Initialise()
+{
+   fEntryRanges.clear();
+   for (size_t rowGroup = 0; rowGroup + 1 < fRowGroupFirstEntry.size(); ++rowGroup) {
+      const auto first = fRowGroupFirstEntry[rowGroup];
+      const auto end = fRowGroupFirstEntry[rowGroup + 1];
+      if (first < end && MayPassCuts(rowGroup)) {
+         fEntryRanges.emplace_back(first, end);
+      }
+   }
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RParquetDS::GetEntryRanges()
+{
+   auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
+   return entryRanges;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Read, with the reader of the slot, the columns requested from the row group holding entry.
+void RParquetDS::ReadRowGroup(unsigned int slot, ULong64_t entry)
+{
+   const int rowGroup =
+      std::upper_bound(fRowGroupFirstEntry.begin(), fRowGroupFirstEntry.end(), entry) - fRowGroupFirstEntry.begin() - 1;
+   fRowGroupPerSlot[slot] = rowGroup;
+
+   std::vector<int> indices;
+   for (size_t ci = 0; ci < fValueGetters.size(); ++ci) {
+      if (fValueGetters[ci]) {
+         indices.push_back(fColumnIndices[ci]);
+      }
+   }
+   if (indices.empty()) {
+      return;
+   }
+
+   std::shared_ptr<arrow::Table> table;
+   auto status = fReaders[slot]->ReadRowGroup(rowGroup, indices, &table);
+   if (!status.ok()) {
+      throw std::runtime_error("Cannot read row group " + std::to_string(rowGroup) + " of the Parquet file " +
+                               fFileName + ": " + status.ToString());
+   }
+   for (size_t ci = 0; ci < fValueGetters.size(); ++ci) {
+      if (fValueGetters[ci]) {
+         const auto column = table->column(table->schema()->GetFieldIndex(fColumnNames[ci]));
+         fValueGetters[ci]->SetChunks(slot, column->data()->chunks(), fRowGroupFirstEntry[rowGroup]);
+      }
+   }
+}
+
+bool RParquetDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   const auto rowGroup = fRowGroupPerSlot[slot];
+   if (rowGroup < 0 || entry < fRowGroupFirstEntry[rowGroup] || entry >= fRowGroupFirstEntry[rowGroup + 1]) {
+      ReadRowGroup(slot, entry);
+   }
+   for (auto &getter : fValueGetters) {
+      if (getter) {
+         getter->SetEntry(slot, entry);
+      }
+   }
+   return true;
+}
+
+/// Release the row group read by the slot.
+void RParquetDS::FinaliseSlot(unsigned int slot)
+{
+   fRowGroupPerSlot[slot] = -1;
+   for (auto &getter : fValueGetters) {
+      if (getter) {
+         getter->SetChunks(slot, {}, 0ULL);
+      }
+   }
+}
+
+std::string RParquetDS::GetLabel()
+{
+   return "ParquetDS";
+}
+
+/// Creates a RDataFrame reading a Parquet file.
+/// \param[in] fileName the path of the Parquet file
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file
+RDataFrame MakeParquetDataFrame(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame rdf(std::make_unique<RParquetDS>(fileName, columnNames));
+   return rdf;
+}
+
+} // namespace RDF
+
+} // namespace ROOT
@@ -0,0 +1,165 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TString.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using ROOT::RDF::RProfileReport;
+
+const char *KindName(RProfileReport::ENodeKind kind)
+{
+   switch (kind) {
+   case RProfileReport::ENodeKind::kFilter: return "Filter";
+   case RProfileReport::ENodeKind::kDefine: return "Define";
+   case RProfileReport::ENodeKind::kAction: return "Action";
+   case RProfileReport::ENodeKind::kColumnRead: return "Read";
+   }
+   return "";
+}
+
+std::string Quote(const std::string &s)
+{
+   std::string quoted = "\"";
+   for (auto c : s) {
+      switch (c) {
+      case '"': quoted += "\\\""; break;
+      case '\\': quoted += "\\\\"; break;
+      case '\n': quoted += "\\n"; break;
+      case '\t': quoted += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            quoted += buf;
+         } else {
+            quoted += c;
+         }
+      }
+   }
+   return quoted + "\"";
+}
+
+std::string Number(double d)
+{
+   char buf[32];
+   std::snprintf(buf, sizeof(buf), "%.9g", d);
+   return buf;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+
+namespace RDF {
+
+const RProfileReport::RNodeInfo &RProfileReport::operator[](std::string_view nodeName) const
+{
+   auto pred = [&nodeName](const RNodeInfo &n) { return n.fName == nodeName; };
+   const auto it = std::find_if(fNodes.begin(), fNodes.end(), pred);
+   if (fNodes.end() == it) {
+      std::string err = "Cannot find a node called \"";
+      err += nodeName;
+      err += "\". Available nodes are: \n";
+      for (auto &&n : fNodes) {
+         err += " - " + n.fName + "\n";
+      }
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Print the nodes from the slowest to the fastest, followed by a summary of the processing slots.
+void RProfileReport::Print() const
+{
+   const auto taskTime = std::accumulate(fSlots.begin(), fSlots.end(), 0.,
+                                         [](double t, const RSlotInfo &s) { return t + s.fTaskTime; });
+   std::vector<const RNodeInfo *> nodes;
+   for (const auto &n : fNodes)
+      nodes.push_back(&n);
+   std::stable_sort(nodes.begin(), nodes.end(),
+                    [](const RNodeInfo *a, const RNodeInfo *b) { return a->fTime > b->fTime; });
+
+   Printf("Event loop: %.3f s, %zu task(s) in %zu slot(s)", fWallTime, fTasks.size(), fSlots.size());
+   Printf("%-8s %12s %12s %8s %12s  %s", "Kind", "Calls", "Time [s]", "Time [%]", "Read [MB]", "Name");
+   for (auto n : nodes) {
+      const auto percent = taskTime > 0. ? 100. * n->fTime / taskTime : 0.;
+      Printf("%-8s %12llu %12.6f %8.2f %12.3f  %s", KindName(n->fKind), n->fCalls, n->fTime, percent, n->fBytes / 1.e6,
+             n->fName.c_str());
+   }
+   for (auto slot = 0u; slot < fSlots.size(); ++slot) {
+      const auto &s = fSlots[slot];
+      Printf("Slot %u: %llu task(s), %llu entries, %.3f s in tasks: %.3f s reading columns, %.3f s computing", slot,
+             s.fTasks, s.fEntries, s.fTaskTime, s.fReadTime, s.GetComputeTime());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the report as a JSON object with the fields `wallTime`, `nodes`, `slots` and `tasks`. Times are in seconds.
+std::string RProfileReport::AsJSON() const
+{
+   std::string json = "{\"wallTime\": " + Number(fWallTime) + ",\n \"nodes\": [";
+   for (auto i = 0u; i < fNodes.size(); ++i) {
+      const auto &n = fNodes[i];
+      json += (i ? ",\n  " : "\n  ");
+      json += "{\"name\": " + Quote(n.fName) + ", \"kind\": " + Quote(KindName(n.fKind)) +
+              ", \"calls\": " + std::to_string(n.fCalls) + ", \"time\": " + Number(n.fTime) +
+              ", \"bytes\": " + std::to_string(n.fBytes) + "}";
+   }
+   json += "],\n \"slots\": [";
+   for (auto i = 0u; i < fSlots.size(); ++i) {
+      const auto &s = fSlots[i];
+      json += (i ? ",\n  " : "\n  ");
+      json += "{\"slot\": " + std::to_string(i) + ", \"tasks\": " + std::to_string(s.fTasks) +
+              ", \"entries\": " + std::to_string(s.fEntries) + ", \"taskTime\": " + Number(s.fTaskTime) +
+              ", \"readTime\": " + Number(s.fReadTime) + ", \"computeTime\": " + Number(s.GetComputeTime()) + "}";
+   }
+   json += "],\n \"tasks\": [";
+   for (auto i = 0u; i < fTasks.size(); ++i) {
+      const auto &t = fTasks[i];
+      json += (i ? ",\n  " : "\n  ");
+      json += "{\"slot\": " + std::to_string(t.fSlot) + ", \"start\": " + Number(t.fStart) +
+              ", \"end\": " + Number(t.fEnd) + ", \"entries\": " + std::to_string(t.fEntries) +
+              ", \"readTime\": " + Number(t.fReadTime) + "}";
+   }
+   json += "]}\n";
+   return json;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Return the tasks in the Trace Event Format of the Chrome trace viewer (chrome://tracing), one track per slot.
+std::string RProfileReport::AsChromeTrace() const
+{
+   std::string trace = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+   bool first = true;
+   auto addEvent = [&trace, &first](const std::string &event) {
+      trace += (first ? "\n " : ",\n ") + event;
+      first = false;
+   };
+   for (auto slot = 0u; slot < fSlots.size(); ++slot)
+      addEvent("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " + std::to_string(slot) +
+               ", \"args\": {\"name\": \"slot " + std::to_string(slot) + "\"}}");
+   for (const auto &t : fTasks)
+      addEvent("{\"name\": \"task\", \"cat\": \"RDataFrame\", \"ph\": \"X\", \"pid\": 0, \"tid\": " +
+               std::to_string(t.fSlot) + ", \"ts\": " + Number(t.fStart * 1.e6) +
+               ", \"dur\": " + Number((t.fEnd - t.fStart) * 1.e6) + ", \"args\": {\"entries\": " +
+               std::to_string(t.fEntries) + ", \"readTime\": " + Number(t.fReadTime) + "}}");
+   trace += "]}\n";
+   return trace;
+}
+
+} // End NS RDF
+
+} // End NS ROOT
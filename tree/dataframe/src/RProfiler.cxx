@@ -0,0 +1,175 @@
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+#include "TBranch.h"
+#include "TBranchProxy.h"
+#include "TMath.h"
+#include "TTree.h"
+#include "TTreeReaderValue.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+double ToSeconds(std::chrono::steady_clock::duration d)
+{
+   return std::chrono::duration<double>(d).count();
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RProfiler::RProfiler(unsigned int nSlots) : fSlots(nSlots) {}
+
+////////////////////////////////////////////////////////////////////////////
+/// Register a node of the computation graph and return its id. Registering a node again returns the same id.
+unsigned int RProfiler::AddNode(const void *node, ENodeKind kind, const std::string &name)
+{
+   const auto it = fNodeIds.find(node);
+   if (it != fNodeIds.end())
+      return it->second;
+   const unsigned int id = fNodes.size();
+   fNodes.push_back({name, kind});
+   fIsRead.push_back(kind == ENodeKind::kColumnRead);
+   fNodeIds[node] = id;
+   return id;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Register a column read from the dataset and return its id. The reads of all the values of a column, by any node,
+/// are accounted to the same id.
+unsigned int RProfiler::AddColumn(const std::string &name)
+{
+   const auto it = fColumnIds.find(name);
+   if (it != fColumnIds.end())
+      return it->second;
+   const unsigned int id = fNodes.size();
+   fNodes.push_back({name, ENodeKind::kColumnRead});
+   fIsRead.push_back(true);
+   fColumnIds[name] = id;
+   return id;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Start a task in the slot, ending the previous one if it is still running.
+void RProfiler::BeginTask(unsigned int slot)
+{
+   auto &s = fSlots[slot];
+   if (s.fInTask)
+      EndTask(slot);
+   s.fStats.resize(fNodes.size());
+   s.fBaskets.resize(fNodes.size());
+   const auto now = Clock_t::now();
+   s.fTasks.push_back({now, now, 0ull, Clock_t::duration(0)});
+   s.fInTask = true;
+}
+
+void RProfiler::EndTask(unsigned int slot)
+{
+   auto &s = fSlots[slot];
+   if (!s.fInTask)
+      return;
+   s.fTasks.back().fEnd = Clock_t::now();
+   s.fInTask = false;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// End the tasks still running, e.g. the ones of the event loops running in sequence. Not thread-safe.
+void RProfiler::EndTasks()
+{
+   for (auto slot = 0u; slot < fSlots.size(); ++slot)
+      EndTask(slot);
+}
+
+void RProfiler::Stop(unsigned int slot, const ROOT::Internal::TTreeReaderValueBase *value)
+{
+   const auto now = Clock_t::now();
+   auto &s = fSlots[slot];
+   const auto frame = s.fStack.back();
+   s.fStack.pop_back();
+   const auto elapsed = now - frame.fStart;
+   const auto self = elapsed - frame.fChildren;
+   auto &stats = s.fStats[frame.fNode];
+   ++stats.fCalls;
+   stats.fTime += self;
+   if (!s.fStack.empty())
+      s.fStack.back().fChildren += elapsed;
+   if (fIsRead[frame.fNode] && s.fInTask)
+      s.fTasks.back().fReadTime += self;
+
+   if (value) {
+      const auto proxy = value->GetProxy();
+      if (proxy && proxy->GetBranch())
+         CountBytes(s, frame.fNode, *proxy->GetBranch());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Count the compressed bytes of the basket of branch holding the entry just read, unless it was counted already.
+void RProfiler::CountBytes(RSlot &slot, unsigned int node, TBranch &branch)
+{
+   auto &range = slot.fBaskets[node];
+   const auto entry = branch.GetTree()->GetReadEntry();
+   if (&branch == range.fBranch && entry >= range.fFirst && entry < range.fEnd)
+      return;
+   const auto basketEntry = branch.GetBasketEntry();
+   if (!basketEntry || entry < 0)
+      return;
+   // baskets before the write basket are on disk, the write basket is in memory
+   const Long64_t writeBasket = branch.GetWriteBasket();
+   const auto basket = TMath::BinarySearch(writeBasket + 1, basketEntry, entry);
+   if (basket < 0)
+      return;
+   range.fBranch = &branch;
+   range.fFirst = basketEntry[basket];
+   range.fEnd = basket < writeBasket ? basketEntry[basket + 1] : std::numeric_limits<Long64_t>::max();
+   if (basket < writeBasket)
+      slot.fStats[node].fBytes += branch.GetBasketBytes()[basket];
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Fill report with the measurements of all slots. To be called once the event loop is over.
+void RProfiler::FillReport(ROOT::RDF::RProfileReport &report) const
+{
+   report.fWallTime = ToSeconds(Clock_t::now() - fStart);
+
+   report.fNodes.clear();
+   for (const auto &node : fNodes)
+      report.fNodes.push_back({node.fName, node.fKind, 0ull, 0., 0ull});
+   report.fSlots.clear();
+   report.fTasks.clear();
+   for (auto slotIdx = 0u; slotIdx < fSlots.size(); ++slotIdx) {
+      const auto &slot = fSlots[slotIdx];
+      for (auto i = 0u; i < slot.fStats.size(); ++i) {
+         auto &info = report.fNodes[i];
+         info.fCalls += slot.fStats[i].fCalls;
+         info.fTime += ToSeconds(slot.fStats[i].fTime);
+         info.fBytes += slot.fStats[i].fBytes;
+      }
+      ROOT::RDF::RProfileReport::RSlotInfo slotInfo{slot.fTasks.size(), 0ull, 0., 0.};
+      for (const auto &task : slot.fTasks) {
+         slotInfo.fEntries += task.fEntries;
+         slotInfo.fTaskTime += ToSeconds(task.fEnd - task.fStart);
+         slotInfo.fReadTime += ToSeconds(task.fReadTime);
+         report.fTasks.push_back({slotIdx, ToSeconds(task.fStart - fStart), ToSeconds(task.fEnd - fStart),
+                                  task.fEntries, ToSeconds(task.fReadTime)});
+      }
+      report.fSlots.emplace_back(slotInfo);
+   }
+   std::sort(report.fTasks.begin(), report.fTasks.end(),
+             [](const ROOT::RDF::RProfileReport::RTaskInfo &a, const ROOT::RDF::RProfileReport::RTaskInfo &b) {
+                return a.fStart < b.fStart;
+             });
+}
+
+} // End NS RDF
+} // End NS Internal
+} // End NS ROOT
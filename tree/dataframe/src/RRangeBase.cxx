@@ -9,13 +9,17 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RRangeBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 
 using ROOT::Detail::RDF::RRangeBase;
 using ROOT::Detail::RDF::RLoopManager;
 
 RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
                        const unsigned int nSlots)
-   : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots) { }
+   : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fLastCheckedBlock(nSlots, 0),
+     fLastBulkMask(nSlots), fNSlots(nSlots), fIsMT(implPtr->IsMultiThreaded())
+{
+}
 
 void RRangeBase::ResetCounters()
 {
@@ -0,0 +1,261 @@
+/****** Run RDataFrame bulk processing tests both with and without IMT enabled *******/
+#include <gtest/gtest.h>
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RTrivialDS.hxx>
+#include <ROOT/RVec.hxx>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <atomic>
+#include <memory>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+using namespace ROOT::VecOps;
+
+// Fixture for all tests in this file. If parameter is true, run with implicit MT, else run sequentially
+class RDFBulkTests : public ::testing::TestWithParam<bool> {
+protected:
+   RDFBulkTests() : NSLOTS(GetParam() ? 4u : 1u)
+   {
+      if (GetParam())
+         ROOT::EnableImplicitMT(NSLOTS);
+   }
+   ~RDFBulkTests()
+   {
+      if (GetParam())
+         ROOT::DisableImplicitMT();
+   }
+   const unsigned int NSLOTS;
+};
+
+void FillBulkTree(const char *filename, const char *treeName, int nevents)
+{
+   TFile f(filename, "RECREATE");
+   TTree t(treeName, treeName);
+   t.SetAutoFlush(100);
+   double x;
+   int i;
+   unsigned int n;
+   float v[3];
+   t.Branch("x", &x);
+   t.Branch("i", &i);
+   t.Branch("n", &n);
+   t.Branch("v", v, "v[n]/F");
+   for (i = 0; i < nevents; ++i) {
+      x = i * 0.5;
+      n = i % 3 + 1;
+      for (auto j = 0u; j < n; ++j)
+         v[j] = i + j;
+      t.Fill();
+   }
+   t.Write();
+   f.Close();
+}
+
+TEST_P(RDFBulkTests, SameResultsAsPerEntry)
+{
+   auto filename = "dataframe_bulk_flat.root";
+   auto treename = "t";
+   FillBulkTree(filename, treename, 1000);
+
+   auto book = [&](RDataFrame &d) {
+      auto f = d.Filter([](int i) { return i % 3 != 0; }, {"i"}, "notMult3")
+                  .Define("y", [](double x, int i) { return x * i; }, {"x", "i"});
+      auto ff = f.Filter([](double y) { return y > 100.; }, {"y"}, "yCut");
+      return std::make_tuple(f.Count(), f.Sum<double>("y"), ff.Max<double>("y"), ff.Count(), d.Report());
+   };
+
+   RDataFrame perEntry(treename, filename);
+   auto expected = book(perEntry);
+   RDataFrame bulk(treename, filename);
+   bulk.SetBulkSize(64);
+   auto res = book(bulk);
+
+   EXPECT_EQ(*std::get<0>(res), *std::get<0>(expected));
+   EXPECT_DOUBLE_EQ(*std::get<1>(res), *std::get<1>(expected));
+   EXPECT_DOUBLE_EQ(*std::get<2>(res), *std::get<2>(expected));
+   EXPECT_EQ(*std::get<3>(res), *std::get<3>(expected));
+   for (auto name : {"notMult3", "yCut"}) {
+      EXPECT_EQ(std::get<4>(res)->At(name).GetAll(), std::get<4>(expected)->At(name).GetAll());
+      EXPECT_EQ(std::get<4>(res)->At(name).GetPass(), std::get<4>(expected)->At(name).GetPass());
+   }
+
+   gSystem->Unlink(filename);
+}
+
+TEST_P(RDFBulkTests, Jitted)
+{
+   auto filename = "dataframe_bulk_jitted.root";
+   auto treename = "t";
+   FillBulkTree(filename, treename, 1000);
+
+   RDataFrame d(treename, filename);
+   d.SetBulkSize(100);
+   auto f = d.Filter("i > 10").Define("y", "x * 2");
+   auto sum = f.Sum<double>("y");
+   auto count = f.Filter("y < 100").Count();
+   EXPECT_DOUBLE_EQ(*sum, 989. * 1010. / 2.);
+   EXPECT_EQ(*count, 89ull);
+
+   gSystem->Unlink(filename);
+}
+
+TEST_P(RDFBulkTests, FallbackOnArrays)
+{
+   auto filename = "dataframe_bulk_arrays.root";
+   auto treename = "t";
+   FillBulkTree(filename, treename, 100);
+
+   RDataFrame d(treename, filename);
+   d.SetBulkSize(16);
+   auto sum = d.Define("s", [](const RVec<float> &v) { return Sum(v); }, {"v"}).Sum<float>("s");
+   float expected = 0.f;
+   for (int i = 0; i < 100; ++i)
+      for (int j = 0; j < i % 3 + 1; ++j)
+         expected += i + j;
+   EXPECT_FLOAT_EQ(*sum, expected);
+
+   gSystem->Unlink(filename);
+}
+
+TEST_P(RDFBulkTests, EmptySource)
+{
+   RDataFrame d(1000);
+   d.SetBulkSize(256);
+   auto f = d.DefineSlotEntry("e", [](unsigned int, ULong64_t e) { return e; }).Filter([](ULong64_t e) {
+      return e % 2 == 1;
+   }, {"e"});
+   EXPECT_EQ(*f.Count(), 500ull);
+   EXPECT_EQ(*f.Sum<ULong64_t>("e"), 500ull * 500ull);
+}
+
+TEST_P(RDFBulkTests, DataSource)
+{
+   RDataFrame d(std::make_unique<RTrivialDS>(1000, /*skipEvenEntries=*/true));
+   d.SetBulkSize(128);
+   auto m = d.Filter([](ULong64_t c) { return c > 100; }, {"col0"}).Min<ULong64_t>("col0");
+   auto s = d.Sum<ULong64_t>("col0");
+   EXPECT_EQ(*m, 101ull);
+   EXPECT_EQ(*s, 500ull * 500ull);
+}
+
+TEST_P(RDFBulkTests, DefineComputedOncePerEntry)
+{
+   std::atomic<ULong64_t> nCalls{0};
+   RDataFrame d(100);
+   d.SetBulkSize(32);
+   auto dd = d.Define("x", [&nCalls](ULong64_t e) { ++nCalls; return e * 2; }, {"tdfentry_"});
+   auto c = dd.Filter([](ULong64_t x) { return x < 50; }, {"x"}).Count();
+   auto m = dd.Max<ULong64_t>("x");
+   EXPECT_EQ(*c, 25ull);
+   EXPECT_EQ(*m, 198ull);
+   EXPECT_EQ(nCalls, 100ull);
+}
+
+struct BulkCallCounts {
+   std::atomic<unsigned int> fNExec{0};
+   std::atomic<unsigned int> fNExecBulk{0};
+   std::atomic<unsigned int> fMaxBlockSize{0};
+};
+
+// Sums its column, counting how many times it is called per entry and per block
+class BulkSumHelper : public ROOT::Detail::RDF::RActionImpl<BulkSumHelper> {
+   const std::shared_ptr<double> fResult = std::make_shared<double>(0.);
+   std::vector<double> fSums;
+   std::shared_ptr<BulkCallCounts> fCounts;
+
+public:
+   BulkSumHelper(unsigned int nSlots, const std::shared_ptr<BulkCallCounts> &counts)
+      : fSums(nSlots, 0.), fCounts(counts)
+   {
+   }
+   BulkSumHelper(BulkSumHelper &&) = default;
+   BulkSumHelper(const BulkSumHelper &) = delete;
+   using Result_t = double;
+   std::shared_ptr<double> GetResultPtr() const { return fResult; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int slot, double x)
+   {
+      ++fCounts->fNExec;
+      fSums[slot] += x;
+   }
+   void ExecBulk(unsigned int slot, const char *mask, unsigned int n, const double *xs)
+   {
+      ++fCounts->fNExecBulk;
+      auto maxSize = fCounts->fMaxBlockSize.load();
+      while (n > maxSize && !fCounts->fMaxBlockSize.compare_exchange_weak(maxSize, n))
+         ;
+      for (auto i = 0u; i < n; ++i) {
+         if (mask[i])
+            fSums[slot] += xs[i];
+      }
+   }
+   void Finalize()
+   {
+      for (auto s : fSums)
+         *fResult += s;
+   }
+   std::string GetActionName() { return "BulkSum"; }
+};
+
+TEST_P(RDFBulkTests, ColumnsAsArrays)
+{
+   auto filename = "dataframe_bulk_columns_as_arrays.root";
+   auto treename = "t";
+   FillBulkTree(filename, treename, 1000);
+
+   RDataFrame d(treename, filename);
+   d.SetBulkSize(64);
+   auto f = d.Filter([](int i) { return i % 2 == 0; }, {"i"}).Define("y", [](double x) { return 2. * x; }, {"x"});
+   auto countsX = std::make_shared<BulkCallCounts>();
+   auto countsY = std::make_shared<BulkCallCounts>();
+   auto sumX = f.Book<double>(BulkSumHelper(NSLOTS, countsX), {"x"});
+   auto sumY = f.Book<double>(BulkSumHelper(NSLOTS, countsY), {"y"});
+   auto mean = f.Mean<double>("y");
+   auto min = f.Min<double>("x");
+   auto max = f.Max<int>("i");
+   auto count = f.Count();
+
+   // x = i / 2, summed over the even i in [0, 1000)
+   EXPECT_DOUBLE_EQ(*sumX, 499. * 500. / 2.);
+   EXPECT_DOUBLE_EQ(*sumY, 499. * 500.);
+   EXPECT_DOUBLE_EQ(*mean, 499.);
+   EXPECT_DOUBLE_EQ(*min, 0.);
+   EXPECT_EQ(*max, 998);
+   EXPECT_EQ(*count, 500ull);
+
+   // the values of the whole block are passed at once, also for custom columns
+   for (const auto &counts : {countsX, countsY}) {
+      EXPECT_EQ(counts->fNExec, 0u);
+      EXPECT_GE(counts->fNExecBulk, 1000u / 64u);
+      EXPECT_LE(counts->fNExecBulk, 1000u);
+      EXPECT_EQ(counts->fMaxBlockSize, 64u);
+   }
+
+   gSystem->Unlink(filename);
+}
+
+TEST(RDFBulk, Ranges)
+{
+   auto take = [](RDataFrame &d) {
+      auto f = d.Filter([](ULong64_t e) { return e % 2 == 0; }, {"tdfentry_"}, "even");
+      return std::make_pair(f.Range(5, 30, 4).Take<ULong64_t>("tdfentry_"), f.Range(3).Count());
+   };
+   RDataFrame perEntry(100);
+   auto expected = take(perEntry);
+   RDataFrame bulk(100);
+   bulk.SetBulkSize(8);
+   auto res = take(bulk);
+   EXPECT_EQ(*res.first, *expected.first);
+   EXPECT_EQ(*res.second, 3ull);
+}
+
+INSTANTIATE_TEST_CASE_P(Seq, RDFBulkTests, ::testing::Values(false));
+
+#ifdef R__USE_IMT
+INSTANTIATE_TEST_CASE_P(MT, RDFBulkTests, ::testing::Values(true));
+#endif
@@ -339,3 +339,108 @@ TEST(Cache, Carrays)
 }
 
 #endif // R__B64
+
+using CachedDF_t = RInterface<ROOT::Detail::RDF::RLoopManager>;
+
+RCacheOptions ChunkedCacheOptions(ULong64_t maxMemory = 0, std::string_view spillDir = "")
+{
+   RCacheOptions opts;
+   opts.fChunkSize = 128;
+   opts.fMaxMemory = maxMemory;
+   opts.fSpillDir = spillDir;
+   return opts;
+}
+
+void CheckChunkedCache(CachedDF_t df, ULong64_t nEntries)
+{
+   auto xs = df.Take<double>("x");
+   auto vs = df.Take<RVec<float>>("v");
+   auto ss = df.Take<std::string>("s");
+   auto c = df.Count();
+   EXPECT_EQ(nEntries, *c);
+   // entries may be cached in any order by multiple threads, but the columns of an entry stay together
+   for (auto i : ROOT::TSeqUL(nEntries)) {
+      const auto e = static_cast<ULong64_t>((*xs)[i] * 2);
+      EXPECT_EQ(e % 5, (*vs)[i].size());
+      for (auto j : ROOT::TSeqUL((*vs)[i].size()))
+         EXPECT_FLOAT_EQ(float(e + j), (*vs)[i][j]);
+      EXPECT_EQ(std::to_string(e), (*ss)[i]);
+   }
+   auto sorted = *xs;
+   std::sort(sorted.begin(), sorted.end());
+   for (auto i : ROOT::TSeqUL(nEntries))
+      EXPECT_DOUBLE_EQ(i * 0.5, sorted[i]);
+}
+
+CachedDF_t DefineChunkedCacheColumns(ROOT::RDataFrame &tdf)
+{
+   return tdf.Define("x", [](ULong64_t e) { return e * 0.5; }, {"rdfentry_"})
+      .Define("v",
+              [](ULong64_t e) {
+                 RVec<float> v(e % 5);
+                 for (auto j : ROOT::TSeqUL(v.size()))
+                    v[j] = e + j;
+                 return v;
+              },
+              {"rdfentry_"})
+      .Define("s", [](ULong64_t e) { return std::to_string(e); }, {"rdfentry_"});
+}
+
+TEST(Cache, Chunked)
+{
+   ROOT::RDataFrame tdf(1000);
+   auto d = DefineChunkedCacheColumns(tdf);
+   auto cached = d.Cache<double, RVec<float>, std::string>({"x", "v", "s"}, ChunkedCacheOptions());
+   CheckChunkedCache(cached, 1000);
+   // the cached dataset can be processed many times
+   EXPECT_DOUBLE_EQ(999. * 1000. / 4., *cached.Sum<double>("x"));
+
+   // same but jitted
+   auto cachedj = d.Cache({"x", "v", "s"}, ChunkedCacheOptions());
+   CheckChunkedCache(cachedj, 1000);
+
+   // and uncompressed
+   auto opts = ChunkedCacheOptions();
+   opts.fCompressionLevel = 0;
+   CheckChunkedCache(d.Cache("x|v|s", opts), 1000);
+}
+
+TEST(Cache, ChunkedSpill)
+{
+   const auto dirName = "dataframe_cache_spill";
+   gSystem->mkdir(dirName);
+   auto countScratchFiles = [dirName]() {
+      auto dir = gSystem->OpenDirectory(dirName);
+      auto n = 0u;
+      while (auto name = gSystem->GetDirEntry(dir))
+         n += std::string(name).find("rdfcache") == 0;
+      gSystem->FreeDirectory(dir);
+      return n;
+   };
+
+   {
+      ROOT::RDataFrame tdf(1000);
+      auto d = DefineChunkedCacheColumns(tdf);
+      // all chunks are spilled
+      auto cached = d.Cache<double, RVec<float>, std::string>({"x", "v", "s"}, ChunkedCacheOptions(1, dirName));
+      CheckChunkedCache(cached, 1000);
+      EXPECT_EQ(1u, countScratchFiles());
+   }
+   EXPECT_EQ(0u, countScratchFiles());
+   gSystem->Unlink(dirName);
+}
+
+#ifdef R__USE_IMT
+TEST(Cache, ChunkedMT)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::RDataFrame tdf(10000);
+      auto d = DefineChunkedCacheColumns(tdf);
+      auto cached = d.Cache<double, RVec<float>, std::string>({"x", "v", "s"}, ChunkedCacheOptions(4096));
+      CheckChunkedCache(cached, 10000);
+      EXPECT_DOUBLE_EQ(9999. * 10000. / 4., *cached.Sum<double>("x"));
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
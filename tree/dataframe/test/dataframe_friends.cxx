@@ -5,6 +5,7 @@
 #include "TFile.h"
 #include "TChain.h"
 #include "TTree.h"
+#include "TTreeCache.h"
 #include "gtest/gtest.h"
 
 // fixture that creates two files with two trees of 10 events each. One has branch `x`, the other branch `y`, both ints.
@@ -150,6 +151,113 @@ TEST_F(RDFAndFriends, FromJittedDefine)
    EXPECT_DOUBLE_EQ(*m, 4.);
 }
 
+TEST_F(RDFAndFriends, PruneBranches)
+{
+   TFile f1(kFile1);
+   TTree *t1 = static_cast<TTree *>(f1.Get("t"));
+   t1->AddFriend("t2", kFile2);
+   t1->AddFriend("t3", kFile3);
+   ROOT::RDataFrame d(*t1);
+   auto df = d.Define("z", "y * 2");
+   // only the branches of the columns read by the computation graph are enabled during the event loop
+   auto checkStatuses = [t1](int) {
+      EXPECT_FALSE(t1->GetBranchStatus("x"));
+      EXPECT_TRUE(t1->GetBranchStatus("y"));
+      EXPECT_FALSE(t1->GetBranchStatus("arr"));
+   };
+   df.Foreach(checkStatuses, {"z"});
+   EXPECT_DOUBLE_EQ(*df.Sum<int>("z"), 16.);
+   EXPECT_TRUE(t1->GetBranchStatus("x"));
+   EXPECT_TRUE(t1->GetBranchStatus("arr"));
+
+   // branches disabled by the user are left alone
+   t1->SetBranchStatus("arr", false);
+   EXPECT_EQ(*d.Max<int>("x"), 1);
+   EXPECT_TRUE(t1->GetBranchStatus("y"));
+   EXPECT_FALSE(t1->GetBranchStatus("arr"));
+}
+
+TEST_F(RDFAndFriends, PruneBranchesCache)
+{
+   const auto fname = "test_tdfandfriends_cache.root";
+   ROOT::RDataFrame(kSizeSmall)
+      .Define("a", [] { return 1; })
+      .Define("b", [] { return 2; })
+      .Snapshot<int, int>("t", fname, {"a", "b"});
+
+   {
+      TFile f(fname);
+      TTree *t = static_cast<TTree *>(f.Get("t"));
+      t->SetCacheSize(10000000);
+      auto cache = t->GetReadCache(&f);
+      ASSERT_NE(cache, nullptr);
+      auto cachedBranches = [cache]() {
+         std::vector<std::string> names;
+         for (auto b : *cache->GetCachedBranches())
+            names.emplace_back(b->GetName());
+         return names;
+      };
+
+      // each event loop caches the branches it reads, and leaves the cache learning as it found it
+      ROOT::RDataFrame d(*t);
+      d.Foreach(
+         [&](int) {
+            EXPECT_FALSE(cache->IsLearning());
+            EXPECT_EQ(cachedBranches(), std::vector<std::string>{"a"});
+         },
+         {"a"});
+      EXPECT_TRUE(cache->IsLearning());
+      d.Foreach(
+         [&](int) {
+            EXPECT_FALSE(cache->IsLearning());
+            EXPECT_EQ(cachedBranches(), std::vector<std::string>{"b"});
+         },
+         {"b"});
+      EXPECT_TRUE(cache->IsLearning());
+
+      // branches cached by the user stay cached, the others are dropped
+      t->AddBranchToCache("a");
+      t->StopCacheLearningPhase();
+      d.Foreach(
+         [&](int) {
+            EXPECT_EQ(cachedBranches(), (std::vector<std::string>{"a", "b"}));
+         },
+         {"b"});
+      EXPECT_FALSE(cache->IsLearning());
+      EXPECT_EQ(cachedBranches(), std::vector<std::string>{"a"});
+   }
+   gSystem->Unlink(fname);
+}
+
+TEST_F(RDFAndFriends, PruneBranchesFriendCache)
+{
+   const auto fname = "test_tdfandfriends_cachemain.root";
+   const auto ffname = "test_tdfandfriends_cachefriend.root";
+   ROOT::RDataFrame(kSizeSmall).Define("a", [] { return 1; }).Snapshot<int>("t", fname, {"a"});
+   ROOT::RDataFrame(kSizeSmall).Define("c", [] { return 3; }).Snapshot<int>("tf", ffname, {"c"});
+
+   {
+      TFile f(fname);
+      TTree *t = static_cast<TTree *>(f.Get("t"));
+      TFile ff(ffname);
+      TTree *tf = static_cast<TTree *>(ff.Get("tf"));
+      t->AddFriend(tf);
+      ASSERT_EQ(tf->GetReadCache(&ff), nullptr);
+
+      // the cache set up for the friend during the event loop is removed afterwards
+      ROOT::RDataFrame d(*t);
+      int sum = 0;
+      d.Foreach(
+         [&](int a, int c) { sum += a + c; },
+         {"a", "tf.c"});
+      EXPECT_EQ(sum, 4 * int(kSizeSmall));
+      EXPECT_EQ(tf->GetReadCache(&ff), nullptr);
+      EXPECT_EQ(ff.GetCacheRead(tf), nullptr);
+   }
+   gSystem->Unlink(fname);
+   gSystem->Unlink(ffname);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
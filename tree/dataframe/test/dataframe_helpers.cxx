@@ -1,6 +1,8 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RVec.hxx>
+#include <TH1D.h>
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <algorithm>
@@ -275,3 +277,45 @@ TEST(RDFHelpers, SaveGraphToFile)
 
    gSystem->Unlink(outFileName);
 }
+
+void CheckRunGraphs()
+{
+   std::vector<RDataFrame> dfs;
+   for (auto i = 1u; i <= 5u; ++i)
+      dfs.emplace_back(i * 10);
+
+   std::vector<RResultPtr<ULong64_t>> counts;
+   std::vector<RResultHandle> handles;
+   for (auto &df : dfs) {
+      counts.emplace_back(df.Filter("tdfentry_ % 2 == 0").Count());
+      handles.emplace_back(counts.back());
+      handles.emplace_back(df.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"}).Histo1D<double>("x"));
+   }
+
+   EXPECT_FALSE(handles[0].IsReady());
+   EXPECT_EQ(RunGraphs(handles), 5u);
+   for (auto i = 0u; i < dfs.size(); ++i) {
+      EXPECT_TRUE(handles[2 * i].IsReady());
+      EXPECT_EQ(*counts[i], (i + 1) * 5);
+      EXPECT_EQ(handles[2 * i].GetValue<ULong64_t>(), (i + 1) * 5);
+      EXPECT_EQ(handles[2 * i + 1].GetValue<TH1D>().GetEntries(), (i + 1) * 10);
+   }
+   EXPECT_THROW(handles[0].GetValue<double>(), std::runtime_error);
+
+   // graphs that already ran are not run again
+   EXPECT_EQ(RunGraphs(handles), 0u);
+}
+
+TEST(RDFHelpers, RunGraphs)
+{
+   CheckRunGraphs();
+}
+
+#ifdef R__USE_IMT
+TEST(RDFHelpers, RunGraphsMT)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckRunGraphs();
+   ROOT::DisableImplicitMT();
+}
+#endif
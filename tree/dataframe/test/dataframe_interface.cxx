@@ -1,11 +1,15 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RTrivialDS.hxx"
+#include "TEnv.h"
+#include "TInterpreter.h"
 #include "TMemFile.h"
 #include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+
 using namespace ROOT;
 using namespace ROOT::RDF;
 
@@ -354,6 +358,104 @@ TEST(RDataFrameInterface, GetColumnType)
    gSystem->Unlink(fname);
 }
 
+TEST(RDataFrameInterface, JittedExpressionsOfSeveralDataFrames)
+{
+   TTree t("t", "t");
+   int x = 0;
+   t.Branch("x", &x);
+   for (x = 0; x < 10; ++x)
+      t.Fill();
+
+   // the same expressions, compiled once, are used by the nodes of both dataframes
+   RDataFrame df1(t);
+   RDataFrame df2(t);
+   auto c1 = df1.Filter("x > 2").Define("y", "x * 2").Filter("y < 15").Count();
+   auto c2 = df2.Filter("x > 2").Define("y", "x * 2").Sum<int>("y");
+   EXPECT_EQ(*c1, 5ull);
+   EXPECT_EQ(*c2, 84);
+}
+
+TEST(RDataFrameInterface, InvalidJittedExpression)
+{
+   TTree t("t", "t");
+   int x = 0;
+   t.Branch("x", &x);
+   t.Fill();
+
+   // jitted code is compiled in batches: errors are reported when the code of the graph is needed
+   RDataFrame df(t);
+   auto c = df.Filter("x >").Count();
+
+   // the invalid expression of another computation graph does not affect this one
+   RDataFrame df2(t);
+   EXPECT_EQ(*df2.Filter("x < 1").Count(), 1ull);
+
+   const auto expectedMsg = "Cannot interpret the following expression:\nx >\n\nMake sure it is valid C++.";
+   try {
+      *c;
+      ADD_FAILURE() << "an invalid expression did not throw";
+   } catch (const std::runtime_error &e) {
+      EXPECT_STREQ(expectedMsg, e.what());
+   }
+   // running the graph again reports the same error
+   try {
+      *df.Count();
+      ADD_FAILURE() << "an invalid expression did not throw";
+   } catch (const std::runtime_error &e) {
+      EXPECT_STREQ(expectedMsg, e.what());
+   }
+
+   // a valid graph booked after the error runs
+   RDataFrame df3(t);
+   EXPECT_EQ(*df3.Filter("x < 1").Count(), 1ull);
+}
+
+TEST(RDataFrameInterface, JitCacheDir)
+{
+   TTree t("t", "t");
+   int x = 0;
+   t.Branch("x", &x);
+   for (x = 0; x < 10; ++x)
+      t.Fill();
+
+   const auto cacheDir = "dataframe_interface_jitcache";
+   gSystem->mkdir(cacheDir);
+   gEnv->SetValue("RDataFrame.JitCacheDir", cacheDir);
+   // an expression calling a function declared to the interpreter cannot be cached, the others are
+   gInterpreter->Declare("int JitCacheDirHelper(int x) { return x + 1; }");
+   RDataFrame df(t);
+   auto s = df.Filter("x % 3 == 0").Define("z", "TMath::Sq(x) + 1").Sum<double>("z");
+   auto w = df.Define("w", "JitCacheDirHelper(x)").Sum<int>("w");
+   EXPECT_DOUBLE_EQ(*s, 130.);
+   EXPECT_EQ(*w, 55);
+   gEnv->SetValue("RDataFrame.JitCacheDir", "");
+
+   // each cached expression was compiled in its own library, and no lock was left behind
+   auto dir = gSystem->OpenDirectory(cacheDir);
+   ASSERT_NE(dir, nullptr);
+   std::vector<std::string> files;
+   while (auto entry = gSystem->GetDirEntry(dir)) {
+      const std::string name(entry);
+      if (name != "." && name != "..")
+         files.emplace_back(name);
+   }
+   gSystem->FreeDirectory(dir);
+   const auto nLibs = std::count_if(files.begin(), files.end(), [](const std::string &f) {
+      return f.find("rdfjit_") == 0 && f.find(std::string(".") + gSystem->GetSoExt()) != std::string::npos;
+   });
+   EXPECT_EQ(nLibs, 2);
+   // the expression that could not be compiled is marked, the next processes do not try again
+   EXPECT_EQ(std::count_if(files.begin(), files.end(),
+                           [](const std::string &f) { return f.find(".failed") != std::string::npos; }),
+             1);
+   EXPECT_TRUE(std::none_of(files.begin(), files.end(),
+                            [](const std::string &f) { return f.find(".lock") != std::string::npos; }));
+
+   for (const auto &f : files)
+      gSystem->Unlink((std::string(cacheDir) + "/" + f).c_str());
+   gSystem->Unlink(cacheDir);
+}
+
 TEST(RDFHelpers, CastToNode)
 {
    // an empty RDF
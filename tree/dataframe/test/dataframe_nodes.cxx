@@ -1,4 +1,5 @@
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDF/InterfaceUtils.hxx>
 #include <ROOT/RDF/RSlotStack.hxx>
 #include <TSystem.h>
 
@@ -86,3 +87,23 @@ TEST(RDataFrameNodes, DoubleEvtLoop)
    for (auto &f : files)
       gSystem->Unlink(f.c_str());
 }
+
+TEST(RDataFrameNodes, ParseRangeCut)
+{
+   using ROOT::Internal::RDF::ParseRangeCut;
+   ROOT::RDF::RDataSource::RRangeCut cut;
+
+   EXPECT_TRUE(ParseRangeCut("x > 1 && 2.5e1 >= x", "x", cut));
+   EXPECT_EQ("x", cut.fColumn);
+   EXPECT_DOUBLE_EQ(1., cut.fMin);
+   EXPECT_DOUBLE_EQ(25., cut.fMax);
+
+   EXPECT_TRUE(ParseRangeCut(" x == -3 ", "x", cut));
+   EXPECT_DOUBLE_EQ(-3., cut.fMin);
+   EXPECT_DOUBLE_EQ(-3., cut.fMax);
+
+   EXPECT_FALSE(ParseRangeCut("x > 1 || x < -1", "x", cut));
+   EXPECT_FALSE(ParseRangeCut("x * 2 > 1", "x", cut));
+   EXPECT_FALSE(ParseRangeCut("xx > 1", "x", cut));
+   EXPECT_FALSE(ParseRangeCut("x != 1", "x", cut));
+}
@@ -1,5 +1,10 @@
 #include "ROOT/RDataFrame.hxx"
+#include <TFile.h>
 #include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <algorithm>
 
 #include "gtest/gtest.h"
 
@@ -91,18 +96,80 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, SameEntriesAsSequential)
+{
+   auto book = [](RDataFrame &d) {
+      auto dd = d.Define("e", [](ULong64_t e) { return e; }, {"tdfentry_"});
+      return std::make_tuple(dd.Range(5, 300, 7).Take<ULong64_t>("e"), dd.Range(100).Count(),
+                             dd.Range(950, 0, 3).Take<ULong64_t>("e"));
+   };
+   RDataFrame seq(1000);
+   auto expected = book(seq);
+   auto expectedTake1 = *std::get<0>(expected);
+   auto expectedTake2 = *std::get<2>(expected);
+
+   ROOT::EnableImplicitMT(4);
+   RDataFrame mt(1000);
+   auto res = book(mt);
+   auto take1 = *std::get<0>(res);
+   auto take2 = *std::get<2>(res);
+   std::sort(take1.begin(), take1.end());
+   std::sort(take2.begin(), take2.end());
+   EXPECT_EQ(take1, expectedTake1);
+   EXPECT_EQ(*std::get<1>(res), 100ull);
+   EXPECT_EQ(take2, expectedTake2);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, Tree)
+{
+   const std::vector<std::string> fileNames{"dataframe_ranges_mt_0.root", "dataframe_ranges_mt_1.root"};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(10);
+      int x = 0;
+      t.Branch("x", &x);
+      for (auto j = 0; j < 100; ++j) {
+         x = 100 * i + j;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d("t", fileNames);
+   auto take = d.Range(15, 155, 4).Take<int>("x");
+   auto count = d.Range(0, 95).Count();
+   std::vector<int> expected;
+   for (auto e = 15; e < 155; ++e)
+      if ((e + 1) % 4 == 0)
+         expected.push_back(e);
+   std::sort(take->begin(), take->end());
+   EXPECT_EQ(*take, expected);
+   EXPECT_EQ(*count, 95ull);
+   ROOT::DisableImplicitMT();
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+TEST(RDFRangesMT, ThrowIfNotOnDataset)
 {
-   bool hasThrown = false;
    ROOT::EnableImplicitMT();
-   RDataFrame d(0);
+   RDataFrame d(10);
+   bool hasThrown = false;
    try {
-      d.Range(0);
+      d.Filter([] { return true; }).Range(0);
    } catch (const std::exception &e) {
       hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
+      EXPECT_STREQ(e.what(), "Range: with ImplicitMT enabled, Range can only be applied directly to the dataset, not "
+                             "after Filters or other Ranges.");
    }
    EXPECT_TRUE(hasThrown);
+   EXPECT_THROW(d.Range(5).Range(2), std::runtime_error);
+   EXPECT_NO_THROW(d.Define("x", [] { return 1; }).Range(2));
+   ROOT::DisableImplicitMT();
 }
 #endif
 
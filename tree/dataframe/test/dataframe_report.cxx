@@ -1,4 +1,7 @@
+#include "TFile.h"
 #include "TRandom.h"
+#include "TSystem.h"
+#include "TTree.h"
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
 #include "gtest/gtest.h"
@@ -110,3 +113,66 @@ TEST(RDataFrameReport, ActionLazyness)
    EXPECT_TRUE(hasRun);
 
 }
+
+TEST(RDataFrameReport, Profile)
+{
+   ROOT::RDataFrame d(10);
+   auto dd = d.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                .Filter([](int x) { return x % 2 == 0; }, {"x"}, "even");
+   auto count = dd.Count();
+   auto profile = d.Profile();
+   EXPECT_EQ(*count, 5ull);
+
+   using ENodeKind = ROOT::RDF::RProfileReport::ENodeKind;
+   const auto &x = profile->At("x");
+   EXPECT_EQ(x.fKind, ENodeKind::kDefine);
+   EXPECT_EQ(x.fCalls, 10ull);
+   const auto &even = profile->At("even");
+   EXPECT_EQ(even.fKind, ENodeKind::kFilter);
+   EXPECT_EQ(even.fCalls, 10ull);
+   const auto &countNode = profile->At("Count()");
+   EXPECT_EQ(countNode.fKind, ENodeKind::kAction);
+   EXPECT_EQ(countNode.fCalls, 5ull);
+   EXPECT_THROW(profile->At("rdfentry_"), std::runtime_error);
+
+   ULong64_t entries = 0ull;
+   for (const auto &slot : profile->GetSlots())
+      entries += slot.fEntries;
+   EXPECT_EQ(entries, 10ull);
+   EXPECT_FALSE(profile->GetTasks().empty());
+   EXPECT_GE(profile->GetWallTime(), 0.);
+   EXPECT_NE(profile->AsJSON().find("\"name\": \"even\""), std::string::npos);
+   EXPECT_NE(profile->AsChromeTrace().find("\"traceEvents\""), std::string::npos);
+
+   // only the event loop running the Profile action is profiled
+   auto count2 = dd.Count();
+   EXPECT_EQ(*count2, 5ull);
+   EXPECT_EQ(profile->At("x").fCalls, 10ull);
+}
+
+TEST(RDataFrameReport, ProfileTreeColumns)
+{
+   const auto fileName = "dataframe_report_profile.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int b = 0;
+      t.Branch("b", &b);
+      for (b = 0; b < 100; ++b)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::RDataFrame d("t", fileName);
+   auto sum = d.Sum<int>("b");
+   auto profile = d.Profile();
+   EXPECT_DOUBLE_EQ(*sum, 4950.);
+
+   const auto &b = profile->At("b");
+   EXPECT_EQ(b.fKind, ROOT::RDF::RProfileReport::ENodeKind::kColumnRead);
+   EXPECT_EQ(b.fCalls, 100ull);
+   EXPECT_GT(b.fBytes, 0ull);
+   EXPECT_EQ(profile->At("Sum(b)").fCalls, 100ull);
+
+   gSystem->Unlink(fileName);
+}
@@ -615,6 +615,44 @@ TEST(RDFSnapshotMore, Lazy)
    gSystem->Unlink(fname1);
 }
 
+void CheckBulkFill(const char *bulkFname, const char *perEntryFname)
+{
+   ROOT::RDataFrame bulk("t", bulkFname);
+   ROOT::RDataFrame perEntry("t", perEntryFname);
+   EXPECT_EQ(*bulk.Count(), *perEntry.Count());
+   EXPECT_EQ(*bulk.Sum<double>("x"), *perEntry.Sum<double>("x"));
+   EXPECT_EQ(*bulk.Sum<ULong64_t>("e"), *perEntry.Sum<ULong64_t>("e"));
+   EXPECT_EQ(*bulk.Max<float>("y"), *perEntry.Max<float>("y"));
+   gSystem->Unlink(bulkFname);
+   gSystem->Unlink(perEntryFname);
+}
+
+TEST(RDFSnapshotMore, BulkFill)
+{
+   RDataFrame d(2500);
+   auto dd = d.Define("x", [](ULong64_t e) { return e * 0.5; }, {"tdfentry_"})
+                .Define("y", [](ULong64_t e) { return float(e % 7); }, {"tdfentry_"})
+                .Define("e", [](ULong64_t e) { return e; }, {"tdfentry_"});
+   RSnapshotOptions opts;
+   opts.fAutoFlush = 300;
+   opts.fBulkFillSize = 128;
+   dd.Snapshot<double, float, ULong64_t>("t", "snapshot_bulkfill.root", {"x", "y", "e"}, opts);
+   opts.fBulkFillSize = 0;
+   dd.Snapshot<double, float, ULong64_t>("t", "snapshot_perentryfill.root", {"x", "y", "e"}, opts);
+
+   // the clusters are the same as when filling one entry at a time
+   TFile f("snapshot_bulkfill.root");
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   ASSERT_NE(t, nullptr);
+   auto clusters = t->GetClusterIterator(0);
+   for (Long64_t start = 0; start < 2500; start += 300)
+      EXPECT_EQ(clusters(), start);
+   f.Close();
+
+   CheckBulkFill("snapshot_bulkfill.root", "snapshot_perentryfill.root");
+}
+
 TEST(RDFSnapshotMore, LazyNotTriggered)
 {
    {
@@ -637,6 +675,23 @@ TEST_F(RDFSnapshotMT, Snapshot_action_with_options)
    test_snapshot_options(tdf);
 }
 
+TEST(RDFSnapshotMore, BulkFillMT)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(10000);
+   auto dd = d.Define("x", [](ULong64_t e) { return e * 0.5; }, {"tdfentry_"})
+                .Define("y", [](ULong64_t e) { return float(e % 7); }, {"tdfentry_"})
+                .Define("e", [](ULong64_t e) { return e; }, {"tdfentry_"});
+   RSnapshotOptions opts;
+   opts.fBulkFillSize = 100;
+   dd.Snapshot<double, float, ULong64_t>("t", "snapshot_bulkfill_mt.root", {"x", "y", "e"}, opts);
+   opts.fBulkFillSize = 0;
+   dd.Snapshot<double, float, ULong64_t>("t", "snapshot_perentryfill_mt.root", {"x", "y", "e"}, opts);
+   ROOT::DisableImplicitMT();
+
+   CheckBulkFill("snapshot_bulkfill_mt.root", "snapshot_perentryfill_mt.root");
+}
+
 TEST(RDFSnapshotMore, ManyTasksPerThread)
 {
    const auto nSlots = 4u;
@@ -0,0 +1,155 @@
+/****** Run RDataFrame systematic variations tests both with and without IMT enabled *******/
+#include <gtest/gtest.h>
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+#include <TH1D.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+using namespace ROOT::VecOps;
+
+// Fixture for all tests in this file. If parameter is true, run with implicit MT, else run sequentially
+class RDFVaryTests : public ::testing::TestWithParam<bool> {
+protected:
+   RDFVaryTests() : NSLOTS(GetParam() ? 4u : 1u)
+   {
+      if (GetParam())
+         ROOT::EnableImplicitMT(NSLOTS);
+   }
+   ~RDFVaryTests()
+   {
+      if (GetParam())
+         ROOT::DisableImplicitMT();
+   }
+   const unsigned int NSLOTS;
+};
+
+TEST_P(RDFVaryTests, FilterDefineAction)
+{
+   RDataFrame d(10);
+   auto x = d.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"});
+   auto varied = x.Vary("x", [](double v) { return RVec<double>{v - 1., v + 1.}; }, {"x"}, {"down", "up"}, "shift");
+   auto f = varied.Filter([](double v) { return v > 4.5; }, {"x"}).Define("y", [](double v) { return v * 2.; }, {"x"});
+   auto sums = VariationsFor(f.Sum<double>("y"));
+   auto counts = VariationsFor(f.Count());
+
+   ASSERT_EQ(sums.size(), 3u);
+   EXPECT_DOUBLE_EQ(*sums["nominal"], 2. * (5. + 6. + 7. + 8. + 9.));
+   EXPECT_DOUBLE_EQ(*sums["shift:down"], 2. * (5. + 6. + 7. + 8.));
+   EXPECT_DOUBLE_EQ(*sums["shift:up"], 2. * (5. + 6. + 7. + 8. + 9. + 10.));
+   EXPECT_EQ(*counts["nominal"], 5ull);
+   EXPECT_EQ(*counts["shift:down"], 4ull);
+   EXPECT_EQ(*counts["shift:up"], 6ull);
+}
+
+TEST_P(RDFVaryTests, UnaffectedNodesAreShared)
+{
+   std::atomic<ULong64_t> nFilterCalls{0};
+   std::atomic<ULong64_t> nDefineCalls{0};
+   RDataFrame d(20);
+   auto xy = d.Define("x", [](ULong64_t e) { return double(e); }, {"tdfentry_"})
+                .Define("y", [](ULong64_t e) { return int(e % 2); }, {"tdfentry_"});
+   auto varied = xy.Vary("x", [](double v) { return RVec<double>{0.5 * v, 2. * v}; }, {"x"}, {"half", "double"});
+   auto even = varied.Filter([&nFilterCalls](int y) { ++nFilterCalls; return y == 0; }, {"y"});
+   auto z = even.Define("z", [&nDefineCalls](int y) { ++nDefineCalls; return y + 1; }, {"y"});
+   auto sumX = VariationsFor(z.Sum<double>("x"));
+   auto sumZ = VariationsFor(z.Sum<int>("z"));
+
+   EXPECT_DOUBLE_EQ(*sumX["nominal"], 90.);
+   EXPECT_DOUBLE_EQ(*sumX["x:half"], 45.);
+   EXPECT_DOUBLE_EQ(*sumX["x:double"], 180.);
+   EXPECT_EQ(*sumZ["nominal"], 10);
+   EXPECT_EQ(*sumZ["x:half"], 10);
+   EXPECT_EQ(*sumZ["x:double"], 10);
+   EXPECT_EQ(nFilterCalls, 20ull);
+   EXPECT_EQ(nDefineCalls, 10ull);
+}
+
+TEST_P(RDFVaryTests, Histo1D)
+{
+   RDataFrame d(100);
+   auto x = d.Define("x", [](ULong64_t e) { return double(e % 10); }, {"tdfentry_"});
+   auto h = x.Vary("x", [](double v) { return RVec<double>{v + 10.}; }, {"x"}, {"plus10"})
+               .Histo1D<double>({"h", "h", 30, 0., 30.}, "x");
+   auto hs = VariationsFor(h);
+   EXPECT_DOUBLE_EQ(hs["nominal"]->GetMean(), 4.5);
+   EXPECT_DOUBLE_EQ(hs["x:plus10"]->GetMean(), 14.5);
+   EXPECT_EQ(hs["x:plus10"]->GetEntries(), 100.);
+   EXPECT_EQ(hs["x:plus10"]->GetDirectory(), nullptr);
+}
+
+TEST_P(RDFVaryTests, Jitted)
+{
+   RDataFrame d(10);
+   auto x = d.Define("x", "double(tdfentry_)");
+   auto varied = x.Vary("x", "ROOT::VecOps::RVec<double>{x - 1., x + 1.}", {"down", "up"});
+   auto sums = VariationsFor(varied.Filter("x > 4.5").Define("y", "x * 2").Sum<double>("y"));
+   EXPECT_DOUBLE_EQ(*sums["nominal"], 70.);
+   EXPECT_DOUBLE_EQ(*sums["x:down"], 52.);
+   EXPECT_DOUBLE_EQ(*sums["x:up"], 90.);
+}
+
+TEST_P(RDFVaryTests, HiddenValuesColumn)
+{
+   RDataFrame d(1);
+   auto x = d.Define("x", []() { return 1.; });
+   auto varied = x.Vary("x", [](double v) { return RVec<double>{v}; }, {"x"}, {"a"});
+   auto jitted = varied.Define("y", []() { return 2.; }).Vary("y", "ROOT::VecOps::RVec<double>{y}", {"b"});
+
+   // the varied values are held by internal columns, which are not listed
+   const auto isHidden = [](const std::vector<std::string> &names) {
+      return std::none_of(names.begin(), names.end(),
+                          [](const std::string &n) { return n.find("variations") != std::string::npos; });
+   };
+   EXPECT_EQ(varied.GetDefinedColumnNames(), std::vector<std::string>{"x"});
+   EXPECT_EQ(jitted.GetDefinedColumnNames().size(), 2u);
+   EXPECT_TRUE(isHidden(jitted.GetDefinedColumnNames()));
+   EXPECT_TRUE(isHidden(jitted.GetColumnNames()));
+}
+
+TEST_P(RDFVaryTests, IndependentVariations)
+{
+   RDataFrame d(4);
+   auto xy = d.Define("x", []() { return 1; }).Define("y", []() { return 10; });
+   auto varied = xy.Vary("x", [](int v) { return RVec<int>{v + 1}; }, {"x"}, {"up"})
+                    .Vary("y", [](int v) { return RVec<int>{v + 1}; }, {"y"}, {"up"});
+   auto sums = VariationsFor(varied.Define("s", [](int a, int b) { return a + b; }, {"x", "y"}).Sum<int>("s"));
+   EXPECT_EQ(sums.size(), 3u);
+   EXPECT_EQ(*sums["nominal"], 44);
+   EXPECT_EQ(*sums["x:up"], 48);
+   EXPECT_EQ(*sums["y:up"], 48);
+}
+
+TEST_P(RDFVaryTests, NoVariations)
+{
+   RDataFrame d(5);
+   auto c = d.Count();
+   auto cs = VariationsFor(c);
+   EXPECT_EQ(cs.size(), 1u);
+   EXPECT_EQ(*cs["nominal"], 5ull);
+}
+
+TEST(RDFVary, Errors)
+{
+   RDataFrame d(5);
+   auto x = d.Define("x", []() { return 1.; });
+   auto varied = x.Vary("x", [](double v) { return RVec<double>{v}; }, {"x"}, {"a"});
+   EXPECT_THROW(varied.Vary("x", [](double v) { return RVec<double>{v}; }, {"x"}, {"a"}), std::runtime_error);
+   EXPECT_THROW(x.Vary("x", [](double v) { return RVec<double>{v}; }, {"x"}, {}), std::runtime_error);
+   EXPECT_THROW(x.Vary("nonexistent", [](double v) { return RVec<double>{v}; }, {"x"}, {"a"}), std::runtime_error);
+
+   auto wrongSize = x.Vary("x", [](double v) { return RVec<double>{v}; }, {"x"}, {"a", "b"}).Sum<double>("x");
+   EXPECT_THROW(*wrongSize, std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(Seq, RDFVaryTests, ::testing::Values(false));
+
+#ifdef R__USE_IMT
+INSTANTIATE_TEST_CASE_P(MT, RDFVaryTests, ::testing::Values(true));
+#endif
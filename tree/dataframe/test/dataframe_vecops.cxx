@@ -1,6 +1,7 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RVec.hxx>
 #include <TBranchElement.h>
+#include <TChain.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TSystem.h> // Unlink
@@ -131,3 +132,50 @@ TEST(RDFAndVecOps, RVecBool)
    gSystem->Unlink(filename);
 }
 
+
+TEST(RDFAndVecOps, ReadLeafListArraysInBulk)
+{
+   const auto fname1 = "rdfandvecops_bulk1.root";
+   const auto fname2 = "rdfandvecops_bulk2.root";
+   const auto treename = "t";
+   for (auto fname : {fname1, fname2}) {
+      TFile f(fname, "RECREATE");
+      TTree t(treename, treename);
+      int n = 0;
+      float arr[16];
+      double fixed[3];
+      t.Branch("n", &n);
+      t.Branch("arr", arr, "arr[n]/F");
+      t.Branch("fixed", fixed, "fixed[3]/D");
+      for (int i = 0; i < 1000; ++i) {
+         n = i % 16;
+         for (int j = 0; j < n; ++j)
+            arr[j] = i + j;
+         for (int j = 0; j < 3; ++j)
+            fixed[j] = i * j;
+         t.Fill();
+         if (i % 128 == 127)
+            t.FlushBaskets();
+      }
+      t.Write();
+   }
+
+   TChain c(treename);
+   c.Add(fname1);
+   c.Add(fname2);
+   RDataFrame d(c);
+   auto checkArrays = [](ULong64_t entry, const RVec<float> &arr, const RVec<double> &fixed) {
+      const auto i = entry % 1000;
+      EXPECT_EQ(i % 16, arr.size());
+      for (auto j = 0u; j < arr.size(); ++j)
+         EXPECT_FLOAT_EQ(i + j, arr[j]);
+      ASSERT_EQ(3u, fixed.size());
+      for (auto j = 0u; j < 3u; ++j)
+         EXPECT_DOUBLE_EQ(i * j, fixed[j]);
+   };
+   d.Foreach(checkArrays, {"rdfentry_", "arr", "fixed"});
+   EXPECT_EQ(2000ull, *d.Filter([](const RVec<float> &arr) { return arr.size() < 16; }, {"arr"}).Count());
+
+   gSystem->Unlink(fname1);
+   gSystem->Unlink(fname2);
+}
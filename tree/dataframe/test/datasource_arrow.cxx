@@ -8,6 +8,8 @@
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 #include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/table.h>
@@ -18,6 +20,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
 #include <iostream>
 
 using namespace ROOT;
@@ -58,6 +61,32 @@ std::shared_ptr<Table> createTestTable()
    return table_;
 }
 
+// The rows of the test table in two record batches, of 4 and 2 rows
+std::vector<std::shared_ptr<RecordBatch>> createTestBatches()
+{
+   auto table = createTestTable();
+   std::vector<std::shared_ptr<RecordBatch>> batches;
+   for (auto range : {std::make_pair(0, 4), std::make_pair(4, 2)}) {
+      std::vector<std::shared_ptr<Array>> arrays;
+      for (auto i : ROOT::TSeqI(table->num_columns()))
+         arrays.push_back(table->column(i)->data()->chunk(0)->Slice(range.first, range.second));
+      batches.push_back(RecordBatch::Make(table->schema(), range.second, arrays));
+   }
+   return batches;
+}
+
+void writeTestFile(const std::string &fileName)
+{
+   std::shared_ptr<io::FileOutputStream> stream;
+   ASSERT_TRUE(io::FileOutputStream::Open(fileName, &stream).ok());
+   std::shared_ptr<ipc::RecordBatchWriter> writer;
+   ASSERT_TRUE(ipc::RecordBatchFileWriter::Open(stream.get(), exampleSchema(), &writer).ok());
+   for (auto &batch : createTestBatches())
+      ASSERT_TRUE(writer->WriteRecordBatch(*batch).ok());
+   ASSERT_TRUE(writer->Close().ok());
+   ASSERT_TRUE(stream->Close().ok());
+}
+
 TEST(RArrowDS, ColTypeNames)
 {
    RArrowDS tds(createTestTable(), {"Name", "Age", "Height", "Married", "Babies"});
@@ -98,6 +127,36 @@ TEST(RArrowDS, EntryRanges)
    EXPECT_EQ(6U, ranges[2].second);
 }
 
+TEST(RArrowDS, EntryRangesFollowRecordBatches)
+{
+   std::shared_ptr<Table> table;
+   ASSERT_TRUE(Table::FromRecordBatches(createTestBatches(), &table).ok());
+   RArrowDS tds(table, {});
+   tds.SetNSlots(3U);
+   auto vals = tds.GetColumnReaders<Long64_t>("Age");
+   tds.Initialise();
+
+   // One range per record batch
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(4U, ranges[0].second);
+   EXPECT_EQ(4U, ranges[1].first);
+   EXPECT_EQ(6U, ranges[1].second);
+
+   std::vector<Long64_t> ages = {64, 50, 40, 30, 2, 0};
+   auto slot = 0U;
+   for (auto &&range : ranges) {
+      tds.InitSlot(slot, range.first);
+      for (auto i : ROOT::TSeq<int>(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(ages[i], **vals[slot]);
+      }
+      slot++;
+   }
+}
+
 TEST(RArrowDS, ColumnReaders)
 {
    RArrowDS tds(createTestTable(), {});
@@ -184,6 +243,26 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromFile)
+{
+   const auto fileName = "datasource_arrow_fromfile.arrow";
+   writeTestFile(fileName);
+   {
+      auto rdf = MakeArrowDataFrame(fileName, {"Name", "Age", "Height"});
+      auto c = rdf.Count();
+      auto sum = rdf.Sum<Long64_t>("Age");
+      auto max = rdf.Max<double>("Height");
+      auto names = rdf.Take<std::string>("Name");
+
+      EXPECT_EQ(6U, *c);
+      EXPECT_EQ(186, *sum);
+      EXPECT_DOUBLE_EQ(200.5, *max);
+      const std::vector<std::string> expectedNames = {"Harry", "Bob,Bob", "\"Joe\"", "Tom", " John  ", " Mary Ann "};
+      EXPECT_EQ(expectedNames, *names);
+   }
+   std::remove(fileName);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -230,6 +309,22 @@ TEST(RArrowDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromFileMT)
+{
+   ROOT::EnableImplicitMT(2);
+   const auto fileName = "datasource_arrow_fromfilemt.arrow";
+   writeTestFile(fileName);
+   {
+      auto rdf = MakeArrowDataFrame(fileName, {});
+      auto c = rdf.Count();
+      auto sum = rdf.Filter("Married").Sum<UInt_t>("Babies");
+
+      EXPECT_EQ(6U, *c);
+      EXPECT_EQ(4U, *sum);
+   }
+   std::remove(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
@@ -2,9 +2,11 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -180,6 +182,27 @@ TEST(RCsvDS, ProgressiveReadingRDF)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, TypeInferenceSample)
+{
+   const auto fileName = "RCsvDS_test_sample.csv";
+   {
+      std::ofstream f(fileName);
+      f << "a,b,c\n1,true,1\n2.5,x,\n";
+   }
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName);
+   EXPECT_EQ("double", tdf.GetColumnType("a"));
+   EXPECT_EQ("std::string", tdf.GetColumnType("b"));
+   EXPECT_EQ("Long64_t", tdf.GetColumnType("c"));
+
+   auto a = tdf.Take<double>("a");
+   auto b = tdf.Take<std::string>("b");
+   auto c = tdf.Take<Long64_t>("c");
+   EXPECT_EQ(std::vector<double>({1., 2.5}), *a);
+   EXPECT_EQ(std::vector<std::string>({"true", "x"}), *b);
+   EXPECT_EQ(std::vector<Long64_t>({1LL, 0LL}), *c);
+   gSystem->Unlink(fileName);
+}
+
 #ifndef NDEBUG
 
 TEST(RCsvDS, SetNSlotsTwice)
@@ -289,6 +312,36 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   // large enough to be parsed by several tasks
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nLines = 100000LL;
+   {
+      std::ofstream f(fileName);
+      f << "x,y,s,b\n";
+      for (auto i = 0LL; i < nLines; ++i)
+         f << i << ',' << i * 0.5 << ",\"s" << i << "\"," << (i % 2 == 0 ? "true" : "false") << '\n';
+   }
+
+   for (auto chunkSize : {-1LL, 30000LL}) {
+      auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName, true, ',', chunkSize);
+      auto c = tdf.Count();
+      auto x = tdf.Sum<Long64_t>("x");
+      auto y = tdf.Sum<double>("y");
+      auto nEven = tdf.Filter([](bool b) { return b; }, {"b"}).Count();
+      auto nMatching = tdf.Filter([](Long64_t i, const std::string &s) { return s == "s" + std::to_string(i); },
+                                  {"x", "s"})
+                          .Count();
+      EXPECT_EQ(ULong64_t(nLines), *c);
+      EXPECT_EQ(nLines * (nLines - 1) / 2, *x);
+      EXPECT_DOUBLE_EQ(nLines * (nLines - 1) / 4., *y);
+      EXPECT_EQ(ULong64_t(nLines / 2), *nEven);
+      EXPECT_EQ(ULong64_t(nLines), *nMatching);
+   }
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
@@ -0,0 +1,160 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <TROOT.h>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/memory_pool.h>
+#include <arrow/table.h>
+#include <parquet/arrow/writer.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <limits>
+
+using namespace ROOT::RDF;
+
+// 100 entries with x = 0.5 * n = 0., .5, 1., ..., in 10 row groups of 10 entries
+void writeTestFile(const std::string &fileName)
+{
+   std::vector<double> xs;
+   std::vector<int64_t> ns;
+   for (auto i = 0; i < 100; ++i) {
+      xs.push_back(0.5 * i);
+      ns.push_back(i);
+   }
+   arrow::DoubleBuilder xBuilder;
+   arrow::Int64Builder nBuilder;
+   std::shared_ptr<arrow::Array> x, n;
+   ASSERT_TRUE(xBuilder.AppendValues(xs).ok());
+   ASSERT_TRUE(xBuilder.Finish(&x).ok());
+   ASSERT_TRUE(nBuilder.AppendValues(ns).ok());
+   ASSERT_TRUE(nBuilder.Finish(&n).ok());
+   auto schema = arrow::schema({arrow::field("x", arrow::float64()), arrow::field("n", arrow::int64())});
+   auto table = arrow::Table::Make(schema, {x, n});
+
+   std::shared_ptr<arrow::io::FileOutputStream> stream;
+   ASSERT_TRUE(arrow::io::FileOutputStream::Open(fileName, &stream).ok());
+   ASSERT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), stream, 10).ok());
+   ASSERT_TRUE(stream->Close().ok());
+}
+
+class RParquetDSTest : public ::testing::Test {
+protected:
+   const std::string fFileName = "datasource_parquet.parquet";
+   void SetUp() override { writeTestFile(fFileName); }
+   void TearDown() override { std::remove(fFileName.c_str()); }
+};
+
+TEST_F(RParquetDSTest, ColTypeNames)
+{
+   RParquetDS tds(fFileName, {"n"});
+
+   EXPECT_TRUE(tds.HasColumn("n"));
+   EXPECT_FALSE(tds.HasColumn("x"));
+   ASSERT_EQ(1U, tds.GetColumnNames().size());
+   EXPECT_STREQ("Long64_t", tds.GetTypeName("n").c_str());
+   EXPECT_THROW(RParquetDS(fFileName, {"y"}), std::runtime_error);
+}
+
+TEST_F(RParquetDSTest, EntryRangesAreRowGroups)
+{
+   RParquetDS tds(fFileName);
+   tds.SetNSlots(2U);
+   auto vals = tds.GetColumnReaders<double>("x");
+   tds.Initialise();
+
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(10U, ranges.size());
+   for (auto i = 0U; i < ranges.size(); ++i) {
+      EXPECT_EQ(10U * i, ranges[i].first);
+      EXPECT_EQ(10U * (i + 1), ranges[i].second);
+   }
+   EXPECT_TRUE(tds.GetEntryRanges().empty());
+
+   // the slots read different row groups
+   tds.SetEntry(0U, 15U);
+   tds.SetEntry(1U, 84U);
+   EXPECT_DOUBLE_EQ(7.5, **vals[0]);
+   EXPECT_DOUBLE_EQ(42., **vals[1]);
+   tds.SetEntry(0U, 16U);
+   EXPECT_DOUBLE_EQ(8., **vals[0]);
+}
+
+TEST_F(RParquetDSTest, RangeCutSkipsRowGroups)
+{
+   RParquetDS tds(fFileName);
+   tds.SetNSlots(1U);
+   tds.SetEntryCuts({{"x", 17.5, 26.}});
+   tds.Initialise();
+
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(3U, ranges.size());
+   EXPECT_EQ(30U, ranges[0].first);
+   EXPECT_EQ(60U, ranges[2].second);
+
+   // entries pass one cut at least
+   tds.SetEntryCuts({{"x", -1., -0.5}, {"n", 95., std::numeric_limits<double>::infinity()}});
+   tds.Initialise();
+   ranges = tds.GetEntryRanges();
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(90U, ranges[0].first);
+}
+
+TEST_F(RParquetDSTest, FromARDF)
+{
+   auto rdf = MakeParquetDataFrame(fFileName);
+   auto c = rdf.Count();
+   auto sum = rdf.Sum<double>("x");
+
+   EXPECT_EQ(100U, *c);
+   EXPECT_DOUBLE_EQ(2475., *sum);
+}
+
+TEST_F(RParquetDSTest, FilterPushdown)
+{
+   auto rdf = MakeParquetDataFrame(fFileName);
+   auto filtered = rdf.Filter("x >= 45");
+   auto c = filtered.Count();
+   auto profile = filtered.Profile();
+
+   EXPECT_EQ(10U, *c);
+   // only the last row group is read
+   ULong64_t entries = 0ull;
+   for (const auto &slot : profile->GetSlots())
+      entries += slot.fEntries;
+   EXPECT_EQ(10U, entries);
+
+   // the entries of all row groups are needed by the actions which do not hang from the filter
+   auto all = rdf.Count();
+   auto c2 = rdf.Filter("x >= 45").Count();
+   EXPECT_EQ(100U, *all);
+   EXPECT_EQ(10U, *c2);
+}
+
+#ifdef R__USE_IMT
+
+TEST_F(RParquetDSTest, FromARDFMT)
+{
+   ROOT::EnableImplicitMT(4);
+   auto rdf = MakeParquetDataFrame(fFileName);
+   auto c = rdf.Count();
+   auto sum = rdf.Filter("x > 21.25 && x < 28").Sum<Long64_t>("n");
+
+   EXPECT_EQ(100U, *c);
+   EXPECT_EQ(637, *sum); // 43 + 44 + ... + 54 + 55
+   ROOT::DisableImplicitMT();
+}
+
+#endif // R__USE_IMT
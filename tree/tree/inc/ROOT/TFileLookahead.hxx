@@ -0,0 +1,70 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFileLookahead
+#define ROOT_TFileLookahead
+
+#include "Rtypes.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+
+namespace ROOT {
+namespace Experimental {
+class TTaskGroup;
+}
+
+namespace Internal {
+
+/// Opens the files of a chain ahead of their use, in IMT tasks, while the current file is processed.
+///
+/// Opening a file reads its header, keys and streamer info and the tree metadata; then the baskets
+/// of the first cluster of the requested branches are read (or, when the file supports it,
+/// asynchronously requested), so that the first TTreeCache fill of the file finds them in the page
+/// cache or in the client cache of a remote file. A prefetched file is handed over, already open,
+/// by Take().
+///
+/// Files are only prefetched when implicit multi-threading is enabled. All the methods are thread-safe.
+class TFileLookahead {
+public:
+   TFileLookahead();
+   ~TFileLookahead();
+
+   TFileLookahead(const TFileLookahead &) = delete;
+   TFileLookahead &operator=(const TFileLookahead &) = delete;
+
+   void Prefetch(Int_t index, const std::string &fileName, const std::string &treeName,
+                 const std::vector<std::string> &branchNames, Long64_t maxWarmBytes);
+   void Retain(Int_t first, Int_t last);
+   Bool_t Take(Int_t index, TFile *&file);
+
+   static void WarmFirstCluster(TFile *file, TTree *tree, const std::vector<std::string> &branchNames,
+                                Long64_t maxBytes);
+
+private:
+   struct TEntry;
+
+   std::mutex fMutex;                                      // Protects fEntries.
+   std::map<Int_t, std::shared_ptr<TEntry>> fEntries;      // Files prefetched or being prefetched, by index in the chain.
+   std::unique_ptr<ROOT::Experimental::TTaskGroup> fGroup; // Tasks opening the files.
+
+   static void Abandon(TEntry &entry);
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -70,6 +70,8 @@ protected:
    Int_t       fLastWriteBufferSize[3] = {0,0,0}; ///<! Size of the buffer last three buffers we wrote it to disk
    Bool_t      fResetAllocation{false};           ///<! True if last reset re-allocated the memory
    UChar_t     fNextBufferSizeRecord{0};          ///<! Index into fLastWriteBufferSize of the last buffer written to disk
+   Int_t       fCompressedNout{-1};               ///<! Size of the payload prepared by CompressBuffer(), -1 if not prepared
+   ULong64_t   fCompressTime{0};                  ///<! Time spent in the last CompressBuffer(), in nanoseconds
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
@@ -111,8 +113,11 @@ public:
    virtual void    AdjustSize(Int_t newsize);
    virtual void    DeleteEntryOffset();
    virtual Int_t   DropBuffers();
+           Int_t   CompressBuffer();
+           void    DetachCompressedBuffer();
    TBranch        *GetBranch() const {return fBranch;}
            Int_t   GetBufferSize() const {return fBufferSize;}
+           ULong64_t GetCompressTime() const {return fCompressTime;}
            Int_t  *GetDisplacement() const {return fDisplacement;}
            Int_t *GetEntryOffset()
            {
@@ -139,6 +144,7 @@ public:
    Long64_t        CopyTo(TFile *to);
 
            void    SetBranch(TBranch *branch) { fBranch = branch; }
+           void    SetCycle(Short_t cycle) { fCycle = cycle; }
            void    SetNevBufSize(Int_t n) { fNevBufSize=n; }
    virtual void    SetReadMode();
    virtual void    SetWriteMode();
@@ -24,6 +24,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <memory>
+#include <vector>
 
 #include "Compression.h"
 
@@ -114,11 +115,14 @@ protected:
    char       *fAddress;          ///<! Address of 1st leaf (variable or object)
    TDirectory *fDirectory;        ///<! Pointer to directory where this branch buffers are stored
    TString     fFileName;         ///<  Name of file where buffers are stored ("" if in same file as Tree header)
+   std::vector<char> fCompressionDictionary; ///<  Dictionary used to compress the baskets (ZSTD only), empty if none
+   UInt_t      fCompressionDictionaryID; ///<! ID under which fCompressionDictionary is registered, 0 if none
    TBuffer    *fEntryBuffer;      ///<! Buffer used to directly pass the content without streaming
    TBuffer    *fTransientBuffer;  ///<! Pointer to the current transient buffer.
    TList      *fBrowsables;       ///<! List of TVirtualBranchBrowsables used for Browse()
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
+   Long64_t    fCompressTime{0};  ///<! Time spent compressing the baskets written in this session (in nanoseconds)
 
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
@@ -144,7 +148,11 @@ protected:
 
 private:
    Int_t FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
+   Int_t    GetBasketAndFirst(Long64_t entry, TBasket *&basket, Long64_t &first);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   void     UpdateEntryOffsetLen(Int_t nevbuf);
+   Bool_t   QueueBasket(TBasket *basket);
+   void     WriteQueuedBasket(TBasket *basket, Int_t where);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -163,6 +171,7 @@ public:
            void      ExpandBasketArrays();
            Int_t     Fill() { return FillImpl(nullptr); }
    virtual Int_t     FillImpl(ROOT::Internal::TBranchIMTHelper *);
+           Int_t     FillBulk(const void *values, Int_t nentries);
    virtual TBranch  *FindBranch(const char *name);
    virtual TLeaf    *FindLeaf(const char *name);
            Int_t     FlushBaskets();
@@ -179,7 +188,13 @@ public:
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+   const std::vector<char> &GetCompressionDictionary() const { return fCompressionDictionary; }
+           UInt_t    GetCompressionDictionaryID() const { return fCompressionDictionaryID; }
+           Long64_t  GetCompressTime() const { return fCompressTime; }
    TDirectory       *GetDirectory() const {return fDirectory;}
+           Int_t     GetBulkEntries(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> *offsets = nullptr);
+           Int_t     GetBulkFillEntriesToWrite() const;
+           Int_t     GetBulkFillEntrySize() const;
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
            Int_t     GetEntryOffsetLen() const { return fEntryOffsetLen; }
@@ -232,6 +247,7 @@ public:
    void              SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
    void              SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
    void              SetCompressionSettings(Int_t settings = ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
+   Bool_t            SetCompressionDictionary(const char *dict, Int_t size);
    virtual void      SetEntries(Long64_t entries);
    virtual void      SetEntryOffsetLen(Int_t len, Bool_t updateSubBranches = kFALSE);
    virtual void      SetFirstEntry( Long64_t entry );
@@ -243,12 +259,13 @@ public:
    virtual void      SetStatus(Bool_t status=1);
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
+           Int_t     TrainCompressionDictionary(Int_t maxsize = 112640);
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
@@ -31,6 +31,12 @@ class TEntryList;
 class TEventList;
 class TCollection;
 
+namespace ROOT {
+namespace Internal {
+class TFileLookahead;
+}
+}
+
 class TChain : public TTree {
 
 protected:
@@ -44,6 +50,8 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Int_t        fFilePrefetch;     ///<! Number of files opened ahead of the current one
+   ROOT::Internal::TFileLookahead *fFileLookahead; ///<! Files being opened ahead of the current one
 
 private:
    TChain(const TChain&);            // not implemented
@@ -52,6 +60,7 @@ private:
 
 protected:
    void InvalidateCurrentTree();
+   void PrefetchFiles();
    void ReleaseChainProof();
 
 public:
@@ -93,6 +102,7 @@ public:
    virtual Long64_t  GetCacheSize() const { return fTree ? fTree->GetCacheSize() : fCacheSize; }
    virtual Long64_t  GetChainEntryNumber(Long64_t entry) const;
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
+           Int_t     GetFilePrefetch() const { return fFilePrefetch; }
            Int_t     GetNtrees() const { return fNtrees; }
    virtual Long64_t  GetEntries() const;
    virtual Long64_t  GetEntries(const char *sel) { return TTree::GetEntries(sel); }
@@ -159,6 +169,7 @@ public:
    virtual void      SetEntryList(TEntryList *elist, Option_t *opt="");
    virtual void      SetEntryListFile(const char *filename="", Option_t *opt="");
    virtual void      SetEventList(TEventList *evlist);
+           void      SetFilePrefetch(Int_t nfiles = 1);
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
@@ -71,6 +71,10 @@ public:
    virtual Bool_t   CanGenerateOffsetArray() {return fLeafCount;} // overload and return true if this leaf can generate its own offset array.
    virtual void     Export(TClonesArray *, Int_t) {}
    virtual void     FillBasket(TBuffer &b);
+   /// Serialize, in one pass, n consecutive values stored in host byte order at the given address, at the current
+   /// position of the buffer, which must have room for them. Only leaves of basic types support this; return kFALSE
+   /// otherwise, leaving the buffer untouched.
+   virtual Bool_t   FillBasketFast(TBuffer &, const void *, Int_t) { return kFALSE; }
    virtual Int_t   *GenerateOffsetArray(Int_t base, Int_t events) { return GenerateOffsetArrayBase(base, events); }
    TBranch         *GetBranch() const { return fBranch; }
    ///  If this leaf stores a variable-sized array or a multi-dimensional array whose last dimension has variable size,
@@ -104,6 +108,10 @@ public:
    virtual Bool_t   IsUnsigned() const { return fIsUnsigned; }
    virtual void     PrintValue(Int_t i = 0) const;
    virtual void     ReadBasket(TBuffer &) {}
+   /// Convert, in place and in one pass, n consecutive values starting at the current position of the
+   /// buffer from the on-file to the in-memory representation.
+   /// Only leaves of basic types support this; return kFALSE otherwise.
+   virtual Bool_t   ReadBasketFast(TBuffer &, Long64_t) { return kFALSE; }
    virtual void     ReadBasketExport(TBuffer &, TClonesArray *, Int_t) {}
    virtual void     ReadValue(std::istream & /*s*/, Char_t /*delim*/ = ' ') {
       Error("ReadValue", "Not implemented!");
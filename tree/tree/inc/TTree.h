@@ -67,6 +67,11 @@ class TTreeCache;
 class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
+namespace ROOT {
+namespace Internal {
+class TBasketCompressionQueue;
+}
+}
 
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -147,11 +152,14 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   Int_t          fCompressionQueueSize{0};       ///<! Maximum number of baskets compressed in the background during Fill, 0 if disabled
+   ROOT::Internal::TBasketCompressionQueue *fCompressionQueue{nullptr}; ///<! Queue of the baskets compressed in the background during Fill
 
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
    void             MarkEventCluster();
+   void             AutoFlushAndSave();
 
 protected:
    virtual void     KeepCircular();
@@ -192,6 +200,8 @@ protected:
    friend class TChainIndex;
    // So that the TTreeCloner can access the protected interfaces
    friend class TTreeCloner;
+   // So that the branches can queue their full baskets for compression
+   friend class TBranch;
 
    // use to update fFriendLockStatus
    enum ELockStatusBits {
@@ -374,6 +384,7 @@ public:
    virtual void            DropBaskets();
    virtual void            DropBuffers(Int_t nbytes);
    virtual Int_t           Fill();
+           Int_t           FillBulk(Long64_t nentries);
    virtual TBranch        *FindBranch(const char* name);
    virtual TLeaf          *FindLeaf(const char* name);
    virtual Int_t           Fit(const char* funcname, const char* varexp, const char* selection = "", Option_t* option = "", Option_t* goption = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
@@ -393,6 +404,10 @@ public:
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
    virtual Long64_t        GetChainEntryNumber(Long64_t entry) const { return entry; }
    virtual Long64_t        GetChainOffset() const { return fChainOffset; }
+           Int_t           GetCompressionQueueSize() const { return fCompressionQueueSize; }
+           Int_t           GetCompressionQueueDepth() const;
+           Int_t           GetCompressionQueueMaxDepth() const;
+           Long64_t        GetCompressionQueueStalls() const;
    virtual Bool_t          GetClusterPrefetch() const { return fCacheDoClusterPrefetch; }
    TFile                  *GetCurrentFile() const;
            Int_t           GetDefaultEntryOffsetLen() const {return fDefaultEntryOffsetLen;}
@@ -545,6 +560,7 @@ public:
    virtual void            SetChainOffset(Long64_t offset = 0) { fChainOffset=offset; }
    virtual void            SetCircular(Long64_t maxEntries);
    virtual void            SetClusterPrefetch(Bool_t enabled) { fCacheDoClusterPrefetch = enabled; }
+           void            SetCompressionQueueSize(Int_t nbaskets);
    virtual void            SetDebug(Int_t level = 1, Long64_t min = 0, Long64_t max = 9999999); // *MENU*
    virtual void            SetDefaultEntryOffsetLen(Int_t newdefault, Bool_t updateExisting = kFALSE);
    virtual void            SetDirectory(TDirectory* dir);
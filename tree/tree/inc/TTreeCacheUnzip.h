@@ -96,6 +96,10 @@ protected:
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   std::vector<Long64_t> fSeekEntry;         ///<! [fNseek] First entry of the basket of each block, gives the unzipping order
+   std::atomic<Long64_t> fUnzipPoolSize;     ///<! Size of the unzipped blocks not yet consumed
+   std::atomic<Bool_t>   fUnzipPoolFull;     ///<! Set by the tasks that stopped unzipping because the pool was full
+   std::atomic<Int_t>    fNActiveTasks;      ///<! Number of unzipping tasks currently running
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
@@ -103,7 +107,9 @@ protected:
    Int_t       fNFound;           ///<! number of blocks that were found in the cache
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t>    fNUnzip;     ///<! number of blocks that were unzipped
+   std::atomic<Long64_t> fUnzipTime;  ///<! time spent by the tasks unzipping blocks, in ns
+   Long64_t    fStallTime;        ///<! time spent by the reading thread waiting for blocks being unzipped, in ns
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -114,6 +120,7 @@ private:
 
    // Private methods
    void  Init();
+   void  ConsumedUnzipped(Int_t len);
 
 public:
    TTreeCacheUnzip();
@@ -149,9 +156,13 @@ public:
    Int_t          UnzipCache(Int_t index);
 
    // Methods to get stats
-   Int_t  GetNUnzip() { return fNUnzip; }
-   Int_t  GetNMissed(){ return fNMissed; }
-   Int_t  GetNFound() { return fNFound; }
+   Int_t    GetNUnzip() { return fNUnzip; }
+   Int_t    GetNMissed(){ return fNMissed; }
+   Int_t    GetNFound() { return fNFound; }
+   Int_t    GetNStalls() { return fNStalls; }
+   Long64_t GetUnzipPoolSize() { return fUnzipPoolSize; }
+   Double_t GetUnzipTime() { return fUnzipTime * 1e-9; }
+   Double_t GetStallTime() { return fStallTime * 1e-9; }
 
    void Print(Option_t* option = "") const;
 
@@ -28,6 +28,7 @@
 #include "RZip.h"
 
 #include <bitset>
+#include <memory>
 
 const UInt_t kDisplacementMask = 0xFF000000;  // In the streamer the two highest bytes of
                                               // the fEntryOffset are used to stored displacement.
@@ -466,6 +467,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   const char *mappedBuffer = nullptr;
+   std::unique_ptr<TBufferFile> mappedBufferRef; // Wraps the compressed data of a memory mapped file.
 
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
@@ -500,14 +503,32 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    // and we will re-add the new size later on.
    fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
 
-   // Initialize the buffer to hold the compressed data.
-   readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file);
-   if (!readBufferRef) {
-      Error("ReadBasketBuffers", "Unable to allocate buffer.");
-      return 1;
+   // If the file is memory mapped, the compressed data is used in place,
+   // avoiding the copy to the compressed buffer. The cache is still told
+   // about the read, so that it keeps advising the upcoming clusters.
+   if (fBranch->GetCompressionLevel() != 0 && file->IsMapped()) {
+      R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+      mappedBuffer = file->GetMappedBuffer(pos, len);
+      if (mappedBuffer && pf)
+         pf->ReadBuffer(nullptr, pos, len);
    }
 
-   if (pf) {
+   if (mappedBuffer) {
+      mappedBufferRef.reset(new TBufferFile(TBuffer::kRead, len, const_cast<char *>(mappedBuffer), kFALSE));
+      mappedBufferRef->SetParent(file);
+      readBufferRef = mappedBufferRef.get();
+   } else {
+      // Initialize the buffer to hold the compressed data.
+      readBufferRef = R__InitializeReadBasketBuffer(readBufferRef, len, file);
+      if (!readBufferRef) {
+         Error("ReadBasketBuffers", "Unable to allocate buffer.");
+         return 1;
+      }
+   }
+
+   if (mappedBuffer) {
+      // Nothing to read, the data is already in place.
+   } else if (pf) {
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       Int_t st = 0;
@@ -711,6 +732,7 @@ void TBasket::Reset()
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    fResetAllocationTime = 0;
 #endif
+   fCompressedNout = -1;
 
    // Name, Title, fClassName, fBranch
    // stay the same.
@@ -1023,53 +1045,21 @@ void TBasket::Update(Int_t offset, Int_t skipped)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Write buffer of this basket on the current file.
+/// Prepare the basket for writing: transfer the fEntryOffset table at the end
+/// of the buffer and compress it.
 ///
-/// The function returns the number of bytes committed to the memory.
-/// If a write error occurs, the number of bytes returned is -1.
-/// If no data are written, the number of bytes returned is 0.
+/// This does not touch the file, hence the baskets of different branches, or
+/// baskets using their own compression buffer (see DetachCompressedBuffer()),
+/// can be compressed concurrently. WriteBuffer() then only writes the result.
+/// The function returns the size of the payload to be written (the size of the
+/// uncompressed object if compression did not help), -1 in case of error.
 
-Int_t TBasket::WriteBuffer()
+Int_t TBasket::CompressBuffer()
 {
-   const Int_t kWrite = 1;
-
-   TFile *file = fBranch->GetFile(kWrite);
-   if (!file) return 0;
-   if (!file->IsWritable()) {
-      return -1;
-   }
-   fMotherDir = file; // fBranch->GetDirectory();
+   if (fCompressedNout >= 0) return fCompressedNout;
 
-   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
-   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
-   //
-   // The only parallelism we'd like to exploit (right now!) is the compression
-   // step - everything else should be serialized at the TFile level.
-#ifdef R__USE_IMT
-   std::unique_lock<std::mutex> sentry(file->fWriteMutex);
-#endif  // R__USE_IMT
-
-   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
-      // Read the basket information that was saved inside the buffer.
-      Bool_t writing = fBufferRef->IsWriting();
-      fBufferRef->SetReadMode();
-      fBufferRef->SetBufferOffset(0);
-
-      Streamer(*fBufferRef);
-      if (writing) fBufferRef->SetWriteMode();
-      Int_t nout = fNbytes - fKeylen;
-
-      fBuffer = fBufferRef->Buffer();
-
-      Create(nout,file);
-      fBufferRef->SetBufferOffset(0);
-      fHeaderOnly = kTRUE;
-
-      Streamer(*fBufferRef);         //write key itself again
-      int nBytes = WriteFileKeepBuffer();
-      fHeaderOnly = kFALSE;
-      return nBytes>0 ? fKeylen+nout : -1;
-   }
+   auto start = std::chrono::steady_clock::now();
+   TFile *file = fBranch->GetFile(1);
 
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
@@ -1109,10 +1099,13 @@ Int_t TBasket::WriteBuffer()
    lbuf       = fBufferRef->Length();
    fObjlen    = lbuf - fKeylen;
 
-   fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fBranch->GetCompressionAlgorithm());
+   // Test if the buffer has really been compressed. In case of small buffers
+   // when the buffer contains random data, it may happen that the compressed
+   // buffer is larger than the input. In this case, we write the original uncompressed buffer.
+   nout = fObjlen;
+   fBuffer = fBufferRef->Buffer();
    if (cxlevel > 0) {
       Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
       Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
@@ -1122,67 +1115,133 @@ Int_t TBasket::WriteBuffer()
          return -1;
       }
       fCompressedBufferRef->SetWriteMode();
-      fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
+      char *bufcur = &fCompressedBufferRef->Buffer()[fKeylen];
       noutot = 0;
       nzip   = 0;
+      Bool_t compressed = kTRUE;
       for (Int_t i = 0; i < nbuffers; ++i) {
          if (i == nbuffers - 1) bufmax = fObjlen - nzip;
          else bufmax = kMAXZIPBUF;
-         // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
-         // for a given TFile: that's because the compression buffer when we use IMT is no longer
-         // shared amongst several threads.
-#ifdef R__USE_IMT
-         sentry.unlock();
-#endif  // R__USE_IMT
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-#ifdef R__USE_IMT
-         sentry.lock();
-#endif  // R__USE_IMT
-
-         // test if buffer has really been compressed. In case of small buffers
-         // when the buffer contains random data, it may happen that the compressed
-         // buffer is larger than the input. In this case, we write the original uncompressed buffer
+         R__zipMultipleAlgorithmDict(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm,
+                                     fBranch->GetCompressionDictionaryID());
          if (nout == 0 || nout >= fObjlen) {
             nout = fObjlen;
-            // We used to delete fBuffer here, we no longer want to since
-            // the buffer (held by fCompressedBufferRef) might be re-used later.
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
-            if ((nout+fKeylen)>buflen) {
-               Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
-                  (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
-            }
-            goto WriteFile;
+            compressed = kFALSE;
+            break;
          }
          bufcur += nout;
          noutot += nout;
          objbuf += kMAXZIPBUF;
          nzip   += kMAXZIPBUF;
       }
-      nout = noutot;
-      Create(noutot,file);
+      if (compressed) {
+         nout = noutot;
+         fBuffer = fCompressedBufferRef->Buffer();
+         if ((nout+fKeylen)>buflen) {
+            Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
+               (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
+         }
+      }
+   }
+
+   fCompressTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+   fCompressedNout = nout;
+   return nout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make this basket compress into a buffer of its own rather than in the
+/// compression buffer shared with the other baskets of its branch, such that
+/// it can be compressed while the branch keeps filling another basket.
+
+void TBasket::DetachCompressedBuffer()
+{
+   if (fOwnsCompressedBuffer) return;
+   fCompressedBufferRef = nullptr;
+   InitializeCompressedBuffer(fBufferRef->BufferSize(), fBranch->GetFile(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write buffer of this basket on the current file.
+///
+/// The buffer is compressed first (see CompressBuffer()) unless this was
+/// already done.
+///
+/// The function returns the number of bytes committed to the memory.
+/// If a write error occurs, the number of bytes returned is -1.
+/// If no data are written, the number of bytes returned is 0.
+
+Int_t TBasket::WriteBuffer()
+{
+   const Int_t kWrite = 1;
+
+   TFile *file = fBranch->GetFile(kWrite);
+   if (!file) return 0;
+   if (!file->IsWritable()) {
+      return -1;
+   }
+   fMotherDir = file; // fBranch->GetDirectory();
+
+   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
+#ifdef R__USE_IMT
+      std::unique_lock<std::mutex> sentry(file->fWriteMutex);
+#endif  // R__USE_IMT
+      // Read the basket information that was saved inside the buffer.
+      Bool_t writing = fBufferRef->IsWriting();
+      fBufferRef->SetReadMode();
       fBufferRef->SetBufferOffset(0);
 
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-   } else {
+      Streamer(*fBufferRef);
+      if (writing) fBufferRef->SetWriteMode();
+      Int_t nout = fNbytes - fKeylen;
+
       fBuffer = fBufferRef->Buffer();
-      Create(fObjlen,file);
+      fCompressTime = 0;
+
+      Create(nout,file);
       fBufferRef->SetBufferOffset(0);
+      fHeaderOnly = kTRUE;
 
       Streamer(*fBufferRef);         //write key itself again
-      nout = fObjlen;
+      int nBytes = WriteFileKeepBuffer();
+      fHeaderOnly = kFALSE;
+      return nBytes>0 ? fKeylen+nout : -1;
+   }
+
+   // Baskets compressed ahead by the compression queue of the tree got their cycle when they
+   // were queued: the branch has moved on to another write basket since.
+   const Bool_t compressedAhead = fCompressedNout >= 0;
+
+   // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
+   // for a given TFile: that's because the compression buffer when we use IMT is no longer
+   // shared amongst several threads.
+   Int_t nout = CompressBuffer();
+   fCompressedNout = -1;
+   if (nout < 0) return -1;
+
+   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
+   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
+   //
+   // The only parallelism we'd like to exploit (right now!) is the compression
+   // step - everything else should be serialized at the TFile level.
+#ifdef R__USE_IMT
+   std::unique_lock<std::mutex> sentry(file->fWriteMutex);
+#endif  // R__USE_IMT
+
+   fHeaderOnly = kTRUE;
+   if (!compressedAhead) fCycle = fBranch->GetWriteBasket();
+   Create(nout,file);
+   fBufferRef->SetBufferOffset(0);
+
+   Streamer(*fBufferRef);         //write key itself again
+   if (fBuffer != fBufferRef->Buffer()) {
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
    }
 
-WriteFile:
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
    return nBytes>0 ? fKeylen+nout : -1;
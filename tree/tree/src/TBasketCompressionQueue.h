@@ -0,0 +1,127 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketCompressionQueue
+#define ROOT_TBasketCompressionQueue
+
+#include "Rtypes.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// A bounded queue of full baskets being compressed in the background while TTree::Fill goes on.
+///
+/// Each basket is compressed by an IMT task. Writing it to the file and updating its branch
+/// is left to the thread filling the tree, which runs the completion of the compressed baskets
+/// in ProcessCompleted(), as TFile and TBranch are not thread-safe. When the queue is full,
+/// Push() waits for the tasks in flight (helping to run them), providing back-pressure.
+class TBasketCompressionQueue {
+
+public:
+   using Completion_t = std::function<void()>;
+
+   explicit TBasketCompressionQueue(Int_t maxPending) : fMaxPending(maxPending) {}
+
+   /// Wait for the tasks in flight; the completions not run yet are dropped, Drain() first to run them.
+   ~TBasketCompressionQueue() { WaitTasks(); }
+
+   /// Run compress in a task, and complete in ProcessCompleted() once compress is done.
+   void Push(const std::function<void()> &compress, const Completion_t &complete)
+   {
+      if (fNPending >= fMaxPending) {
+         ++fNStalls;
+         Drain();
+      }
+      ++fNPending;
+      ++fNPushed;
+      if (fNPending > fMaxNPending)
+         fMaxNPending = fNPending;
+#ifdef R__USE_IMT
+      fGroup.Run([this, compress, complete]() {
+         compress();
+         std::lock_guard<std::mutex> lock(fMutex);
+         fCompleted.push_back(complete);
+      });
+#else
+      compress();
+      fCompleted.push_back(complete);
+#endif
+   }
+
+   /// Run the completions of the baskets compressed so far.
+   void ProcessCompleted()
+   {
+      if (fNPending == 0)
+         return;
+      std::vector<Completion_t> completed;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         completed.swap(fCompleted);
+      }
+      for (auto &complete : completed) {
+         --fNPending;
+         complete();
+      }
+   }
+
+   /// Wait for all the baskets in flight and run their completions.
+   void Drain()
+   {
+      WaitTasks();
+      ProcessCompleted();
+   }
+
+   /// Wait for all the baskets in flight and drop their completions, e.g. when the baskets are reset.
+   void Discard()
+   {
+      WaitTasks();
+      std::lock_guard<std::mutex> lock(fMutex);
+      fCompleted.clear();
+      fNPending = 0;
+   }
+
+   Int_t GetMaxPending() const { return fMaxPending; }
+   Int_t GetNPending() const { return fNPending; }
+   Int_t GetMaxNPending() const { return fMaxNPending; }
+   Long64_t GetNPushed() const { return fNPushed; }
+   Long64_t GetNStalls() const { return fNStalls; }
+
+private:
+   void WaitTasks()
+   {
+#ifdef R__USE_IMT
+      fGroup.Wait();
+#endif
+   }
+
+   const Int_t fMaxPending;              // Maximum number of baskets compressed or waiting for completion.
+   Int_t fNPending{0};                   // Number of baskets pushed and not completed yet.
+   Int_t fMaxNPending{0};                // Largest value of fNPending so far.
+   Long64_t fNPushed{0};                 // Number of baskets pushed so far.
+   Long64_t fNStalls{0};                 // Number of times Push() had to wait for the baskets in flight.
+   std::mutex fMutex;                    // Protects fCompleted.
+   std::vector<Completion_t> fCompleted; // Completions of the compressed baskets.
+#ifdef R__USE_IMT
+   ROOT::Experimental::TTaskGroup fGroup;
+#endif
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -44,9 +44,12 @@
 #include "TVirtualPerfStats.h"
 
 #include "TBranchIMTHelper.h"
+#include "TBasketCompressionQueue.h"
+#include "RZip.h"
 
 #include "ROOT/TIOFeatures.hxx"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <string.h>
@@ -112,6 +115,7 @@ TBranch::TBranch()
 , fAddress(0)
 , fDirectory(0)
 , fFileName("")
+, fCompressionDictionaryID(0)
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
@@ -216,6 +220,7 @@ TBranch::TBranch(TTree *tree, const char *name, void *address, const char *leafl
 , fAddress((char *)address)
 , fDirectory(fTree->GetDirectory())
 , fFileName("")
+, fCompressionDictionaryID(0)
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
@@ -268,6 +273,7 @@ TBranch::TBranch(TBranch *parent, const char *name, void *address, const char *l
 , fAddress((char *)address)
 , fDirectory(fTree ? fTree->GetDirectory() : 0)
 , fFileName("")
+, fCompressionDictionaryID(0)
 , fEntryBuffer(0)
 , fTransientBuffer(0)
 , fBrowsables(0)
@@ -428,6 +434,9 @@ TBranch::~TBranch()
    delete fBrowsables;
    fBrowsables = 0;
 
+   R__zipUnregisterDictionary(fCompressionDictionaryID);
+   fCompressionDictionaryID = 0;
+
    // Note: We do *not* have ownership of the buffer.
    fEntryBuffer = 0;
 
@@ -885,6 +894,8 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    if (noFlushAtCluster && !fTree->TestBit(TTree::kCircular) &&
        ((fSkipZip && (lnew >= TBuffer::kMinimalSize)) || (buf->TestBit(TBufferFile::kNotDecompressed)) ||
         ((lnew + (2 * nsize) + nbytes) >= fBasketSize))) {
+      if (!imtHelper && QueueBasket(basket))
+         return nbytes;
       Int_t nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
       if (nout < 0) Error("TBranch::Fill", "Failed to write out basket.\n");
       return (nout >= 0) ? nbytes : -1;
@@ -892,6 +903,132 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append in one go nentries entries to the branch, their values being stored
+/// contiguously, in host byte order, at `values`.
+///
+/// This is the writing counterpart of GetBulkEntries, for branches made of a
+/// single leaf of a basic type of fixed size (for example `x/F` or `v[3]/D`),
+/// see GetBulkFillEntrySize: the values of as many entries as fit in the write
+/// basket are serialized in a single pass, rather than going through TLeaf::FillBasket
+/// for each entry. Baskets are written out (or handed over to the compression
+/// queue of the tree) when full, as by Fill, so that the layout on file is the
+/// same as if the entries had been filled one by one.
+///
+/// Only the branch is filled: TTree::FillBulk fills all the branches of a tree
+/// and takes care of the clusters.
+/// Returns the number of bytes filled, or -1 if the branch does not support
+/// bulk filling or if an I/O error occurred.
+
+Int_t TBranch::FillBulk(const void *values, Int_t nentries)
+{
+   const Int_t entrySize = GetBulkFillEntrySize();
+   if (R__unlikely(entrySize <= 0 || nentries < 0)) {
+      return -1;
+   }
+   TLeaf *leaf = static_cast<TLeaf *>(fLeaves.UncheckedAt(0));
+   const Int_t nvalues = leaf->GetLen();
+   const char *cursor = static_cast<const char *>(values);
+
+   // See FillImpl
+   const bool noFlushAtCluster = !fTree->TestBit(TTree::kOnlyFlushAtCluster) || (fTree->GetAutoFlush() < 0);
+
+   Int_t nbytes = 0;
+   while (nentries > 0) {
+      TBasket *basket = (TBasket *)fBaskets.UncheckedAt(fWriteBasket);
+      if (!basket) {
+         basket = fTree->CreateBasket(this);
+         if (!basket) {
+            return -1;
+         }
+         ++fNBaskets;
+         fBaskets.AddAtAndExpand(basket, fWriteBasket);
+      }
+      TBuffer *buf = basket->GetBufferRef();
+      if (buf->IsReading()) {
+         basket->SetWriteMode();
+      }
+
+      // Stop where Fill would write the basket out.
+      const Int_t lold = buf->Length();
+      Int_t n = std::min(nentries, GetBulkFillEntriesToWrite());
+      // The length of a buffer is an Int_t: so is the number of values serialized at once.
+      n = std::min(n, (kMaxInt - lold) / entrySize);
+      if (n <= 0) {
+         Error("FillBulk", "The basket of branch %s cannot hold more entries.", GetName());
+         return -1;
+      }
+      if (!leaf->FillBasketFast(*buf, cursor, n * nvalues)) {
+         return -1;
+      }
+      for (Int_t i = 0; i < n; ++i) {
+         basket->Update(lold + i * entrySize);
+      }
+      if (!basket->GetNevBufSize()) {
+         basket->SetNevBufSize(entrySize);
+      }
+      fEntries += n;
+      fEntryNumber += n;
+      nbytes += n * entrySize;
+      cursor += Long64_t(n) * entrySize;
+      nentries -= n;
+
+      const Int_t lnew = buf->Length();
+      if (noFlushAtCluster && !fTree->TestBit(TTree::kCircular) && lnew + entrySize >= fBasketSize) {
+         if (QueueBasket(basket)) {
+            continue;
+         }
+         if (WriteBasketImpl(basket, fWriteBasket, nullptr) < 0) {
+            Error("FillBulk", "Failed to write out basket.");
+            return -1;
+         }
+      }
+   }
+   return nbytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of entries that FillBulk fills before writing out the
+/// current basket, i.e. the entries after which Fill would write it out (kMaxInt
+/// if the baskets are only written out at cluster boundaries). Before the first
+/// entry of a basket, return 1.
+
+Int_t TBranch::GetBulkFillEntriesToWrite() const
+{
+   const Int_t entrySize = GetBulkFillEntrySize();
+   if (!entrySize)
+      return 0;
+   // See FillImpl
+   if (fTree->TestBit(TTree::kOnlyFlushAtCluster) && fTree->GetAutoFlush() >= 0)
+      return kMaxInt;
+   TBasket *basket = (TBasket *)fBaskets.UncheckedAt(fWriteBasket);
+   if (!basket)
+      return 1;
+   // Fill would write the basket out after the first entry that brings it within one entry of fBasketSize.
+   const Int_t lold = basket->GetBufferRef()->Length();
+   return std::max(1, (fBasketSize - lold + entrySize - 1) / entrySize - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size in bytes of the values of an entry if the branch can be
+/// filled with FillBulk, 0 otherwise.
+///
+/// Bulk filling is supported by branches with no sub-branches made of a single
+/// leaf of a basic type of fixed size, which is not the counter of another leaf.
+
+Int_t TBranch::GetBulkFillEntrySize() const
+{
+   if (IsA() != TBranch::Class() || fNleaves != 1 || fBranches.GetEntriesFast() || fEntryBuffer || fEntryOffsetLen ||
+       fSkipZip || TestBit(kDoNotProcess)) {
+      return 0;
+   }
+   TLeaf *leaf = static_cast<TLeaf *>(fLeaves.UncheckedAt(0));
+   if (leaf->GetLeafCount() || leaf->IsRange() || leaf->GetLenType() <= 0) {
+      return 0;
+   }
+   return leaf->GetLenType() * leaf->GetLen();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy the data from fEntryBuffer into the current basket.
 
@@ -1100,6 +1237,11 @@ Int_t TBranch::FlushBaskets()
    UInt_t nerror = 0;
    Int_t nbytes = 0;
 
+   // The baskets being compressed in the background must be written by their completion.
+   auto queue = fTree ? fTree->fCompressionQueue : nullptr;
+   if (queue && queue->GetNPending())
+      queue->Drain();
+
    Int_t maxbasket = fWriteBasket + 1;
    // The following protection is not necessary since we should always
    // have fWriteBasket < fBasket.GetSize()
@@ -1296,6 +1438,60 @@ const char* TBranch::GetIconName() const
       return "TBranchElement-leaf";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Locate, and load in memory if needed, the basket holding `entry`.
+///
+/// On success `basket` points to the basket, `first` is the number of its
+/// first entry, fCurrentBasket/fFirstBasketEntry/fNextBasketEntry are updated
+/// and 1 is returned. Returns 0 if `entry` is not in this branch and -1 in
+/// case of I/O error.
+
+Int_t TBranch::GetBasketAndFirst(Long64_t entry, TBasket *&basket, Long64_t &first)
+{
+   if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
+      return 0;
+   }
+   first = fFirstBasketEntry;
+   Long64_t last = fNextBasketEntry - 1;
+   // Are we still in the same ReadBasket?
+   if ((entry < first) || (entry > last)) {
+      fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
+      if (fReadBasket < 0) {
+         fNextBasketEntry = -1;
+         Error("In the branch %s, no basket contains the entry %d\n", GetName(), entry);
+         return -1;
+      }
+      if (fReadBasket == fWriteBasket) {
+         fNextBasketEntry = fEntryNumber;
+      } else {
+         fNextBasketEntry = fBasketEntry[fReadBasket+1];
+      }
+      first = fFirstBasketEntry = fBasketEntry[fReadBasket];
+   }
+   // We have found the basket containing this entry.
+   // make sure basket buffers are in memory.
+   basket = (TBasket*) fBaskets.UncheckedAt(fReadBasket);
+   if (!basket) {
+      basket = GetBasket(fReadBasket);
+      if (!basket) {
+         fCurrentBasket = 0;
+         fFirstBasketEntry = -1;
+         fNextBasketEntry = -1;
+         return -1;
+      }
+      if (fTree->GetClusterPrefetch()) {
+         TTree::TClusterIterator clusterIterator = fTree->GetClusterIterator(entry);
+         clusterIterator.Next();
+         Int_t nextClusterEntry = clusterIterator.GetNextEntry();
+         for (Int_t i = fReadBasket + 1; i < fMaxBaskets && fBasketEntry[i] < nextClusterEntry; i++) {
+            GetBasket(i);
+         }
+      }
+   }
+   fCurrentBasket = basket;
+   return 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -1332,47 +1528,10 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
       if (!enabled) {
          return 0;
       }
-      if ((entry < fFirstEntry) || (entry >= fEntryNumber)) {
-         return 0;
+      Int_t result = GetBasketAndFirst(entry, basket, first);
+      if (R__unlikely(result <= 0)) {
+         return result;
       }
-      first = fFirstBasketEntry;
-      Long64_t last = fNextBasketEntry - 1;
-      // Are we still in the same ReadBasket?
-      if ((entry < first) || (entry > last)) {
-         fReadBasket = TMath::BinarySearch(fWriteBasket + 1, fBasketEntry, entry);
-         if (fReadBasket < 0) {
-            fNextBasketEntry = -1;
-            Error("In the branch %s, no basket contains the entry %d\n", GetName(), entry);
-            return -1;
-         }
-         if (fReadBasket == fWriteBasket) {
-            fNextBasketEntry = fEntryNumber;
-         } else {
-            fNextBasketEntry = fBasketEntry[fReadBasket+1];
-         }
-         first = fFirstBasketEntry = fBasketEntry[fReadBasket];
-      }
-      // We have found the basket containing this entry.
-      // make sure basket buffers are in memory.
-      basket = (TBasket*) fBaskets.UncheckedAt(fReadBasket);
-      if (!basket) {
-         basket = GetBasket(fReadBasket);
-         if (!basket) {
-            fCurrentBasket = 0;
-            fFirstBasketEntry = -1;
-            fNextBasketEntry = -1;
-            return -1;
-         }
-         if (fTree->GetClusterPrefetch()) {
-            TTree::TClusterIterator clusterIterator = fTree->GetClusterIterator(entry);
-            clusterIterator.Next();
-            Int_t nextClusterEntry = clusterIterator.GetNextEntry();
-            for (Int_t i = fReadBasket + 1; i < fMaxBaskets && fBasketEntry[i] < nextClusterEntry; i++) {
-               GetBasket(i);
-            }
-         }
-      }
-      fCurrentBasket = basket;
    }
    basket->PrepareBasket(entry);
    TBuffer* buf = basket->GetBufferRef();
@@ -1410,6 +1569,126 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    return buf->Length() - bufbegin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read in one go all the entries from `entry` to the end of the basket
+/// containing it and store them, in host byte order, in `user_buf`.
+///
+/// This is a fast path for branches made of a single leaf of a basic type,
+/// either of fixed size (for example `x/F` or `v[3]/D`) or a variable size
+/// array (for example `px[n]/F`): the content of the basket is copied as a
+/// whole into `user_buf` and byte-swapped in a single pass over the memory,
+/// without going through the per-entry TLeaf::ReadBasket calls.
+/// On return the values start at `user_buf.GetCurrent()`, i.e. at offset 0 of
+/// `user_buf.Buffer()`, and the buffer is expanded as needed:
+///
+///~~~ {.cpp}
+///     TBufferFile buf(TBuffer::kWrite, 10000);
+///     TBranch *br = tree->GetBranch("px");
+///     for (Long64_t entry = 0; entry < br->GetEntries();) {
+///        auto count = br->GetBulkEntries(entry, buf);
+///        if (count <= 0) break;
+///        auto px = reinterpret_cast<Float_t *>(buf.GetCurrent());
+///        for (Int_t i = 0; i < count; ++i) { /* use px[i] */ }
+///        entry += count;
+///     }
+///~~~
+///
+/// If `offsets` is not null, it is filled with `count + 1` byte offsets such
+/// that the values of entry `entry + i` are stored between
+/// `user_buf.Buffer() + (*offsets)[i]` and `user_buf.Buffer() + (*offsets)[i + 1]`.
+/// `offsets` is mandatory for variable size arrays.
+///
+/// Returns the number of entries stored in `user_buf`, 0 if `entry` does not
+/// exist and -1 if the branch does not support bulk reading (several leaves,
+/// objects, ...) or if an I/O error occurred.
+/// The state of the branch for TBranch::GetEntry is not affected, except that
+/// the basket holding `entry` becomes the current one.
+
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> *offsets)
+{
+   if (R__unlikely(fNleaves != 1)) {
+      return -1;
+   }
+   TLeaf *leaf = static_cast<TLeaf *>(fLeaves.UncheckedAt(0));
+   if (R__unlikely(leaf->GetLeafCount() && !offsets)) {
+      return -1;
+   }
+   if (R__unlikely(TestBit(kDoNotProcess))) {
+      return -1;
+   }
+
+   TBasket *basket = nullptr;
+   Long64_t first = 0;
+   if (R__likely(fFirstBasketEntry <= entry && entry < fNextBasketEntry)) {
+      basket = fCurrentBasket;
+      first = fFirstBasketEntry;
+   } else {
+      Int_t result = GetBasketAndFirst(entry, basket, first);
+      if (R__unlikely(result <= 0)) {
+         return result;
+      }
+   }
+   basket->PrepareBasket(entry);
+   TBuffer *buf = basket->GetBufferRef();
+   // Baskets with displacements (or of very old files) cannot be read in bulk.
+   if (R__unlikely(!buf || basket->GetDisplacement())) {
+      return -1;
+   }
+   if (R__unlikely(!buf->IsReading())) {
+      basket->SetReadMode();
+   }
+
+   const Long64_t last = (fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry;
+   const Int_t nentries = last - entry;
+   if (R__unlikely(nentries <= 0)) {
+      return -1;
+   }
+   Int_t bufbegin = 0;
+   Int_t nbytes = 0;
+   if (leaf->GetLeafCount()) {
+      // The values of consecutive entries are contiguous in the basket, the
+      // table of entry offsets starts right after them (at fLast).
+      Int_t *entryOffset = basket->GetEntryOffset();
+      if (R__unlikely(!entryOffset || basket->GetNevBuf() != last - first)) {
+         return -1;
+      }
+      bufbegin = entryOffset[entry - first];
+      nbytes = basket->GetLast() - bufbegin;
+      offsets->resize(nentries + 1);
+      for (Int_t i = 0; i < nentries; ++i) {
+         (*offsets)[i] = entryOffset[entry - first + i] - bufbegin;
+      }
+      (*offsets)[nentries] = nbytes;
+   } else {
+      if (R__unlikely(basket->GetEntryOffset())) {
+         return -1;
+      }
+      const Int_t entrySize = basket->GetNevBufSize();
+      bufbegin = basket->GetKeylen() + (entry - first) * entrySize;
+      nbytes = nentries * entrySize;
+      if (offsets) {
+         offsets->resize(nentries + 1);
+         for (Int_t i = 0; i <= nentries; ++i) {
+            (*offsets)[i] = i * entrySize;
+         }
+      }
+   }
+   const Int_t lenType = leaf->GetLenType();
+   if (R__unlikely(nbytes < 0 || bufbegin + nbytes > basket->GetLast() || lenType <= 0 || nbytes % lenType)) {
+      return -1;
+   }
+
+   if (user_buf.BufferSize() < nbytes) {
+      user_buf.Expand(nbytes, kFALSE);
+   }
+   memcpy(user_buf.Buffer(), buf->Buffer() + bufbegin, nbytes);
+   user_buf.SetBufferOffset(0);
+   if (R__unlikely(!leaf->ReadBasketFast(user_buf, nbytes / lenType))) {
+      return -1;
+   }
+   return nentries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of an entry and export buffers to real objects in a TClonesArray list.
 ///
@@ -2396,6 +2675,44 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the dictionary used to compress the baskets of this branch.
+///
+/// The dictionary must be in the ZSTD format, e.g. as produced by
+/// TrainCompressionDictionary() or by `zstd --train`; it is only used if the
+/// branch's compression algorithm is ROOT::RCompressionSetting::EAlgorithm::kZSTD.
+/// The dictionary is stored together with the branch, so that readers can
+/// decompress the baskets. Passing a null dictionary removes it.
+///
+/// The dictionary cannot be changed anymore once baskets have been written
+/// with it. Since the baskets only record the ID of their dictionary, a
+/// dictionary with the same ID as a different one already in use in the
+/// process is refused. Returns kFALSE if the dictionary could not be set.
+
+Bool_t TBranch::SetCompressionDictionary(const char *dict, Int_t size)
+{
+   if (!fCompressionDictionary.empty() && fWriteBasket > 0) {
+      Error("SetCompressionDictionary", "Baskets of branch %s have already been written with a dictionary", GetName());
+      return kFALSE;
+   }
+   UInt_t dictid = 0;
+   if (dict && size > 0) {
+      dictid = R__zipRegisterDictionary(dict, size);
+      if (!dictid) {
+         Error("SetCompressionDictionary",
+               "Invalid compression dictionary for branch %s, or its ID is used by a different dictionary", GetName());
+         return kFALSE;
+      }
+   }
+   R__zipUnregisterDictionary(fCompressionDictionaryID);
+   fCompressionDictionaryID = dictid;
+   if (dictid)
+      fCompressionDictionary.assign(dict, dict + size);
+   else
+      fCompressionDictionary.clear();
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
@@ -2554,6 +2871,18 @@ void TBranch::Streamer(TBuffer& b)
       if (v > 9) {
          b.ReadClassBuffer(TBranch::Class(), this, v, R__s, R__c);
 
+         R__zipUnregisterDictionary(fCompressionDictionaryID);
+         fCompressionDictionaryID = 0;
+         if (!fCompressionDictionary.empty()) {
+            fCompressionDictionaryID =
+               R__zipRegisterDictionary(fCompressionDictionary.data(), fCompressionDictionary.size());
+            if (!fCompressionDictionaryID)
+               Warning("Streamer",
+                       "Branch %s uses a compression dictionary which is not supported by this build of ROOT "
+                       "or whose ID is already used by a different dictionary",
+                       GetName());
+         }
+
          if (fWriteBasket>=fBaskets.GetSize()) {
             fBaskets.Expand(fWriteBasket+1);
          }
@@ -2781,14 +3110,7 @@ void TBranch::Streamer(TBuffer& b)
 
 Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
 {
-   Int_t nevbuf = basket->GetNevBuf();
-   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
-      // Make sure that the fEntryOffset array does not stay large unnecessarily.
-      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
-   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
-      // Increase the array ...
-      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
-   }
+   UpdateEntryOffsetLen(basket->GetNevBuf());
 
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
@@ -2799,6 +3121,7 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
       fBasketBytes[where]  = basket->GetNbytes();
       fBasketSeek[where]   = basket->GetSeekKey();
       Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+      fCompressTime += basket->GetCompressTime();
       TBasket *reusebasket = 0;
       if (nout>0) {
          // The Basket was written so we can now safely reuse it.
@@ -2852,6 +3175,97 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the size of the entry offset table to the number of entries of the
+/// basket being written.
+
+void TBranch::UpdateEntryOffsetLen(Int_t nevbuf)
+{
+   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
+      // Make sure that the fEntryOffset array does not stay large unnecessarily.
+      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
+   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
+      // Increase the array ...
+      fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the full write basket over to the compression queue of the tree (see
+/// TTree::SetCompressionQueueSize) and move on to a new write basket.
+///
+/// The basket stays in fBaskets until it is written by WriteQueuedBasket.
+/// Return kFALSE, leaving the basket untouched, if it has to be written right away.
+
+Bool_t TBranch::QueueBasket(TBasket *basket)
+{
+   auto queue = fTree->fCompressionQueue;
+   if (!queue || !fDirectory || fTree->TestBit(TTree::kCircular) || basket->IsA() != TBasket::Class() ||
+       basket->GetBufferRef()->TestBit(TBufferFile::kNotDecompressed) || GetCompressionLevel() <= 0) {
+      return kFALSE;
+   }
+
+   UpdateEntryOffsetLen(basket->GetNevBuf());
+   // The write basket shares its compression buffer with the other baskets of the branch.
+   basket->DetachCompressedBuffer();
+
+   Int_t where = fWriteBasket;
+   // As WriteBuffer() would do for the write basket
+   basket->SetCycle(where);
+   ++fWriteBasket;
+   if (fWriteBasket >= fMaxBaskets) {
+      ExpandBasketArrays();
+   }
+   fBaskets.AddAtAndExpand(nullptr, fWriteBasket);
+   fBasketEntry[fWriteBasket] = fEntryNumber;
+
+   queue->Push([basket]() { basket->CompressBuffer(); },
+               [this, basket, where]() { WriteQueuedBasket(basket, where); });
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a basket compressed by the compression queue of the tree and recycle
+/// it as the write basket if the branch has none yet.
+
+void TBranch::WriteQueuedBasket(TBasket *basket, Int_t where)
+{
+   Int_t nout = basket->WriteBuffer();
+   if (nout < 0) Error("TBranch::WriteQueuedBasket", "basket's WriteBuffer failed.\n");
+   fBasketBytes[where] = basket->GetNbytes();
+   fBasketSeek[where]  = basket->GetSeekKey();
+   fCompressTime += basket->GetCompressTime();
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+   if (nout <= 0) {
+      // The basket could not be written, keep it in memory.
+      return;
+   }
+
+   Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+   fZipBytes += nout;
+   fTotBytes += addbytes;
+   fTree->AddTotBytes(addbytes);
+   fTree->AddZipBytes(nout);
+
+   fBaskets[where] = 0;
+   if (!fBaskets.UncheckedAt(fWriteBasket)) {
+      basket->Reset();
+#ifdef R__TRACK_BASKET_ALLOC_TIME
+      fTree->AddAllocationTime(basket->GetResetAllocationTime());
+#endif
+      fTree->AddAllocationCount(basket->GetResetAllocationCount());
+      fBaskets.AddAt(basket, fWriteBasket);
+   } else {
+      --fNBaskets;
+      basket->DropBuffers();
+      delete basket;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
@@ -2875,6 +3289,55 @@ void TBranch::SetupAddresses()
    // Nothing to do for regular branch, the TLeaf already did it.
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Train a compression dictionary of at most maxsize bytes on the entries
+/// filled so far in the current basket, and use it for this branch (see
+/// SetCompressionDictionary()).
+///
+/// Dictionaries pay off for branches with small baskets, whose entries are
+/// too small to be compressed efficiently on their own. This must be called
+/// before the first basket of the branch is written, typically after filling
+/// a few thousand entries with a large enough basket size. Sub-branches are
+/// not trained. Returns the size of the dictionary, 0 in case of failure.
+
+Int_t TBranch::TrainCompressionDictionary(Int_t maxsize)
+{
+   if (fWriteBasket > 0) {
+      Error("TrainCompressionDictionary", "Baskets of branch %s have already been written", GetName());
+      return 0;
+   }
+   TBasket *basket = (TBasket*)fBaskets.UncheckedAt(fWriteBasket);
+   if (!basket || basket->GetNevBuf() == 0) {
+      Error("TrainCompressionDictionary", "No entries filled in branch %s", GetName());
+      return 0;
+   }
+
+   // Each entry is one sample.
+   const Int_t nevbuf = basket->GetNevBuf();
+   const Int_t keylen = basket->GetKeylen();
+   const Int_t last = basket->GetBufferRef()->Length();
+   Int_t *entryOffset = basket->GetEntryOffset();
+   std::vector<size_t> sizes(nevbuf);
+   for (Int_t i = 0; i < nevbuf; ++i) {
+      if (entryOffset) {
+         sizes[i] = (i + 1 < nevbuf ? entryOffset[i + 1] : last) - entryOffset[i];
+      } else {
+         sizes[i] = (last - keylen) / nevbuf;
+      }
+   }
+   const char *samples = basket->GetBufferRef()->Buffer() + (entryOffset ? entryOffset[0] : keylen);
+
+   std::vector<char> dict(maxsize);
+   Int_t size = R__zipTrainDictionary(dict.data(), maxsize, samples, sizes.data(), nevbuf);
+   if (!size) {
+      Error("TrainCompressionDictionary", "Unable to train a compression dictionary for branch %s", GetName());
+      return 0;
+   }
+   if (!SetCompressionDictionary(dict.data(), size))
+      return 0;
+   return size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Refresh the value of fDirectory (i.e. where this branch writes/reads its buffers)
 /// with the current value of fTree->GetCurrentFile unless this branch has been
@@ -32,6 +32,7 @@ the trees in the chain.
 #include "TClass.h"
 #include "TColor.h"
 #include "TCut.h"
+#include "TEnv.h"
 #include "TError.h"
 #include "TMath.h"
 #include "TFile.h"
@@ -55,6 +56,7 @@ the trees in the chain.
 #include "TFileStager.h"
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
+#include "ROOT/TFileLookahead.hxx"
 
 ClassImp(TChain);
 
@@ -73,6 +75,8 @@ TChain::TChain()
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fFilePrefetch(gEnv->GetValue("TChain.FilePrefetch", 0))
+, fFileLookahead(0)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -147,6 +151,8 @@ TChain::TChain(const char* name, const char* title)
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fFilePrefetch(gEnv->GetValue("TChain.FilePrefetch", 0))
+, fFileLookahead(0)
 {
    //
    //*-*
@@ -184,6 +190,8 @@ TChain::~TChain()
    }
 
    SafeDelete(fProofChain);
+   delete fFileLookahead;
+   fFileLookahead = 0;
    fStatus->Delete();
    delete fStatus;
    fStatus = 0;
@@ -1477,7 +1485,10 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      // The file may have been opened ahead, see SetFilePrefetch.
+      if (!fFileLookahead || !fFileLookahead->Take(treenum, fFile)) {
+         fFile = TFile::Open(element->GetTitle());
+      }
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
@@ -1530,6 +1541,9 @@ Long64_t TChain::LoadTree(Long64_t entry)
       }
    }
 
+   // Start opening the next files while this one is processed.
+   PrefetchFiles();
+
    // Check if fTreeOffset has really been set.
    Long64_t nentries = 0;
    if (fTree) {
@@ -2161,6 +2175,40 @@ void TChain::ParseTreeFilename(const char *name, TString &filename, TString &tre
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Start opening, in the background, the fFilePrefetch files following the
+/// current one, warming their first cluster for the branches of the TTreeCache
+/// of the chain, see SetFilePrefetch.
+
+void TChain::PrefetchFiles()
+{
+   if (fFilePrefetch <= 0 || fTreeNumber < 0 || !ROOT::IsImplicitMTEnabled()) {
+      return;
+   }
+   if (!fFileLookahead) {
+      fFileLookahead = new ROOT::Internal::TFileLookahead();
+   }
+
+   // Warm the branches the cache reads, at most as many bytes as it holds.
+   std::vector<std::string> branchNames;
+   Long64_t maxBytes = 0;
+   TTreeCache *tc = (fTree && fFile) ? fTree->GetReadCache(fFile) : 0;
+   if (tc && tc->GetCachedBranches()) {
+      maxBytes = tc->GetBufferSize();
+      TIter next(tc->GetCachedBranches());
+      while (TBranch *branch = (TBranch*) next()) {
+         branchNames.push_back(branch->GetName());
+      }
+   }
+
+   const Int_t last = TMath::Min(fTreeNumber + fFilePrefetch, fNtrees - 1);
+   fFileLookahead->Retain(fTreeNumber + 1, last);
+   for (Int_t i = fTreeNumber + 1; i <= last; ++i) {
+      TChainElement *element = (TChainElement*) fFiles->At(i);
+      fFileLookahead->Prefetch(i, element->GetTitle(), element->GetName(), branchNames, maxBytes);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the header information of each tree in the chain.
 /// See TTree::Print for a list of options.
@@ -2272,6 +2320,8 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   delete fFileLookahead;
+   fFileLookahead = 0;
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2294,6 +2344,8 @@ void TChain::Reset(Option_t*)
 
 void TChain::ResetAfterMerge(TFileMergeInfo *info)
 {
+   delete fFileLookahead;
+   fFileLookahead = 0;
    fNtrees         = 0;
    fTreeNumber     = -1;
    fTree           = 0;
@@ -2827,6 +2879,29 @@ void TChain::SetEventList(TEventList *evlist)
    SetEntryList(enlist);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of files opened ahead of the current one.
+///
+/// When LoadTree moves to a new file, the nfiles following files of the chain
+/// start being opened in the background: their header, streamer info and tree
+/// metadata are read, and so are the baskets of their first cluster for the
+/// branches in the TTreeCache of the chain, so that moving to the next file
+/// does not stall on opening it and filling the cache. Files are opened in
+/// ROOT::EnableImplicitMT tasks, hence nothing is prefetched when implicit
+/// multi-threading is not enabled.
+///
+/// A value of 0 disables the lookahead. The default is set by the rootrc
+/// setting TChain.FilePrefetch (0).
+
+void TChain::SetFilePrefetch(Int_t nfiles)
+{
+   fFilePrefetch = nfiles;
+   if (fFilePrefetch <= 0) {
+      delete fFileLookahead;
+      fFileLookahead = 0;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the name of this TChain.
 
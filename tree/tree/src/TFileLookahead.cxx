@@ -0,0 +1,251 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TFileLookahead.hxx"
+
+#include "ROOT/TTaskGroup.hxx"
+#include "TBranch.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <utility>
+
+namespace ROOT {
+namespace Internal {
+
+/// A file prefetched, or being prefetched, by a task.
+struct TFileLookahead::TEntry {
+   enum class EState { kQueued, kRunning, kDone };
+
+   std::mutex fMutex;
+   std::condition_variable fDone;
+   EState fState{EState::kQueued};
+   Bool_t fAbandoned{kFALSE}; // Whether the file is not wanted anymore; it is then deleted by whoever sees it last.
+   TFile *fFile{nullptr};     // The opened file, owned until taken.
+};
+
+TFileLookahead::TFileLookahead() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the tasks in flight and delete the files not taken.
+
+TFileLookahead::~TFileLookahead()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (auto &entry : fEntries)
+         Abandon(*entry.second);
+      fEntries.clear();
+   }
+   fGroup.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark the file as not wanted anymore, deleting it if it is already open.
+
+void TFileLookahead::Abandon(TEntry &entry)
+{
+   std::lock_guard<std::mutex> lock(entry.fMutex);
+   entry.fAbandoned = kTRUE;
+   if (entry.fState == TEntry::EState::kDone) {
+      delete entry.fFile;
+      entry.fFile = nullptr;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start opening, in a task, the file fileName holding the tree treeName, known as
+/// index by the caller, and warming at most maxWarmBytes (0 for no limit) of the
+/// first cluster of the branches branchNames, see WarmFirstCluster(). Does nothing
+/// if index is already prefetched or if implicit multi-threading is not enabled.
+
+void TFileLookahead::Prefetch(Int_t index, const std::string &fileName, const std::string &treeName,
+                              const std::vector<std::string> &branchNames, Long64_t maxWarmBytes)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled())
+      return;
+
+   auto entry = std::make_shared<TEntry>();
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fEntries.count(index))
+         return;
+      if (!fGroup)
+         fGroup.reset(new ROOT::Experimental::TTaskGroup());
+      fEntries[index] = entry;
+   }
+
+   fGroup->Run([entry, fileName, treeName, branchNames, maxWarmBytes]() {
+      {
+         std::lock_guard<std::mutex> lock(entry->fMutex);
+         if (entry->fAbandoned) {
+            entry->fState = TEntry::EState::kDone;
+            return;
+         }
+         entry->fState = TEntry::EState::kRunning;
+      }
+
+      TFile *file = nullptr;
+      {
+         TDirectory::TContext ctxt;
+         file = TFile::Open(fileName.c_str());
+      }
+      if (file && !file->IsZombie()) {
+         TTree *tree = nullptr; // owned by the file
+         file->GetObject(treeName.c_str(), tree);
+         if (tree)
+            WarmFirstCluster(file, tree, branchNames, maxWarmBytes);
+      }
+
+      std::lock_guard<std::mutex> lock(entry->fMutex);
+      if (entry->fAbandoned)
+         delete file;
+      else
+         entry->fFile = file;
+      entry->fState = TEntry::EState::kDone;
+      entry->fDone.notify_all();
+   });
+#else
+   (void)index;
+   (void)fileName;
+   (void)treeName;
+   (void)branchNames;
+   (void)maxWarmBytes;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop the files prefetched with an index outside [first, last].
+
+void TFileLookahead::Retain(Int_t first, Int_t last)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (auto it = fEntries.begin(); it != fEntries.end();) {
+      if (it->first < first || it->first > last) {
+         Abandon(*it->second);
+         it = fEntries.erase(it);
+      } else {
+         ++it;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand over the file prefetched as index, waiting for its task if it is running.
+///
+/// Returns kFALSE if the file was not prefetched, or its task did not start yet: the
+/// caller then opens the file itself rather than waiting for a free worker. Otherwise
+/// file is set to the result of TFile::Open (possibly null or a zombie), owned by the caller.
+
+Bool_t TFileLookahead::Take(Int_t index, TFile *&file)
+{
+   std::shared_ptr<TEntry> entry;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto it = fEntries.find(index);
+      if (it == fEntries.end())
+         return kFALSE;
+      entry = std::move(it->second);
+      fEntries.erase(it);
+   }
+
+   std::unique_lock<std::mutex> lock(entry->fMutex);
+   if (entry->fState == TEntry::EState::kQueued) {
+      entry->fAbandoned = kTRUE;
+      return kFALSE;
+   }
+   entry->fDone.wait(lock, [&entry] { return entry->fState == TEntry::EState::kDone; });
+   file = entry->fFile;
+   entry->fFile = nullptr;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the baskets of the first cluster of the branches branchNames of tree, "*"
+/// standing for all its branches, stopping after maxBytes (0 for no limit).
+///
+/// If the file supports asynchronous reads, they are only requested; otherwise they
+/// are read, a chunk at a time, and dropped, leaving them in the page cache.
+
+void TFileLookahead::WarmFirstCluster(TFile *file, TTree *tree, const std::vector<std::string> &branchNames,
+                                      Long64_t maxBytes)
+{
+   std::vector<TBranch *> branches;
+   for (const auto &name : branchNames) {
+      if (name == "*") {
+         TIter next(tree->GetListOfLeaves());
+         while (auto leaf = static_cast<TLeaf *>(next()))
+            branches.push_back(leaf->GetBranch());
+      } else if (auto branch = tree->GetBranch(name.c_str())) {
+         branches.push_back(branch);
+      }
+   }
+   if (branches.empty())
+      return;
+   std::sort(branches.begin(), branches.end());
+   branches.erase(std::unique(branches.begin(), branches.end()), branches.end());
+
+   auto clusters = tree->GetClusterIterator(0);
+   clusters.Next();
+   const Long64_t end = clusters.GetNextEntry();
+
+   std::vector<std::pair<Long64_t, Int_t>> blocks;
+   for (auto branch : branches) {
+      const Int_t *bytes = branch->GetBasketBytes();
+      const Long64_t *entries = branch->GetBasketEntry();
+      for (Int_t i = 0; i < branch->GetWriteBasket() && entries[i] < end; ++i) {
+         const Long64_t pos = branch->GetBasketSeek(i);
+         if (pos > 0 && bytes[i] > 0)
+            blocks.emplace_back(pos, bytes[i]);
+      }
+   }
+   std::sort(blocks.begin(), blocks.end());
+
+   const Bool_t async = !file->ReadBufferAsync(0, 0);
+   const Long64_t kChunkSize = 8 * 1024 * 1024;
+   std::vector<char> scratch;
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   Long64_t total = 0;
+   Long64_t chunk = 0;
+   auto flush = [&]() {
+      if (pos.empty())
+         return;
+      if (async) {
+         file->ReadBuffers(nullptr, pos.data(), len.data(), pos.size());
+      } else {
+         scratch.resize(chunk);
+         file->ReadBuffers(scratch.data(), pos.data(), len.data(), pos.size());
+      }
+      pos.clear();
+      len.clear();
+      chunk = 0;
+   };
+   for (const auto &block : blocks) {
+      if (maxBytes > 0 && total + block.second > maxBytes)
+         break;
+      if (chunk > 0 && chunk + block.second > kChunkSize)
+         flush();
+      pos.push_back(block.first);
+      len.push_back(block.second);
+      chunk += block.second;
+      total += block.second;
+   }
+   flush();
+}
+
+} // Internal
+} // ROOT
@@ -95,6 +95,18 @@ void TLeafB::FillBasket(TBuffer& b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize n values of this leaf stored at values. See TLeaf::FillBasketFast.
+
+Bool_t TLeafB::FillBasketFast(TBuffer &b, const void *values, Int_t n)
+{
+   if (IsRange()) {
+      return kFALSE;
+   }
+   b.WriteFastArray(static_cast<const Char_t *>(values), n);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns name of leaf type.
 
@@ -172,6 +184,14 @@ void TLeafB::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place n values of this leaf. See TLeaf::ReadBasketFast.
+
+Bool_t TLeafB::ReadBasketFast(TBuffer &b, Long64_t n)
+{
+   return b.ByteSwapBuffer(n, kChar_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
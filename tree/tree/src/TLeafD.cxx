@@ -78,6 +78,15 @@ void TLeafD::FillBasket(TBuffer &b)
    b.WriteFastArray(fValue,len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize n values of this leaf stored at values. See TLeaf::FillBasketFast.
+
+Bool_t TLeafD::FillBasketFast(TBuffer &b, const void *values, Int_t n)
+{
+   b.WriteFastArray(static_cast<const Double_t *>(values), n);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Import element from ClonesArray into local leaf buffer.
 
@@ -129,6 +138,14 @@ void TLeafD::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place n values of this leaf. See TLeaf::ReadBasketFast.
+
+Bool_t TLeafD::ReadBasketFast(TBuffer &b, Long64_t n)
+{
+   return b.ByteSwapBuffer(n, kDouble_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
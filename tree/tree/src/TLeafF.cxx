@@ -82,6 +82,15 @@ void TLeafF::FillBasket(TBuffer &b)
    b.WriteFastArray(fValue,len);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize n values of this leaf stored at values. See TLeaf::FillBasketFast.
+
+Bool_t TLeafF::FillBasketFast(TBuffer &b, const void *values, Int_t n)
+{
+   b.WriteFastArray(static_cast<const Float_t *>(values), n);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Import element from ClonesArray into local leaf buffer.
 
@@ -133,6 +142,14 @@ void TLeafF::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place n values of this leaf. See TLeaf::ReadBasketFast.
+
+Bool_t TLeafF::ReadBasketFast(TBuffer &b, Long64_t n)
+{
+   return b.ByteSwapBuffer(n, kFloat_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -90,6 +90,18 @@ void TLeafI::FillBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize n values of this leaf stored at values. See TLeaf::FillBasketFast.
+
+Bool_t TLeafI::FillBasketFast(TBuffer &b, const void *values, Int_t n)
+{
+   if (IsRange()) {
+      return kFALSE;
+   }
+   b.WriteFastArray(static_cast<const Int_t *>(values), n);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns name of leaf type.
 
@@ -182,6 +194,14 @@ void TLeafI::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place n values of this leaf. See TLeaf::ReadBasketFast.
+
+Bool_t TLeafI::ReadBasketFast(TBuffer &b, Long64_t n)
+{
+   return b.ByteSwapBuffer(n, kInt_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
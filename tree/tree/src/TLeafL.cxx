@@ -90,6 +90,18 @@ void TLeafL::FillBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Serialize n values of this leaf stored at values. See TLeaf::FillBasketFast.
+
+Bool_t TLeafL::FillBasketFast(TBuffer &b, const void *values, Int_t n)
+{
+   if (IsRange()) {
+      return kFALSE;
+   }
+   b.WriteFastArray(static_cast<const Long64_t *>(values), n);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns name of leaf type.
 
@@ -193,6 +205,14 @@ void TLeafL::ReadBasket(TBuffer &b)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize in place n values of this leaf. See TLeaf::ReadBasketFast.
+
+Bool_t TLeafL::ReadBasketFast(TBuffer &b, Long64_t n)
+{
+   return b.ByteSwapBuffer(n, kLong64_t);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read leaf elements from Basket input buffer and export buffer to
 /// TClonesArray objects.
@@ -395,6 +395,7 @@ End_Macro
 #include "TVirtualMutex.h"
 
 #include "TBranchIMTHelper.h"
+#include "TBasketCompressionQueue.h"
 #include "TNotifyLink.h"
 
 #include <chrono>
@@ -406,6 +407,8 @@ End_Macro
 #include <stdio.h>
 #include <limits.h>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -891,6 +894,17 @@ TTree::~TTree()
       Info("TTree::~TTree", "For tree %s, allocation time is %lluus.", GetName(), fAllocationTime.load());
 #endif
    }
+   // Write the baskets still being compressed, as Fill would have written them without the queue,
+   // as long as the file is still open for writing; Write() and AutoSave() already drained the queue.
+   if (fCompressionQueue) {
+      TFile *file = fDirectory ? fDirectory->GetFile() : nullptr;
+      if (file && file->IsOpen() && file->IsWritable())
+         fCompressionQueue->Drain();
+      else
+         fCompressionQueue->Discard();
+      delete fCompressionQueue;
+      fCompressionQueue = nullptr;
+   }
 
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
@@ -4285,6 +4299,24 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// You can use the option "goff" to turn off the graphics output
 /// of TTree::Draw in the above example.
 ///
+/// ### Multi-threaded processing
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the
+/// 1-D and 2-D histograms and profiles of TTree::Draw and TTree::Project
+/// are filled in parallel, in tasks made of whole clusters, as soon as their
+/// limits are known: from the start if the binning is given or the histogram
+/// exists, otherwise after the first GetEstimate() selected rows, which are
+/// used to compute the limits. The histograms filled by the tasks are merged
+/// at the end. This applies to trees and chains read from files which are not
+/// open for writing, when the expressions are scalar and numerical and no
+/// TEventList or TEntryList is used; other cases are processed sequentially.
+/// The processing also stays sequential when all the rows must be kept in the
+/// arrays returned by GetV1() etc., i.e. when GetEstimate() is larger than the
+/// number of rows or when option "goff" is used without a target histogram,
+/// when an expression uses Entry$, LocalEntry$ or Entries$, and when the tree
+/// has friends. Otherwise these arrays only hold the rows processed
+/// sequentially, while GetSelectedRows() counts all of them.
+///
 /// ### Automatic interface to TTree::Draw via the TTreeViewer
 ///
 /// A complete graphical interface to this function is implemented
@@ -4307,6 +4339,8 @@ Long64_t TTree::Draw(const char* varexp, const char* selection, Option_t* option
 
 void TTree::DropBaskets()
 {
+   if (fCompressionQueue)
+      fCompressionQueue->Drain();
    TBranch* branch = 0;
    Int_t nb = fBranches.GetEntriesFast();
    for (Int_t i = 0; i < nb; ++i) {
@@ -4402,7 +4436,16 @@ Int_t TTree::Fill()
       fBranchRef->Clear();
 
 #ifdef R__USE_IMT
-   const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
+   if (fCompressionQueueSize > 0 && !fCompressionQueue && ROOT::IsImplicitMTEnabled() && fIMTEnabled)
+      fCompressionQueue = new ROOT::Internal::TBasketCompressionQueue(fCompressionQueueSize);
+#endif
+   // Write the baskets compressed in the background since the previous entry.
+   if (fCompressionQueue)
+      fCompressionQueue->ProcessCompleted();
+
+#ifdef R__USE_IMT
+   // With the compression queue, full baskets are compressed in the background instead of during Fill.
+   const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled && !fCompressionQueue;
    ROOT::Internal::TBranchIMTHelper imtHelper;
    if (useIMT) {
       fIMTFlush = true;
@@ -4467,6 +4510,18 @@ Int_t TTree::Fill()
       Info("TTree::Fill", " - A: %d %lld %lld %lld %lld %lld %lld \n", nbytes, fEntries, fAutoFlush, fAutoSave,
            GetZipBytes(), fFlushedBytes, fSavedBytes);
 
+   AutoFlushAndSave();
+
+   return nerror == 0 ? nbytes : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the baskets and save the tree if it is time to, after entries were
+/// filled, and move on to a new file if the current one exceeds the maximum
+/// size. See Fill.
+
+void TTree::AutoFlushAndSave()
+{
    bool autoFlush = false;
    bool autoSave = false;
 
@@ -4566,6 +4621,108 @@ Int_t TTree::Fill()
       if (TFile *file = fDirectory->GetFile())
          if ((TDirectory *)file == fDirectory && (file->GetEND() > fgMaxTreeSize))
             ChangeFile(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill in one go nentries entries, the address of each branch (see
+/// SetBranchAddress) pointing to an array with the values of the nentries
+/// entries, stored contiguously.
+///
+/// All the branches must support bulk filling, see TBranch::GetBulkFillEntrySize:
+/// they must be made of a single leaf of a basic type of fixed size (for example
+/// `x/F` or `v[3]/D`). The values of each branch are then serialized a basket at
+/// a time by TBranch::FillBulk, rather than an entry at a time by Fill, which
+/// removes most of the per-entry cost of filling trees of simple columns:
+///
+///~~~ {.cpp}
+///     std::vector<Float_t> px(1000);
+///     std::vector<Int_t> n(1000);
+///     auto tree = new TTree("t", "t");
+///     tree->Branch("px", px.data());
+///     tree->Branch("n", n.data());
+///     // ... set the values of 1000 entries in px and n
+///     tree->FillBulk(1000);
+///~~~
+///
+/// The baskets are flushed and the tree is saved at the same entries as with Fill,
+/// whether fAutoFlush and fAutoSave are numbers of entries or of bytes (see
+/// SetAutoFlush): the entries are serialized in chunks ending where Fill could
+/// take a decision, i.e. at the next multiple of a number of entries or, until
+/// the first flush when a threshold is a number of bytes, at the next entry
+/// after which a basket is written out.
+///
+/// Returns the number of bytes filled, or -1 if a write error occurred, if the tree
+/// is circular or if some branch does not support bulk filling (nothing is filled
+/// then).
+
+Int_t TTree::FillBulk(Long64_t nentries)
+{
+   if (nentries <= 0)
+      return 0;
+   if (TestBit(kCircular) || fBranchRef) {
+      Error("FillBulk", "Circular trees and trees with references cannot be filled in bulk.");
+      return -1;
+   }
+
+   const Int_t nbranches = fBranches.GetEntriesFast();
+   std::vector<Int_t> entrySizes(nbranches, 0);
+   for (Int_t i = 0; i < nbranches; ++i) {
+      TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
+      if (branch->TestBit(kDoNotProcess))
+         continue;
+      entrySizes[i] = branch->GetBulkFillEntrySize();
+      if (!entrySizes[i] || !branch->GetAddress()) {
+         Error("FillBulk", "Branch %s cannot be filled in bulk.", branch->GetName());
+         return -1;
+      }
+   }
+
+#ifdef R__USE_IMT
+   if (fCompressionQueueSize > 0 && !fCompressionQueue && ROOT::IsImplicitMTEnabled() && fIMTEnabled)
+      fCompressionQueue = new ROOT::Internal::TBasketCompressionQueue(fCompressionQueueSize);
+#endif
+
+   Int_t nbytes = 0;
+   Int_t nerror = 0;
+   for (Long64_t done = 0; done < nentries;) {
+      // Write the baskets compressed in the background since the previous chunk.
+      if (fCompressionQueue)
+         fCompressionQueue->ProcessCompleted();
+
+      // Stop at the next entry after which Fill would flush the baskets or save the tree.
+      Long64_t n = std::min<Long64_t>(nentries - done, kMaxInt);
+      if (fAutoFlush > 0) {
+         const Long64_t first = (fFlushedBytes != 0 && fNClusterRange) ? fClusterRangeEnd[fNClusterRange - 1] + 1 : 0;
+         n = std::min(n, fAutoFlush - (fEntries - first) % fAutoFlush);
+      }
+      if (fAutoSave > 0)
+         n = std::min(n, fAutoSave - fEntries % fAutoSave);
+      if (fFlushedBytes == 0 && (fAutoFlush < 0 || fAutoSave < 0)) {
+         // The thresholds in bytes are compared to the compressed size, which only changes when a basket is written.
+         for (Int_t i = 0; i < nbranches; ++i) {
+            if (entrySizes[i])
+               n = std::min<Long64_t>(n, ((TBranch *)fBranches.UncheckedAt(i))->GetBulkFillEntriesToWrite());
+         }
+      }
+
+      for (Int_t i = 0; i < nbranches; ++i) {
+         if (!entrySizes[i])
+            continue;
+         TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
+         const auto nwrite = branch->FillBulk(branch->GetAddress() + done * entrySizes[i], n);
+         if (nwrite < 0) {
+            Error("FillBulk", "Failed filling branch:%s.%s, nentries=%lld, entry=%lld", GetName(), branch->GetName(),
+                  n, fEntries + 1);
+            ++nerror;
+         } else {
+            nbytes += nwrite;
+         }
+      }
+      fEntries += n;
+      done += n;
+
+      AutoFlushAndSave();
+   }
 
    return nerror == 0 ? nbytes : -1;
 }
@@ -4924,6 +5081,9 @@ Int_t TTree::FlushBaskets(Bool_t create_cluster) const
 Int_t TTree::FlushBasketsImpl() const
 {
    if (!fDirectory) return 0;
+   // Write the baskets compressed in the background first, they precede the ones flushed here.
+   if (fCompressionQueue)
+      fCompressionQueue->Drain();
    Int_t nbytes = 0;
    Int_t nerror = 0;
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
@@ -5227,6 +5387,33 @@ TTree::TClusterIterator TTree::GetClusterIterator(Long64_t firstentry)
    return TClusterIterator(this,firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of baskets currently compressed in the background or
+/// waiting to be written, see SetCompressionQueueSize.
+
+Int_t TTree::GetCompressionQueueDepth() const
+{
+   return fCompressionQueue ? fCompressionQueue->GetNPending() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the largest number of baskets compressed in the background at the
+/// same time so far, see SetCompressionQueueSize.
+
+Int_t TTree::GetCompressionQueueMaxDepth() const
+{
+   return fCompressionQueue ? fCompressionQueue->GetMaxNPending() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of times Fill had to wait for the baskets compressed in
+/// the background because the queue was full, see SetCompressionQueueSize.
+
+Long64_t TTree::GetCompressionQueueStalls() const
+{
+   return fCompressionQueue ? fCompressionQueue->GetNStalls() : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to the current file.
 
@@ -6690,11 +6877,22 @@ Long64_t TTree::Merge(TCollection* li, Option_t *options)
 /// this TTree object (so that this TTree object is now the appropriate to
 /// use for further merging).
 ///
+/// If info->fOptions contains "LiveSources", the input trees (including this
+/// TTree when info->fIsFirst is true) are trees still being filled, e.g. by
+/// the workers of a ROOT::Experimental::TBufferMerger: their branch addresses
+/// and MakeClass mode are restored once their entries are copied and, when
+/// info->fIsFirst is true, the clone created in info->fOutputDirectory is kept
+/// there (attached to the directory) as the target of the further merges
+/// instead of being overlaid onto this TTree.
+/// Together with "fast", this moves the compressed baskets of the inputs
+/// without reading back or restreaming anything.
+///
 /// Returns the total number of entries in the merged tree.
 
 Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
 {
    const char *options = info ? info->fOptions.Data() : "";
+   const Bool_t liveSources = info && info->fOptions.Contains("LiveSources", TString::kIgnoreCase);
    if (info && info->fIsFirst && info->fOutputDirectory && info->fOutputDirectory->GetFile() != GetCurrentFile()) {
       TDirectory::TContext ctxt(info->fOutputDirectory);
       TIOFeatures saved_features = fIOFeatures;
@@ -6703,6 +6901,14 @@ Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
       }
       TTree *newtree = CloneTree(-1, options);
       fIOFeatures = saved_features;
+      if (liveSources) {
+         if (!newtree)
+            return -1;
+         // Separate the trees, the clone lives on in the output directory.
+         GetListOfClones()->Remove(newtree);
+         newtree->ResetBranchAddresses();
+         return newtree->GetEntries();
+      }
       if (newtree) {
          newtree->Write();
          delete newtree;
@@ -6727,15 +6933,39 @@ Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
          fAutoSave = storeAutoSave;
          return -1;
       }
+      // A live source is filled further after the merge: remember its own setup to restore it.
+      const Int_t liveMakeClass = tree->GetMakeClass();
+      // ResetBranchAddresses also resets the sub-branches of the split branches: record all of
+      // them, the top-level branches first, as their addresses set the ones of their sub-branches.
+      std::vector<std::pair<TBranch *, char *>> liveAddresses;
+      if (liveSources) {
+         for (auto branch : TRangeDynCast<TBranch>(tree->GetListOfBranches()))
+            liveAddresses.emplace_back(branch, branch->GetAddress());
+         for (auto leaf : TRangeDynCast<TLeaf>(tree->GetListOfLeaves())) {
+            TBranch *branch = leaf ? leaf->GetBranch() : nullptr;
+            if (branch && branch->GetMother() != branch)
+               liveAddresses.emplace_back(branch, branch->GetAddress());
+         }
+      }
+
       // Copy MakeClass status.
       tree->SetMakeClass(fMakeClass);
 
-      // Copy branch addresses.
+      // Copy branch addresses, CopyEntries reads the entries through them if the
+      // baskets cannot be copied as they are.
       CopyAddresses(tree);
 
       CopyEntries(tree,-1,options);
 
       tree->ResetBranchAddresses();
+
+      if (liveSources) {
+         tree->SetMakeClass(liveMakeClass);
+         for (auto &address : liveAddresses) {
+            if (address.second && address.first->GetAddress() != address.second)
+               address.first->SetAddress(address.second);
+         }
+      }
    }
    fAutoSave = storeAutoSave;
    return GetEntries();
@@ -7692,6 +7922,10 @@ void TTree::Reset(Option_t* option)
    delete fTreeIndex;
    fTreeIndex = 0;
 
+   // The baskets compressed in the background are dropped with the others.
+   if (fCompressionQueue)
+      fCompressionQueue->Discard();
+
    Int_t nb = fBranches.GetEntriesFast();
    for (Int_t i = 0; i < nb; ++i)  {
       TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
@@ -7722,6 +7956,9 @@ void TTree::ResetAfterMerge(TFileMergeInfo *info)
    delete fTreeIndex;
    fTreeIndex     = 0;
 
+   if (fCompressionQueue)
+      fCompressionQueue->Discard();
+
    Int_t nb = fBranches.GetEntriesFast();
    for (Int_t i = 0; i < nb; ++i)  {
       TBranch* branch = (TBranch*) fBranches.UncheckedAt(i);
@@ -8539,6 +8776,39 @@ void TTree::SetCircular(Long64_t maxEntries)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the full baskets in the background during Fill.
+///
+/// When implicit multi-threading is enabled, a basket filled up by Fill is
+/// handed over to a task compressing it while the filling goes on in a new
+/// basket, instead of being compressed and written before Fill returns.
+/// The compressed baskets are written to the file by the thread calling Fill,
+/// at the next call of Fill or at the latest by FlushBaskets.
+/// At most nbaskets baskets are in flight at any time: when the queue is full,
+/// Fill waits for the compression of the pending baskets (helping with it).
+/// The memory held by the queue is thus bounded by nbaskets times the basket size.
+///
+/// With nbaskets <= 0 (the default) the baskets are compressed during Fill.
+/// The queue only applies to branches with a plain TBasket in a tree attached
+/// to a file and is ignored for circular trees.
+/// The statistics of the queue are returned by GetCompressionQueueDepth,
+/// GetCompressionQueueMaxDepth and GetCompressionQueueStalls, and the time
+/// spent compressing the baskets of a branch by TBranch::GetCompressTime.
+
+void TTree::SetCompressionQueueSize(Int_t nbaskets)
+{
+   if (fCompressionQueue) {
+      fCompressionQueue->Drain();
+      delete fCompressionQueue;
+      fCompressionQueue = nullptr;
+   }
+   fCompressionQueueSize = nbaskets > 0 ? nbaskets : 0;
+#ifndef R__USE_IMT
+   if (fCompressionQueueSize)
+      Warning("SetCompressionQueueSize", "ROOT was built without implicit multi-threading, baskets are compressed during Fill.");
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the debug level and the debug range.
 ///
@@ -8589,6 +8859,9 @@ void TTree::SetDirectory(TDirectory* dir)
    if (fDirectory == dir) {
       return;
    }
+   // The baskets compressed in the background belong to the current file.
+   if (fCompressionQueue)
+      fCompressionQueue->Drain();
    if (fDirectory) {
       fDirectory->Remove(this);
 
@@ -912,7 +912,8 @@ Bool_t TTreeCache::ProcessMiss(Long64_t pos, int len)
 Bool_t TTreeCache::CheckMissCache(char *buf, Long64_t pos, int len)
 {
 
-   if (!fOptimizeMisses) {
+   // Without a buffer (memory mapped files) there is nothing to recover.
+   if (!fOptimizeMisses || !buf) {
       return kFALSE;
    }
    if (R__unlikely((pos < 0) || (len < 0))) {
@@ -2001,6 +2002,8 @@ Int_t TTreeCache::ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len)
 ///  - 0 in case not in cache,
 ///  - 1 in case read from cache.
 /// This function overloads TFileCacheRead::ReadBuffer.
+/// buf can be null when the basket is read in place from a memory mapped
+/// file: the call then only drives the prefetching of the clusters.
 
 Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
@@ -28,6 +28,10 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TMutex.h"
 #include "ROOT/RMakeUnique.hxx"
 
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
@@ -161,10 +165,15 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPoolSize(0),
+   fUnzipPoolFull(kFALSE),
+   fNActiveTasks(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fUnzipTime(0),
+   fStallTime(0)
 {
    // Default Constructor.
    Init();
@@ -180,10 +189,15 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipPoolSize(0),
+   fUnzipPoolFull(kFALSE),
+   fNActiveTasks(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fUnzipTime(0),
+   fStallTime(0)
 {
    Init();
 }
@@ -305,6 +319,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fSeekEntry.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -336,6 +351,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fSeekEntry.push_back(entries[j]);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -501,6 +517,8 @@ void TTreeCacheUnzip::ResetCache()
    // Reset all the lists and wipe all the chunks
    fCycle++;
    fUnzipState.Clear(fNseekMax);
+   fUnzipPoolSize = 0;
+   fUnzipPoolFull = kFALSE;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -583,13 +601,17 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 
    // Unzip it into a new blk
    char *ptr = 0;
+   auto start = std::chrono::steady_clock::now();
    Int_t loclen = UnzipBuffer(&ptr, locbuff);
+   fUnzipTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
          if (locbuff) delete [] locbuff;
+         delete [] ptr;
          return 1;
       }
+      fUnzipPoolSize += loclen;
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
@@ -602,18 +624,54 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// We create a TTaskGroup and asynchronously map each group of untouched baskets
+/// (> fUnzipGroupSize in total) to a task. In TTaskGroup, we use TThreadExecutor
+/// to do the actual work of unzipping a group of baskets. The purpose of creating
+/// TTaskGroup is to avoid competing with main thread.
+///
+/// Baskets are grouped and scheduled in the order in which they will be read,
+/// i.e. by increasing first entry, so that the tasks stay ahead of the reading
+/// cursor. The tasks stop as soon as the unzipped blocks waiting to be consumed
+/// exceed fUnzipBufferSize; GetUnzipBuffer schedules the remaining baskets again
+/// once enough blocks have been consumed.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
+   std::vector<Int_t> order(fNseek);
+   std::iota(order.begin(), order.end(), 0);
+   if (fSeekEntry.size() == (size_t)fNseek) {
+      std::stable_sort(order.begin(), order.end(), [&](Int_t i, Int_t j) { return fSeekEntry[i] < fSeekEntry[j]; });
+   }
+
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   std::vector<std::vector<Int_t>> basketIndices;
+   std::vector<Int_t> indices;
+   Int_t accusz = 0;
+   for (auto i : order) {
+      if (!fUnzipState.IsUntouched(i)) continue;
+      indices.push_back(i);
+      accusz += fSeekLen[i];
+      if (accusz >= fUnzipGroupSize) {
+         basketIndices.push_back(std::move(indices));
+         indices.clear();
+         accusz = 0;
+      }
+   }
+   if (!indices.empty()) basketIndices.push_back(std::move(indices));
+   if (basketIndices.empty()) return 0;
+
+   fUnzipPoolFull = kFALSE;
+   auto mapFunction = [this, basketIndices]() {
+      auto unzipFunction = [&](const std::vector<Int_t> &groupIndices) {
          // If cache is invalidated and we should return immediately.
          if (!fIsTransferred) return nullptr;
 
-         for (auto ii : indices) {
+         for (auto ii : groupIndices) {
+            // Keep the memory used by the unzipped blocks bounded
+            if (fUnzipPoolSize > fUnzipBufferSize) {
+               fUnzipPoolFull = kTRUE;
+               break;
+            }
             if(fUnzipState.TryUnzipping(ii)) {
                Int_t res = UnzipCache(ii);
                if(res)
@@ -624,33 +682,35 @@ Int_t TTreeCacheUnzip::CreateTasks()
          return nullptr;
       };
 
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
-         }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
-      }
       ROOT::TThreadExecutor pool;
       pool.Foreach(unzipFunction, basketIndices);
+      --fNActiveTasks;
    };
 
    fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   ++fNActiveTasks;
    fUnzipTaskGroup->Run(mapFunction);
 
    return 0;
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for an unzipped block of size len handed over to a basket. If the
+/// tasks stopped because the pool of unzipped blocks was full and enough of it
+/// has been consumed since, schedule the unzipping of the remaining baskets.
+
+void TTreeCacheUnzip::ConsumedUnzipped(Int_t len)
+{
+   fUnzipPoolSize -= len;
+#ifdef R__USE_IMT
+   if (fUnzipPoolFull && fNActiveTasks == 0 && 2 * fUnzipPoolSize < fUnzipBufferSize &&
+       ROOT::IsImplicitMTEnabled()) {
+      CreateTasks();
+   }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// We try to read a buffer that has already been unzipped
 /// Returns -1 in case of read failure, 0 in case it's not in the
@@ -693,6 +753,8 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // The buffer is, at minimum, in the file cache. We must know its index in the requests list
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
+         std::chrono::steady_clock::time_point stallStart;
+         Bool_t stalled = kFALSE;
 
          do {
 
@@ -711,26 +773,32 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                }
 
                fNFound++;
+               ConsumedUnzipped(fUnzipState.fUnzipLen[seekidx]);
                return fUnzipState.fUnzipLen[seekidx];
             }
 
             // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
             Int_t reqi = -1;
-            
+
             if (fUnzipState.IsProgress(seekidx)) {
-               if (fEmpty) {
+               if (!stalled) {
+                  stallStart = std::chrono::steady_clock::now();
+                  stalled = kTRUE;
+               }
+               // Steal the next basket in reading order, unless the pool of unzipped blocks is full
+               if (fEmpty && fUnzipPoolSize <= fUnzipBufferSize) {
+                  const Bool_t ordered = fSeekEntry.size() == (size_t)fNseek;
                   for (Int_t ii = 0; ii < fNseek; ++ii) {
                      Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
+                     if (fUnzipState.IsUntouched(idx) &&
+                         (reqi < 0 || (ordered && fSeekEntry[idx] < fSeekEntry[reqi]))) {
+                        reqi = idx;
+                        if (!ordered) break;
                      }
                   }
                   if (reqi < 0) {
                      fEmpty = kFALSE;
-                  } else {
+                  } else if (fUnzipState.TryUnzipping(reqi)) {
                      UnzipCache(reqi);
                   }
                }
@@ -747,6 +815,11 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 
          } while (fUnzipState.IsProgress(seekidx));
 
+         if (stalled) {
+            fStallTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                              stallStart).count();
+         }
+
          // Here the block is not pending. It could be done or aborted or not yet being processed.
          if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
             if(!(*buf)) {
@@ -760,6 +833,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
             }
 
             fNStalls++;
+            ConsumedUnzipped(fUnzipState.fUnzipLen[seekidx]);
             return fUnzipState.fUnzipLen[seekidx];
          } else {
             // This is a complete miss. We want to avoid the background tasks
@@ -791,6 +865,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
          fUnzipTaskGroup->Cancel();
          fUnzipTaskGroup.reset();
+         fNActiveTasks = 0; // cancelled tasks might not have run at all
       }
 #endif
       {
@@ -944,10 +1019,12 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Time spent unzipping by threads: %.3f s\n", fUnzipTime * 1e-9);
+   printf("Time spent waiting for blocks being unzipped: %.3f s\n", fStallTime * 1e-9);
 
    TTreeCache::Print(option);
 }
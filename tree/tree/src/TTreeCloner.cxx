@@ -248,6 +248,17 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
    // Since this is called from the constructor, this can not be a virtual function
 
    UInt_t numBaskets = 0;
+   if (from->GetCompressionDictionaryID() && from->GetCompressionDictionaryID() != to->GetCompressionDictionaryID()) {
+      // The baskets can only be decompressed with the dictionary of the branch they come from.
+      fWarningMsg.Form("The export branch and the import branch do not have the same compression dictionary. (The branch name is %s.)",
+                       from->GetName());
+      if (!(fOptions & kNoWarnings)) {
+         Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+      }
+      fNeedConversion = kTRUE;
+      fIsValid = kFALSE;
+      return 0;
+   }
    if (from->InheritsFrom(TBranchClones::Class())) {
       TBranchClones *fromclones = (TBranchClones*) from;
       TBranchClones *toclones = (TBranchClones*) to;
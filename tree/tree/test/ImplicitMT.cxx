@@ -1,12 +1,20 @@
+#include "TBasket.h"
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <limits>
+
 #ifdef R__USE_IMT
 
+#include "ROOT/TTaskGroup.hxx"
+
 // ROOT-9668
 TEST(TTreeImplicitMT, flushBaskets)
 {
@@ -28,4 +36,231 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+// Gives access to the unzipping state of the cache
+class TUnzipCacheProbe : public TTreeCacheUnzip {
+public:
+   TUnzipCacheProbe(TTree *tree, Int_t buffersize) : TTreeCacheUnzip(tree, buffersize) {}
+   void SetUnzipGroupSize(Int_t size) { fUnzipGroupSize = size; }
+   void WaitForTasks()
+   {
+      if (fUnzipTaskGroup)
+         fUnzipTaskGroup->Wait();
+   }
+   Int_t GetNUntouched() const
+   {
+      Int_t n = 0;
+      for (Int_t i = 0; i < fNseek; ++i)
+         n += fUnzipState.IsUntouched(i);
+      return n;
+   }
+   // No basket left untouched comes before a basket already unzipped in reading order
+   bool UnzippedInReadingOrder() const
+   {
+      if (fSeekEntry.size() != (size_t)fNseek)
+         return false;
+      Long64_t lastTouched = -1;
+      Long64_t firstUntouched = std::numeric_limits<Long64_t>::max();
+      for (Int_t i = 0; i < fNseek; ++i) {
+         if (fUnzipState.IsUntouched(i))
+            firstUntouched = std::min(firstUntouched, fSeekEntry[i]);
+         else
+            lastTouched = std::max(lastTouched, fSeekEntry[i]);
+      }
+      return lastTouched <= firstUntouched;
+   }
+};
+
+TEST(TTreeImplicitMT, parallelUnzip)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelUnzipMT.root";
+   const Int_t basketSize = 1000;
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      // No flush, hence no resizing of the baskets: the small baskets of all the branches interleave in the
+      // reading order, which differs from the order of the branches
+      t.SetAutoFlush(0);
+      Int_t values[20];
+      for (Int_t i = 0; i < 20; ++i)
+         t.Branch(TString::Format("b%d", i), &values[i], TString::Format("b%d/I", i), basketSize);
+      for (Int_t entry = 0; entry < 10000; ++entry) {
+         for (Int_t i = 0; i < 20; ++i)
+            values[i] = entry * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(ofileName);
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      ASSERT_NE(nullptr, t);
+      // Owned by the file
+      auto cache = new TUnzipCacheProbe(t, 10000000);
+      ASSERT_EQ(cache, f.GetCacheRead(t));
+      t->AddBranchToCache("*", kTRUE);
+      t->StopCacheLearningPhase();
+      // A single task unzips the baskets one after the other, in a pool of about 10 baskets
+      const Long64_t poolSize = 10 * basketSize;
+      cache->SetUnzipGroupSize(std::numeric_limits<Int_t>::max());
+      cache->SetUnzipBufferSize(poolSize);
+      // The task and the reading thread may each go past the limit by one basket
+      const Long64_t maxPoolSize = poolSize + 2 * basketSize;
+
+      Int_t values[20];
+      for (Int_t i = 0; i < 20; ++i)
+         t->SetBranchAddress(TString::Format("b%d", i), &values[i]);
+      t->GetEntry(0);
+      cache->WaitForTasks();
+      EXPECT_GE(maxPoolSize, cache->GetUnzipPoolSize());
+      EXPECT_LT(0, cache->GetNUntouched());
+      EXPECT_TRUE(cache->UnzippedInReadingOrder());
+
+      for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+         t->GetEntry(entry);
+         for (Int_t i = 0; i < 20; ++i)
+            EXPECT_EQ(entry * i, values[i]);
+         EXPECT_GE(maxPoolSize, cache->GetUnzipPoolSize());
+      }
+      // Every basket went through the cache: either already unzipped, waited for or unzipped on the spot
+      EXPECT_LT(0, cache->GetNFound() + cache->GetNStalls() + cache->GetNMissed());
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(ofileName);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(TTreeImplicitMT, compressionQueue)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "compressionQueueMT.root";
+   const Long64_t nentries = 20000;
+   {
+      TFile f(ofileName, "RECREATE");
+      // The same content, with the baskets compressed during Fill or in the background
+      TTree ref("ref", "ref");
+      TTree t("t", "t");
+      t.SetCompressionQueueSize(4);
+      EXPECT_EQ(4, t.GetCompressionQueueSize());
+      Int_t i1 = 0;
+      Double_t d1 = 0.;
+      TBranch *b1 = nullptr;
+      TBranch *b2 = nullptr;
+      for (auto tree : {&ref, &t}) {
+         // Small baskets, such that many of them go through the queue
+         b1 = tree->Branch("i1", &i1, "i1/I", 1000);
+         b2 = tree->Branch("d1", &d1, "d1/D", 1000);
+      }
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         i1 = entry;
+         d1 = 0.5 * entry;
+         ref.Fill();
+         t.Fill();
+         EXPECT_GE(t.GetCompressionQueueSize(), t.GetCompressionQueueDepth());
+      }
+      EXPECT_LT(0, t.GetCompressionQueueMaxDepth());
+      EXPECT_GE(4, t.GetCompressionQueueMaxDepth());
+      EXPECT_EQ(0, ref.GetCompressionQueueMaxDepth());
+      ref.Write();
+      t.Write();
+      EXPECT_EQ(0, t.GetCompressionQueueDepth());
+      EXPECT_LT(0, b1->GetCompressTime());
+      EXPECT_LT(0, b2->GetCompressTime());
+      EXPECT_LT(1, b1->GetWriteBasket());
+   }
+   {
+      TFile f(ofileName);
+      TTree *ref = nullptr;
+      TTree *t = nullptr;
+      f.GetObject("ref", ref);
+      f.GetObject("t", t);
+      ASSERT_NE(nullptr, ref);
+      ASSERT_NE(nullptr, t);
+      ASSERT_EQ(nentries, t->GetEntries());
+      // The baskets are laid out and keyed as without the queue
+      for (auto name : {"i1", "d1"}) {
+         auto refBranch = ref->GetBranch(name);
+         auto branch = t->GetBranch(name);
+         ASSERT_EQ(refBranch->GetWriteBasket(), branch->GetWriteBasket());
+         for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+            EXPECT_EQ(refBranch->GetBasketEntry()[i], branch->GetBasketEntry()[i]);
+            EXPECT_EQ(refBranch->GetBasketBytes()[i], branch->GetBasketBytes()[i]);
+            EXPECT_EQ(refBranch->GetBasket(i)->GetCycle(), branch->GetBasket(i)->GetCycle()) << name << " basket " << i;
+         }
+      }
+      Int_t i1 = -1;
+      Double_t d1 = -1.;
+      t->SetBranchAddress("i1", &i1);
+      t->SetBranchAddress("d1", &d1);
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         t->GetEntry(entry);
+         EXPECT_EQ(entry, i1);
+         EXPECT_DOUBLE_EQ(0.5 * entry, d1);
+      }
+   }
+   {
+      // The baskets in the queue are written to the file they were filled for before the tree moves
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetCompressionQueueSize(4);
+      Int_t i1 = 0;
+      auto b1 = t.Branch("i1", &i1, "i1/I", 1000);
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         i1 = entry;
+         t.Fill();
+      }
+      t.SetDirectory(nullptr);
+      EXPECT_EQ(0, t.GetCompressionQueueDepth());
+      for (Int_t i = 0; i < b1->GetWriteBasket(); ++i)
+         EXPECT_LT(0, b1->GetBasketSeek(i)) << "basket " << i;
+   }
+   gSystem->Unlink(ofileName);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(TTreeImplicitMT, chainFilePrefetch)
+{
+   ROOT::EnableImplicitMT();
+   const Int_t nfiles = 4;
+   const Long64_t nentries = 1000;
+   TChain chain("t");
+   for (Int_t file = 0; file < nfiles; ++file) {
+      const auto ofileName = TString::Format("chainFilePrefetchMT%d.root", file);
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      Long64_t value = 0;
+      t.Branch("value", &value);
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         value = file * nentries + entry;
+         t.Fill();
+      }
+      t.Write();
+      chain.Add(ofileName);
+   }
+
+   chain.SetFilePrefetch(2);
+   EXPECT_EQ(2, chain.GetFilePrefetch());
+   chain.SetCacheSize(10000000);
+   chain.AddBranchToCache("*", kTRUE);
+   Long64_t value = -1;
+   chain.SetBranchAddress("value", &value);
+   for (Long64_t entry = 0; entry < nfiles * nentries; ++entry) {
+      chain.GetEntry(entry);
+      EXPECT_EQ(entry, value);
+   }
+   // Going back to the first file drops the files opened ahead.
+   chain.GetEntry(0);
+   EXPECT_EQ(0, value);
+
+   chain.Reset();
+   for (Int_t file = 0; file < nfiles; ++file) {
+      const auto ofileName = TString::Format("chainFilePrefetchMT%d.root", file);
+      EXPECT_EQ(nullptr, gROOT->GetListOfFiles()->FindObject(ofileName));
+      gSystem->Unlink(ofileName);
+   }
+}
+
 #endif // R__USE_IMT
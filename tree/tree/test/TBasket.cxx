@@ -4,11 +4,14 @@
 #include "TBranch.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
+#include "TFile.h"
 #include "TMemFile.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
 
+#include <cstring>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -403,3 +406,53 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, ReadFromMappedFile)
+{
+   const auto filename = "tbasket_mmap_test.root";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t("t", "Tree with several baskets per branch.");
+      Int_t idx;
+      Double_t x;
+      t.Branch("idx", &idx, "idx/I", 1024);
+      t.Branch("x", &x, "x/D", 1024);
+      for (idx = 0; idx < 10000; idx++) {
+         x = idx * 0.5;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   for (auto useCache : {false, true}) {
+      TFile f(filename, "MMAP");
+      ASSERT_FALSE(f.IsZombie());
+      EXPECT_TRUE(f.IsMapped());
+      EXPECT_STREQ(f.GetOption(), "READ");
+
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      ASSERT_NE(t, nullptr);
+      ASSERT_GT(t->GetBranch("idx")->GetWriteBasket(), 1);
+      t->SetCacheSize(useCache ? 10000000 : 0);
+
+      Int_t idx;
+      Double_t x;
+      t->SetBranchAddress("idx", &idx);
+      t->SetBranchAddress("x", &x);
+      for (Long64_t i = 0; i < t->GetEntries(); i++) {
+         t->GetEntry(i);
+         EXPECT_EQ(idx, i);
+         EXPECT_DOUBLE_EQ(x, i * 0.5);
+      }
+      t->ResetBranchAddresses();
+      EXPECT_GT(f.GetBytesRead(), 0);
+
+      // The mapping covers the whole file and nothing else.
+      EXPECT_NE(f.GetMappedBuffer(0, 4), nullptr);
+      EXPECT_EQ(memcmp(f.GetMappedBuffer(0, 4), "root", 4), 0);
+      EXPECT_EQ(f.GetMappedBuffer(f.GetSize(), 1), nullptr);
+   }
+
+   gSystem->Unlink(filename);
+}
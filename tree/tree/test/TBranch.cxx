@@ -1,7 +1,10 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TRandom.h"
+#include "TSystem.h"
+#include "RConfigure.h"
 
 #include "gtest/gtest.h"
 
@@ -178,3 +181,286 @@ TEST_F(TBranchTest, twoPreviousTest)
    ASSERT_TRUE(branch->GetListOfBaskets()->At(7));
    delete file;
 }
+
+TEST(TBranch, BulkReadFixedSize)
+{
+   {
+      TFile file("TBranchBulkRead.root", "RECREATE");
+      TTree tree("tree", "A test tree");
+      Float_t x = 0;
+      Double_t v[3] = {0, 0, 0};
+      Int_t n = 0;
+      Float_t arr[10];
+      tree.Branch("x", &x);
+      tree.Branch("v", v, "v[3]/D");
+      tree.Branch("n", &n);
+      tree.Branch("arr", arr, "arr[n]/F");
+      for (Int_t ev = 0; ev < 1000; ++ev) {
+         x = ev * 0.5f;
+         v[0] = ev;
+         v[1] = -ev;
+         v[2] = 2. * ev;
+         n = ev % 10;
+         for (Int_t j = 0; j < n; ++j)
+            arr[j] = ev + j;
+         tree.Fill();
+         if (ev % 100 == 99)
+            tree.FlushBaskets();
+      }
+      file.Write();
+   }
+
+   TFile file("TBranchBulkRead.root");
+   TTree *tree = (TTree *)file.Get("tree");
+   TBufferFile buf(TBuffer::kWrite, 100);
+
+   TBranch *bx = tree->GetBranch("x");
+   Long64_t entry = 0;
+   while (entry < tree->GetEntries()) {
+      auto count = bx->GetBulkEntries(entry, buf);
+      ASSERT_GT(count, 0);
+      auto values = reinterpret_cast<Float_t *>(buf.GetCurrent());
+      for (Int_t i = 0; i < count; ++i)
+         EXPECT_FLOAT_EQ((entry + i) * 0.5f, values[i]);
+      entry += count;
+   }
+   EXPECT_EQ(tree->GetEntries(), entry);
+   EXPECT_EQ(0, bx->GetBulkEntries(entry, buf));
+
+   // Start in the middle of a basket.
+   TBranch *bv = tree->GetBranch("v");
+   auto count = bv->GetBulkEntries(150, buf);
+   EXPECT_EQ(50, count);
+   auto values = reinterpret_cast<Double_t *>(buf.GetCurrent());
+   for (Int_t i = 0; i < count; ++i) {
+      EXPECT_DOUBLE_EQ(150 + i, values[3 * i]);
+      EXPECT_DOUBLE_EQ(-150 - i, values[3 * i + 1]);
+      EXPECT_DOUBLE_EQ(2. * (150 + i), values[3 * i + 2]);
+   }
+
+   // Regular reading is unaffected by the bulk reads.
+   Float_t x = 0;
+   tree->SetBranchAddress("x", &x);
+   tree->GetEntry(42);
+   EXPECT_FLOAT_EQ(21.f, x);
+   bx->GetBulkEntries(500, buf);
+   EXPECT_EQ(42, bx->GetReadEntry());
+
+   // Variable size arrays need the offsets of the entries.
+   TBranch *barr = tree->GetBranch("arr");
+   EXPECT_EQ(-1, barr->GetBulkEntries(0, buf));
+   std::vector<Int_t> offsets;
+   count = barr->GetBulkEntries(95, buf, &offsets);
+   EXPECT_EQ(5, count);
+   ASSERT_EQ(6u, offsets.size());
+   for (Int_t i = 0; i < count; ++i) {
+      const Long64_t ev = 95 + i;
+      EXPECT_EQ(ev % 10 * sizeof(Float_t), UInt_t(offsets[i + 1] - offsets[i]));
+      auto arr = reinterpret_cast<Float_t *>(buf.Buffer() + offsets[i]);
+      for (Int_t j = 0; j < ev % 10; ++j)
+         EXPECT_FLOAT_EQ(ev + j, arr[j]);
+   }
+}
+
+#ifdef R__HAS_ZSTD
+TEST(TBranch, ZSTDCompressionDictionary)
+{
+   const char *fname = "TBranchZSTDDictionary.root";
+   {
+      TFile f(fname, "RECREATE");
+      f.SetCompressionAlgorithm(ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+      f.SetCompressionLevel(5);
+      TTree t("t", "t");
+      Int_t n = 0;
+      Int_t run[16];
+      Float_t pt = 0;
+      t.Branch("n", &n, "n/I");
+      auto brun = t.Branch("run", run, "run[n]/I", 256000);
+      t.Branch("pt", &pt, "pt/F");
+      for (Int_t i = 0; i < 20000; ++i) {
+         n = i % 16;
+         for (Int_t j = 0; j < n; ++j)
+            run[j] = 1000 + (i + j) % 7;
+         pt = i * 0.5f;
+         t.Fill();
+         if (i == 4999) {
+            EXPECT_GT(brun->TrainCompressionDictionary(4096), 0);
+            EXPECT_NE(brun->GetCompressionDictionaryID(), 0u);
+            // A dictionary in use can not be replaced anymore once baskets were written with it.
+            t.FlushBaskets();
+            EXPECT_FALSE(brun->SetCompressionDictionary(nullptr, 0));
+            // A different dictionary with the same ID would be mistaken for this one when decompressing.
+            auto dict = brun->GetCompressionDictionary();
+            dict.back() ^= 0x1;
+            EXPECT_FALSE(t.GetBranch("pt")->SetCompressionDictionary(dict.data(), dict.size()));
+         }
+      }
+      EXPECT_EQ(t.GetBranch("n")->GetCompressionAlgorithm(), ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+      t.Write();
+   }
+
+   TFile f(fname);
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   ASSERT_NE(t, nullptr);
+   auto brun = t->GetBranch("run");
+   EXPECT_FALSE(brun->GetCompressionDictionary().empty());
+   EXPECT_NE(brun->GetCompressionDictionaryID(), 0u);
+   EXPECT_TRUE(t->GetBranch("pt")->GetCompressionDictionary().empty());
+
+   Int_t n = 0;
+   Int_t run[16];
+   Float_t pt = 0;
+   t->SetBranchAddress("n", &n);
+   t->SetBranchAddress("run", run);
+   t->SetBranchAddress("pt", &pt);
+   ASSERT_EQ(t->GetEntries(), 20000);
+   for (Int_t i = 0; i < 20000; ++i) {
+      ASSERT_GT(t->GetEntry(i), 0);
+      ASSERT_EQ(n, i % 16);
+      for (Int_t j = 0; j < n; ++j)
+         ASSERT_EQ(run[j], 1000 + (i + j) % 7);
+      ASSERT_FLOAT_EQ(pt, i * 0.5f);
+   }
+   delete t;
+   gSystem->Unlink(fname);
+}
+#endif
+
+TEST(TBranch, BulkFill)
+{
+   const Int_t kEntries = 5000;
+   std::vector<Float_t> x(kEntries);
+   std::vector<Double_t> v(3 * kEntries);
+   std::vector<Long64_t> l(kEntries);
+   for (Int_t i = 0; i < kEntries; ++i) {
+      x[i] = i * 0.5f;
+      v[3 * i] = i;
+      v[3 * i + 1] = -i;
+      v[3 * i + 2] = 2. * i;
+      l[i] = -1000000000000ll * i;
+   }
+
+   auto fname = "TBranchBulkFill.root";
+   {
+      TFile file(fname, "RECREATE");
+      TTree bulk("bulk", "filled with FillBulk");
+      TTree perEntry("perEntry", "filled with Fill");
+      for (auto t : {&bulk, &perEntry}) {
+         t->SetAutoFlush(1000);
+         t->Branch("x", x.data())->SetBasketSize(2048);
+         t->Branch("v", v.data(), "v[3]/D");
+         t->Branch("l", l.data());
+      }
+      for (Int_t first = 0; first < kEntries; first += 700) {
+         const auto n = std::min(700, kEntries - first);
+         bulk.SetBranchAddress("x", &x[first]);
+         bulk.SetBranchAddress("v", &v[3 * first]);
+         bulk.SetBranchAddress("l", &l[first]);
+         ASSERT_GT(bulk.FillBulk(n), 0);
+      }
+      for (Int_t i = 0; i < kEntries; ++i) {
+         perEntry.SetBranchAddress("x", &x[i]);
+         perEntry.SetBranchAddress("v", &v[3 * i]);
+         perEntry.SetBranchAddress("l", &l[i]);
+         perEntry.Fill();
+      }
+      file.Write();
+   }
+
+   TFile file(fname);
+   TTree *bulk = nullptr;
+   TTree *perEntry = nullptr;
+   file.GetObject("bulk", bulk);
+   file.GetObject("perEntry", perEntry);
+   ASSERT_NE(bulk, nullptr);
+   ASSERT_NE(perEntry, nullptr);
+   EXPECT_EQ(bulk->GetEntries(), kEntries);
+
+   // same baskets and clusters as when filling one entry at a time
+   for (auto name : {"x", "v", "l"}) {
+      EXPECT_EQ(bulk->GetBranch(name)->GetWriteBasket(), perEntry->GetBranch(name)->GetWriteBasket());
+      EXPECT_EQ(bulk->GetBranch(name)->GetTotBytes(), perEntry->GetBranch(name)->GetTotBytes());
+   }
+   auto bulkClusters = bulk->GetClusterIterator(0);
+   auto perEntryClusters = perEntry->GetClusterIterator(0);
+   for (Long64_t start = bulkClusters(); start < kEntries; start = bulkClusters())
+      EXPECT_EQ(start, perEntryClusters());
+
+   Float_t bx = 0;
+   Double_t bv[3];
+   Long64_t bl = 0;
+   bulk->SetBranchAddress("x", &bx);
+   bulk->SetBranchAddress("v", bv);
+   bulk->SetBranchAddress("l", &bl);
+   for (Int_t i = 0; i < kEntries; ++i) {
+      ASSERT_GT(bulk->GetEntry(i), 0);
+      ASSERT_FLOAT_EQ(bx, x[i]);
+      ASSERT_DOUBLE_EQ(bv[0], v[3 * i]);
+      ASSERT_DOUBLE_EQ(bv[2], v[3 * i + 2]);
+      ASSERT_EQ(bl, l[i]);
+   }
+
+   // only branches of basic types of fixed size can be filled in bulk
+   Int_t n = 0;
+   Float_t arr[3];
+   TTree t("t", "t");
+   t.Branch("n", &n);
+   t.Branch("arr", arr, "arr[n]/F");
+   EXPECT_EQ(t.GetBranch("n")->GetBulkFillEntrySize(), 0);
+   EXPECT_EQ(t.GetBranch("arr")->GetBulkFillEntrySize(), 0);
+   EXPECT_EQ(t.FillBulk(1), -1);
+   EXPECT_EQ(t.GetEntries(), 0);
+
+   delete bulk;
+   delete perEntry;
+   gSystem->Unlink(fname);
+}
+
+TEST(TBranch, BulkFillAutoFlushBytes)
+{
+   // a threshold in bytes, as the default one, is turned into a number of entries at the first flush
+   const Int_t kEntries = 20000;
+   std::vector<Double_t> x(kEntries);
+   std::vector<Int_t> n(kEntries);
+   for (Int_t i = 0; i < kEntries; ++i) {
+      x[i] = i * 0.25 + (i * 31) % 17;
+      n[i] = (i * 7919) % 1013;
+   }
+
+   auto fname = "TBranchBulkFillAutoFlushBytes.root";
+   {
+      TFile file(fname, "RECREATE");
+      TTree bulk("bulk", "filled with FillBulk");
+      TTree perEntry("perEntry", "filled with Fill");
+      for (auto t : {&bulk, &perEntry}) {
+         ASSERT_LT(t->GetAutoFlush(), 0);
+         t->SetAutoFlush(-20000);
+         t->Branch("x", x.data())->SetBasketSize(4096);
+         t->Branch("n", n.data())->SetBasketSize(2048);
+      }
+      for (Int_t first = 0; first < kEntries; first += 3000) {
+         bulk.SetBranchAddress("x", &x[first]);
+         bulk.SetBranchAddress("n", &n[first]);
+         ASSERT_GT(bulk.FillBulk(std::min(3000, kEntries - first)), 0);
+      }
+      for (Int_t i = 0; i < kEntries; ++i) {
+         perEntry.SetBranchAddress("x", &x[i]);
+         perEntry.SetBranchAddress("n", &n[i]);
+         perEntry.Fill();
+      }
+
+      ASSERT_GT(perEntry.GetAutoFlush(), 0);
+      EXPECT_EQ(bulk.GetAutoFlush(), perEntry.GetAutoFlush());
+      EXPECT_EQ(bulk.GetAutoSave(), perEntry.GetAutoSave());
+      for (auto name : {"x", "n"}) {
+         EXPECT_EQ(bulk.GetBranch(name)->GetWriteBasket(), perEntry.GetBranch(name)->GetWriteBasket());
+         EXPECT_EQ(bulk.GetBranch(name)->GetZipBytes(), perEntry.GetBranch(name)->GetZipBytes());
+      }
+      auto bulkClusters = bulk.GetClusterIterator(0);
+      auto perEntryClusters = perEntry.GetClusterIterator(0);
+      for (Long64_t start = bulkClusters(); start < kEntries; start = bulkClusters())
+         EXPECT_EQ(start, perEntryClusters());
+   }
+   gSystem->Unlink(fname);
+}
@@ -87,6 +87,8 @@ namespace ROOT {
                fChain->Add(fileNames[i].c_str(), nEntries[i]);
             }
             fChain->ResetBit(TObject::kMustCleanup);
+            // Files are opened ahead by TTreeProcessorMT::Process, if at all, not by each thread
+            fChain->SetFilePrefetch(0);
 
             fFriends.clear();
             const auto nFriends = friendNames.size();
@@ -169,6 +171,10 @@ namespace ROOT {
       /// User-defined selection of entry numbers to be processed, empty if none was provided
       const TEntryList fEntryList; // const to be sure to avoid race conditions among TTreeViews
       const Internal::FriendInfo fFriendInfo;
+      Int_t fFilePrefetch; ///< Number of files opened ahead of the ones being processed
+      bool fHasEntriesRange = false; ///< Whether only a range of entries is processed, see SetEntriesRange
+      Long64_t fBeginEntry = 0;      ///< First entry to process
+      Long64_t fEndEntry = -1;       ///< Entry after the last one to process, -1 for the end of the dataset
 
       ROOT::TThreadedObject<ROOT::Internal::TTreeView> treeView; ///<! Thread-local TreeViews
 
@@ -182,6 +188,8 @@ namespace ROOT {
       TTreeProcessorMT(TTree &tree);
 
       void Process(std::function<void(TTreeReader &)> func);
+      void SetFilePrefetch(Int_t nfiles);
+      void SetEntriesRange(Long64_t begin, Long64_t end = -1);
    };
 
 } // End of namespace ROOT
@@ -115,6 +115,8 @@ namespace Detail {
 
       TBranchProxy* GetProxy() { return this; }
       const char* GetBranchName() const { return fBranchName; }
+      /// Return the branch read by this proxy, null if the proxy is not set up.
+      TBranch* GetBranch() const { return fBranch; }
 
       void Reset();
 
@@ -200,6 +200,7 @@ public:
    virtual Bool_t      IsInteger(Bool_t fast=kTRUE) const;
            Bool_t      IsQuickLoad() const { return fQuickLoad; }
    virtual Bool_t      IsString() const;
+           Bool_t      UsesEntryNumbers() const;
    virtual Bool_t      Notify() { UpdateFormulaLeaves(); return kTRUE; }
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
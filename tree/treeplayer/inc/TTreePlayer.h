@@ -53,12 +53,14 @@ protected:
    TList         *fInput;           //! input list to the selector
    TList         *fFormulaList;     //! Pointer to a list of coordinated list TTreeFormula (used by Scan and Query)
    TSelector     *fSelectorUpdate;  //! Set to the selector address when it's entry list needs to be updated by the UpdateFormulaLeaves function
+   Bool_t         fDrawMT;          //! True if the entries of the current TTree::Draw may be processed in parallel, see ProcessDrawMT
 
 protected:
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Bool_t         ProcessDrawMT(Long64_t firstentry, Long64_t lastentry);
 
 public:
    TTreePlayer();
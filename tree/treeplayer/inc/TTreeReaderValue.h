@@ -78,6 +78,9 @@ Base class of TTreeReaderValue.
 
       const char* GetBranchName() const { return fBranchName; }
 
+      /// Return the proxy reading the data, null until the TTreeReader reads its first entry.
+      Detail::TBranchProxy* GetProxy() const { return fProxy; }
+
       virtual ~TTreeReaderValueBase();
 
    protected:
@@ -95,8 +98,6 @@ Base class of TTreeReaderValue.
 
       virtual const char* GetDerivedTypeName() const = 0;
 
-      Detail::TBranchProxy* GetProxy() const { return fProxy; }
-
       void MarkTreeReaderUnavailable() { fTreeReader = 0; fSetupStatus = kSetupTreeDestructed; }
 
       /// Stringify the template argument.
@@ -26,6 +26,66 @@ and kept inside this chain index.
 #include "TTreeIndex.h"
 #include "TFile.h"
 #include "TError.h"
+#include "TChainElement.h"
+#include "TROOT.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <memory>
+#include <string>
+
+namespace {
+
+using SubIndices_t = std::vector<std::unique_ptr<TTreeIndex>>;
+
+#ifdef R__USE_IMT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the indices of the trees of the chain in parallel, one task per file.
+/// The index of a tree is null if the tree has its own index, which is used instead, or if it cannot be built
+/// this way, in which case it is built sequentially. All the indices are null if the chain has friends.
+
+SubIndices_t BuildSubIndicesMT(TChain *chain, const char *majorname, const char *minorname)
+{
+   auto friends = chain->GetListOfFriends();
+   if (chain->GetNtrees() < 2 || (friends && friends->GetEntries() > 0))
+      return SubIndices_t();
+
+   std::vector<std::pair<std::string, std::string>> files; // tree name, file name
+   for (auto element : *chain->GetListOfFiles())
+      files.emplace_back(element->GetName(), element->GetTitle());
+   auto aliases = chain->GetListOfAliases();
+
+   auto buildIndex = [&](unsigned i) -> TTreeIndex * {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> f(TFile::Open(files[i].second.c_str(), "READ"));
+      if (!f || f->IsZombie())
+         return nullptr;
+      TTree *t = nullptr; // owned by f
+      f->GetObject(files[i].first.c_str(), t);
+      if (!t || t->GetTreeIndex())
+         return nullptr;
+      if (aliases)
+         for (auto alias : *aliases)
+            t->SetAlias(alias->GetName(), alias->GetTitle());
+      std::unique_ptr<TTreeIndex> index(new TTreeIndex(t, majorname, minorname));
+      if (index->IsZombie() || index->GetN() == 0)
+         return nullptr;
+      index->SetTree(nullptr);
+      return index.release();
+   };
+
+   ROOT::TThreadExecutor pool;
+   SubIndices_t indices;
+   for (auto index : pool.Map(buildIndex, ROOT::TSeq<unsigned>(files.size())))
+      indices.emplace_back(index);
+   return indices;
+}
+
+#endif // R__USE_IMT
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class TChainIndex::TChainIndexEntry
@@ -58,7 +118,8 @@ TChainIndex::TChainIndex(): TVirtualIndex()
 /// less then any index value in the second one, and so on.
 /// If any of those requirements isn't met the object becomes a zombie.
 /// If some subtrees don't have indices the indices are created and stored inside this
-/// TChainIndex.
+/// TChainIndex. If implicit multi-threading is enabled, they are created concurrently,
+/// each from its own TFile, unless the chain has friends.
 
 TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *minorname)
            : TVirtualIndex()
@@ -79,6 +140,13 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
    fMinorName          = minorname;
    Int_t i = 0;
 
+   // With implicit multi-threading, the missing indices are built concurrently beforehand.
+   SubIndices_t subIndices;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled())
+      subIndices = BuildSubIndicesMT(chain, majorname, minorname);
+#endif
+
    // Go through all the trees and check if they have indeces. If not then build them.
    for (i = 0; i < chain->GetNtrees(); i++) {
       chain->LoadTree((chain->GetTreeOffset())[i]);
@@ -96,6 +164,11 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
             return;
          }
       }
+      if (!index && i < Int_t(subIndices.size()) && subIndices[i]) {
+         index = subIndices[i].release();
+         index->SetTree(chain->GetTree());
+         entry.fTreeIndex = index;
+      }
       if (!index) {
          chain->GetTree()->BuildIndex(majorname, minorname);
          index = chain->GetTree()->GetTreeIndex();
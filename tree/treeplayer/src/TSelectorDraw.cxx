@@ -24,6 +24,7 @@ A specialized TSelector for TTree::Draw.
 #include "TVirtualPad.h"
 #include "TProfile.h"
 #include "TProfile2D.h"
+#include "TTreeFormula.h"
 #include "TTreeFormulaManager.h"
 #include "TEnv.h"
 #include "TTree.h"
@@ -935,6 +936,52 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the rows of the nentries entries still to be processed can be
+/// filled concurrently into copies of the current histogram, which are then merged
+/// with MergeFillMT.
+///
+/// This is the case once the histogram has its limits, i.e. after the first call
+/// to TakeAction if they are estimated, for 1-D and 2-D histograms and 1-D and 2-D
+/// profiles filled with scalar numerical expressions, when no entry list is used.
+/// Scatter plots, entry lists and objects are filled sequentially.
+///
+/// The rows are also filled sequentially when they must all be kept in the
+/// buffers returned by GetVal: if the estimate of the tree covers them, or if the
+/// temporary histogram is not drawn (option "goff"), in which case the buffers
+/// are the purpose of the call. So are they if an expression uses Entry$,
+/// LocalEntry$ or Entries$, whose values differ in the tasks, or if the tree has
+/// friends: the tasks rebuild them from their file names only, without their
+/// TTreeIndex or the other files of a friend chain.
+
+Bool_t TSelectorDraw::CanFillMT(Long64_t nentries) const
+{
+   if (fAction != 1 && fAction != 2 && fAction != 4 && fAction != 23) return kFALSE;
+   if (!fObject || !fObject->InheritsFrom(TH1::Class())) return kFALSE;
+   if (fObjEval || fMultiplicity || fTreeElist || fTree->TestBit(TTree::kForceRead)) return kFALSE;
+   if (fTree->GetEstimate() >= fNfill + nentries) return kFALSE;
+   if (fOption.Contains("goff") && !strcmp(fObject->GetName(), "htemp")) return kFALSE;
+   if (fSelect && fSelect->UsesEntryNumbers()) return kFALSE;
+   for (TTree *tree : {fTree, fTree->GetTree()}) {
+      if (tree && tree->GetListOfFriends() && tree->GetListOfFriends()->GetSize()) return kFALSE;
+   }
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString() || fVar[i]->UsesEntryNumbers()) return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the histograms filled concurrently with the rows selected outside of this
+/// selector into the current histogram, and count the nrows rows they hold.
+/// See CanFillMT.
+
+void TSelectorDraw::MergeFillMT(TCollection *objects, Long64_t nrows)
+{
+   if (objects && objects->GetSize()) ((TH1*)fObject)->Merge(objects);
+   fSelectedRows += nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -4673,6 +4673,24 @@ Bool_t TTreeFormula::IsString() const
    return TestBit(kIsCharacter);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return TRUE if the formula, or one of the aliases it uses, depends on the
+/// entry numbers or on the number of entries of the tree or chain, i.e. uses
+/// Entry$, LocalEntry$ or Entries$.
+
+Bool_t TTreeFormula::UsesEntryNumbers() const
+{
+   for (Int_t i = 0; i < fNcodes; ++i) {
+      const Int_t type = fLookupType[i];
+      if (type == kIndexOfEntry || type == kIndexOfLocalEntry || type == kEntries) return kTRUE;
+   }
+   for (Int_t i = 0; i <= fAliases.GetLast(); ++i) {
+      const TTreeFormula *alias = static_cast<const TTreeFormula*>(fAliases.UncheckedAt(i));
+      if (alias && alias->UsesEntryNumbers()) return kTRUE;
+   }
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return true if the expression at the index 'oper' is to be treated as
 /// as string.
@@ -16,6 +16,18 @@ A Tree Index with majorname and minorname.
 #include "TTreeIndex.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "TFile.h"
+#include "TROOT.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
@@ -27,7 +39,7 @@ struct IndexSortComparator {
   {}
 
    template<typename Index>
-   bool operator()(Index i1, Index i2) {
+   bool operator()(Index i1, Index i2) const {
       if( *(fValMajor + i1) == *(fValMajor + i2) )
          return *(fValMinor + i1) < *(fValMinor + i2);
       else
@@ -39,6 +51,154 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the mutex serializing the construction of the TTreeFormulas of the indices built concurrently, e.g. by
+/// the tasks of FillIndexMT or by those building the sub-indices of a TChainIndex: the parsing of the expressions is
+/// not meant to run concurrently.
+
+std::mutex &GetFormulaMutex()
+{
+   static std::mutex formulaMutex;
+   return formulaMutex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the entry numbers in [first, last) of index by their (major, minor) values.
+/// Nothing is done if they are already sorted, as it is the case when the values grow with the entry number.
+
+void SortIndexRange(Long64_t *index, Long64_t first, Long64_t last, Long64_t *major, Long64_t *minor)
+{
+   const IndexSortComparator comp(major, minor);
+   if (!std::is_sorted(index + first, index + last, comp))
+      std::sort(index + first, index + last, comp);
+}
+
+#ifdef R__USE_IMT
+
+using EntryRange_t = std::pair<Long64_t, Long64_t>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge pairs of consecutive sorted ranges of index in parallel until the whole index is sorted.
+/// Two ranges are merged only if the values of the second one do not all follow the values of the first one.
+
+void MergeIndexRanges(Long64_t *index, std::vector<EntryRange_t> ranges, Long64_t *major, Long64_t *minor,
+                      ROOT::TThreadExecutor &pool)
+{
+   const IndexSortComparator comp(major, minor);
+   while (ranges.size() > 1) {
+      const auto nPairs = ranges.size() / 2;
+      auto merge = [&](unsigned pair) {
+         const auto first = ranges[2 * pair].first;
+         const auto middle = ranges[2 * pair + 1].first;
+         const auto last = ranges[2 * pair + 1].second;
+         if (comp(index[middle], index[middle - 1]))
+            std::inplace_merge(index + first, index + middle, index + last, comp);
+      };
+      pool.Foreach(merge, ROOT::TSeq<unsigned>(nPairs));
+
+      std::vector<EntryRange_t> merged;
+      for (auto pair = 0u; pair < nPairs; ++pair)
+         merged.emplace_back(ranges[2 * pair].first, ranges[2 * pair + 1].second);
+      if (ranges.size() % 2)
+         merged.emplace_back(ranges.back());
+      ranges.swap(merged);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the major and minor values of all the entries of tree and the sorted index in parallel.
+///
+/// The entries are split in groups of clusters. Each task reads its group from its own copy of the tree, read from
+/// the file of the tree, and sorts it; the sorted groups are then merged in parallel.
+/// Return false, without filling the index, if the tree cannot be read this way: if it is not read from a file,
+/// if the file is being written, if the tree is a TChain or if it has friends. The caller must then fill the index
+/// sequentially.
+
+bool FillIndexMT(TTree *tree, const char *majorname, const char *minorname, Long64_t nEntries, Long64_t *major,
+                 Long64_t *minor, Long64_t *index)
+{
+   auto file = tree->GetCurrentFile();
+   auto dir = tree->GetDirectory();
+   auto friends = tree->GetListOfFriends();
+   if (!file || !dir || file->IsWritable() || tree->GetTree() != tree || (friends && friends->GetEntries() > 0))
+      return false;
+
+   ROOT::TThreadExecutor pool;
+   // a few tasks per thread to balance the load, with whole clusters to read each basket once
+   const Long64_t nTasks = 4 * pool.GetPoolSize();
+   const auto minTaskEntries = (nEntries + nTasks - 1) / nTasks;
+   std::vector<EntryRange_t> ranges;
+   auto clusterIter = tree->GetClusterIterator(0);
+   Long64_t start = 0;
+   while ((start = clusterIter()) < nEntries) {
+      const auto end = std::min(clusterIter.GetNextEntry(), nEntries);
+      if (!ranges.empty() && ranges.back().second - ranges.back().first < minTaskEntries)
+         ranges.back().second = end;
+      else
+         ranges.emplace_back(start, end);
+   }
+   if (ranges.size() < 2)
+      return false;
+
+   // the path of the tree in its file, e.g. "dir/tree" for "file.root:/dir"
+   std::string treePath = dir->GetPath();
+   const auto colon = treePath.find(":/");
+   treePath = colon == std::string::npos ? std::string() : treePath.substr(colon + 2);
+   if (!treePath.empty())
+      treePath += "/";
+   treePath += tree->GetName();
+   const std::string fileName = file->GetName();
+   auto aliases = tree->GetListOfAliases();
+
+   auto fillRange = [&](unsigned i) -> int {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ"));
+      if (!f || f->IsZombie())
+         return 0;
+      TTree *t = nullptr; // owned by f
+      f->GetObject(treePath.c_str(), t);
+      if (!t || t->GetEntries() != nEntries)
+         return 0;
+
+      std::unique_ptr<TTreeFormula> majorFormula, minorFormula;
+      {
+         std::lock_guard<std::mutex> lock(GetFormulaMutex());
+         if (aliases)
+            for (auto alias : *aliases)
+               t->SetAlias(alias->GetName(), alias->GetTitle());
+         majorFormula.reset(new TTreeFormula("Major", majorname, t));
+         minorFormula.reset(new TTreeFormula("Minor", minorname, t));
+      }
+      if (majorFormula->GetNdim() != 1 || minorFormula->GetNdim() != 1)
+         return 0;
+      majorFormula->SetQuickLoad(kTRUE);
+      minorFormula->SetQuickLoad(kTRUE);
+
+      const auto &range = ranges[i];
+      for (auto entry = range.first; entry < range.second; ++entry) {
+         if (t->LoadTree(entry) < 0)
+            return 0;
+         major[entry] = (Long64_t)majorFormula->EvalInstance<LongDouble_t>();
+         minor[entry] = (Long64_t)minorFormula->EvalInstance<LongDouble_t>();
+         index[entry] = entry;
+      }
+      SortIndexRange(index, range.first, range.second, major, minor);
+      return 1;
+   };
+   const auto filled = pool.Map(fillRange, ROOT::TSeq<unsigned>(ranges.size()));
+   if (std::find(filled.begin(), filled.end(), 0) != filled.end())
+      return false;
+
+   MergeIndexRanges(index, std::move(ranges), major, minor, pool);
+   return true;
+}
+
+#endif // R__USE_IMT
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -90,6 +250,16 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// To build an index with only majorname, specify minorname="0" (default)
 ///
+/// ## Building the index in parallel
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()) and the Tree
+/// is read from a file which is not open for writing, the expressions are
+/// evaluated in parallel: each task reads a group of clusters of the Tree from
+/// its own TFile and sorts its entries, then the sorted groups are merged.
+/// Trees with friends, and TChains, are processed sequentially.
+/// In both cases, the sort is skipped for entries whose index values already
+/// grow with the entry number.
+///
 /// ## TreeIndex and Friend Trees
 ///
 /// Assuming a parent Tree T and a friend Tree TF, the following cases are supported:
@@ -142,8 +312,11 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
       return;
    }
 
-   GetMajorFormula();
-   GetMinorFormula();
+   {
+      std::lock_guard<std::mutex> lock(GetFormulaMutex());
+      GetMajorFormula();
+      GetMinorFormula();
+   }
    if (!fMajorFormula || !fMinorFormula) {
       MakeZombie();
       Error("TreeIndex","Cannot build the index with major=%s, minor=%s",fMajorName.Data(), fMinorName.Data());
@@ -165,21 +338,28 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   fIndex = new Long64_t[fN];
+   Bool_t filled = kFALSE;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled())
+      filled = FillIndexMT(fTree, fMajorName.Data(), fMinorName.Data(), fN, tmp_major, tmp_minor, fIndex);
+#endif
+   if (!filled) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+      for(i = 0; i < fN; i++) { fIndex[i] = i; }
+      SortIndexRange(fIndex, 0, fN, tmp_major, tmp_minor);
    }
-   fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -268,7 +448,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      SortIndexRange(conv, 0, fN, addValues, addValues2);
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -595,9 +775,15 @@ void TTreeIndex::UpdateFormulaLeaves(const TTree *parent)
 /// when a new Tree is loaded.
 /// Because Trees in a TChain may have a different list of leaves, one
 /// must update the leaves numbers in the TTreeFormula used by the TreeIndex.
+/// The formulas of the major and minor names are bound to the previous Tree:
+/// they are deleted, and built again for the new Tree when needed.
 
 void TTreeIndex::SetTree(const TTree *T)
 {
+   if (fTree != T) {
+      delete fMajorFormula;        fMajorFormula  = 0;
+      delete fMinorFormula;        fMinorFormula  = 0;
+   }
    fTree = (TTree*)T;
 }
 
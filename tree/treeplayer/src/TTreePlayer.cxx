@@ -83,6 +83,14 @@ extra libraries (Histogram, display, etc).
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Math/MinimizerOptions.h"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#endif
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 
 
@@ -109,6 +117,7 @@ TTreePlayer::TTreePlayer()
    fSelectorFromFile = 0;
    fSelectorClass    = 0;
    fSelectorUpdate   = 0;
+   fDrawMT           = kFALSE;
    fInput            = new TList();
    fInput->Add(new TNamed("varexp",""));
    fInput->Add(new TNamed("selection",""));
@@ -415,8 +424,14 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    // Do not process more than fMaxEntryLoop entries
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
+#ifdef R__USE_IMT
+   // once the histogram is set up, the entries left may be processed in parallel, see ProcessDrawMT
+   fDrawMT = ROOT::IsImplicitMTEnabled() && !evlist && !elist;
+#endif
+
    // invoke the selector
    Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   fDrawMT = kFALSE;
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
@@ -2306,6 +2321,13 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
             // Reset the abort status.
             selector->ResetAbort();
          }
+         // TTree::Draw can fill its histogram in parallel once its limits are known
+         if (fDrawMT && selector == fSelector && fSelector->GetAction() > 0) {
+            fDrawMT = kFALSE;
+            if (fSelector->CanFillMT(firstentry + nentries - entry - 1) &&
+                ProcessDrawMT(entry + 1, firstentry + nentries))
+               break;
+         }
       }
       delete timer;
       //we must reset the cache
@@ -2334,6 +2356,118 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram of the current TTree::Draw with the entries [firstentry, lastentry)
+/// in parallel, when implicit multi-threading is enabled.
+///
+/// The entries are processed by a ROOT::TTreeProcessorMT, in tasks made of whole clusters
+/// which read their own copy of the tree. Each task evaluates the expressions of the
+/// selector with its own TTreeFormula objects and fills its own copy of the histogram;
+/// the copies are merged into the histogram at the end (see TSelectorDraw::MergeFillMT).
+/// Return kFALSE, before processing any entry, if the tree is not read from a file or if
+/// its file is open for writing: the entries must then be processed sequentially.
+
+Bool_t TTreePlayer::ProcessDrawMT(Long64_t firstentry, Long64_t lastentry)
+{
+#ifdef R__USE_IMT
+   if (firstentry >= lastentry) return kFALSE;
+   TChain *chain = dynamic_cast<TChain*>(fTree);
+   if (!chain) {
+      TFile *file = fTree->GetCurrentFile();
+      if (!file || file->IsWritable() || !fTree->GetDirectory()) return kFALSE;
+   }
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor.reset(new ROOT::TTreeProcessorMT(*fTree));
+   } catch (const std::exception &) {
+      return kFALSE;
+   }
+   processor->SetEntriesRange(firstentry, lastentry);
+
+   TH1 *hist = (TH1*)fSelector->GetObject();
+   const Int_t action = fSelector->GetAction();
+   const Int_t dimension = fSelector->GetDimension();
+   std::vector<std::string> varexps;
+   for (Int_t i = 0; i < dimension; ++i) varexps.emplace_back(fSelector->GetVar(i)->GetTitle());
+   const std::string selection = fSelector->GetSelect() ? fSelector->GetSelect()->GetTitle() : "";
+   // the weight of the trees, unless a weight was set for the whole chain (see TChain::SetWeight)
+   const Bool_t globalWeight = !chain || chain->TestBit(TChain::kGlobalWeight);
+   const Double_t weight = fTree->GetWeight();
+   TList *aliases = fTree->GetListOfAliases();
+
+   std::mutex mutex;
+   std::vector<std::unique_ptr<TH1>> slotHists;
+   std::vector<TH1*> freeHists;
+   Long64_t nrows = 0;
+
+   auto fill = [&](TTreeReader &reader) {
+      if (!reader.Next()) return;
+      TTree *tree = reader.GetTree();
+      std::vector<std::unique_ptr<TTreeFormula>> vars;
+      std::unique_ptr<TTreeFormula> select;
+      TH1 *h = nullptr;
+      {
+         // the formulas are compiled and the histograms cloned one at a time
+         std::lock_guard<std::mutex> lock(mutex);
+         if (aliases) {
+            for (auto alias : *aliases) tree->SetAlias(alias->GetName(), alias->GetTitle());
+         }
+         if (!selection.empty()) select.reset(new TTreeFormula("Selection", selection.c_str(), tree));
+         for (Int_t i = 0; i < dimension; ++i)
+            vars.emplace_back(new TTreeFormula(TString::Format("Var%i", i + 1), varexps[i].c_str(), tree));
+         if (freeHists.empty()) {
+            TDirectory::TContext ctxt(nullptr);
+            h = (TH1*)hist->Clone();
+            h->SetDirectory(nullptr);
+            h->Reset();
+            slotHists.emplace_back(h);
+         } else {
+            h = freeHists.back();
+            freeHists.pop_back();
+         }
+      }
+
+      Long64_t rows = 0;
+      Int_t treeNumber = -1;
+      Double_t treeWeight = weight;
+      Double_t v[3] = {0, 0, 0};
+      do {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            if (!globalWeight) treeWeight = tree->GetTree()->GetWeight();
+            if (select) select->UpdateFormulaLeaves();
+            for (auto &var : vars) var->UpdateFormulaLeaves();
+         }
+         Double_t w = treeWeight;
+         if (select) {
+            w *= select->EvalInstance(0);
+            if (!w) continue;
+         }
+         for (Int_t i = 0; i < dimension; ++i) v[i] = vars[i]->EvalInstance(0);
+         if      (action ==  1) h->Fill(v[0], w);
+         else if (action ==  2) ((TH2*)h)->Fill(v[1], v[0], w);
+         else if (action ==  4) ((TProfile*)h)->Fill(v[1], v[0], w);
+         else if (action == 23) ((TProfile2D*)h)->Fill(v[2], v[1], v[0], w);
+         ++rows;
+      } while (reader.Next());
+
+      std::lock_guard<std::mutex> lock(mutex);
+      freeHists.push_back(h);
+      nrows += rows;
+   };
+   processor->Process(fill);
+
+   TList hists;
+   for (auto &h : slotHists) hists.Add(h.get());
+   fSelector->MergeFillMT(&hists, nrows);
+   return kTRUE;
+#else
+   (void)firstentry;
+   (void)lastentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -24,19 +24,29 @@ of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTr
 objects.
 */
 
+#include "TEnv.h"
 #include "TROOT.h"
+#include "ROOT/TFileLookahead.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <algorithm>
+#include <mutex>
+
 using namespace ROOT;
 
 namespace ROOT {
 namespace Internal {
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// Files already opened by lookahead, as firstIndex and following, are taken from it.
+/// If maxEntries is not negative, the files after the one holding entry maxEntries - 1 are
+/// not opened, and the returned vectors only cover the files before them.
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
-static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames)
+static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames,
+                                       TFileLookahead *lookahead = nullptr, std::size_t firstIndex = 0,
+                                       Long64_t maxEntries = -1)
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -45,9 +55,16 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
    std::vector<std::vector<EntryCluster>> clustersPerFile; clustersPerFile.reserve(nFileNames);
    std::vector<Long64_t> entriesPerFile; entriesPerFile.reserve(nFileNames);
    Long64_t offset = 0ll;
-   for (const auto &fileName : fileNames) {
-      auto fileNameC = fileName.c_str();
-      std::unique_ptr<TFile> f(TFile::Open(fileNameC)); // need TFile::Open to load plugins if need be
+   for (auto i = 0u; i < nFileNames; ++i) {
+      if (maxEntries >= 0 && offset >= maxEntries)
+         break;
+      auto fileNameC = fileNames[i].c_str();
+      TFile *prefetched = nullptr;
+      std::unique_ptr<TFile> f;
+      if (lookahead && lookahead->Take(firstIndex + i, prefetched))
+         f.reset(prefetched);
+      else
+         f.reset(TFile::Open(fileNameC)); // need TFile::Open to load plugins if need be
       if (!f || f->IsZombie()) {
          Error("TTreeProcessorMT::Process",
                "An error occurred while opening file %s: skipping it.",
@@ -215,7 +232,8 @@ std::string TTreeProcessorMT::FindTreeName()
 ///                     the implementation will automatically search for a
 ///                     tree in the file.
 TTreeProcessorMT::TTreeProcessorMT(std::string_view filename, std::string_view treename)
-   : fFileNames({std::string(filename)}), fTreeName(treename.empty() ? FindTreeName() : treename), fFriendInfo() {}
+   : fFileNames({std::string(filename)}), fTreeName(treename.empty() ? FindTreeName() : treename), fFriendInfo(),
+     fFilePrefetch(gEnv->GetValue("TChain.FilePrefetch", 0)) {}
 
 std::vector<std::string> CheckAndConvert(const std::vector<std::string_view> & views)
 {
@@ -236,7 +254,8 @@ std::vector<std::string> CheckAndConvert(const std::vector<std::string_view> & v
 ///                     the implementation will automatically search for a
 ///                     tree in the collection of files.
 TTreeProcessorMT::TTreeProcessorMT(const std::vector<std::string_view> &filenames, std::string_view treename)
-   : fFileNames(CheckAndConvert(filenames)), fTreeName(treename.empty() ? FindTreeName() : treename), fFriendInfo() {}
+   : fFileNames(CheckAndConvert(filenames)), fTreeName(treename.empty() ? FindTreeName() : treename), fFriendInfo(),
+     fFilePrefetch(gEnv->GetValue("TChain.FilePrefetch", 0)) {}
 
 std::vector<std::string> GetFilesFromTree(TTree &tree)
 {
@@ -270,13 +289,47 @@ std::vector<std::string> GetFilesFromTree(TTree &tree)
 /// \param[in] entries List of entry numbers to process.
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree, const TEntryList &entries)
    : fFileNames(GetFilesFromTree(tree)), fTreeName(ROOT::Internal::GetTreeFullPath(tree)), fEntryList(entries),
-     fFriendInfo(GetFriendInfo(tree)) {}
+     fFriendInfo(GetFriendInfo(tree)), fFilePrefetch(gEnv->GetValue("TChain.FilePrefetch", 0)) {}
 
 ////////////////////////////////////////////////////////////////////////
 /// Constructor based on a TTree.
 /// \param[in] tree Tree or chain of files containing the tree to process.
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree) : TTreeProcessorMT(tree, TEntryList()) {}
 
+//////////////////////////////////////////////////////////////////////////////
+/// Set the number of files opened ahead of the ones being processed.
+///
+/// While a file is processed, Process opens the nfiles following ones in the
+/// background, reading their metadata and the baskets of their first cluster, so
+/// that their processing does not start by waiting for them. A value of 0 disables
+/// the lookahead. The default is set by the rootrc setting TChain.FilePrefetch (0).
+/// Files are only opened ahead when implicit multi-threading is enabled, the entries
+/// are not selected by an entry list and the tree has no friends.
+/// \param[in] nfiles Number of files to open ahead.
+void TTreeProcessorMT::SetFilePrefetch(Int_t nfiles)
+{
+   fFilePrefetch = nfiles;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Only process the entries [begin, end) of the dataset, numbered globally
+/// across its files.
+///
+/// Only the clusters overlapping the range are processed, each one restricted to
+/// the part within the range. The TTreeReader passed to the function of Process
+/// then iterates on the chain of all files, so that TTreeReader::GetCurrentEntry
+/// returns global entry numbers; as a consequence, the files up to the one holding
+/// the end of the range are opened before processing starts and no file is opened
+/// ahead, see SetFilePrefetch. The files after it are not opened.
+/// \param[in] begin First entry to process.
+/// \param[in] end Entry after the last one to process, -1 for the end of the dataset.
+void TTreeProcessorMT::SetEntriesRange(Long64_t begin, Long64_t end)
+{
+   fHasEntriesRange = true;
+   fBeginEntry = begin;
+   fEndEntry = end;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// Process the entries of a TTree in parallel. The user-provided function
 /// receives a TTreeReader which can be used to iterate on a subrange of
@@ -299,33 +352,59 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const std::vector<Internal::NameAlias> &friendNames = fFriendInfo.fFriendNames;
    const std::vector<std::vector<std::string>> &friendFileNames = fFriendInfo.fFriendFileNames;
 
-   // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
-   // so we do it here for all files.
+   // If an entry list, friend trees or a range of entries are present, we need to generate clusters with global entry
+   // numbers, so we do it here for all files.
    const bool hasFriends = !friendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
-   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
+   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fHasEntriesRange;
    const auto clustersAndEntries =
-      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames) : Internal::ClustersAndEntries{};
+      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames, nullptr, 0, fEndEntry)
+                                : Internal::ClustersAndEntries{};
    const auto &clusters = clustersAndEntries.first;
    const auto &entries = clustersAndEntries.second;
 
+   // The files after the end of the range of entries are neither opened nor processed
+   const std::vector<std::string> fileNames =
+      shouldRetrieveAllClusters
+         ? std::vector<std::string>(fFileNames.begin(), fFileNames.begin() + clusters.size())
+         : fFileNames;
+
    // Retrieve number of entries for each file for each friend tree
    const auto friendEntries =
       hasFriends ? Internal::GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
+   // Files are opened ahead of their processing, see SetFilePrefetch. This only applies to local entry numbers:
+   // with global ones, all files were opened above already.
+   const std::size_t nFiles = fileNames.size();
+   const std::size_t filePrefetch = shouldRetrieveAllClusters || fFilePrefetch < 0 ? 0u : fFilePrefetch;
+   Internal::TFileLookahead lookahead;
+   std::mutex lookaheadMutex;
+   std::vector<bool> fileStarted(nFiles, false);
+
    TThreadExecutor pool;
    // Parent task, spawns tasks that process each of the entry clusters for each input file
    using Internal::EntryCluster;
    auto processFile = [&](std::size_t fileIdx) {
 
+      // Start opening the next files, unless their processing started already
+      if (filePrefetch > 0) {
+         std::lock_guard<std::mutex> lock(lookaheadMutex);
+         fileStarted[fileIdx] = true;
+         for (auto i = fileIdx + 1; i < nFiles && i <= fileIdx + filePrefetch; ++i) {
+            if (!fileStarted[i])
+               lookahead.Prefetch(i, fileNames[i], fTreeName, {"*"}, 0);
+         }
+      }
+
       // If cluster information is already present, build TChains with all input files and use global entry numbers
       // Otherwise get cluster information only for the file we need to process and use local entry numbers
-      const bool shouldUseGlobalEntries = hasFriends || hasEntryList;
+      const bool shouldUseGlobalEntries = hasFriends || hasEntryList || fHasEntriesRange;
       // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldUseGlobalEntries ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
+      const auto &theseFiles = shouldUseGlobalEntries ? fileNames : std::vector<std::string>({fileNames[fileIdx]});
       // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
       const auto theseClustersAndEntries =
-         shouldUseGlobalEntries ? Internal::ClustersAndEntries{} : Internal::MakeClusters(fTreeName, theseFiles);
+         shouldUseGlobalEntries ? Internal::ClustersAndEntries{}
+                                : Internal::MakeClusters(fTreeName, theseFiles, &lookahead, fileIdx);
 
       // All clusters for the file to process, either with global or local entry numbers
       const auto &thisFileClusters = shouldUseGlobalEntries ? clusters[fileIdx] : theseClustersAndEntries.first[0];
@@ -342,10 +421,24 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
          func(*reader);
       };
 
+      // Only process the part of the clusters within the range of entries, see SetEntriesRange
+      if (fHasEntriesRange) {
+         std::vector<EntryCluster> clustersInRange;
+         for (const auto &c : thisFileClusters) {
+            const auto start = std::max(c.start, fBeginEntry);
+            const auto end = fEndEntry < 0 ? c.end : std::min(c.end, fEndEntry);
+            if (start < end)
+               clustersInRange.emplace_back(EntryCluster{start, end});
+         }
+         if (!clustersInRange.empty())
+            pool.Foreach(processCluster, clustersInRange);
+         return;
+      }
+
       pool.Foreach(processCluster, thisFileClusters);
    };
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
+   std::vector<std::size_t> fileIdxs(nFiles);
    std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
 
    // Enable this IMT use case (activate its locks)
@@ -0,0 +1,190 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+#ifdef R__USE_IMT
+
+// A tree with a cluster every 1000 entries
+void WriteDrawTree(const std::string &fileName, int nEntries, int offset = 0)
+{
+   TFile f(fileName.c_str(), "RECREATE");
+   TTree t("t", "t");
+   double x = 0.;
+   int n = 0;
+   t.Branch("x", &x);
+   t.Branch("n", &n);
+   t.SetAutoFlush(1000);
+   for (n = offset; n < offset + nEntries; ++n) {
+      x = (n * 7919) % 1000 / 10.;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ExpectSameHistograms(const TH1 &expected, const TH1 &h)
+{
+   ASSERT_EQ(expected.GetNbinsX(), h.GetNbinsX());
+   ASSERT_EQ(expected.GetNbinsY(), h.GetNbinsY());
+   EXPECT_DOUBLE_EQ(expected.GetXaxis()->GetXmin(), h.GetXaxis()->GetXmin());
+   EXPECT_DOUBLE_EQ(expected.GetXaxis()->GetXmax(), h.GetXaxis()->GetXmax());
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), h.GetEntries());
+   for (auto bin = 0; bin < expected.GetNcells(); ++bin)
+      EXPECT_DOUBLE_EQ(expected.GetBinContent(bin), h.GetBinContent(bin)) << "bin " << bin;
+}
+
+// Draw the expression sequentially and in parallel, return the two histograms
+std::pair<std::unique_ptr<TH1>, std::unique_ptr<TH1>>
+DrawTwice(TTree &t, const char *varexp, const char *selection, const char *option = "goff")
+{
+   std::pair<std::unique_ptr<TH1>, std::unique_ptr<TH1>> hists;
+   auto nSelected = t.Draw(varexp, selection, option);
+   hists.first.reset(static_cast<TH1 *>(t.GetHistogram()->Clone("expected")));
+   hists.first->SetDirectory(nullptr);
+
+   ROOT::EnableImplicitMT(4);
+   EXPECT_EQ(nSelected, t.Draw(varexp, selection, option));
+   ROOT::DisableImplicitMT();
+   hists.second.reset(static_cast<TH1 *>(t.GetHistogram()->Clone("mt")));
+   hists.second->SetDirectory(nullptr);
+   return hists;
+}
+
+TEST(TTreeDrawMT, FixedBinning)
+{
+   const std::string fileName = "treedraw_fixed.root";
+   WriteDrawTree(fileName, 50000);
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   t->SetWeight(2.);
+   // with an estimate covering the entries, the values are kept in the buffers of GetV1() etc. and not filled in
+   // parallel
+   t->SetEstimate(1000);
+
+   auto h1 = DrawTwice(*t, "x>>h1(50,0,100)", "n % 3 == 0");
+   ExpectSameHistograms(*h1.first, *h1.second);
+   EXPECT_DOUBLE_EQ(2. * 16667, h1.second->GetSumOfWeights());
+
+   auto h2 = DrawTwice(*t, "n:x>>h2(10,0,100,10,0,50000)", "", "col goff");
+   ExpectSameHistograms(*h2.first, *h2.second);
+
+   auto p = DrawTwice(*t, "n:x>>p(10,0,100)", "x > 20", "prof goff");
+   ExpectSameHistograms(*p.first, *p.second);
+   ASSERT_NE(nullptr, dynamic_cast<TProfile *>(p.second.get()));
+   EXPECT_DOUBLE_EQ(p.first->GetBinContent(5), p.second->GetBinContent(5));
+
+   gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeDrawMT, EstimatedBinning)
+{
+   const std::string fileName = "treedraw_estimated.root";
+   WriteDrawTree(fileName, 50000);
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   // the limits are estimated from the first 1000 selected rows, the following ones are filled in parallel
+   t->SetEstimate(1000);
+
+   auto h = DrawTwice(*t, "x>>hx", "n % 2 == 1");
+   ExpectSameHistograms(*h.first, *h.second);
+   EXPECT_DOUBLE_EQ(25000, h.second->GetEntries());
+
+   gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeDrawMT, Chain)
+{
+   const std::string fileName0 = "treedraw_chain0.root";
+   const std::string fileName1 = "treedraw_chain1.root";
+   WriteDrawTree(fileName0, 20000);
+   WriteDrawTree(fileName1, 30000, 20000);
+   TChain c("t");
+   c.Add(fileName0.c_str());
+   c.Add(fileName1.c_str());
+   c.SetEstimate(1000);
+
+   auto h = DrawTwice(c, "n>>hn(50,0,50000)", "x < 50");
+   ExpectSameHistograms(*h.first, *h.second);
+
+   gSystem->Unlink(fileName0.c_str());
+   gSystem->Unlink(fileName1.c_str());
+}
+
+TEST(TTreeDrawMT, ChainEntryNumbers)
+{
+   const std::string fileName0 = "treedraw_chainentry0.root";
+   const std::string fileName1 = "treedraw_chainentry1.root";
+   WriteDrawTree(fileName0, 20000);
+   WriteDrawTree(fileName1, 30000, 20000);
+   TChain c("t");
+   c.Add(fileName0.c_str());
+   c.Add(fileName1.c_str());
+   c.SetEstimate(1000);
+
+   // the entry numbers of the chain are not known to the tasks: these expressions are processed sequentially
+   auto h = DrawTwice(c, "Entry$>>he(50,0,50000)", "x < 50");
+   ExpectSameHistograms(*h.first, *h.second);
+   EXPECT_DOUBLE_EQ(h.first->GetMean(), h.second->GetMean());
+
+   auto hs = DrawTwice(c, "n>>hs(50,0,50000)", "Entry$ % 2 == 0 && LocalEntry$ < Entries$");
+   ExpectSameHistograms(*hs.first, *hs.second);
+   EXPECT_DOUBLE_EQ(25000, hs.second->GetEntries());
+
+   // Entry$ equals n in this chain
+   auto hn = DrawTwice(c, "n>>hn2(50,0,50000)", "x < 50");
+   ExpectSameHistograms(*h.second, *hn.second);
+
+   gSystem->Unlink(fileName0.c_str());
+   gSystem->Unlink(fileName1.c_str());
+}
+
+TEST(TTreeDrawMT, IndexedFriend)
+{
+   const std::string fileName = "treedraw_main.root";
+   const std::string friendFileName = "treedraw_friend.root";
+   WriteDrawTree(fileName, 20000);
+   {
+      // the friend entries are in reverse order, matched to the main tree through its index
+      TFile f(friendFileName.c_str(), "RECREATE");
+      TTree t("tf", "tf");
+      int n = 0;
+      double y = 0.;
+      t.Branch("n", &n);
+      t.Branch("y", &y);
+      for (int i = 19999; i >= 0; --i) {
+         n = i;
+         y = i < 10000 ? 1. : 3.;
+         t.Fill();
+      }
+      t.Write();
+   }
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   t->SetEstimate(1000);
+   TFile ff(friendFileName.c_str());
+   TTree *tf = nullptr;
+   ff.GetObject("tf", tf);
+   tf->BuildIndex("n");
+   t->AddFriend(tf);
+
+   auto h = DrawTwice(*t, "tf.y>>hy(4,0,4)", "n < 10000");
+   ExpectSameHistograms(*h.first, *h.second);
+   EXPECT_DOUBLE_EQ(10000, h.second->GetBinContent(2));
+
+   gSystem->Unlink(fileName.c_str());
+   gSystem->Unlink(friendFileName.c_str());
+}
+
+#endif // R__USE_IMT
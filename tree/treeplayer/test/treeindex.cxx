@@ -0,0 +1,150 @@
+#include "TChain.h"
+#include "TChainIndex.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Entries have run = entry / 1000 and, within a run, decreasing event numbers, so that the index must sort them.
+// The tree has a cluster every 100 entries.
+void WriteIndexTree(const std::string &fileName, int firstRun, int nRuns)
+{
+   TFile f(fileName.c_str(), "RECREATE");
+   TTree t("t", "t");
+   int run = 0, event = 0;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.SetAutoFlush(100);
+   for (auto r = firstRun; r < firstRun + nRuns; ++r) {
+      for (auto e = 999; e >= 0; --e) {
+         run = r;
+         event = e;
+         t.Fill();
+      }
+   }
+   t.Write();
+}
+
+void CheckIndex(const TTreeIndex &index, int firstRun, int nRuns)
+{
+   ASSERT_EQ(1000 * nRuns, index.GetN());
+   for (auto i = 0; i < index.GetN(); ++i) {
+      EXPECT_EQ(firstRun + i / 1000, index.GetIndexValues()[i]);
+      EXPECT_EQ(i % 1000, index.GetIndexValuesMinor()[i]);
+      EXPECT_EQ(1000 * (i / 1000) + 999 - i % 1000, index.GetIndex()[i]);
+   }
+}
+
+TEST(TTreeIndex, Build)
+{
+   const std::string fileName = "treeindex_build.root";
+   WriteIndexTree(fileName, 3, 20);
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+
+   TTreeIndex index(t, "run", "event");
+
+   CheckIndex(index, 3, 20);
+   gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeIndex, AlreadySorted)
+{
+   const std::string fileName = "treeindex_sorted.root";
+   WriteIndexTree(fileName, 0, 5);
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+
+   TTreeIndex index(t, "run", "-event");
+
+   ASSERT_EQ(5000, index.GetN());
+   for (auto i = 0; i < index.GetN(); ++i)
+      EXPECT_EQ(i, index.GetIndex()[i]);
+   gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeIndex, SetTree)
+{
+   const std::string fileName = "treeindex_settree.root";
+   WriteIndexTree(fileName, 0, 2);
+   TTreeIndex *index = nullptr;
+   {
+      TFile f(fileName.c_str());
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      index = new TTreeIndex(t, "run", "event");
+      EXPECT_EQ(t, index->GetMajorFormula()->GetTree());
+      index->SetTree(nullptr);
+   }
+
+   // the formulas are built again for the new tree
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   index->SetTree(t);
+   EXPECT_EQ(t, index->GetMajorFormula()->GetTree());
+   EXPECT_EQ(t, index->GetMinorFormula()->GetTree());
+   delete index;
+   gSystem->Unlink(fileName.c_str());
+}
+
+#ifdef R__USE_IMT
+
+TEST(TTreeIndex, BuildMT)
+{
+   const std::string fileName = "treeindex_buildmt.root";
+   WriteIndexTree(fileName, 3, 20);
+   TFile f(fileName.c_str());
+   TTree *t = nullptr;
+   f.GetObject("t", t);
+   t->SetAlias("runAlias", "run");
+
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex index(t, "runAlias", "event");
+   ROOT::DisableImplicitMT();
+
+   CheckIndex(index, 3, 20);
+   t->SetTreeIndex(&index);
+   EXPECT_EQ(2 * 1000 + 999 - 42, t->GetEntryNumberWithIndex(5, 42));
+   EXPECT_EQ(-1, t->GetEntryNumberWithIndex(5, 1000));
+   t->SetTreeIndex(nullptr);
+   gSystem->Unlink(fileName.c_str());
+}
+
+TEST(TTreeIndex, ChainMT)
+{
+   const std::vector<std::string> fileNames{"treeindex_chainmt0.root", "treeindex_chainmt1.root",
+                                            "treeindex_chainmt2.root"};
+   TChain c("t");
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      WriteIndexTree(fileNames[i], 10 * i, 2);
+      c.Add(fileNames[i].c_str());
+   }
+
+   ROOT::EnableImplicitMT(4);
+   c.BuildIndex("run", "event");
+   ROOT::DisableImplicitMT();
+
+   auto index = dynamic_cast<TChainIndex *>(c.GetTreeIndex());
+   ASSERT_NE(nullptr, index);
+   EXPECT_EQ(3, index->GetN());
+   EXPECT_EQ(999 - 7, c.GetEntryNumberWithIndex(0, 7));
+   EXPECT_EQ(3 * 1000 + 999 - 7, c.GetEntryNumberWithIndex(11, 7));
+   EXPECT_EQ(4 * 1000 + 999, c.GetEntryNumberWithIndex(20, 0));
+   EXPECT_EQ(-1, c.GetEntryNumberWithIndex(2, 0));
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+#endif // R__USE_IMT
@@ -4,7 +4,9 @@
 #include <string>
 #include <thread>
 
+#include <TError.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TSystem.h>
 #include <TTreeReader.h>
@@ -85,6 +87,101 @@ TEST(TreeProcessorMT, ManyFiles)
    DeleteFiles(filenames);
 }
 
+TEST(TreeProcessorMT, FilePrefetch)
+{
+   ROOT::EnableImplicitMT();
+   const auto nFiles = 20u;
+   const std::string treename = "t";
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < nFiles; ++i)
+      filenames.emplace_back("treeprocmt_prefetch_" + std::to_string(i) + ".root");
+
+   WriteFiles(treename, filenames);
+
+   std::atomic_int sum(0);
+   std::atomic_int count(0);
+   auto sumValues = [&sum, &count](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      while (r.Next()) {
+         sum += *v;
+         ++count;
+      }
+   };
+
+   std::vector<std::string_view> fnames;
+   for (const auto &f : filenames)
+      fnames.emplace_back(f);
+
+   ROOT::TTreeProcessorMT proc(fnames, treename);
+   proc.SetFilePrefetch(3);
+   proc.Process(sumValues);
+
+   EXPECT_EQ(count.load(), int(nFiles * 10)); // 10 entries per file
+   EXPECT_EQ(sum.load(), 20100);              // sum 1..nFiles*10
+
+   // No file opened ahead is left open
+   for (const auto &f : filenames)
+      EXPECT_EQ(nullptr, gROOT->GetListOfFiles()->FindObject(f.c_str()));
+
+   DeleteFiles(filenames);
+}
+
+TEST(TreeProcessorMT, EntriesRange)
+{
+   ROOT::EnableImplicitMT();
+   const std::string treename = "t";
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < 5u; ++i)
+      filenames.emplace_back("treeprocmt_entriesrange_" + std::to_string(i) + ".root");
+
+   WriteFiles(treename, filenames);
+
+   std::atomic_int sum(0);
+   std::atomic_int count(0);
+   std::atomic_int nWrongEntries(0);
+   auto sumValues = [&sum, &count, &nWrongEntries](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      while (r.Next()) {
+         sum += *v;
+         ++count;
+         if (r.GetCurrentEntry() != *v - 1) // entry numbers are global
+            ++nWrongEntries;
+      }
+   };
+
+   std::vector<std::string_view> fnames;
+   for (const auto &f : filenames)
+      fnames.emplace_back(f);
+
+   ROOT::TTreeProcessorMT proc(fnames, treename);
+   proc.SetEntriesRange(13, 37);
+   proc.Process(sumValues);
+
+   EXPECT_EQ(count.load(), 24);
+   EXPECT_EQ(sum.load(), 612); // sum 14..37
+   EXPECT_EQ(nWrongEntries.load(), 0);
+
+   // The files after the end of the range are not opened: a missing one raises no error
+   gSystem->Unlink(filenames.back().c_str());
+   static std::atomic_int nErrors(0);
+   auto oldHandler = SetErrorHandler([](int level, Bool_t, const char *, const char *) {
+      if (level >= kError)
+         ++nErrors;
+   });
+   sum = 0;
+   count = 0;
+   ROOT::TTreeProcessorMT proc2(fnames, treename);
+   proc2.SetEntriesRange(13, 37);
+   proc2.Process(sumValues);
+   SetErrorHandler(oldHandler);
+
+   EXPECT_EQ(count.load(), 24);
+   EXPECT_EQ(sum.load(), 612);
+   EXPECT_EQ(nErrors.load(), 0);
+
+   DeleteFiles(filenames);
+}
+
 TEST(TreeProcessorMT, TreeInSubDirectory)
 {
    auto filename = "fileTreeInSubDirectory.root";